@@ -41,6 +41,12 @@ b3_action_free_impl(b3_action_t *action);
 static int
 b3_action_exec_impl(b3_action_t *action, b3_director_t *director, b3_win_t *win);
 
+static int
+b3_action_prepare_impl(b3_action_t *action, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement);
+
+static int
+b3_action_equals_impl(b3_action_t *action, b3_action_t *other);
+
 b3_action_t *
 b3_action_new(void)
 {
@@ -51,6 +57,8 @@ b3_action_new(void)
   if (action) {
     action->action_free = b3_action_free_impl;
     action->action_exec = b3_action_exec_impl;
+    action->action_prepare = b3_action_prepare_impl;
+    action->action_equals = b3_action_equals_impl;
   }
 
   return action;
@@ -68,6 +76,18 @@ b3_action_exec(b3_action_t *action, b3_director_t *director, b3_win_t *win)
   return action->action_exec(action, director, win);
 }
 
+int
+b3_action_prepare(b3_action_t *action, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement)
+{
+  return action->action_prepare(action, director, win, placement);
+}
+
+int
+b3_action_equals(b3_action_t *action, b3_action_t *other)
+{
+  return action->action_equals(action, other);
+}
+
 int
 b3_action_free_impl(b3_action_t *action)
 {
@@ -83,3 +103,16 @@ b3_action_exec_impl(b3_action_t *action, b3_director_t *director, b3_win_t *win)
 
   return -1;
 }
+
+int
+b3_action_prepare_impl(b3_action_t *action, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement)
+{
+  /** By default an action can only be executed on a managed window */
+  return 1;
+}
+
+int
+b3_action_equals_impl(b3_action_t *action, b3_action_t *other)
+{
+  return action == other;
+}
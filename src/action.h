@@ -36,10 +36,30 @@
 
 typedef struct b3_action_s b3_action_t;
 
+/**
+ * The destination of a window that is not yet managed by the director. It is
+ * filled in by b3_action_prepare() so that the window can be placed once.
+ */
+typedef struct b3_action_placement_s
+{
+  /**
+   * Name of the target workspace or NULL for the focused workspace of the
+   * monitor of the window. Owned by the action. Do not free it!
+   */
+  const char *ws_id;
+
+  /**
+   * Non-0 if the window will be floating.
+   */
+  char floating;
+} b3_action_placement_t;
+
 struct b3_action_s
 {
   int (*action_free)(b3_action_t *action);
   int (*action_exec)(b3_action_t *action, b3_director_t *director, b3_win_t *win);
+  int (*action_prepare)(b3_action_t *action, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement);
+  int (*action_equals)(b3_action_t *action, b3_action_t *other);
 };
 
 extern b3_action_t *
@@ -49,9 +69,29 @@ extern int
 b3_action_free(b3_action_t *action);
 
 /**
- * Executes action with director and win.
+ * Executes action with director and win. Actions arrange the windows through
+ * b3_director_arrange_wins(), which is deferred to the commit if the action
+ * runs within a transaction of director.
  */
 extern int
 b3_action_exec(b3_action_t *action, b3_director_t *director, b3_win_t *win);
 
+/**
+ * Applies action to the placement of a window before the window is added to
+ * director.
+ *
+ * @return 0 if the action is fully expressed by placement. Non-0 if it has to
+ * be executed by b3_action_exec() after the window was added.
+ */
+extern int
+b3_action_prepare(b3_action_t *action, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement);
+
+/**
+ * Checks if two actions are of the same kind and have the same arguments.
+ *
+ * @return Non-0 if action equals other.
+ */
+extern int
+b3_action_equals(b3_action_t *action, b3_action_t *other);
+
 #endif // B3_ACTION_H
@@ -42,6 +42,18 @@ b3_action_list_free_impl(b3_action_t *action);
 static int
 b3_action_list_exec_impl(b3_action_t *action, b3_director_t *director, b3_win_t *win);
 
+/**
+ * Implementation of b3_action_prepare().
+ */
+static int
+b3_action_list_prepare_impl(b3_action_t *action, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement);
+
+/**
+ * Implementation of b3_action_equals().
+ */
+static int
+b3_action_list_equals_impl(b3_action_t *action, b3_action_t *other);
+
 static int
 b3_action_cc_list_add_impl(b3_action_list_t *action_list, b3_action_t *new_action);
 
@@ -60,9 +72,13 @@ b3_action_list_new(void)
 
     action_list->super_action_free = action_list->action.action_free;
     action_list->super_action_exec = action_list->action.action_exec;
+    action_list->super_action_prepare = action_list->action.action_prepare;
+    action_list->super_action_equals = action_list->action.action_equals;
 
     action_list->action.action_free = b3_action_list_free_impl;
     action_list->action.action_exec = b3_action_list_exec_impl;
+    action_list->action.action_prepare = b3_action_list_prepare_impl;
+    action_list->action.action_equals = b3_action_list_equals_impl;
 
     action_list->action_cc_list_add = b3_action_cc_list_add_impl;
 
@@ -109,12 +125,17 @@ b3_action_list_exec_impl(b3_action_t *action, b3_director_t *director, b3_win_t
 
   action_list = (b3_action_list_t *) action;
 
+  /** All actions share one transaction, so the windows are arranged once */
+  b3_director_begin_transaction(director);
+
   error = 0;
 	cc_array_iter_init(&iter, action_list->action_arr);
 	while (!error && cc_array_iter_next(&iter, (void*) &action_iter) != CC_ITER_END) {
     error = b3_action_exec(action_iter, director, win);
   }
 
+  b3_director_commit_transaction(director);
+
   return error;
 }
 
@@ -125,3 +146,66 @@ b3_action_cc_list_add_impl(b3_action_list_t *action_list, b3_action_t *new_actio
 
   return 0;
 }
+
+int
+b3_action_list_prepare_impl(b3_action_t *action, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement)
+{
+  b3_action_list_t *action_list;
+  CC_ArrayIter iter;
+	b3_action_t *action_iter;
+  b3_action_placement_t list_placement;
+  int error;
+
+  action_list = (b3_action_list_t *) action;
+
+  /**
+   * Either all actions of the list are prepared or none, otherwise the
+   * prepared ones would be applied a second time by b3_action_exec().
+   */
+  list_placement = *placement;
+
+  error = 0;
+	cc_array_iter_init(&iter, action_list->action_arr);
+	while (!error && cc_array_iter_next(&iter, (void*) &action_iter) != CC_ITER_END) {
+    error = b3_action_prepare(action_iter, director, win, &list_placement);
+  }
+
+  if (!error) {
+    *placement = list_placement;
+  }
+
+  return error;
+}
+
+int
+b3_action_list_equals_impl(b3_action_t *action, b3_action_t *other)
+{
+  b3_action_list_t *action_list;
+  b3_action_list_t *other_list;
+  b3_action_t *action_iter;
+  b3_action_t *other_iter;
+  int equals;
+  int i;
+
+  equals = (other->action_equals == action->action_equals);
+
+  if (equals) {
+    action_list = (b3_action_list_t *) action;
+    other_list = (b3_action_list_t *) other;
+
+    equals = (cc_array_size(action_list->action_arr) == cc_array_size(other_list->action_arr));
+    for (i = 0; equals && i < cc_array_size(action_list->action_arr); i++) {
+      cc_array_get_at(action_list->action_arr, i, (void *) &action_iter);
+      cc_array_get_at(other_list->action_arr, i, (void *) &other_iter);
+      equals = b3_action_equals(action_iter, other_iter);
+    }
+  }
+
+  return equals;
+}
+
+int
+b3_action_list_instance_of(const b3_action_t *action)
+{
+  return action->action_free == b3_action_list_free_impl;
+}
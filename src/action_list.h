@@ -47,6 +47,8 @@ struct b3_action_list_s
   b3_action_t action;
   int (*super_action_free)(b3_action_t *action);
   int (*super_action_exec)(b3_action_t *action, b3_director_t *director, b3_win_t *win);
+  int (*super_action_prepare)(b3_action_t *action, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement);
+  int (*super_action_equals)(b3_action_t *action, b3_action_t *other);
 
   int (*action_cc_list_add)(b3_action_list_t *action_list, b3_action_t *new_action);
 
@@ -68,4 +70,10 @@ b3_action_list_new(void);
 extern int
 b3_action_cc_list_add(b3_action_list_t *action_list, b3_action_t *new_action);
 
+/**
+ * @return Non-0 if action is an action list.
+ */
+extern int
+b3_action_list_instance_of(const b3_action_t *action);
+
 #endif // B3_ACTION_LIST_H
@@ -1,95 +1,109 @@
-/******************************************************************************
-  This file is part of b3.
-
-  Copyright 2020 Richard Paul Baeck <richard.baeck@mailbox.org>
-
-  Permission is hereby granted, free of charge, to any person obtaining a copy
-  of this software and associated documentation files (the "Software"), to deal
-  in the Software without restriction, including without limitation the rights
-  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
-  copies of the Software, and to permit persons to whom the Software is
-  furnished to do so, subject to the following conditions:
-
-  The above copyright notice and this permission notice shall be included in all
-  copies or substantial portions of the Software.
-
-  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-  SOFTWARE.
-*******************************************************************************/
-
-#include "bar.h"
-
-#include <stdlib.h>
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+#include "bar.h"
+
+#include <stdlib.h>
 #include <string.h>
-#include <collectc/cc_hashtable.h>
+#include <collectc/cc_hashtable.h>
 #include <collectc/cc_array.h>
 #include <windows.h>
 #include <windowsx.h>
 #include <w32bindkeys/logger.h>
-
+
 #include "ws.h"
 
 static wbk_logger_t logger = { "bar" };
 
 /**
- * Communication structure for b3_bar_draw() and b3_bar_draw_ws_visitor().
+ * Creates the window that will be used to paint the status bar on.
  */
-typedef struct b3_bar_draw_comm_s
-{
-  b3_bar_t *bar;
-  b3_ws_t *focused_ws;
-  HDC hdc;
-  PAINTSTRUCT ps;
-  RECT rect;
-  RECT text_rect;
-  HBRUSH background_brush;
-  HBRUSH focused_monitor_ws_brush;
-  HBRUSH focused_ws_brush;
-} b3_bar_draw_comm_t;
+static int
+b3_bar_create_window(b3_bar_t *bar, const char *monitor_name);
 
 /**
- * Communication structure for b3_bar_handle_mouse_click() and
- * b3_bar_click_ws_visitor().
+ * Draws the changed workspaces of the status bar into its back buffer and
+ * copies them to the window.
  */
-typedef struct b3_bar_click_comm_s
-{
-    b3_bar_t *bar;
-    b3_ws_t *focused_ws;
-    HDC hdc;
-    RECT rect;
-    RECT text_rect;
-    int x;
-    int y;
-} b3_bar_click_comm_t;
+static int
+b3_bar_draw(b3_bar_t *bar, HWND window_handler);
 
 /**
- * Belongs to b3_bar_draw() and b3_bar_draw_ws_visitor(). Do not set it
- * somewhere else!
+ * Creates the back buffer and the GDI resources if they are missing, stale or
+ * the size of the bar changed.
+ *
+ * @return Non-0 if the back buffer has to be drawn from scratch.
  */
-static b3_bar_draw_comm_t g_draw_comm;
+static int
+b3_bar_prepare_buffer(b3_bar_t *bar, HDC hdc);
+
+static int
+b3_bar_free_buffer(b3_bar_t *bar);
+
+static int
+b3_bar_create_resources(b3_bar_t *bar);
+
+static int
+b3_bar_free_resources(b3_bar_t *bar);
 
 /**
- * Belongs to b3_bar_click() and b3_bar_click_ws_visitor_click(). Do not set it
- * somewhere else!
+ * Draws a cell into the back buffer.
  */
-static b3_bar_click_comm_t g_click_comm;
+static int
+b3_bar_draw_cell(b3_bar_t *bar, const b3_bar_cell_t *cell);
 
 /**
- * Creates the window that will be used to paint the status bar on.
+ * Draws the status blocks right aligned into the back buffer. Blocks which
+ * would cover a workspace are left out.
+ *
+ * @param left The right end of the workspaces
+ * @param dirty Enlarged by the changed area
  */
 static int
-b3_bar_create_window(b3_bar_t *bar, const char *monitor_name);
+b3_bar_draw_status(b3_bar_t *bar, LONG left, RECT *dirty);
+
+/**
+ * @return A new wide string of a UTF-8 string. Free it yourself! NULL if
+ * conversion failed.
+ */
+static wchar_t *
+b3_bar_utf8_to_wide(const char *str, int *len);
 
 /**
- * Draws the status bar.
+ * @param color 0xRRGGBB
+ */
+static COLORREF
+b3_bar_color(long color);
+
+/**
+ * @return Non-0 if both cells look the same.
  */
 static int
-b3_bar_draw(b3_bar_t *bar, HWND window_handler);
+b3_bar_cell_equals(const b3_bar_cell_t *cell, const b3_bar_cell_t *other);
+
+static int
+b3_bar_free_cell_arr(b3_bar_cell_t *cell_arr, int cell_arr_len);
 
 /**
  * Window procedure attached to the window created by b3_bar_create_window(). It
@@ -99,17 +113,21 @@ static LRESULT
 CALLBACK b3_bar_WndProc(HWND window_handler, UINT msg, WPARAM wParam, LPARAM lParam);
 
 /**
- * Visitor used in b3_bar_draw() to draw each available workspace.
+ * Visitor used in b3_bar_draw() to lay out each available workspace.
+ *
+ * @param data The draw communication structure of the bar
  */
 static void
-b3_bar_draw_ws_visitor(b3_ws_t *ws);
+b3_bar_draw_ws_visitor(b3_ws_t *ws, void *data);
 
 /**
- * Visitor used in b3_bar_handle_mouse_click() to check if the mouse click was
- * performed in a rectangle of/for a workspace.
+ * Searches the cells drawn last for the one containing point. The cells are
+ * sorted from left to right and do not overlap.
+ *
+ * @return The cell or NULL if there is none at point. Do not free it!
  */
-static void
-b3_bar_click_ws_visitor(b3_ws_t *ws);
+static const b3_bar_cell_t *
+b3_bar_find_cell(b3_bar_t *bar, POINT point);
 
 /**
  * Returns the rectangle of the area accommondated by the b3 bar on the Windows'
@@ -127,57 +145,61 @@ b3_bar_get_canvas_area(b3_bar_t *bar);
 static RECT
 b3_bar_get_workspace_area(b3_bar_t *bar);
 
-/**
- * Returns the rectangle of the area in which one workspace name is drawn. It
- * starts from the left.
- *
- * This rectangle is relative to b3_bar_get_workspace_area().
- */
-static RECT
-b3_bar_get_workspace_text_area(b3_bar_t *bar);
-
-b3_bar_t *
+b3_bar_t *
 b3_bar_new(const char *monitor_name,
 		   RECT monitor_area,
 		   b3_wsman_t *wsman,
-		   b3_ws_switcher_t *ws_switcher)
-{
-	b3_bar_t *bar;
-
-	bar = NULL;
-	bar = malloc(sizeof(b3_bar_t));
-
+		   b3_ws_switcher_t *ws_switcher,
+		   b3_textcache_t *textcache)
+{
+	b3_bar_t *bar;
+
+	bar = NULL;
+	bar = malloc(sizeof(b3_bar_t));
+	memset(bar, 0, sizeof(b3_bar_t));
+
 	bar->position = B3_BAR_DEFAULT_POS;
 
-	bar->area.top    = monitor_area.top;
+	bar->area.top    = monitor_area.top;
 	bar->area.bottom = monitor_area.top + B3_BAR_DEFAULT_BAR_HEIGHT;
-	bar->area.left   = monitor_area.left;
-	bar->area.right  = monitor_area.right;
-
+	bar->area.left   = monitor_area.left;
+	bar->area.right  = monitor_area.right;
+
 	bar->wsman = wsman;
 
     bar->ws_switcher = ws_switcher;
 
+	bar->textcache = textcache;
+
 	b3_bar_create_window(bar, monitor_name);
 
-	return bar;
-}
-
-int
-b3_bar_free(b3_bar_t *bar)
-{
+	return bar;
+}
+
+int
+b3_bar_free(b3_bar_t *bar)
+{
 	bar->wsman = NULL;
 
+	bar->textcache = NULL;
+
     b3_ws_switcher_free(bar->ws_switcher);
     bar->ws_switcher = NULL;
 
 	DestroyWindow(bar->window_handler);
 	bar->window_handler = NULL;
 
-	free(bar);
-	return 0;
-}
-
+	b3_bar_free_buffer(bar);
+	b3_bar_free_resources(bar);
+
+	b3_bar_free_cell_arr(bar->cell_arr, bar->cell_arr_len);
+	bar->cell_arr = NULL;
+	bar->cell_arr_len = 0;
+
+	free(bar);
+	return 0;
+}
+
 RECT
 b3_bar_get_area(b3_bar_t *bar)
 {
@@ -199,48 +221,80 @@ b3_bar_is_focused(b3_bar_t *bar)
 int
 b3_bar_set_focused(b3_bar_t *bar, char focused)
 {
-	bar->focused = focused;
+	if (bar->focused != focused) {
+		bar->focused = focused;
+		b3_bar_set_dirty(bar, B3_BAR_DIRTY_FOCUSED_WS);
+	}
+	return 0;
+}
+
+int
+b3_bar_set_status(b3_bar_t *bar, b3_status_t *status)
+{
+	bar->status = status;
+	b3_bar_set_dirty(bar, B3_BAR_DIRTY_STATUS);
+	return 0;
+}
+
+int
+b3_bar_set_dirty(b3_bar_t *bar, LONG dirty)
+{
+	InterlockedOr(&(bar->dirty), dirty);
+	return 0;
+}
+
+int
+b3_bar_update(b3_bar_t *bar)
+{
+	if (bar->dirty
+	    && InterlockedExchange(&(bar->update_posted), 1) == 0) {
+		if (!PostMessage(bar->window_handler, B3_BAR_WM_UPDATE, 0, 0)) {
+			InterlockedExchange(&(bar->update_posted), 0);
+			wbk_logger_log(&logger, WARNING, "Could not post an update to the bar\n");
+			return 1;
+		}
+	}
 	return 0;
 }
 
-int
-b3_bar_create_window(b3_bar_t *bar, const char *monitor_name)
-{
+int
+b3_bar_create_window(b3_bar_t *bar, const char *monitor_name)
+{
 	int error;
-	WNDCLASSEX wc;
-	HINSTANCE hInstance;
+	WNDCLASSEX wc;
+	HINSTANCE hInstance;
 	int monitor_name_len;
 	int titlebar_height;
 	char *win_class;
-
+
 	error = 0;
 	win_class = NULL;
-
+
 	if (!error) {
-		hInstance = GetModuleHandle(NULL);
-
+		hInstance = GetModuleHandle(NULL);
+
 		monitor_name_len = strlen(monitor_name);
 		win_class = malloc(sizeof(char) * (B3_BAR_WIN_NAME_LEN + monitor_name_len + 1));
 		strcpy(win_class, B3_BAR_WIN_NAME);
 		strcpy(win_class + B3_BAR_WIN_NAME_LEN, monitor_name);
 		win_class[B3_BAR_WIN_NAME_LEN + monitor_name_len] = '\0';
 
-		wc.cbSize		= sizeof(WNDCLASSEX);
-		wc.style		 = 0;
-		wc.lpfnWndProc   = b3_bar_WndProc;
-		wc.cbClsExtra	= 0;
-		wc.cbWndExtra	= 0;
-		wc.hInstance	 = hInstance;
-		wc.hIcon		 = LoadIcon(NULL, IDI_APPLICATION);
-		wc.hCursor	   = LoadCursor(NULL, IDC_ARROW);
-		wc.hbrBackground = (HBRUSH)(COLOR_WINDOW+1);
-		wc.lpszMenuName  = NULL;
+		wc.cbSize		= sizeof(WNDCLASSEX);
+		wc.style		 = 0;
+		wc.lpfnWndProc   = b3_bar_WndProc;
+		wc.cbClsExtra	= 0;
+		wc.cbWndExtra	= 0;
+		wc.hInstance	 = hInstance;
+		wc.hIcon		 = LoadIcon(NULL, IDI_APPLICATION);
+		wc.hCursor	   = LoadCursor(NULL, IDC_ARROW);
+		wc.hbrBackground = (HBRUSH)(COLOR_WINDOW+1);
+		wc.lpszMenuName  = NULL;
 		wc.lpszClassName = win_class;
-		wc.hIconSm	   = LoadIcon(NULL, IDI_APPLICATION);
-
+		wc.hIconSm	   = LoadIcon(NULL, IDI_APPLICATION);
+
 		if(!RegisterClassEx(&wc)) {
 			error = 1;
-		}
+		}
 	}
 
 	if (!error) {
@@ -262,11 +316,11 @@ b3_bar_create_window(b3_bar_t *bar, const char *monitor_name)
 
 	if (win_class) {
 		free(win_class);
-	}
-
+	}
+
 	return error;
-}
-
+}
+
 int
 b3_bar_show(b3_bar_t *bar)
 {
@@ -297,176 +351,617 @@ b3_bar_hide(b3_bar_t *bar)
 	return 0;
 }
 
+
+
 void
-b3_bar_draw_ws_visitor(b3_ws_t *ws)
+b3_bar_draw_ws_visitor(b3_ws_t *ws, void *data)
 {
+  b3_bar_draw_comm_t *comm;
   SIZE text_size;
   int str_length;
+  b3_bar_cell_t *cell;
+  b3_bar_cell_t *cell_arr;
+  const b3_bar_cell_t *prev_cell;
 
-  /**
-   * Enlarge the rectangle to enclose the workspace's name
-   */
-  GetTextExtentPoint32A(g_draw_comm.hdc, b3_ws_get_name(ws), strlen(b3_ws_get_name(ws)), &text_size);
-  str_length = text_size.cx + B3_BAR_DEFAULT_PADDING_TO_FRAME;
-  g_draw_comm.rect.right = g_draw_comm.rect.left + str_length + B3_BAR_DEFAULT_PADDING_TO_FRAME;
+  comm = (b3_bar_draw_comm_t *) data;
 
-  g_draw_comm.text_rect.left = g_draw_comm.rect.left + B3_BAR_DEFAULT_PADDING_TO_FRAME;
-  g_draw_comm.text_rect.right = g_draw_comm.rect.right - B3_BAR_DEFAULT_PADDING_TO_FRAME;
+  if (comm->cell_arr_len == comm->cell_arr_cap) {
+    cell_arr = realloc(comm->cell_arr, sizeof(b3_bar_cell_t) * (comm->cell_arr_cap + 8));
+    if (cell_arr == NULL) {
+      return;
+    }
+    comm->cell_arr = cell_arr;
+    comm->cell_arr_cap += 8;
+  }
+
+  prev_cell = NULL;
+  if (!comm->relayout && comm->cell_arr_len < comm->bar->cell_arr_len) {
+    prev_cell = &(comm->bar->cell_arr[comm->cell_arr_len]);
+  }
 
+  if (prev_cell && strcmp(prev_cell->name, b3_ws_get_name(ws)) == 0) {
+    /**
+     * Same name at the same position, so the cell did not move
+     */
+    comm->rect = prev_cell->rect;
+  } else {
+    /**
+     * Enlarge the rectangle to enclose the workspace's name. All following
+     * cells move as well.
+     */
+    b3_textcache_get_extent(comm->bar->textcache, comm->hdc, &(comm->bar->logfont),
+                            B3_TEXTCACHE_ANSI, b3_ws_get_name(ws), &text_size);
+    str_length = text_size.cx + B3_BAR_DEFAULT_PADDING_TO_FRAME;
+    comm->rect.right = comm->rect.left + str_length + B3_BAR_DEFAULT_PADDING_TO_FRAME;
+    comm->relayout = 1;
+  }
+
+  cell = &(comm->cell_arr[comm->cell_arr_len]);
+  cell->name = strdup(b3_ws_get_name(ws));
+  cell->rect = comm->rect;
+  cell->style = B3_BAR_CELL_NORMAL;
   if (strcmp(b3_ws_get_name(ws),
-             b3_ws_get_name(g_draw_comm.focused_ws)) == 0) {
-    if (b3_bar_is_focused(g_draw_comm.bar)) {
-      FillRect(g_draw_comm.hdc, &g_draw_comm.rect, g_draw_comm.focused_monitor_ws_brush);
+             b3_ws_get_name(comm->focused_ws)) == 0) {
+    if (b3_bar_is_focused(comm->bar)) {
+      cell->style = B3_BAR_CELL_FOCUSED_MONITOR;
     } else {
-      FillRect(g_draw_comm.hdc, &g_draw_comm.rect, g_draw_comm.focused_ws_brush);
+      cell->style = B3_BAR_CELL_FOCUSED;
     }
-  } else {
-    Rectangle(g_draw_comm.hdc,
-              g_draw_comm.rect.left, g_draw_comm.rect.top,
-              g_draw_comm.rect.right, g_draw_comm.rect.bottom);
+  } else if (b3_ws_is_urgent(ws)) {
+    cell->style = B3_BAR_CELL_URGENT;
+  }
+
+  if (cell->name) {
+    comm->cell_arr_len++;
+  }
+
+  /**
+   * Move the rectangle for the next workspace
+   */
+  comm->rect.left = comm->rect.right + B3_BAR_DEFAULT_PADDING_TO_NEXT_FRAME;
+}
+
+int
+b3_bar_draw(b3_bar_t *bar, HWND window_handler)
+{
+  b3_bar_draw_comm_t *comm;
+  HDC hdc;
+  RECT canvas;
+  RECT dirty;
+  char redraw;
+  int i;
+
+  hdc = GetDC(window_handler);
+
+  redraw = b3_bar_prepare_buffer(bar, hdc);
+
+  comm = &(bar->draw_comm);
+
+  /**
+   * Lay out the workspaces with the font of the back buffer
+   */
+  comm->bar = bar;
+  comm->focused_ws = b3_wsman_get_focused_ws(bar->wsman);
+  comm->hdc = bar->buffer_hdc;
+  comm->rect = b3_bar_get_workspace_area(bar);
+  comm->relayout = redraw;
+  comm->cell_arr = NULL;
+  comm->cell_arr_len = 0;
+  comm->cell_arr_cap = 0;
+
+  b3_wsman_iterate_ws_arr(bar->wsman, b3_bar_draw_ws_visitor, comm);
+
+  canvas = b3_bar_get_canvas_area(bar);
+  SetRectEmpty(&dirty);
+
+  if (redraw) {
+    FillRect(bar->buffer_hdc, &canvas, bar->background_brush);
+    dirty = canvas;
+  }
+
+  /**
+   * Only cells which look different are drawn again. A changed cell may grow
+   * into the old rectangle of the next one, so all old rectangles are cleared
+   * before any cell is drawn.
+   */
+  for (i = 0; !redraw && i < bar->cell_arr_len; i++) {
+    if (i >= comm->cell_arr_len
+        || !b3_bar_cell_equals(&(bar->cell_arr[i]), &(comm->cell_arr[i]))) {
+      FillRect(bar->buffer_hdc, &(bar->cell_arr[i].rect), bar->background_brush);
+      UnionRect(&dirty, &dirty, &(bar->cell_arr[i].rect));
+    }
+  }
+
+  for (i = 0; i < comm->cell_arr_len; i++) {
+    if (redraw
+        || i >= bar->cell_arr_len
+        || !b3_bar_cell_equals(&(bar->cell_arr[i]), &(comm->cell_arr[i]))) {
+      b3_bar_draw_cell(bar, &(comm->cell_arr[i]));
+      UnionRect(&dirty, &dirty, &(comm->cell_arr[i].rect));
+    }
+  }
+
+  b3_bar_free_cell_arr(bar->cell_arr, bar->cell_arr_len);
+  bar->cell_arr = comm->cell_arr;
+  bar->cell_arr_len = comm->cell_arr_len;
+  comm->cell_arr = NULL;
+
+  /**
+   * The status is only drawn again if it changed or the workspaces moved
+   */
+  if (comm->relayout
+      || (bar->status && b3_status_get_serial(bar->status) != bar->status_serial)
+      || (bar->status == NULL && !IsRectEmpty(&(bar->status_rect)))) {
+    b3_bar_draw_status(bar, comm->rect.left, &dirty);
+  }
+
+  if (!IsRectEmpty(&dirty)) {
+    BitBlt(hdc,
+           dirty.left, dirty.top,
+           dirty.right - dirty.left, dirty.bottom - dirty.top,
+           bar->buffer_hdc,
+           dirty.left, dirty.top,
+           SRCCOPY);
+  }
+
+  ReleaseDC(window_handler, hdc);
+
+  return 0;
+}
+
+int
+b3_bar_prepare_buffer(b3_bar_t *bar, HDC hdc)
+{
+  RECT canvas;
+  int width;
+  int height;
+  int redraw;
+
+  redraw = 0;
+
+  if (bar->font == NULL || bar->resources_stale) {
+    b3_bar_free_resources(bar);
+    b3_bar_create_resources(bar);
+    bar->resources_stale = 0;
+    redraw = 1;
+  }
+
+  canvas = b3_bar_get_canvas_area(bar);
+  width = canvas.right - canvas.left;
+  height = canvas.bottom - canvas.top;
+
+  if (bar->buffer_hdc == NULL
+      || bar->buffer_width != width
+      || bar->buffer_height != height) {
+    b3_bar_free_buffer(bar);
+
+    bar->buffer_hdc = CreateCompatibleDC(hdc);
+    bar->buffer_bitmap = CreateCompatibleBitmap(hdc, width, height);
+    bar->buffer_default_bitmap = SelectObject(bar->buffer_hdc, bar->buffer_bitmap);
+    bar->buffer_width = width;
+    bar->buffer_height = height;
+
+    SetBkMode(bar->buffer_hdc, TRANSPARENT);
+    redraw = 1;
   }
 
-  DrawText(g_draw_comm.hdc, b3_ws_get_name(ws),
+  if (redraw) {
+    bar->buffer_default_font = SelectObject(bar->buffer_hdc, bar->font);
+  }
+
+  return redraw;
+}
+
+int
+b3_bar_free_buffer(b3_bar_t *bar)
+{
+  if (bar->buffer_hdc) {
+    SelectObject(bar->buffer_hdc, bar->buffer_default_bitmap);
+    if (bar->buffer_default_font) {
+      SelectObject(bar->buffer_hdc, bar->buffer_default_font);
+    }
+    DeleteDC(bar->buffer_hdc);
+    bar->buffer_hdc = NULL;
+  }
+
+  if (bar->buffer_bitmap) {
+    DeleteObject(bar->buffer_bitmap);
+    bar->buffer_bitmap = NULL;
+  }
+
+  bar->buffer_default_bitmap = NULL;
+  bar->buffer_default_font = NULL;
+
+  return 0;
+}
+
+int
+b3_bar_create_resources(b3_bar_t *bar)
+{
+  NONCLIENTMETRICS metrics;
+
+  bar->background_brush = CreateSolidBrush(RGB(255, 255, 255));
+  bar->focused_monitor_ws_brush = CreateSolidBrush(RGB(255, 0, 0));
+  bar->focused_ws_brush = CreateSolidBrush(RGB(100, 100, 100));
+  bar->urgent_ws_brush = CreateSolidBrush(RGB(255, 165, 0));
+
+  /**
+   * The font of message boxes follows the theme and the DPI
+   */
+  metrics.cbSize = sizeof(NONCLIENTMETRICS);
+  if (SystemParametersInfo(SPI_GETNONCLIENTMETRICS, sizeof(NONCLIENTMETRICS), &metrics, 0)) {
+    bar->font = CreateFontIndirect(&(metrics.lfMessageFont));
+    bar->logfont = metrics.lfMessageFont;
+  }
+
+  if (bar->font == NULL) {
+    wbk_logger_log(&logger, WARNING, "Could not create the font of the bar, using the default font\n");
+    bar->font = (HFONT) GetStockObject(DEFAULT_GUI_FONT);
+    GetObject(bar->font, sizeof(LOGFONT), &(bar->logfont));
+  }
+
+  return 0;
+}
+
+int
+b3_bar_free_resources(b3_bar_t *bar)
+{
+  /**
+   * The font must not be selected when it is deleted
+   */
+  if (bar->buffer_hdc && bar->buffer_default_font) {
+    SelectObject(bar->buffer_hdc, bar->buffer_default_font);
+    bar->buffer_default_font = NULL;
+  }
+
+  if (bar->background_brush) {
+    DeleteObject(bar->background_brush);
+    bar->background_brush = NULL;
+  }
+
+  if (bar->focused_monitor_ws_brush) {
+    DeleteObject(bar->focused_monitor_ws_brush);
+    bar->focused_monitor_ws_brush = NULL;
+  }
+
+  if (bar->focused_ws_brush) {
+    DeleteObject(bar->focused_ws_brush);
+    bar->focused_ws_brush = NULL;
+  }
+
+  if (bar->urgent_ws_brush) {
+    DeleteObject(bar->urgent_ws_brush);
+    bar->urgent_ws_brush = NULL;
+  }
+
+  if (bar->font) {
+    DeleteObject(bar->font);
+    bar->font = NULL;
+  }
+
+  return 0;
+}
+
+int
+b3_bar_draw_cell(b3_bar_t *bar, const b3_bar_cell_t *cell)
+{
+  RECT text_rect;
+
+  switch (cell->style) {
+  case B3_BAR_CELL_FOCUSED_MONITOR:
+    FillRect(bar->buffer_hdc, &(cell->rect), bar->focused_monitor_ws_brush);
+    break;
+
+  case B3_BAR_CELL_FOCUSED:
+    FillRect(bar->buffer_hdc, &(cell->rect), bar->focused_ws_brush);
+    break;
+
+  case B3_BAR_CELL_URGENT:
+    FillRect(bar->buffer_hdc, &(cell->rect), bar->urgent_ws_brush);
+    break;
+
+  default:
+    Rectangle(bar->buffer_hdc,
+              cell->rect.left, cell->rect.top,
+              cell->rect.right, cell->rect.bottom);
+  }
+
+  text_rect.left = cell->rect.left + B3_BAR_DEFAULT_PADDING_TO_FRAME;
+  text_rect.right = cell->rect.right - B3_BAR_DEFAULT_PADDING_TO_FRAME;
+  text_rect.top = cell->rect.top + B3_BAR_DEFAULT_PADDING_TO_FRAME;
+  text_rect.bottom = cell->rect.bottom - B3_BAR_DEFAULT_PADDING_TO_FRAME;
+
+  DrawText(bar->buffer_hdc, cell->name,
            -1,
-           &g_draw_comm.text_rect,
+           &text_rect,
            DT_CENTER | DT_SINGLELINE | DT_VCENTER);
 
+  return 0;
+}
+
+int
+b3_bar_draw_status(b3_bar_t *bar, LONG left, RECT *dirty)
+{
+  b3_status_block_t *block_arr;
+  int block_arr_len;
+  b3_status_block_t *block;
+  LONG serial;
+  RECT rect;
+  RECT separator_rect;
+  SIZE text_size;
+  HBRUSH brush;
+  wchar_t *text;
+  int text_len;
+  int width;
+  int i;
+
+  block_arr = NULL;
+  block_arr_len = 0;
+  serial = 0;
+  if (bar->status) {
+    serial = b3_status_copy_blocks(bar->status, &block_arr, &block_arr_len);
+  }
+
   /**
-   * Move the rectangle for the next workspace
+   * Clear the blocks drawn before
+   */
+  if (!IsRectEmpty(&(bar->status_rect))) {
+    FillRect(bar->buffer_hdc, &(bar->status_rect), bar->background_brush);
+    UnionRect(dirty, dirty, &(bar->status_rect));
+  }
+  SetRectEmpty(&(bar->status_rect));
+
+  rect = b3_bar_get_workspace_area(bar);
+  rect.right = b3_bar_get_canvas_area(bar).right - B3_BAR_DEFAULT_PADDING_TO_FRAME;
+
+  /**
+   * The blocks are laid out from the right to the left
    */
-  g_draw_comm.rect.left = g_draw_comm.rect.right + B3_BAR_DEFAULT_PADDING_TO_NEXT_FRAME;
+  for (i = block_arr_len - 1; i >= 0; i--) {
+    block = &(block_arr[i]);
+
+    if (b3_textcache_get_extent(bar->textcache, bar->buffer_hdc, &(bar->logfont), B3_TEXTCACHE_UTF8,
+                                block->full_text ? block->full_text : "", &text_size)) {
+      break;
+    }
+
+    width = text_size.cx > block->min_width ? text_size.cx : block->min_width;
+    rect.left = rect.right - width - 2 * B3_BAR_DEFAULT_PADDING_TO_FRAME;
+
+    if (rect.left < left) {
+      break;
+    }
+
+    text = b3_bar_utf8_to_wide(block->full_text ? block->full_text : "", &text_len);
+    if (text == NULL) {
+      break;
+    }
+
+    if (block->urgent) {
+      FillRect(bar->buffer_hdc, &rect, bar->urgent_ws_brush);
+    } else if (block->background != B3_STATUS_COLOR_UNSET) {
+      brush = CreateSolidBrush(b3_bar_color(block->background));
+      FillRect(bar->buffer_hdc, &rect, brush);
+      DeleteObject(brush);
+    }
+
+    SetTextColor(bar->buffer_hdc,
+                 block->color != B3_STATUS_COLOR_UNSET ? b3_bar_color(block->color) : RGB(0, 0, 0));
+    DrawTextW(bar->buffer_hdc, text, text_len, &rect,
+              DT_CENTER | DT_SINGLELINE | DT_VCENTER | DT_NOPREFIX);
+    free(text);
+
+    UnionRect(&(bar->status_rect), &(bar->status_rect), &rect);
+    rect.right = rect.left;
+
+    /**
+     * The separator belongs to the block on its left
+     */
+    if (i > 0) {
+      if (block_arr[i - 1].separator) {
+        separator_rect = rect;
+        separator_rect.right = rect.left - block_arr[i - 1].separator_block_width / 2;
+        separator_rect.left = separator_rect.right - 1;
+        if (separator_rect.left >= left) {
+          FillRect(bar->buffer_hdc, &separator_rect, bar->focused_ws_brush);
+          UnionRect(&(bar->status_rect), &(bar->status_rect), &separator_rect);
+        }
+      }
+      rect.right -= block_arr[i - 1].separator_block_width;
+    }
+  }
+
+  SetTextColor(bar->buffer_hdc, RGB(0, 0, 0));
+  UnionRect(dirty, dirty, &(bar->status_rect));
+
+  b3_status_block_arr_free(block_arr, block_arr_len);
+  bar->status_serial = serial;
+
+  return 0;
+}
+
+wchar_t *
+b3_bar_utf8_to_wide(const char *str, int *len)
+{
+  wchar_t *wide;
+
+  *len = MultiByteToWideChar(CP_UTF8, 0, str, -1, NULL, 0);
+  if (*len <= 0) {
+    return NULL;
+  }
+
+  wide = malloc(sizeof(wchar_t) * (*len));
+  if (wide) {
+    MultiByteToWideChar(CP_UTF8, 0, str, -1, wide, *len);
+  }
+
+  /** Without the terminating byte */
+  (*len)--;
+
+  return wide;
+}
+
+COLORREF
+b3_bar_color(long color)
+{
+  return RGB((color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF);
+}
+
+int
+b3_bar_cell_equals(const b3_bar_cell_t *cell, const b3_bar_cell_t *other)
+{
+  return cell->style == other->style
+    && EqualRect(&(cell->rect), &(other->rect))
+    && strcmp(cell->name, other->name) == 0;
+}
+
+int
+b3_bar_free_cell_arr(b3_bar_cell_t *cell_arr, int cell_arr_len)
+{
+  int i;
+
+  for (i = 0; i < cell_arr_len; i++) {
+    free(cell_arr[i].name);
+  }
+  free(cell_arr);
+
+  return 0;
 }
 
-int
-b3_bar_draw(b3_bar_t *bar, HWND window_handler)
-{
-    // g_draw_comm = { 0 };
-
-	g_draw_comm.bar = bar;
-
-	g_draw_comm.focused_ws = b3_wsman_get_focused_ws(bar->wsman);
-
-	g_draw_comm.hdc = GetDC(window_handler);
-	BeginPaint(window_handler, &g_draw_comm.ps);
-
-	/** Init everything */
-	g_draw_comm.background_brush = CreateSolidBrush(RGB(255, 255, 255));
-	g_draw_comm.focused_monitor_ws_brush = CreateSolidBrush(RGB(255, 0, 0));
-	g_draw_comm.focused_ws_brush = CreateSolidBrush(RGB(100, 100, 100));
-
-	g_draw_comm.rect = b3_bar_get_canvas_area(bar);
-	FillRect(g_draw_comm.hdc, &g_draw_comm.rect, g_draw_comm.background_brush);
-
-	g_draw_comm.rect = b3_bar_get_workspace_area(bar);
-
-	g_draw_comm.text_rect = b3_bar_get_workspace_text_area(bar);
-
-  b3_wsman_iterate_ws_arr(bar->wsman, b3_bar_draw_ws_visitor);
-
-	DeleteObject(g_draw_comm.background_brush);
-	DeleteObject(g_draw_comm.focused_monitor_ws_brush);
-	DeleteObject(g_draw_comm.focused_ws_brush);
-
-   	EndPaint(window_handler, &g_draw_comm.ps);
-    ReleaseDC(window_handler, g_draw_comm.hdc);
-
-	return 0;
-}
-
 LRESULT CALLBACK
 b3_bar_WndProc(HWND window_handler, UINT msg, WPARAM wParam, LPARAM lParam)
-{
-	LRESULT CALLBACK result;
-	b3_bar_t *bar;
+{
+	LRESULT CALLBACK result;
+	b3_bar_t *bar;
+	PAINTSTRUCT ps;
+	LONG dirty;
     int x;
     int y;
-
+
 	result = 0;
 
     bar = (b3_bar_t *) GetWindowLongPtr(window_handler, GWLP_USERDATA);
 
-	switch(msg)
-	{
-    	case WM_NCPAINT:
+	switch(msg)
+	{
+		case B3_BAR_WM_UPDATE:
 			if (bar != NULL) {
+				InterlockedExchange(&(bar->update_posted), 0);
+				dirty = InterlockedExchange(&(bar->dirty), 0);
+
 				if (b3_wsman_any_win_has_state(bar->wsman, MAXIMIZED)) {
 					b3_bar_hide(bar);
 				} else {
-					b3_bar_show(bar);
+					/**
+					 * Showing the window paints it from the back buffer
+					 */
+					if (dirty & ~B3_BAR_DIRTY_VISIBILITY) {
+						b3_bar_draw(bar, window_handler);
+					}
+					if (!IsWindowVisible(window_handler)) {
+						b3_bar_show(bar);
+					}
+				}
+			}
+			break;
+
+		case WM_PAINT:
+			/**
+			 * The window was uncovered, the back buffer is still up to date
+			 */
+			BeginPaint(window_handler, &ps);
+			if (bar != NULL) {
+				if (bar->buffer_hdc == NULL) {
 					b3_bar_draw(bar, window_handler);
 				}
+				BitBlt(ps.hdc,
+					   ps.rcPaint.left, ps.rcPaint.top,
+					   ps.rcPaint.right - ps.rcPaint.left, ps.rcPaint.bottom - ps.rcPaint.top,
+					   bar->buffer_hdc,
+					   ps.rcPaint.left, ps.rcPaint.top,
+					   SRCCOPY);
+			}
+			EndPaint(window_handler, &ps);
+			break;
+
+		case WM_ERASEBKGND:
+			/** The back buffer covers the whole window */
+			result = 1;
+			break;
+
+		case WM_THEMECHANGED:
+		case WM_SETTINGCHANGE:
+		case WM_SYSCOLORCHANGE:
+		case WM_DPICHANGED:
+			if (bar != NULL) {
+				bar->resources_stale = 1;
+				b3_bar_draw(bar, window_handler);
 			}
-			break;
+			result = DefWindowProc(window_handler, msg, wParam, lParam);
+			break;
+
         case WM_LBUTTONDOWN:
             x = GET_X_LPARAM(lParam);
             y = GET_Y_LPARAM(lParam);
             b3_bar_handle_mouse_click(bar, x, y);
             break;
-
-		case WM_CLOSE:
+
+		case WM_CLOSE:
 			DestroyWindow(window_handler);
-			break;
-
-		default:
-			result = DefWindowProc(window_handler, msg, wParam, lParam);
-	}
-
-	return result;
-}
+			break;
 
-void
-b3_bar_click_ws_visitor(b3_ws_t *ws)
-{
-    SIZE text_size;
-    int str_length;
-    POINT point;
+		default:
+			result = DefWindowProc(window_handler, msg, wParam, lParam);
+	}
 
-    /**
-     * Enlarge the rectangle to enclose the workspace's name
-     */
-    GetTextExtentPoint32A(g_click_comm.hdc, b3_ws_get_name(ws),
-                          strlen(b3_ws_get_name(ws)), &text_size);
-    str_length = text_size.cx + B3_BAR_DEFAULT_PADDING_TO_FRAME;
-    g_click_comm.rect.right =
-        g_click_comm.rect.left + str_length + B3_BAR_DEFAULT_PADDING_TO_FRAME;
+	return result;
+}
 
-    point.x = g_click_comm.x;
-    point.y = g_click_comm.y;
-    if (PtInRect(&(g_click_comm.rect), point)) {
-        b3_ws_switcher_switch_to_ws(g_click_comm.bar->ws_switcher, b3_ws_get_name(ws));
-    }
 
-    /**
-     * Move the rectangle for the next workspace
-     */
-    g_click_comm.rect.left =
-        g_click_comm.rect.right + B3_BAR_DEFAULT_PADDING_TO_NEXT_FRAME;
-}
 int
 b3_bar_handle_mouse_click(b3_bar_t *bar, int x, int y)
 {
-    // g_click_comm = { 0 };
-
-    g_click_comm.bar = bar;
-
-    g_click_comm.focused_ws = b3_wsman_get_focused_ws(bar->wsman);
-
-    g_click_comm.hdc = GetDC(bar->window_handler);
-
-    g_click_comm.rect = b3_bar_get_canvas_area(bar);
+    POINT point;
+    const b3_bar_cell_t *cell;
 
-    g_click_comm.rect = b3_bar_get_workspace_area(bar);
+    point.x = x;
+    point.y = y;
 
-    g_click_comm.text_rect = b3_bar_get_workspace_text_area(bar);
+    cell = b3_bar_find_cell(bar, point);
+    if (cell) {
+        b3_ws_switcher_switch_to_ws(bar->ws_switcher, cell->name);
+    }
 
-    g_click_comm.x = x;
-    g_click_comm.y = y;
+    return 0;
+}
 
-    b3_wsman_iterate_ws_arr(bar->wsman, b3_bar_click_ws_visitor);
+const b3_bar_cell_t *
+b3_bar_find_cell(b3_bar_t *bar, POINT point)
+{
+    const b3_bar_cell_t *cell;
+    int low;
+    int high;
+    int mid;
+
+    cell = NULL;
+    low = 0;
+    high = bar->cell_arr_len - 1;
+    while (cell == NULL && low <= high) {
+        mid = low + (high - low) / 2;
+        if (point.x < bar->cell_arr[mid].rect.left) {
+            high = mid - 1;
+        } else if (point.x >= bar->cell_arr[mid].rect.right) {
+            low = mid + 1;
+        } else {
+            cell = &(bar->cell_arr[mid]);
+        }
+    }
 
-    ReleaseDC(bar->window_handler, g_draw_comm.hdc);
+    if (cell && !PtInRect(&(cell->rect), point)) {
+        cell = NULL;
+    }
 
-    return 0;
+    return cell;
 }
 
 RECT
@@ -494,16 +989,3 @@ b3_bar_get_workspace_area(b3_bar_t *bar)
 
     return rect;
 }
-
-RECT
-b3_bar_get_workspace_text_area(b3_bar_t *bar)
-{
-    RECT rect;
-
-    rect = b3_bar_get_workspace_area(bar);
-
-    rect.top = g_draw_comm.rect.top + B3_BAR_DEFAULT_PADDING_TO_FRAME;
-	rect.bottom = g_draw_comm.rect.bottom - B3_BAR_DEFAULT_PADDING_TO_FRAME;
-
-    return rect;
-}
@@ -32,6 +32,8 @@
 
 #include "wsman.h"
 #include "ws_switcher.h"
+#include "status.h"
+#include "textcache.h"
 
 #ifndef B3_BAR_H
 #define B3_BAR_H
@@ -44,6 +46,21 @@
 #define B3_BAR_DEFAULT_PADDING_TO_WINDOW 1
 #define B3_BAR_DEFAULT_PADDING_TO_FRAME 4
 #define B3_BAR_DEFAULT_PADDING_TO_NEXT_FRAME 4
+
+/**
+ * Parts of a bar which may have changed since it was drawn
+ */
+#define B3_BAR_DIRTY_FOCUSED_WS 0x1
+#define B3_BAR_DIRTY_WS_ARR 0x2
+#define B3_BAR_DIRTY_URGENT 0x4
+#define B3_BAR_DIRTY_VISIBILITY 0x8
+#define B3_BAR_DIRTY_STATUS 0x10
+#define B3_BAR_DIRTY_ALL 0x1f
+
+/**
+ * Posted to the window of a bar to update its dirty parts
+ */
+#define B3_BAR_WM_UPDATE (WM_APP + 1)
 
 typedef enum b3_bar_pos_e
 {
@@ -51,6 +68,53 @@ typedef enum b3_bar_pos_e
 	BOTTOM
 } b3_bar_pos_t;
 
+typedef enum b3_bar_cell_style_e
+{
+	B3_BAR_CELL_NORMAL = 0,
+	B3_BAR_CELL_FOCUSED,
+	B3_BAR_CELL_FOCUSED_MONITOR,
+	B3_BAR_CELL_URGENT
+} b3_bar_cell_style_t;
+
+/**
+ * A workspace as it was drawn into the back buffer of a bar
+ */
+typedef struct b3_bar_cell_s
+{
+	char *name;
+
+	/**
+	 * Relative to the bar
+	 */
+	RECT rect;
+
+	b3_bar_cell_style_t style;
+} b3_bar_cell_t;
+
+/**
+ * Communication structure for b3_bar_draw() and b3_bar_draw_ws_visitor().
+ * Each bar has its own, so bars can be drawn at the same time.
+ */
+typedef struct b3_bar_draw_comm_s
+{
+	struct b3_bar_s *bar;
+	b3_ws_t *focused_ws;
+	HDC hdc;
+	RECT rect;
+
+	/**
+	 * Non-0 if the extents of the previously drawn cells cannot be reused
+	 */
+	char relayout;
+
+	/**
+	 * The cells of the workspaces, as they should be drawn
+	 */
+	b3_bar_cell_t *cell_arr;
+	int cell_arr_len;
+	int cell_arr_cap;
+} b3_bar_draw_comm_t;
+
 typedef struct b3_bar_s
 {
 	b3_bar_pos_t position;
@@ -64,6 +128,74 @@ typedef struct b3_bar_s
 	HWND window_handler;
 
 	char focused;
+
+	/**
+	 * The bar is rendered into the back buffer and only the changed parts are
+	 * copied to the window. NULL until the first paint.
+	 */
+	HDC buffer_hdc;
+	HBITMAP buffer_bitmap;
+	HGDIOBJ buffer_default_bitmap;
+	HGDIOBJ buffer_default_font;
+	int buffer_width;
+	int buffer_height;
+
+	/**
+	 * GDI resources of the bar. They are created on the first paint and again
+	 * after the theme or the DPI changed.
+	 */
+	HBRUSH background_brush;
+	HBRUSH focused_monitor_ws_brush;
+	HBRUSH focused_ws_brush;
+	HBRUSH urgent_ws_brush;
+	HFONT font;
+	LOGFONT logfont;
+	char resources_stale;
+
+	/**
+	 * Extents of the texts drawn with the font. Shared by the bars of all
+	 * monitors. It will not be freed by the bar.
+	 */
+	b3_textcache_t *textcache;
+
+	/**
+	 * The workspaces as drawn into the back buffer, sorted from left to right.
+	 * Their extents are kept until a name or the font changes and resolve the
+	 * mouse clicks.
+	 */
+	b3_bar_cell_t *cell_arr;
+	int cell_arr_len;
+
+	/**
+	 * Only used while the bar is drawn
+	 */
+	b3_bar_draw_comm_t draw_comm;
+
+	/**
+	 * The status shown right aligned. NULL if there is none. It will not be
+	 * freed by the bar.
+	 */
+	b3_status_t *status;
+
+	/**
+	 * Serial of the status blocks drawn into the back buffer
+	 */
+	LONG status_serial;
+
+	/**
+	 * Area covered by the status blocks in the back buffer
+	 */
+	RECT status_rect;
+
+	/**
+	 * B3_BAR_DIRTY_* flags of the parts changed since the last update
+	 */
+	volatile LONG dirty;
+
+	/**
+	 * Non-0 while a B3_BAR_WM_UPDATE is waiting in the message queue
+	 */
+	volatile LONG update_posted;
 } b3_bar_t;
 
 
@@ -72,13 +204,15 @@ typedef struct b3_bar_s
  * @param monitor_area The area used by the monitor the bar is painted on.
  * @param wsman A workspace manager object. It will not be freed by the bar.
  * @param ws_switcher
- * @return A new status bar or NULL if allocation failed
- */
-extern b3_bar_t *
+ * @param textcache A text cache object. It will not be freed by the bar.
+ * @return A new status bar or NULL if allocation failed
+ */
+extern b3_bar_t *
 b3_bar_new(const char *monitor_name,
 		   RECT monitor_area,
 		   b3_wsman_t *wsman,
-		   b3_ws_switcher_t *ws_switcher);
+		   b3_ws_switcher_t *ws_switcher,
+		   b3_textcache_t *textcache);
 
 /**
  * @brief Frees a status bar
@@ -108,9 +242,37 @@ b3_bar_show(b3_bar_t *bar);
 extern int
 b3_bar_hide(b3_bar_t *bar);
 
+/**
+ * Marks the bar dirty if the focus changed.
+ */
 extern int
 b3_bar_set_focused(b3_bar_t *bar, char focused);
 
+/**
+ * Sets the status shown on the bar and marks it dirty.
+ *
+ * @param status Can be NULL. It will not be freed by the bar.
+ */
+extern int
+b3_bar_set_status(b3_bar_t *bar, b3_status_t *status);
+
+/**
+ * Marks parts of the bar as changed. They are not drawn before
+ * b3_bar_update() is called.
+ *
+ * @param dirty B3_BAR_DIRTY_* flags
+ */
+extern int
+b3_bar_set_dirty(b3_bar_t *bar, LONG dirty);
+
+/**
+ * Lets the thread of the bar's window draw the dirty parts of the bar. Nothing
+ * is posted if the bar is clean or an update is already pending. Can be called
+ * from any thread.
+ */
+extern int
+b3_bar_update(b3_bar_t *bar);
+
 /**
  * Switches to the workspace on which the user has clicked.
  */
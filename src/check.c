@@ -0,0 +1,176 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the entry point of b3-check
+ *
+ * b3-check is a console program, so its report reaches the terminal it was
+ * started from. b3 itself is a GUI program without one.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <w32bindkeys/logger.h>
+#include <getopt.h>
+
+#include "../config.h"
+#include "kc_director_factory.h"
+#include "condition_factory.h"
+#include "action_factory.h"
+#include "parser.h"
+#include "config_check.h"
+
+#define B3_CHECK_GETOPT_OPTIONS "dsvV"
+
+static struct option B3_CHECK_GETOPT_LONG_OPTIONS[] = {
+    /*   NAME          ARGUMENT           FLAG  SHORTNAME */
+        {"all",        no_argument,       NULL, 'd'},
+        {"strict",     no_argument,       NULL, 's'},
+        {NULL,         0,                 NULL, 0}
+    };
+
+static int
+print_version(void);
+
+static int
+print_usage(const char *program);
+
+/**
+ * @param strict Non-0 if a shadowed key binding makes the file invalid.
+ * @return 0 if the configuration file is valid. Non-0 otherwise.
+ */
+static int
+check_config(b3_parser_t *parser, const char *config_filename, char strict);
+
+int
+main(int argc, char **argv)
+{
+	int error;
+	char exec;
+	char strict;
+	int opt;
+	int option_index;
+	b3_kc_director_factory_t *kc_director_factory;
+	b3_condition_factory_t *condition_factory;
+	b3_action_factory_t *action_factory;
+	b3_parser_t *parser;
+	int i;
+
+	/**
+	 * Shadowed and repeated key bindings are warnings, so they are listed
+	 */
+	wbk_logger_set_level(WARNING);
+
+	error = 0;
+	exec = 1;
+	strict = 0;
+
+	option_index = 0;
+	while ((opt = getopt_long(argc, argv,
+							  B3_CHECK_GETOPT_OPTIONS,
+							  B3_CHECK_GETOPT_LONG_OPTIONS,
+							  &option_index))
+			!= -1) {
+		switch(opt) {
+		case 'V':
+			wbk_logger_set_level(INFO);
+			break;
+
+		case 'd':
+			wbk_logger_set_level(DEBUG);
+			break;
+
+		case 's':
+			strict = 1;
+			break;
+
+		case 'v':
+			error = print_version();
+			exec = 0;
+			break;
+
+		default:
+			error = 1;
+			exec = 0;
+		}
+	}
+
+	if (exec && optind >= argc) {
+		error = print_usage(argv[0]);
+		exec = 0;
+	}
+
+	if (exec) {
+		/**
+		 * Nothing but the parser is needed. No director, window, hook or daemon
+		 * is created.
+		 */
+		kc_director_factory = b3_kc_director_factory_new();
+		condition_factory = b3_condition_factory_new();
+		action_factory = b3_action_factory_new();
+		parser = b3_parser_new(kc_director_factory, condition_factory, action_factory);
+
+		for (i = optind; i < argc; i++) {
+			if (check_config(parser, argv[i], strict)) {
+				error = 1;
+			}
+		}
+
+		b3_parser_free(parser);
+		b3_action_factory_free(action_factory);
+		b3_condition_factory_free(condition_factory);
+		b3_kc_director_factory_free(kc_director_factory);
+	}
+
+	return error;
+}
+
+int
+print_version(void)
+{
+	fprintf(stdout, "%s version %s\n", PACKAGE, PACKAGE_VERSION);
+	return 0;
+}
+
+int
+print_usage(const char *program)
+{
+	fprintf(stderr, "Usage: %s [-d] [-s] [-v] [-V] configfile...\n", program);
+	return 1;
+}
+
+int
+check_config(b3_parser_t *parser, const char *config_filename, char strict)
+{
+	int error;
+	b3_config_check_t check;
+
+	error = b3_config_check(parser, config_filename, strict, &check);
+	b3_config_check_print(&check, stdout);
+	fprintf(stdout, "%s: %s\n", config_filename, error ? "invalid" : "valid");
+
+	return error;
+}
@@ -36,8 +36,6 @@
 
 static wbk_logger_t logger = { "class_condition" };
 
-#define B3_CLASS_CONDITION_CLASS_BUFFER_LENGTH 255
-
 /**
  * Implementation of b3_condition_free().
  */
@@ -50,8 +48,20 @@ b3_class_condition_free_impl(b3_condition_t *condition);
 static int
 b3_class_condition_applies_impl(b3_condition_t *condition, b3_director_t *director, b3_win_t *win);
 
+/**
+ * Implementation of b3_condition_get_key().
+ */
+static int
+b3_class_condition_get_key_impl(b3_condition_t *condition, b3_condition_key_t *key);
+
 b3_class_condition_t *
 b3_class_condition_new(const char *pattern)
+{
+  return b3_class_condition_new_compiled(pattern, NULL, NULL);
+}
+
+b3_class_condition_t *
+b3_class_condition_new_compiled(const char *pattern, pcre *re_compiled, pcre_extra *re_extra)
 {
   int error;
     b3_class_condition_t *class_condition;
@@ -70,15 +80,25 @@ b3_class_condition_new(const char *pattern)
   }
 
   if (!error) {
-    pattern_condition = b3_pattern_condition_new(pattern);
+    pattern_condition = b3_pattern_condition_new_compiled(pattern, re_compiled, re_extra);
+    if (pattern_condition == NULL) {
+      free(class_condition);
+      class_condition = NULL;
+      error = 1;
+    }
+  }
+
+  if (!error) {
     memcpy(class_condition, pattern_condition, sizeof(b3_pattern_condition_t));
     free(pattern_condition); /* Just free the top level element */
 
     class_condition->super_condition_free = class_condition->pattern_condition.condition.condition_free;
     class_condition->super_condition_applies = class_condition->pattern_condition.condition.condition_applies;
+    class_condition->super_condition_get_key = class_condition->pattern_condition.condition.condition_get_key;
 
     class_condition->pattern_condition.condition.condition_free = b3_class_condition_free_impl;
     class_condition->pattern_condition.condition.condition_applies = b3_class_condition_applies_impl;
+    class_condition->pattern_condition.condition.condition_get_key = b3_class_condition_get_key_impl;
   }
 
   return class_condition;
@@ -101,10 +121,11 @@ b3_class_condition_applies_impl(b3_condition_t *condition, b3_director_t *direct
 {
   b3_class_condition_t *class_condition;
   int applies;
-	char classname[B3_CLASS_CONDITION_CLASS_BUFFER_LENGTH];
+	const char *classname;
   int pcre_rc;
   pcre *re_compiled;
   pcre_extra *re_extra;
+  b3_win_t *focused_win;
   int error;
 
   class_condition = (b3_class_condition_t *) condition;
@@ -113,28 +134,35 @@ b3_class_condition_applies_impl(b3_condition_t *condition, b3_director_t *direct
 
   if (!error) {
     if (b3_pattern_condition_get_use_focused_as_pattern((b3_pattern_condition_t *) class_condition)) {
-      GetClassName(b3_win_get_window_handler(b3_monitor_get_focused_win(b3_director_get_focused_monitor(director))),
-                   classname,
-                   B3_CLASS_CONDITION_CLASS_BUFFER_LENGTH);
-      error = b3_compile_pattern(classname, &re_compiled, &re_extra);
-    } else {
-      re_compiled = b3_pattern_condition_get_re_compiled((b3_pattern_condition_t *) class_condition);
-      re_extra = b3_pattern_condition_get_re_extra((b3_pattern_condition_t *) class_condition);
+      focused_win = b3_director_copy_focused_win(director);
+      if (focused_win) {
+        b3_win_cache_attrs(focused_win);
+        error = b3_compile_pattern(b3_win_get_class_name(focused_win), &re_compiled, &re_extra);
+        b3_win_free(focused_win);
+      } else {
+        error = 1;
+      }
     }
   }
 
   if (!error) {
-    GetClassName(b3_win_get_window_handler(win), classname, B3_CLASS_CONDITION_CLASS_BUFFER_LENGTH);
-    pcre_rc = pcre_exec(re_compiled,
-                        re_extra,
-                        classname,
-                        strlen(classname),
-                        0,
-                        0,
-                        NULL,
-                        0);
-    if (pcre_rc >= 0) {
-      applies = 1;
+    b3_win_cache_attrs(win);
+    classname = b3_win_get_class_name(win);
+
+    if (b3_pattern_condition_get_use_focused_as_pattern((b3_pattern_condition_t *) class_condition)) {
+      pcre_rc = pcre_exec(re_compiled,
+                          re_extra,
+                          classname,
+                          strlen(classname),
+                          0,
+                          0,
+                          NULL,
+                          0);
+      if (pcre_rc >= 0) {
+        applies = 1;
+      }
+    } else {
+      applies = b3_pattern_condition_match((b3_pattern_condition_t *) class_condition, classname);
     }
   }
 
@@ -151,3 +179,25 @@ b3_class_condition_applies_impl(b3_condition_t *condition, b3_director_t *direct
 
   return applies;
 }
+
+int
+b3_class_condition_get_key_impl(b3_condition_t *condition, b3_condition_key_t *key)
+{
+  b3_class_condition_t *class_condition;
+  int error;
+
+  class_condition = (b3_class_condition_t *) condition;
+
+  error = class_condition->super_condition_get_key(condition, key);
+  if (!error) {
+    key->attr = B3_CONDITION_ATTR_CLASS;
+  }
+
+  return error;
+}
+
+int
+b3_class_condition_instance_of(const b3_condition_t *condition)
+{
+  return condition->condition_free == b3_class_condition_free_impl;
+}
@@ -47,9 +47,22 @@ struct b3_class_condition_s
   b3_pattern_condition_t pattern_condition;
   int (*super_condition_free)(b3_condition_t *condition);
   int (*super_condition_applies)(b3_condition_t *condition, b3_director_t *director, b3_win_t *win);
+  int (*super_condition_get_key)(b3_condition_t *condition, b3_condition_key_t *key);
 };
 
 extern b3_class_condition_t *
 b3_class_condition_new(const char *pattern);
 
+/**
+ * See b3_pattern_condition_new_compiled().
+ */
+extern b3_class_condition_t *
+b3_class_condition_new_compiled(const char *pattern, pcre *re_compiled, pcre_extra *re_extra);
+
+/**
+ * @return Non-0 if condition is a class condition.
+ */
+extern int
+b3_class_condition_instance_of(const b3_condition_t *condition);
+
 #endif // B3_CLASS_CONDITION_H
@@ -41,6 +41,13 @@ b3_condition_free_impl(b3_condition_t *condition);
 static int
 b3_condition_applies_impl(b3_condition_t *condition, b3_director_t *director, b3_win_t *win);
 
+static int
+b3_condition_get_key_impl(b3_condition_t *condition, b3_condition_key_t *key);
+
+static int
+b3_condition_equals_impl(b3_condition_t *condition, b3_condition_t *other);
+
+
 b3_condition_t *
 b3_condition_new(void)
 {
@@ -51,6 +58,10 @@ b3_condition_new(void)
   if (condition) {
     condition->condition_free = b3_condition_free_impl;
     condition->condition_applies = b3_condition_applies_impl;
+    condition->condition_get_key = b3_condition_get_key_impl;
+    condition->condition_equals = b3_condition_equals_impl;
+
+    b3_profile_init(&(condition->profile));
   }
 
   return condition;
@@ -65,7 +76,32 @@ b3_condition_free(b3_condition_t *condition)
 int
 b3_condition_applies(b3_condition_t *condition, b3_director_t *director, b3_win_t *win)
 {
-  return condition->condition_applies(condition, director, win);
+  LONGLONG start;
+  int applies;
+
+  start = b3_profile_start();
+  applies = condition->condition_applies(condition, director, win);
+  b3_profile_record(&(condition->profile), start, applies);
+
+  return applies;
+}
+
+int
+b3_condition_get_key(b3_condition_t *condition, b3_condition_key_t *key)
+{
+  return condition->condition_get_key(condition, key);
+}
+
+b3_profile_t *
+b3_condition_get_profile(b3_condition_t *condition)
+{
+  return &(condition->profile);
+}
+
+int
+b3_condition_equals(b3_condition_t *condition, b3_condition_t *other)
+{
+  return condition->condition_equals(condition, other);
 }
 
 int
@@ -83,3 +119,15 @@ b3_condition_applies_impl(b3_condition_t *condition, b3_director_t *director, b3
 
   return -1;
 }
+
+int
+b3_condition_get_key_impl(b3_condition_t *condition, b3_condition_key_t *key)
+{
+  return 1;
+}
+
+int
+b3_condition_equals_impl(b3_condition_t *condition, b3_condition_t *other)
+{
+  return condition == other;
+}
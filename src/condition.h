@@ -33,13 +33,52 @@
 
 #include "director.h"
 #include "win.h"
+#include "profile.h"
 
 typedef struct b3_condition_s b3_condition_t;
 
+/**
+ * The window attribute a condition key refers to.
+ */
+typedef enum b3_condition_attr_e
+{
+  B3_CONDITION_ATTR_NONE = 0,
+  B3_CONDITION_ATTR_CLASS,
+  B3_CONDITION_ATTR_TITLE
+} b3_condition_attr_t;
+
+/**
+ * A literal that has to match a window attribute for a condition to apply.
+ * Rules are indexed by it.
+ */
+typedef struct b3_condition_key_s
+{
+  b3_condition_attr_t attr;
+
+  /**
+   * If non-0, then literal only has to be a prefix of the attribute.
+   * Otherwise the attribute has to equal literal.
+   */
+  char prefix;
+
+  /**
+   * Owned by the condition. Do not free it!
+   */
+  const char *literal;
+} b3_condition_key_t;
+
 struct b3_condition_s
 {
   int (*condition_free)(b3_condition_t *condition);
   int (*condition_applies)(b3_condition_t *condition, b3_director_t *director, b3_win_t *win);
+  int (*condition_get_key)(b3_condition_t *condition, b3_condition_key_t *key);
+  int (*condition_equals)(b3_condition_t *condition, b3_condition_t *other);
+
+
+  /**
+   * Counters of b3_condition_applies()
+   */
+  b3_profile_t profile;
 };
 
 extern b3_condition_t *
@@ -54,4 +93,30 @@ b3_condition_free(b3_condition_t *condition);
 extern int
 b3_condition_applies(b3_condition_t *condition, b3_director_t *director, b3_win_t *win);
 
+/**
+ * Gets a literal that is necessary for the condition to apply.
+ *
+ * @param key Will be filled with the key of the condition.
+ * @return 0 if the condition has such a key. Non-0 if the condition can only
+ * be decided by b3_condition_applies().
+ */
+extern int
+b3_condition_get_key(b3_condition_t *condition, b3_condition_key_t *key);
+
+/**
+ * @return The counters of all evaluations of the condition. Do not free it!
+ */
+extern b3_profile_t *
+b3_condition_get_profile(b3_condition_t *condition);
+
+/**
+ * Checks if two conditions are of the same kind and would apply to the same
+ * windows for the same reason, e.g. to keep conditions on reloading the
+ * configuration.
+ *
+ * @return Non-0 if condition equals other.
+ */
+extern int
+b3_condition_equals(b3_condition_t *condition, b3_condition_t *other);
+
 #endif // B3_CONDITION_H
@@ -42,6 +42,21 @@ b3_condition_and_free_impl(b3_condition_t *condition);
 static int
 b3_condition_and_applies_impl(b3_condition_t *condition, b3_director_t *director, b3_win_t *win);
 
+/**
+ * Implementation of b3_condition_get_key(). As all conditions have to apply,
+ * the key of any of them is also a key of the condition and. Exact keys are
+ * preferred over prefix keys.
+ */
+static int
+b3_condition_and_get_key_impl(b3_condition_t *condition, b3_condition_key_t *key);
+
+/**
+ * Implementation of b3_condition_equals(). Both have to contain equal
+ * conditions in the same order.
+ */
+static int
+b3_condition_and_equals_impl(b3_condition_t *condition, b3_condition_t *other);
+
 static int
 b3_condition_and_add_impl(b3_condition_and_t *condition_and, b3_condition_t *new_condition);
 
@@ -60,9 +75,13 @@ b3_condition_and_new(void)
 
     condition_and->super_condition_free = condition_and->condition.condition_free;
     condition_and->super_condition_applies = condition_and->condition.condition_applies;
+    condition_and->super_condition_get_key = condition_and->condition.condition_get_key;
+    condition_and->super_condition_equals = condition_and->condition.condition_equals;
 
     condition_and->condition.condition_free = b3_condition_and_free_impl;
     condition_and->condition.condition_applies = b3_condition_and_applies_impl;
+    condition_and->condition.condition_get_key = b3_condition_and_get_key_impl;
+    condition_and->condition.condition_equals = b3_condition_and_equals_impl;
 
     condition_and->condition_and_add = b3_condition_and_add_impl;
 
@@ -118,6 +137,58 @@ b3_condition_and_applies_impl(b3_condition_t *condition, b3_director_t *director
   return applies;
 }
 
+int
+b3_condition_and_get_key_impl(b3_condition_t *condition, b3_condition_key_t *key)
+{
+  b3_condition_and_t *condition_and;
+  CC_ArrayIter iter;
+	b3_condition_t *condition_iter;
+  b3_condition_key_t key_iter;
+  int error;
+
+  condition_and = (b3_condition_and_t *) condition;
+
+  error = 1;
+	cc_array_iter_init(&iter, condition_and->condition_arr);
+	while (cc_array_iter_next(&iter, (void*) &condition_iter) != CC_ITER_END) {
+    if (b3_condition_get_key(condition_iter, &key_iter) == 0) {
+      if (error || (key->prefix && !key_iter.prefix)) {
+        *key = key_iter;
+        error = 0;
+      }
+    }
+  }
+
+  return error;
+}
+
+int
+b3_condition_and_equals_impl(b3_condition_t *condition, b3_condition_t *other)
+{
+  b3_condition_and_t *condition_and;
+  b3_condition_and_t *other_and;
+  b3_condition_t *condition_iter;
+  b3_condition_t *other_iter;
+  int equals;
+  int i;
+
+  equals = (other->condition_equals == condition->condition_equals);
+
+  if (equals) {
+    condition_and = (b3_condition_and_t *) condition;
+    other_and = (b3_condition_and_t *) other;
+
+    equals = (cc_array_size(condition_and->condition_arr) == cc_array_size(other_and->condition_arr));
+    for (i = 0; equals && i < cc_array_size(condition_and->condition_arr); i++) {
+      cc_array_get_at(condition_and->condition_arr, i, (void *) &condition_iter);
+      cc_array_get_at(other_and->condition_arr, i, (void *) &other_iter);
+      equals = b3_condition_equals(condition_iter, other_iter);
+    }
+  }
+
+  return equals;
+}
+
 int
 b3_condition_and_add_impl(b3_condition_and_t *condition_and, b3_condition_t *new_condition)
 {
@@ -125,3 +196,9 @@ b3_condition_and_add_impl(b3_condition_and_t *condition_and, b3_condition_t *new
 
   return 0;
 }
+
+int
+b3_condition_and_instance_of(const b3_condition_t *condition)
+{
+  return condition->condition_free == b3_condition_and_free_impl;
+}
@@ -47,6 +47,8 @@ struct b3_condition_and_s
   b3_condition_t condition;
   int (*super_condition_free)(b3_condition_t *condition);
   int (*super_condition_applies)(b3_condition_t *condition, b3_director_t *director, b3_win_t *win);
+  int (*super_condition_get_key)(b3_condition_t *condition, b3_condition_key_t *key);
+  int (*super_condition_equals)(b3_condition_t *condition, b3_condition_t *other);
 
   int (*condition_and_add)(b3_condition_and_t *condition_and, b3_condition_t *new_condition);
 
@@ -66,4 +68,10 @@ b3_condition_and_new(void);
 extern int
 b3_condition_and_add(b3_condition_and_t *condition_and, b3_condition_t *new_condition);
 
+/**
+ * @return Non-0 if condition is a condition and.
+ */
+extern int
+b3_condition_and_instance_of(const b3_condition_t *condition);
+
 #endif // B3_CONDITION_AND_H
@@ -0,0 +1,1018 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-18
+ * @brief File contains the implementation of the compiled configuration cache
+ */
+
+#include "config_cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+#include <pcre.h>
+#include <w32bindkeys/logger.h>
+#include <w32bindkeys/b.h>
+#include <w32bindkeys/kc.h>
+
+#include "../config.h"
+#include "kc_director.h"
+#include "kc_exec.h"
+#include "rule.h"
+#include "condition_and.h"
+#include "class_condition.h"
+#include "title_condition.h"
+#include "action_list.h"
+#include "floating_action.h"
+#include "mwtw_action.h"
+
+#define B3_CONFIG_CACHE_FNV_OFFSET 14695981039346656037ULL
+#define B3_CONFIG_CACHE_FNV_PRIME 1099511628211ULL
+
+/**
+ * Length of a NULL string
+ */
+#define B3_CONFIG_CACHE_NULL_LEN 0xFFFFFFFF
+
+static wbk_logger_t logger = { "config_cache" };
+
+typedef enum b3_config_cache_tag_e
+{
+  B3_CONFIG_CACHE_TAG_KC_DIRECTOR = 1,
+  B3_CONFIG_CACHE_TAG_KC_EXEC,
+  B3_CONFIG_CACHE_TAG_CONDITION_AND,
+  B3_CONFIG_CACHE_TAG_CLASS_CONDITION,
+  B3_CONFIG_CACHE_TAG_TITLE_CONDITION,
+  B3_CONFIG_CACHE_TAG_ACTION_LIST,
+  B3_CONFIG_CACHE_TAG_FLOATING_ACTION,
+  B3_CONFIG_CACHE_TAG_MWTW_ACTION
+} b3_config_cache_tag_t;
+
+typedef struct b3_config_cache_writer_s
+{
+  char *buffer;
+  size_t len;
+  size_t capacity;
+} b3_config_cache_writer_t;
+
+typedef struct b3_config_cache_reader_s
+{
+  const char *buffer;
+  size_t len;
+  size_t pos;
+} b3_config_cache_reader_t;
+
+static unsigned long long
+b3_config_cache_hash(unsigned long long hash, const char *data, size_t data_len);
+
+static int
+b3_config_cache_put(b3_config_cache_writer_t *writer, const void *data, size_t data_len);
+
+static int
+b3_config_cache_put_u32(b3_config_cache_writer_t *writer, unsigned int value);
+
+/**
+ * @param str Can be NULL.
+ */
+static int
+b3_config_cache_put_str(b3_config_cache_writer_t *writer, const char *str);
+
+static int
+b3_config_cache_put_kc(b3_config_cache_writer_t *writer, const wbk_kc_t *kc);
+
+static int
+b3_config_cache_put_pattern(b3_config_cache_writer_t *writer, b3_pattern_condition_t *pattern_condition);
+
+static int
+b3_config_cache_put_condition(b3_config_cache_writer_t *writer, b3_condition_t *condition);
+
+static int
+b3_config_cache_put_action(b3_config_cache_writer_t *writer, b3_action_t *action);
+
+/**
+ * @return A pointer to the next data_len bytes or NULL if the cache is too
+ * short.
+ */
+static const char *
+b3_config_cache_get(b3_config_cache_reader_t *reader, size_t data_len);
+
+static int
+b3_config_cache_get_u32(b3_config_cache_reader_t *reader, unsigned int *value);
+
+/**
+ * @param str Will be set to a new string or NULL. Free it by yourself!
+ */
+static int
+b3_config_cache_get_str(b3_config_cache_reader_t *reader, char **str);
+
+static wbk_kc_t *
+b3_config_cache_get_kc(b3_config_cache_reader_t *reader, unsigned int binding_size, b3_director_t *director);
+
+static int
+b3_config_cache_get_pattern(b3_config_cache_reader_t *reader, char **pattern,
+                            pcre **re_compiled, pcre_extra **re_extra);
+
+static b3_condition_t *
+b3_config_cache_get_condition(b3_config_cache_reader_t *reader);
+
+static b3_action_t *
+b3_config_cache_get_action(b3_config_cache_reader_t *reader);
+
+unsigned long long
+b3_config_cache_key(const char *config, size_t config_len)
+{
+  unsigned long long key;
+  const char *pcre_ver;
+
+  pcre_ver = pcre_version();
+
+  key = b3_config_cache_hash(B3_CONFIG_CACHE_FNV_OFFSET, config, config_len);
+  key = b3_config_cache_hash(key, PACKAGE_VERSION, strlen(PACKAGE_VERSION) + 1);
+  key = b3_config_cache_hash(key, pcre_ver, strlen(pcre_ver) + 1);
+
+  return key;
+}
+
+int
+b3_config_cache_write(unsigned long long key, const wbk_kbman_t *kbman, CC_Array *rule_arr,
+                      char **buffer, size_t *buffer_len)
+{
+  int error;
+  b3_config_cache_writer_t writer;
+  b3_config_cache_header_t header;
+  CC_ArrayIter iter;
+  b3_rule_t *rule;
+  int i;
+
+  error = 0;
+
+  writer.len = 0;
+  writer.capacity = 4096;
+  writer.buffer = malloc(writer.capacity);
+  if (writer.buffer == NULL) {
+    wbk_logger_log(&logger, SEVERE, "Could not allocate memory.\n");
+    error = 1;
+  }
+
+  /** The header is completed at the end */
+  if (!error) {
+    memset(&header, 0, sizeof(b3_config_cache_header_t));
+    error = b3_config_cache_put(&writer, &header, sizeof(b3_config_cache_header_t));
+  }
+
+  for (i = 0; !error && i < kbman->kc_arr_len; i++) {
+    error = b3_config_cache_put_kc(&writer, kbman->kc_arr[i]);
+  }
+
+  if (!error) {
+    cc_array_iter_init(&iter, rule_arr);
+    while (!error && cc_array_iter_next(&iter, (void*) &rule) != CC_ITER_END) {
+      error = b3_config_cache_put_condition(&writer, b3_rule_get_condition(rule));
+      if (!error) {
+        error = b3_config_cache_put_action(&writer, b3_rule_get_action(rule));
+      }
+    }
+  }
+
+  if (!error) {
+    memcpy(header.magic, B3_CONFIG_CACHE_MAGIC, sizeof(header.magic));
+    header.format = B3_CONFIG_CACHE_FORMAT;
+    header.key = key;
+    header.checksum = b3_config_cache_hash(B3_CONFIG_CACHE_FNV_OFFSET,
+                                           writer.buffer + sizeof(b3_config_cache_header_t),
+                                           writer.len - sizeof(b3_config_cache_header_t));
+    header.size = writer.len;
+    header.binding_size = sizeof(wbk_b_t);
+    header.kc_len = kbman->kc_arr_len;
+    header.rule_len = cc_array_size(rule_arr);
+    memcpy(writer.buffer, &header, sizeof(b3_config_cache_header_t));
+
+    *buffer = writer.buffer;
+    *buffer_len = writer.len;
+  } else {
+    free(writer.buffer);
+  }
+
+  return error;
+}
+
+int
+b3_config_cache_read(const char *buffer, size_t buffer_len, unsigned long long key,
+                     b3_director_t *director, wbk_kbman_t **kbman, CC_Array *rule_arr)
+{
+  int error;
+  b3_config_cache_reader_t reader;
+  b3_config_cache_header_t header;
+  wbk_kc_t *kc;
+  b3_condition_t *condition;
+  b3_action_t *action;
+  CC_Array *read_rule_arr;
+  CC_ArrayIter iter;
+  b3_rule_t *rule;
+  unsigned int i;
+
+  error = 0;
+  *kbman = NULL;
+  read_rule_arr = NULL;
+
+  if (buffer_len < sizeof(b3_config_cache_header_t)) {
+    error = 1;
+  }
+
+  if (!error) {
+    memcpy(&header, buffer, sizeof(b3_config_cache_header_t));
+    if (memcmp(header.magic, B3_CONFIG_CACHE_MAGIC, sizeof(header.magic))
+        || header.format != B3_CONFIG_CACHE_FORMAT
+        || header.binding_size != sizeof(wbk_b_t)
+        || header.size != buffer_len) {
+      wbk_logger_log(&logger, INFO, "Cache has an unknown format.\n");
+      error = 2;
+    }
+  }
+
+  if (!error && header.key != key) {
+    wbk_logger_log(&logger, INFO, "Cache is outdated.\n");
+    error = 3;
+  }
+
+  if (!error
+      && header.checksum != b3_config_cache_hash(B3_CONFIG_CACHE_FNV_OFFSET,
+                                                 buffer + sizeof(b3_config_cache_header_t),
+                                                 buffer_len - sizeof(b3_config_cache_header_t))) {
+    wbk_logger_log(&logger, WARNING, "Cache is corrupted.\n");
+    error = 4;
+  }
+
+  if (!error) {
+    reader.buffer = buffer;
+    reader.len = buffer_len;
+    reader.pos = sizeof(b3_config_cache_header_t);
+
+    *kbman = wbk_kbman_new();
+    cc_array_new(&read_rule_arr);
+  }
+
+  for (i = 0; !error && i < header.kc_len; i++) {
+    kc = b3_config_cache_get_kc(&reader, header.binding_size, director);
+    if (kc) {
+      wbk_kbman_add(*kbman, kc);
+    } else {
+      error = 5;
+    }
+  }
+
+  for (i = 0; !error && i < header.rule_len; i++) {
+    condition = b3_config_cache_get_condition(&reader);
+    action = NULL;
+    if (condition) {
+      action = b3_config_cache_get_action(&reader);
+    }
+
+    if (condition && action) {
+      cc_array_add(read_rule_arr, b3_rule_new(condition, action));
+    } else {
+      if (condition) {
+        b3_condition_free(condition);
+      }
+      error = 6;
+    }
+  }
+
+  if (!error && reader.pos != reader.len) {
+    error = 7;
+  }
+
+  if (read_rule_arr) {
+    cc_array_iter_init(&iter, read_rule_arr);
+    while (cc_array_iter_next(&iter, (void*) &rule) != CC_ITER_END) {
+      if (!error) {
+        cc_array_add(rule_arr, rule);
+      } else {
+        b3_rule_free(rule);
+      }
+    }
+    cc_array_destroy(read_rule_arr);
+  }
+
+  if (error >= 5) {
+    wbk_logger_log(&logger, WARNING, "Cache is malformed.\n");
+  }
+
+  if (error && *kbman) {
+    wbk_kbman_free(*kbman);
+    *kbman = NULL;
+  }
+
+  return error;
+}
+
+int
+b3_config_cache_save(const char *filename, unsigned long long key,
+                     const wbk_kbman_t *kbman, CC_Array *rule_arr)
+{
+  int error;
+  char *buffer;
+  size_t buffer_len;
+  char *tmp_filename;
+  FILE *file;
+
+  error = 0;
+  buffer = NULL;
+  tmp_filename = NULL;
+
+  error = b3_config_cache_write(key, kbman, rule_arr, &buffer, &buffer_len);
+
+  if (!error) {
+    tmp_filename = malloc(sizeof(char) * (strlen(filename) + 5));
+    if (tmp_filename == NULL) {
+      error = 1;
+    }
+  }
+
+  if (!error) {
+    strcpy(tmp_filename, filename);
+    strcat(tmp_filename, ".tmp");
+
+    file = fopen(tmp_filename, "wb");
+    if (file == NULL) {
+      error = 1;
+    }
+  }
+
+  if (!error) {
+    if (fwrite(buffer, 1, buffer_len, file) != buffer_len) {
+      error = 2;
+    }
+
+    if (fclose(file)) {
+      error = 2;
+    }
+  }
+
+  if (!error) {
+    if (!MoveFileEx(tmp_filename, filename, MOVEFILE_REPLACE_EXISTING)) {
+      error = 3;
+    }
+  }
+
+  if (error) {
+    wbk_logger_log(&logger, WARNING, "Could not write cache %s\n", filename);
+  }
+
+  free(tmp_filename);
+  free(buffer);
+
+  return error;
+}
+
+int
+b3_config_cache_load(const char *filename, unsigned long long key,
+                     b3_director_t *director, wbk_kbman_t **kbman, CC_Array *rule_arr)
+{
+  int error;
+  HANDLE file_handle;
+  HANDLE mapping_handle;
+  DWORD size;
+  const char *buffer;
+
+  error = 0;
+  *kbman = NULL;
+  mapping_handle = NULL;
+  buffer = NULL;
+  size = 0;
+
+  file_handle = CreateFile(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file_handle == INVALID_HANDLE_VALUE) {
+    error = 1;
+  }
+
+  if (!error) {
+    size = GetFileSize(file_handle, NULL);
+    if (size == INVALID_FILE_SIZE || size < sizeof(b3_config_cache_header_t)) {
+      error = 2;
+    }
+  }
+
+  if (!error) {
+    mapping_handle = CreateFileMapping(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping_handle == NULL) {
+      error = 3;
+    }
+  }
+
+  if (!error) {
+    buffer = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    if (buffer == NULL) {
+      error = 4;
+    }
+  }
+
+  if (!error) {
+    error = b3_config_cache_read(buffer, size, key, director, kbman, rule_arr);
+  }
+
+  if (buffer) {
+    UnmapViewOfFile(buffer);
+  }
+
+  if (mapping_handle) {
+    CloseHandle(mapping_handle);
+  }
+
+  if (file_handle != INVALID_HANDLE_VALUE) {
+    CloseHandle(file_handle);
+  }
+
+  return error;
+}
+
+unsigned long long
+b3_config_cache_hash(unsigned long long hash, const char *data, size_t data_len)
+{
+  size_t i;
+
+  for (i = 0; i < data_len; i++) {
+    hash ^= (unsigned char) data[i];
+    hash *= B3_CONFIG_CACHE_FNV_PRIME;
+  }
+
+  return hash;
+}
+
+int
+b3_config_cache_put(b3_config_cache_writer_t *writer, const void *data, size_t data_len)
+{
+  char *buffer;
+  size_t capacity;
+
+  if (writer->len + data_len > writer->capacity) {
+    capacity = writer->capacity * 2;
+    while (writer->len + data_len > capacity) {
+      capacity *= 2;
+    }
+
+    buffer = realloc(writer->buffer, capacity);
+    if (buffer == NULL) {
+      wbk_logger_log(&logger, SEVERE, "Could not allocate memory.\n");
+      return 1;
+    }
+
+    writer->buffer = buffer;
+    writer->capacity = capacity;
+  }
+
+  memcpy(writer->buffer + writer->len, data, data_len);
+  writer->len += data_len;
+
+  return 0;
+}
+
+int
+b3_config_cache_put_u32(b3_config_cache_writer_t *writer, unsigned int value)
+{
+  return b3_config_cache_put(writer, &value, sizeof(unsigned int));
+}
+
+int
+b3_config_cache_put_str(b3_config_cache_writer_t *writer, const char *str)
+{
+  int error;
+  unsigned int len;
+
+  len = B3_CONFIG_CACHE_NULL_LEN;
+  if (str) {
+    len = strlen(str);
+  }
+
+  error = b3_config_cache_put_u32(writer, len);
+  if (!error && str) {
+    error = b3_config_cache_put(writer, str, len);
+  }
+
+  return error;
+}
+
+int
+b3_config_cache_put_kc(b3_config_cache_writer_t *writer, const wbk_kc_t *kc)
+{
+  int error;
+  const b3_kc_director_t *kc_director;
+  const b3_kc_exec_t *kc_exec;
+
+  error = 0;
+
+  if (b3_kc_director_instance_of(kc)) {
+    kc_director = (const b3_kc_director_t *) kc;
+
+    error = b3_config_cache_put_u32(writer, B3_CONFIG_CACHE_TAG_KC_DIRECTOR);
+    if (!error) {
+      error = b3_config_cache_put(writer, wbk_kc_get_binding(kc), sizeof(wbk_b_t));
+    }
+    if (!error) {
+      error = b3_config_cache_put_u32(writer, kc_director->kind);
+    }
+    if (!error) {
+      switch (kc_director->kind) {
+      case CHANGE_WORKSPACE:
+      case CHANGE_MONITOR:
+      case MOVE_ACTIVE_WINDOW_TO_WORKSPACE:
+      case SWITCH_MODE:
+        error = b3_config_cache_put_str(writer, (const char *) kc_director->data);
+        break;
+
+      default:
+        error = b3_config_cache_put_str(writer, NULL);
+      }
+    }
+  } else if (b3_kc_exec_instance_of(kc)) {
+    kc_exec = (const b3_kc_exec_t *) kc;
+
+    error = b3_config_cache_put_u32(writer, B3_CONFIG_CACHE_TAG_KC_EXEC);
+    if (!error) {
+      error = b3_config_cache_put(writer, wbk_kc_get_binding(kc), sizeof(wbk_b_t));
+    }
+    if (!error) {
+      error = b3_config_cache_put_u32(writer, kc_exec->type);
+    }
+    if (!error) {
+      error = b3_config_cache_put_str(writer, b3_kc_exec_get_cmd(kc_exec));
+    }
+  } else {
+    wbk_logger_log(&logger, WARNING, "Key command cannot be cached.\n");
+    error = 1;
+  }
+
+  return error;
+}
+
+int
+b3_config_cache_put_pattern(b3_config_cache_writer_t *writer, b3_pattern_condition_t *pattern_condition)
+{
+  int error;
+  pcre *re_compiled;
+  pcre_extra *re_extra;
+  size_t re_size;
+  size_t study_size;
+
+  re_compiled = b3_pattern_condition_get_re_compiled(pattern_condition);
+  re_extra = b3_pattern_condition_get_re_extra(pattern_condition);
+
+  re_size = 0;
+  if (re_compiled) {
+    pcre_fullinfo(re_compiled, NULL, PCRE_INFO_SIZE, &re_size);
+  }
+
+  study_size = 0;
+  if (re_compiled && re_extra && (re_extra->flags & PCRE_EXTRA_STUDY_DATA)) {
+    pcre_fullinfo(re_compiled, re_extra, PCRE_INFO_STUDYSIZE, &study_size);
+  }
+
+  error = b3_config_cache_put_str(writer, b3_pattern_condition_get_pattern(pattern_condition));
+
+  if (!error) {
+    error = b3_config_cache_put_u32(writer, re_size);
+  }
+  if (!error && re_size) {
+    error = b3_config_cache_put(writer, re_compiled, re_size);
+  }
+
+  if (!error) {
+    error = b3_config_cache_put_u32(writer, study_size);
+  }
+  if (!error && study_size) {
+    error = b3_config_cache_put(writer, re_extra->study_data, study_size);
+  }
+
+  return error;
+}
+
+int
+b3_config_cache_put_condition(b3_config_cache_writer_t *writer, b3_condition_t *condition)
+{
+  int error;
+  b3_condition_and_t *condition_and;
+  CC_ArrayIter iter;
+  b3_condition_t *child;
+
+  error = 0;
+
+  if (b3_condition_and_instance_of(condition)) {
+    condition_and = (b3_condition_and_t *) condition;
+
+    error = b3_config_cache_put_u32(writer, B3_CONFIG_CACHE_TAG_CONDITION_AND);
+    if (!error) {
+      error = b3_config_cache_put_u32(writer, cc_array_size(condition_and->condition_arr));
+    }
+
+    cc_array_iter_init(&iter, condition_and->condition_arr);
+    while (!error && cc_array_iter_next(&iter, (void*) &child) != CC_ITER_END) {
+      error = b3_config_cache_put_condition(writer, child);
+    }
+  } else if (b3_class_condition_instance_of(condition)) {
+    error = b3_config_cache_put_u32(writer, B3_CONFIG_CACHE_TAG_CLASS_CONDITION);
+    if (!error) {
+      error = b3_config_cache_put_pattern(writer, (b3_pattern_condition_t *) condition);
+    }
+  } else if (b3_title_condition_instance_of(condition)) {
+    error = b3_config_cache_put_u32(writer, B3_CONFIG_CACHE_TAG_TITLE_CONDITION);
+    if (!error) {
+      error = b3_config_cache_put_pattern(writer, (b3_pattern_condition_t *) condition);
+    }
+  } else {
+    wbk_logger_log(&logger, WARNING, "Condition cannot be cached.\n");
+    error = 1;
+  }
+
+  return error;
+}
+
+int
+b3_config_cache_put_action(b3_config_cache_writer_t *writer, b3_action_t *action)
+{
+  int error;
+  b3_action_list_t *action_list;
+  CC_ArrayIter iter;
+  b3_action_t *child;
+
+  error = 0;
+
+  if (b3_action_list_instance_of(action)) {
+    action_list = (b3_action_list_t *) action;
+
+    error = b3_config_cache_put_u32(writer, B3_CONFIG_CACHE_TAG_ACTION_LIST);
+    if (!error) {
+      error = b3_config_cache_put_u32(writer, cc_array_size(action_list->action_arr));
+    }
+
+    cc_array_iter_init(&iter, action_list->action_arr);
+    while (!error && cc_array_iter_next(&iter, (void*) &child) != CC_ITER_END) {
+      error = b3_config_cache_put_action(writer, child);
+    }
+  } else if (b3_floating_action_instance_of(action)) {
+    error = b3_config_cache_put_u32(writer, B3_CONFIG_CACHE_TAG_FLOATING_ACTION);
+  } else if (b3_mwtw_action_instance_of(action)) {
+    error = b3_config_cache_put_u32(writer, B3_CONFIG_CACHE_TAG_MWTW_ACTION);
+    if (!error) {
+      error = b3_config_cache_put_str(writer, ((b3_mwtw_action_t *) action)->ws_id);
+    }
+  } else {
+    wbk_logger_log(&logger, WARNING, "Action cannot be cached.\n");
+    error = 1;
+  }
+
+  return error;
+}
+
+const char *
+b3_config_cache_get(b3_config_cache_reader_t *reader, size_t data_len)
+{
+  const char *data;
+
+  data = NULL;
+  if (data_len <= reader->len - reader->pos) {
+    data = reader->buffer + reader->pos;
+    reader->pos += data_len;
+  }
+
+  return data;
+}
+
+int
+b3_config_cache_get_u32(b3_config_cache_reader_t *reader, unsigned int *value)
+{
+  const char *data;
+
+  data = b3_config_cache_get(reader, sizeof(unsigned int));
+  if (data) {
+    memcpy(value, data, sizeof(unsigned int));
+  }
+
+  return data == NULL;
+}
+
+int
+b3_config_cache_get_str(b3_config_cache_reader_t *reader, char **str)
+{
+  int error;
+  unsigned int len;
+  const char *data;
+
+  *str = NULL;
+
+  error = b3_config_cache_get_u32(reader, &len);
+
+  if (!error && len != B3_CONFIG_CACHE_NULL_LEN) {
+    data = b3_config_cache_get(reader, len);
+    if (data) {
+      *str = malloc(sizeof(char) * (len + 1));
+    }
+
+    if (*str) {
+      memcpy(*str, data, len);
+      (*str)[len] = '\0';
+    } else {
+      error = 1;
+    }
+  }
+
+  return error;
+}
+
+wbk_kc_t *
+b3_config_cache_get_kc(b3_config_cache_reader_t *reader, unsigned int binding_size, b3_director_t *director)
+{
+  int error;
+  unsigned int tag;
+  unsigned int kind;
+  const char *binding;
+  char *str;
+  wbk_b_t *comb;
+  wbk_kc_t *kc;
+
+  kc = NULL;
+  str = NULL;
+  binding = NULL;
+
+  error = b3_config_cache_get_u32(reader, &tag);
+
+  if (!error) {
+    /** wbk_b_t does not contain any pointers */
+    binding = b3_config_cache_get(reader, binding_size);
+    error = binding == NULL;
+  }
+
+  if (!error) {
+    error = b3_config_cache_get_u32(reader, &kind);
+  }
+
+  if (!error) {
+    error = b3_config_cache_get_str(reader, &str);
+  }
+
+  if (!error) {
+    comb = wbk_b_new();
+    memcpy(comb, binding, sizeof(wbk_b_t));
+
+    if (tag == B3_CONFIG_CACHE_TAG_KC_DIRECTOR && kind <= SWITCH_MODE) {
+      switch (kind) {
+      case CHANGE_WORKSPACE:
+      case CHANGE_MONITOR:
+      case MOVE_ACTIVE_WINDOW_TO_WORKSPACE:
+      case SWITCH_MODE:
+        if (str == NULL) {
+          error = 1;
+        }
+        break;
+
+      default:
+        free(str);
+        str = NULL;
+      }
+
+      if (!error) {
+        kc = (wbk_kc_t *) b3_kc_director_new(comb, director, kind, str);
+        str = NULL;
+      }
+    } else if (tag == B3_CONFIG_CACHE_TAG_KC_EXEC
+               && (kind == ON_START_WS || kind == ON_CURRENT_WS)
+               && str) {
+      kc = (wbk_kc_t *) b3_kc_exec_new(comb, director, kind, str);
+      str = NULL;
+    } else {
+      error = 1;
+    }
+
+    if (error) {
+      wbk_b_free(comb);
+    }
+  }
+
+  free(str);
+
+  return kc;
+}
+
+int
+b3_config_cache_get_pattern(b3_config_cache_reader_t *reader, char **pattern,
+                            pcre **re_compiled, pcre_extra **re_extra)
+{
+  int error;
+  unsigned int re_size;
+  unsigned int study_size;
+  const char *re_data;
+  const char *study_data;
+  size_t check_size;
+
+  *pattern = NULL;
+  *re_compiled = NULL;
+  *re_extra = NULL;
+  re_data = NULL;
+  study_data = NULL;
+  re_size = 0;
+  study_size = 0;
+
+  error = b3_config_cache_get_str(reader, pattern);
+  if (!error && *pattern == NULL) {
+    error = 1;
+  }
+
+  if (!error) {
+    error = b3_config_cache_get_u32(reader, &re_size);
+  }
+  if (!error && re_size) {
+    re_data = b3_config_cache_get(reader, re_size);
+    error = re_data == NULL;
+  }
+
+  if (!error) {
+    error = b3_config_cache_get_u32(reader, &study_size);
+  }
+  if (!error && study_size) {
+    study_data = b3_config_cache_get(reader, study_size);
+    error = study_data == NULL || re_data == NULL;
+  }
+
+  /**
+   * PCRE rejects patterns with a wrong magic number or byte order. If that
+   * happens, then the pattern is compiled again.
+   */
+  if (!error && re_data) {
+    *re_compiled = pcre_malloc(re_size);
+    if (*re_compiled) {
+      memcpy(*re_compiled, re_data, re_size);
+    }
+
+    if (*re_compiled == NULL) {
+      study_data = NULL;
+    } else if (pcre_fullinfo(*re_compiled, NULL, PCRE_INFO_SIZE, &check_size) != 0
+               || check_size != re_size) {
+      pcre_free(*re_compiled);
+      *re_compiled = NULL;
+      study_data = NULL;
+    }
+  }
+
+  if (!error && study_data) {
+    /** Allocated like pcre_study() does, so that pcre_free_study() can free it */
+    *re_extra = pcre_malloc(sizeof(pcre_extra) + study_size);
+  }
+
+  /** Matching works without the study data */
+  if (!error && study_data && *re_extra) {
+    memset(*re_extra, 0, sizeof(pcre_extra));
+    (*re_extra)->flags = PCRE_EXTRA_STUDY_DATA;
+    (*re_extra)->study_data = ((char *) *re_extra) + sizeof(pcre_extra);
+    memcpy((*re_extra)->study_data, study_data, study_size);
+  }
+
+  if (error) {
+    free(*pattern);
+    *pattern = NULL;
+  }
+
+  return error;
+}
+
+b3_condition_t *
+b3_config_cache_get_condition(b3_config_cache_reader_t *reader)
+{
+  int error;
+  unsigned int tag;
+  unsigned int len;
+  unsigned int i;
+  char *pattern;
+  pcre *re_compiled;
+  pcre_extra *re_extra;
+  b3_condition_t *child;
+  b3_condition_t *condition;
+
+  condition = NULL;
+
+  error = b3_config_cache_get_u32(reader, &tag);
+
+  if (!error) {
+    switch (tag) {
+    case B3_CONFIG_CACHE_TAG_CONDITION_AND:
+      error = b3_config_cache_get_u32(reader, &len);
+      if (!error) {
+        condition = (b3_condition_t *) b3_condition_and_new();
+      }
+      for (i = 0; !error && i < len; i++) {
+        child = b3_config_cache_get_condition(reader);
+        if (child) {
+          b3_condition_and_add((b3_condition_and_t *) condition, child);
+        } else {
+          error = 1;
+        }
+      }
+      break;
+
+    case B3_CONFIG_CACHE_TAG_CLASS_CONDITION:
+    case B3_CONFIG_CACHE_TAG_TITLE_CONDITION:
+      error = b3_config_cache_get_pattern(reader, &pattern, &re_compiled, &re_extra);
+      if (!error) {
+        if (tag == B3_CONFIG_CACHE_TAG_CLASS_CONDITION) {
+          condition = (b3_condition_t *) b3_class_condition_new_compiled(pattern, re_compiled, re_extra);
+        } else {
+          condition = (b3_condition_t *) b3_title_condition_new_compiled(pattern, re_compiled, re_extra);
+        }
+        free(pattern);
+        error = condition == NULL;
+      }
+      break;
+
+    default:
+      error = 1;
+    }
+  }
+
+  if (error && condition) {
+    b3_condition_free(condition);
+    condition = NULL;
+  }
+
+  return condition;
+}
+
+b3_action_t *
+b3_config_cache_get_action(b3_config_cache_reader_t *reader)
+{
+  int error;
+  unsigned int tag;
+  unsigned int len;
+  unsigned int i;
+  char *ws_id;
+  b3_action_t *child;
+  b3_action_t *action;
+
+  action = NULL;
+
+  error = b3_config_cache_get_u32(reader, &tag);
+
+  if (!error) {
+    switch (tag) {
+    case B3_CONFIG_CACHE_TAG_ACTION_LIST:
+      error = b3_config_cache_get_u32(reader, &len);
+      if (!error) {
+        action = (b3_action_t *) b3_action_list_new();
+      }
+      for (i = 0; !error && i < len; i++) {
+        child = b3_config_cache_get_action(reader);
+        if (child) {
+          b3_action_cc_list_add((b3_action_list_t *) action, child);
+        } else {
+          error = 1;
+        }
+      }
+      break;
+
+    case B3_CONFIG_CACHE_TAG_FLOATING_ACTION:
+      action = (b3_action_t *) b3_floating_action_new();
+      break;
+
+    case B3_CONFIG_CACHE_TAG_MWTW_ACTION:
+      error = b3_config_cache_get_str(reader, &ws_id);
+      if (!error && ws_id) {
+        action = (b3_action_t *) b3_mwtw_action_new(ws_id);
+      } else {
+        error = 1;
+      }
+      break;
+
+    default:
+      error = 1;
+    }
+  }
+
+  if (error && action) {
+    b3_action_free(action);
+    action = NULL;
+  }
+
+  return action;
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-18
+ * @brief File contains the definition of the compiled configuration cache
+ *
+ * The cache stores the key bindings and the for_window rules of a parsed
+ * configuration, so that they can be restored without running the parser.
+ * It is keyed by a hash of the configuration, the b3 version and the PCRE
+ * version. Compiled regular expressions and their study data are stored as
+ * they are.
+ *
+ * The layout is flat: a b3_config_cache_header_t followed by the key bindings
+ * and then the rules. Every record starts with a tag, strings and binary
+ * blocks are prefixed by their length. It contains no pointers, so it can be
+ * mapped at any address.
+ */
+
+#ifndef B3_CONFIG_CACHE_H
+#define B3_CONFIG_CACHE_H
+
+#include <stddef.h>
+#include <collectc/cc_array.h>
+#include <w32bindkeys/kbman.h>
+
+#include "director.h"
+
+#define B3_CONFIG_CACHE_MAGIC "B3CC"
+
+/**
+ * Increase it whenever the layout changes.
+ */
+#define B3_CONFIG_CACHE_FORMAT 1
+
+typedef struct b3_config_cache_header_s
+{
+  char magic[4];
+
+  unsigned int format;
+
+  unsigned long long key;
+
+  /**
+   * Hash of everything following the header
+   */
+  unsigned long long checksum;
+
+  /**
+   * Size of the whole cache including the header
+   */
+  unsigned int size;
+
+  /**
+   * sizeof(wbk_b_t) of the writer
+   */
+  unsigned int binding_size;
+
+  unsigned int kc_len;
+
+  unsigned int rule_len;
+} b3_config_cache_header_t;
+
+/**
+ * @param config The contents of the configuration file.
+ * @return The key of a configuration.
+ */
+extern unsigned long long
+b3_config_cache_key(const char *config, size_t config_len);
+
+/**
+ * @brief Serializes key bindings and rules.
+ * @param buffer Will be set to the newly allocated cache. Free it by yourself!
+ * @return Non-0 if a key binding or rule cannot be serialized.
+ */
+extern int
+b3_config_cache_write(unsigned long long key, const wbk_kbman_t *kbman, CC_Array *rule_arr,
+                      char **buffer, size_t *buffer_len);
+
+/**
+ * @brief Validates a cache and restores its key bindings and rules.
+ * @param director The director of the restored key bindings.
+ * @param kbman Will be set to the restored key bindings. Free them by yourself!
+ * @param rule_arr The restored rules are added to this array. Free them by
+ * yourself!
+ * @return Non-0 if the cache is invalid or was written for another key. Then
+ * nothing is restored.
+ */
+extern int
+b3_config_cache_read(const char *buffer, size_t buffer_len, unsigned long long key,
+                     b3_director_t *director, wbk_kbman_t **kbman, CC_Array *rule_arr);
+
+/**
+ * @brief Writes the cache file. The file is replaced atomically.
+ */
+extern int
+b3_config_cache_save(const char *filename, unsigned long long key,
+                     const wbk_kbman_t *kbman, CC_Array *rule_arr);
+
+/**
+ * @brief Maps the cache file and restores it. See b3_config_cache_read().
+ */
+extern int
+b3_config_cache_load(const char *filename, unsigned long long key,
+                     b3_director_t *director, wbk_kbman_t **kbman, CC_Array *rule_arr);
+
+#endif // B3_CONFIG_CACHE_H
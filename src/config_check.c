@@ -0,0 +1,443 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the configuration checker implementation
+ */
+
+#include "config_check.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <pcre.h>
+#include <collectc/cc_array.h>
+#include <w32bindkeys/logger.h>
+#include <w32bindkeys/b.h>
+#include <w32bindkeys/kc.h>
+#include <w32bindkeys/kbman.h>
+
+#include "kc_director.h"
+#include "kc_exec.h"
+#include "rule.h"
+#include "condition_and.h"
+#include "pattern_condition.h"
+#include "class_condition.h"
+#include "title_condition.h"
+#include "utils.h"
+#include "mode.h"
+
+static wbk_logger_t logger = { "config_check" };
+
+typedef struct b3_config_check_binding_s
+{
+  wbk_kc_t *kc;
+
+  /**
+   * Position of the key binding in the configuration
+   */
+  int index;
+} b3_config_check_binding_t;
+
+static const char *g_phase_name_arr[B3_CONFIG_CHECK_PHASE_LEN] = {
+  "read", "parse", "patterns", "bindings"
+};
+
+static char *
+b3_config_check_read(const char *config_filename);
+
+static char *
+b3_config_check_get_dir(const char *config_filename);
+
+static int
+b3_config_check_patterns(b3_config_check_t *check, CC_Array *rule_arr);
+
+static int
+b3_config_check_condition(b3_config_check_t *check, b3_condition_t *condition);
+
+/**
+ * Searches for combinations that are bound more than once.
+ *
+ * @param mode_name The name of the mode of the key bindings for the log.
+ */
+static int
+b3_config_check_bindings(b3_config_check_t *check, wbk_kbman_t *kbman, const char *mode_name);
+
+/**
+ * Searches for key bindings switching to a mode that is not in mode_arr.
+ */
+static int
+b3_config_check_modes(b3_config_check_t *check, wbk_kbman_t *kbman, CC_Array *mode_arr);
+
+static int
+b3_config_check_compare_bindings(const void *a, const void *b);
+
+static int
+b3_config_check_kc_equals(const wbk_kc_t *kc, const wbk_kc_t *other);
+
+int
+b3_config_check(b3_parser_t *parser, const char *config_filename, char strict,
+                b3_config_check_t *check)
+{
+  int error;
+  char *config;
+  char *config_dir;
+  wbk_kbman_t *kbman;
+  CC_Array *rule_arr;
+  CC_Array *mode_arr;
+  CC_ArrayIter iter;
+  b3_rule_t *rule;
+  b3_mode_t *mode;
+  LONGLONG start;
+  int i;
+
+  error = 0;
+  config = NULL;
+  kbman = NULL;
+  memset(check, 0, sizeof(b3_config_check_t));
+  for (i = 0; i < B3_CONFIG_CHECK_PHASE_LEN; i++) {
+    b3_profile_init(&(check->phase_profile_arr[i]));
+  }
+  cc_array_new(&rule_arr);
+  cc_array_new(&mode_arr);
+
+  start = b3_profile_start();
+  config = b3_config_check_read(config_filename);
+  if (config == NULL) {
+    wbk_logger_log(&logger, SEVERE, "Could not open %s\n", config_filename);
+    error = 1;
+  }
+  b3_profile_record(&(check->phase_profile_arr[B3_CONFIG_CHECK_PHASE_READ]), start, !error);
+
+  if (!error) {
+    start = b3_profile_start();
+    config_dir = b3_config_check_get_dir(config_filename);
+    kbman = b3_parser_parse_str_in_dir(parser, NULL, config, config_dir, config_filename,
+                                       rule_arr, mode_arr, &(check->fragment_len));
+    free(config_dir);
+    if (kbman == NULL) {
+      wbk_logger_log(&logger, SEVERE, "Could not parse %s\n", config_filename);
+      error = 2;
+    }
+    b3_profile_record(&(check->phase_profile_arr[B3_CONFIG_CHECK_PHASE_PARSE]), start, !error);
+  }
+
+  if (!error) {
+    check->binding_len = kbman->kc_arr_len;
+    check->rule_len = cc_array_size(rule_arr);
+    check->mode_len = cc_array_size(mode_arr);
+
+    cc_array_iter_init(&iter, mode_arr);
+    while (cc_array_iter_next(&iter, (void*) &mode) != CC_ITER_END) {
+      check->binding_len += b3_mode_get_kbman(mode)->kc_arr_len;
+    }
+
+    start = b3_profile_start();
+    error = b3_config_check_patterns(check, rule_arr);
+    b3_profile_record(&(check->phase_profile_arr[B3_CONFIG_CHECK_PHASE_PATTERNS]), start, !error);
+  }
+
+  if (!error) {
+    start = b3_profile_start();
+    b3_config_check_bindings(check, kbman, B3_MODE_DEFAULT);
+    b3_config_check_modes(check, kbman, mode_arr);
+
+    cc_array_iter_init(&iter, mode_arr);
+    while (cc_array_iter_next(&iter, (void*) &mode) != CC_ITER_END) {
+      b3_config_check_bindings(check, b3_mode_get_kbman(mode), b3_mode_get_name(mode));
+      b3_config_check_modes(check, b3_mode_get_kbman(mode), mode_arr);
+    }
+
+    error = (strict && check->shadowed_len > 0) || check->undefined_mode_len > 0;
+    b3_profile_record(&(check->phase_profile_arr[B3_CONFIG_CHECK_PHASE_BINDINGS]), start, !error);
+  }
+
+  while (cc_array_remove_last(rule_arr, (void*) &rule) == CC_OK) {
+    b3_rule_free(rule);
+  }
+  cc_array_destroy(rule_arr);
+
+  while (cc_array_remove_last(mode_arr, (void*) &mode) == CC_OK) {
+    b3_mode_free(mode);
+  }
+  cc_array_destroy(mode_arr);
+
+  if (kbman) {
+    wbk_kbman_free(kbman);
+  }
+
+  if (config) {
+    free(config);
+  }
+
+  return error;
+}
+
+int
+b3_config_check_print(const b3_config_check_t *check, FILE *stream)
+{
+  b3_profile_t profile;
+  int i;
+
+  fprintf(stream, "%d key bindings, %d rules, %d modes, %d included fragments\n",
+          check->binding_len, check->rule_len, check->mode_len, check->fragment_len);
+  fprintf(stream, "%d regular expressions, %d literal patterns\n",
+          check->regex_len, check->literal_len);
+  fprintf(stream, "%d duplicate key bindings, %d shadowed key bindings, %d undeclared modes\n",
+          check->duplicate_len, check->shadowed_len, check->undefined_mode_len);
+
+  for (i = 0; i < B3_CONFIG_CHECK_PHASE_LEN; i++) {
+    b3_profile_copy((b3_profile_t *) &(check->phase_profile_arr[i]), &profile);
+    if (profile.evaluations) {
+      fprintf(stream, "%-10s %10.3f ms%s\n", g_phase_name_arr[i], profile.total_ns / 1000000.0,
+              profile.matches ? "" : " (failed)");
+    } else {
+      fprintf(stream, "%-10s %13s\n", g_phase_name_arr[i], "skipped");
+    }
+  }
+
+  return 0;
+}
+
+char *
+b3_config_check_read(const char *config_filename)
+{
+  FILE *config_file;
+  long size;
+  size_t config_len;
+  char *config;
+
+  config = NULL;
+
+  config_file = fopen(config_filename, "r");
+  if (config_file) {
+    fseek(config_file, 0, SEEK_END);
+    size = ftell(config_file);
+    fseek(config_file, 0, SEEK_SET);
+
+    if (size >= 0) {
+      config = malloc(sizeof(char) * (size + 1));
+      /** Text mode might shrink the contents */
+      config_len = fread(config, sizeof(char), size, config_file);
+      config[config_len] = '\0';
+    }
+
+    fclose(config_file);
+  }
+
+  return config;
+}
+
+char *
+b3_config_check_get_dir(const char *config_filename)
+{
+  char *config_dir;
+  int length;
+
+  length = strlen(config_filename);
+  while (length > 0
+         && config_filename[length - 1] != '\\'
+         && config_filename[length - 1] != '/') {
+    length--;
+  }
+
+  config_dir = malloc(sizeof(char) * (length + 1));
+  memcpy(config_dir, config_filename, length);
+  config_dir[length] = '\0';
+
+  return config_dir;
+}
+
+int
+b3_config_check_patterns(b3_config_check_t *check, CC_Array *rule_arr)
+{
+  int error;
+  CC_ArrayIter iter;
+  b3_rule_t *rule;
+
+  error = 0;
+
+  cc_array_iter_init(&iter, rule_arr);
+  while (!error && cc_array_iter_next(&iter, (void*) &rule) != CC_ITER_END) {
+    error = b3_config_check_condition(check, b3_rule_get_condition(rule));
+  }
+
+  return error;
+}
+
+int
+b3_config_check_condition(b3_config_check_t *check, b3_condition_t *condition)
+{
+  int error;
+  b3_condition_and_t *condition_and;
+  b3_pattern_condition_t *pattern_condition;
+  CC_ArrayIter iter;
+  b3_condition_t *child;
+  pcre *re_compiled;
+  pcre_extra *re_extra;
+
+  error = 0;
+
+  if (b3_condition_and_instance_of(condition)) {
+    condition_and = (b3_condition_and_t *) condition;
+
+    cc_array_iter_init(&iter, condition_and->condition_arr);
+    while (!error && cc_array_iter_next(&iter, (void*) &child) != CC_ITER_END) {
+      error = b3_config_check_condition(check, child);
+    }
+  } else if (b3_class_condition_instance_of(condition)
+             || b3_title_condition_instance_of(condition)) {
+    pattern_condition = (b3_pattern_condition_t *) condition;
+
+    if (b3_pattern_condition_get_use_focused_as_pattern(pattern_condition)) {
+      /** The pattern is only known when the rule is applied */
+    } else if (b3_pattern_condition_get_kind(pattern_condition) != B3_PATTERN_KIND_REGEX) {
+      check->literal_len++;
+    } else {
+      check->regex_len++;
+      error = b3_compile_pattern(b3_pattern_condition_get_pattern(pattern_condition),
+                                 &re_compiled, &re_extra);
+
+      if (!error) {
+        pcre_free(re_compiled);
+        if (re_extra) {
+#ifdef PCRE_CONFIG_JIT
+          pcre_free_study(re_extra);
+#else
+          pcre_free(re_extra);
+#endif
+        }
+      }
+    }
+  }
+
+  return error;
+}
+
+int
+b3_config_check_bindings(b3_config_check_t *check, wbk_kbman_t *kbman, const char *mode_name)
+{
+  CC_Array *binding_arr;
+  b3_config_check_binding_t *binding_mem;
+  b3_config_check_binding_t *first;
+  b3_config_check_binding_t *binding;
+  char *binding_str;
+  int i;
+
+  binding_mem = malloc(sizeof(b3_config_check_binding_t) * (kbman->kc_arr_len + 1));
+  cc_array_new(&binding_arr);
+
+  for (i = 0; i < kbman->kc_arr_len; i++) {
+    binding_mem[i].kc = kbman->kc_arr[i];
+    binding_mem[i].index = i;
+    cc_array_add(binding_arr, &(binding_mem[i]));
+  }
+
+  /**
+   * Equal combinations become neighbours, ordered by their position. The first
+   * one of each run is the one that takes effect.
+   */
+  cc_array_sort(binding_arr, b3_config_check_compare_bindings);
+
+  first = NULL;
+  for (i = 0; i < cc_array_size(binding_arr); i++) {
+    cc_array_get_at(binding_arr, i, (void*) &binding);
+
+    if (first == NULL
+        || wbk_b_compare(wbk_kc_get_binding(first->kc), wbk_kc_get_binding(binding->kc))) {
+      first = binding;
+    } else {
+      binding_str = wbk_b_to_str(wbk_kc_get_binding(binding->kc));
+
+      if (b3_config_check_kc_equals(first->kc, binding->kc)) {
+        wbk_logger_log(&logger, WARNING, "Key binding %d (%s) of mode %s repeats key binding %d\n",
+                       binding->index + 1, binding_str, mode_name, first->index + 1);
+        check->duplicate_len++;
+      } else {
+        wbk_logger_log(&logger, WARNING, "Key binding %d (%s) of mode %s is shadowed by key binding %d\n",
+                       binding->index + 1, binding_str, mode_name, first->index + 1);
+        check->shadowed_len++;
+      }
+
+      free(binding_str);
+    }
+  }
+
+  cc_array_destroy(binding_arr);
+  free(binding_mem);
+
+  return check->shadowed_len > 0;
+}
+
+int
+b3_config_check_modes(b3_config_check_t *check, wbk_kbman_t *kbman, CC_Array *mode_arr)
+{
+  b3_kc_director_t *kc_director;
+  char *binding_str;
+  int i;
+
+  for (i = 0; i < kbman->kc_arr_len; i++) {
+    kc_director = (b3_kc_director_t *) kbman->kc_arr[i];
+
+    if (b3_kc_director_instance_of(kbman->kc_arr[i])
+        && kc_director->kind == SWITCH_MODE
+        && strcmp(kc_director->data, B3_MODE_DEFAULT)
+        && b3_mode_find(mode_arr, kc_director->data) == NULL) {
+      binding_str = wbk_b_to_str(wbk_kc_get_binding(kbman->kc_arr[i]));
+      wbk_logger_log(&logger, SEVERE, "Key binding %s switches to the undeclared mode %s\n",
+                     binding_str, (char *) kc_director->data);
+      free(binding_str);
+
+      check->undefined_mode_len++;
+    }
+  }
+
+  return check->undefined_mode_len > 0;
+}
+
+int
+b3_config_check_compare_bindings(const void *a, const void *b)
+{
+  const b3_config_check_binding_t *binding;
+  const b3_config_check_binding_t *other;
+  int result;
+
+  binding = *((const b3_config_check_binding_t **) a);
+  other = *((const b3_config_check_binding_t **) b);
+
+  result = wbk_b_compare(wbk_kc_get_binding(binding->kc), wbk_kc_get_binding(other->kc));
+  if (result == 0) {
+    result = binding->index - other->index;
+  }
+
+  return result;
+}
+
+int
+b3_config_check_kc_equals(const wbk_kc_t *kc, const wbk_kc_t *other)
+{
+  return b3_kc_director_equals(kc, other)
+    || b3_kc_exec_equals(kc, other);
+}
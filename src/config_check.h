@@ -0,0 +1,131 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the definition of the configuration checker
+ *
+ * The checker validates a configuration file the same way it would be loaded,
+ * but against no director. The key commands only keep the director they
+ * belong to and none of them is executed, so no window, hook or daemon is
+ * created and the director is never touched.
+ *
+ * The check runs in phases and each phase is timed:
+ * - read: Reading the configuration file
+ * - parse: Parsing it and all included fragments. The patterns are compiled
+ *   while parsing, an invalid pattern fails this phase.
+ * - patterns: Every regular expression is compiled once more on its own, so
+ *   that the time spent in PCRE is reported apart from the parser.
+ * - bindings: Searching for key bindings that are bound more than once, in
+ *   each mode on its own, and for mode commands naming an undeclared mode.
+ *
+ * A shadowed key binding never takes effect, but b3 loads the configuration
+ * anyway. It is therefore only a warning, unless the check is strict.
+ */
+
+#ifndef B3_CONFIG_CHECK_H
+#define B3_CONFIG_CHECK_H
+
+#include <stdio.h>
+
+#include "parser.h"
+#include "profile.h"
+
+typedef enum b3_config_check_phase_e
+{
+  B3_CONFIG_CHECK_PHASE_READ = 0,
+  B3_CONFIG_CHECK_PHASE_PARSE,
+  B3_CONFIG_CHECK_PHASE_PATTERNS,
+  B3_CONFIG_CHECK_PHASE_BINDINGS,
+  B3_CONFIG_CHECK_PHASE_LEN
+} b3_config_check_phase_t;
+
+typedef struct b3_config_check_s
+{
+  /**
+   * Time spent in each phase. A phase is recorded as matched if it succeeded.
+   */
+  b3_profile_t phase_profile_arr[B3_CONFIG_CHECK_PHASE_LEN];
+
+  /**
+   * Number of key bindings including the ones of all modes
+   */
+  int binding_len;
+
+  int rule_len;
+
+  int mode_len;
+
+  int fragment_len;
+
+  /**
+   * Number of patterns that are matched by PCRE
+   */
+  int regex_len;
+
+  /**
+   * Number of patterns that are compared as literals
+   */
+  int literal_len;
+
+  /**
+   * Number of key bindings that repeat an earlier binding with the same
+   * command. They are harmless.
+   */
+  int duplicate_len;
+
+  /**
+   * Number of key bindings whose combination is already bound to another
+   * command. They never take effect. They fail a strict check only.
+   */
+  int shadowed_len;
+
+  /**
+   * Number of key bindings switching to a mode that is not declared
+   */
+  int undefined_mode_len;
+} b3_config_check_t;
+
+/**
+ * @brief Checks a configuration file. The findings are logged.
+ * @param parser The parser. Rules and key bindings are not kept.
+ * @param strict Non-0 if a shadowed key binding fails the check.
+ * @param check Receives the statistics. Phases that were not reached have no
+ * evaluations.
+ * @return 0 if the configuration is valid. Non-0 if it cannot be read or
+ * parsed, if a mode is not declared or, if strict, if a key binding is
+ * shadowed.
+ */
+extern int
+b3_config_check(b3_parser_t *parser, const char *config_filename, char strict,
+                b3_config_check_t *check);
+
+/**
+ * @brief Prints the statistics of a check.
+ */
+extern int
+b3_config_check_print(const b3_config_check_t *check, FILE *stream);
+
+#endif // B3_CONFIG_CHECK_H
@@ -38,6 +38,7 @@
 #include "monitor.h"
 #include "ws.h"
 #include "rule.h"
+#include "rule_set.h"
 
 static wbk_logger_t logger = { "director" };
 
@@ -67,14 +68,41 @@ b3_director_set_focused_monitor(b3_director_t *director, b3_monitor_t *monitor);
 static const b3_monitor_t *
 b3_director_get_monitor_by_monitor_name(b3_director_t *director, const char *monitor_name);
 
+/**
+ * @return The workspace with the name ws_id on any monitor or NULL if there is
+ * none.
+ */
+static b3_ws_t *
+b3_director_find_ws(b3_director_t *director, const char *ws_id);
+
 static BOOL CALLBACK
 b3_director_enum_monitors(HMONITOR monitor, HDC hdc, LPRECT rect, LPARAM data);
 
-static DWORD WINAPI
-b3_director_repaint_all_threaded(_In_ LPVOID param);
+/**
+ * Marks parts of the bar of a monitor as dirty and updates the dirty bars at
+ * once or, within a transaction, at its commit. Requires holding the global
+ * mutex.
+ *
+ * @param monitor The monitor whose bar changed. If NULL, then the bars of all
+ * monitors are marked.
+ * @param dirty B3_BAR_DIRTY_* flags. If 0, then only the already dirty bars are
+ * updated.
+ */
+static int
+b3_director_request_repaint(b3_director_t *director, b3_monitor_t *monitor, LONG dirty);
+
+/**
+ * Lets every dirty bar redraw its changed cells.
+ */
+static int
+b3_director_update_bars(b3_director_t *director);
 
+/**
+ * Fills the window table with the windows just arranged. The caller holds the
+ * global mutex.
+ */
 static int
-b3_director_repaint_all(void);
+b3_director_update_wintable(b3_director_t *director);
 
 b3_director_t *
 b3_director_new(b3_monitor_factory_t *monitor_factory)
@@ -99,6 +127,13 @@ b3_director_new(b3_monitor_factory_t *monitor_factory)
         director->monitor_factory = monitor_factory;
 
         cc_array_new(&(director->rule_arr));
+        director->rule_set = b3_rule_set_new(director->rule_arr);
+
+        director->launchman = b3_launchman_new();
+        director->status = NULL;
+
+        director->wintable = b3_wintable_new();
+        director->wintable_stale = 1;
     }
 
 	return director;
@@ -124,6 +159,7 @@ b3_director_free_monitor_arr(b3_director_t *director)
 	cc_array_destroy_cb(director->monitor_arr, NULL);
 
 	director->monitor_arr = NULL;
+	director->wintable_stale = 1;
 
 	return 0;
 }
@@ -143,12 +179,18 @@ b3_director_free_rule_arr(b3_director_t *director)
 
 	director->rule_arr = NULL;
 
+	if (director->rule_set) {
+		b3_rule_set_release(director->rule_set);
+		director->rule_set = NULL;
+	}
+
   return 0;
 }
 
 int
 b3_director_refresh(b3_director_t *director)
 {
+	CC_ArrayIter iter;
 	b3_monitor_t *monitor;
 	char found;
 
@@ -159,7 +201,14 @@ b3_director_refresh(b3_director_t *director)
 
 	EnumDisplayMonitors(NULL, NULL, b3_director_enum_monitors, (LPARAM) director);
 
-   	b3_director_repaint_all();
+	if (director->status) {
+		cc_array_iter_init(&iter, director->monitor_arr);
+		while (cc_array_iter_next(&iter, (void*) &monitor) != CC_ITER_END) {
+			b3_bar_set_status(b3_monitor_get_bar(monitor), director->status);
+		}
+	}
+
+   	b3_director_request_repaint(director, NULL, B3_BAR_DIRTY_ALL);
 
 	ReleaseMutex(director->global_mutex);
 
@@ -235,6 +284,46 @@ b3_director_get_focused_monitor(b3_director_t *director)
 	return director->focused_monitor;
 }
 
+b3_launchman_t *
+b3_director_get_launchman(b3_director_t *director)
+{
+	return director->launchman;
+}
+
+int
+b3_director_set_status(b3_director_t *director, b3_status_t *status)
+{
+	CC_ArrayIter iter;
+	b3_monitor_t *monitor;
+
+	WaitForSingleObject(director->global_mutex, INFINITE);
+
+	director->status = status;
+
+	cc_array_iter_init(&iter, director->monitor_arr);
+	while (cc_array_iter_next(&iter, (void*) &monitor) != CC_ITER_END) {
+		b3_bar_set_status(b3_monitor_get_bar(monitor), status);
+	}
+
+	b3_director_request_repaint(director, NULL, 0);
+
+	ReleaseMutex(director->global_mutex);
+
+	return 0;
+}
+
+int
+b3_director_update_status(b3_director_t *director)
+{
+	WaitForSingleObject(director->global_mutex, INFINITE);
+
+	b3_director_request_repaint(director, NULL, B3_BAR_DIRTY_STATUS);
+
+	ReleaseMutex(director->global_mutex);
+
+	return 0;
+}
+
 int
 b3_director_set_focused_monitor(b3_director_t *director, b3_monitor_t *monitor)
 {
@@ -301,7 +390,8 @@ b3_director_set_focused_monitor_by_name(b3_director_t *director, const char *mon
     	ret = 1;
     }
 
-    b3_director_repaint_all();
+    /** The bars were marked by b3_director_set_focused_monitor() */
+    b3_director_request_repaint(director, NULL, 0);
 
 	ReleaseMutex(director->global_mutex);
 
@@ -314,6 +404,7 @@ b3_director_switch_to_ws(b3_director_t *director, const char *ws_id)
 	char found;
 	CC_ArrayIter iter;
 	b3_monitor_t *monitor;
+	b3_ws_t *focused_ws;
 	b3_win_t *focused_win;
   
 	WaitForSingleObject(director->global_mutex, INFINITE);
@@ -331,7 +422,14 @@ b3_director_switch_to_ws(b3_director_t *director, const char *ws_id)
   }
 
   b3_monitor_set_focused_ws(director->focused_monitor, ws_id);
-  focused_win = b3_ws_get_focused_win(b3_monitor_get_focused_ws(b3_director_get_focused_monitor(director)));
+  focused_ws = b3_monitor_get_focused_ws(b3_director_get_focused_monitor(director));
+  focused_win = b3_ws_get_focused_win(focused_ws);
+
+  /** The user is looking at the workspace now */
+  if (focused_ws && b3_ws_is_urgent(focused_ws)) {
+    b3_ws_set_urgent(focused_ws, 0);
+    b3_director_request_repaint(director, director->focused_monitor, B3_BAR_DIRTY_URGENT);
+  }
 
   b3_director_arrange_wins(director);
 
@@ -342,23 +440,246 @@ b3_director_switch_to_ws(b3_director_t *director, const char *ws_id)
     b3_director_w32_set_active_window(b3_win_get_window_handler(focused_win), 1);
   }
 
-  b3_director_repaint_all();
+  b3_director_request_repaint(director, director->focused_monitor, B3_BAR_DIRTY_FOCUSED_WS);
 
   ReleaseMutex(director->global_mutex);
 
   return 0;
 }
 
+int
+b3_director_begin_transaction(b3_director_t *director)
+{
+	WaitForSingleObject(director->global_mutex, INFINITE);
+
+	director->transaction_depth++;
+
+	return 0;
+}
+
+int
+b3_director_commit_transaction(b3_director_t *director)
+{
+	int error;
+
+	error = 0;
+
+	director->transaction_depth--;
+
+	if (director->transaction_depth == 0) {
+		if (director->arrange_pending) {
+			director->arrange_pending = 0;
+			error = b3_director_arrange_wins(director);
+		}
+
+		if (director->repaint_pending) {
+			director->repaint_pending = 0;
+			b3_director_update_bars(director);
+		}
+	}
+
+	ReleaseMutex(director->global_mutex);
+
+	return error;
+}
+
 int
 b3_director_add_rule(b3_director_t *director, b3_rule_t *rule)
 {
+  int error;
+  b3_rule_set_t *rule_set;
+
+  error = 0;
+
 	WaitForSingleObject(director->global_mutex, INFINITE);
 
   cc_array_add(director->rule_arr, rule);
 
+  /**
+   * Publish a new snapshot. Threads still evaluating the old one keep it alive
+   * until they release it.
+   */
+  rule_set = b3_rule_set_new(director->rule_arr);
+  if (rule_set) {
+    b3_rule_set_release(director->rule_set);
+    director->rule_set = rule_set;
+  } else {
+    error = 1;
+  }
+
   ReleaseMutex(director->global_mutex);
 
-  return 0;
+  return error;
+}
+
+int
+b3_director_replace_rules(b3_director_t *director, CC_Array *rule_arr)
+{
+  int error;
+  CC_ArrayIter iter;
+  b3_rule_t *rule;
+  b3_rule_t *old_rule;
+  CC_Array *new_rule_arr;
+  CC_Array *unused_rule_arr;
+  CC_Array *dropped_rule_arr;
+  b3_rule_set_t *rule_set;
+  int added;
+  int i;
+  char found;
+
+  error = 0;
+  added = 0;
+
+  cc_array_new(&new_rule_arr);
+  cc_array_new(&unused_rule_arr);
+  cc_array_new(&dropped_rule_arr);
+
+	WaitForSingleObject(director->global_mutex, INFINITE);
+
+  cc_array_iter_init(&iter, director->rule_arr);
+  while (cc_array_iter_next(&iter, (void *) &old_rule) != CC_ITER_END) {
+    cc_array_add(unused_rule_arr, old_rule);
+  }
+
+  cc_array_iter_init(&iter, rule_arr);
+  while (cc_array_iter_next(&iter, (void *) &rule) != CC_ITER_END) {
+    found = 0;
+    for (i = 0; !found && i < cc_array_size(unused_rule_arr); i++) {
+      cc_array_get_at(unused_rule_arr, i, (void *) &old_rule);
+      if (b3_rule_equals(old_rule, rule)) {
+        found = 1;
+        cc_array_remove_at(unused_rule_arr, i, NULL);
+      }
+    }
+
+    if (found) {
+      cc_array_add(new_rule_arr, old_rule);
+      cc_array_add(dropped_rule_arr, rule);
+    } else {
+      cc_array_add(new_rule_arr, rule);
+      added++;
+    }
+  }
+
+  rule_set = b3_rule_set_new(new_rule_arr);
+  if (rule_set) {
+    /**
+     * Threads still evaluating the old snapshot keep the removed rules alive
+     * until they release it.
+     */
+    cc_array_iter_init(&iter, unused_rule_arr);
+    while (cc_array_iter_next(&iter, (void *) &old_rule) != CC_ITER_END) {
+      b3_rule_set_retire(director->rule_set, old_rule);
+    }
+
+    b3_rule_set_release(director->rule_set);
+    director->rule_set = rule_set;
+
+    cc_array_destroy(director->rule_arr);
+    director->rule_arr = new_rule_arr;
+    new_rule_arr = NULL;
+
+    wbk_logger_log(&logger, INFO, "Replaced rules: %d kept, %d added, %d removed\n",
+                   cc_array_size(rule_arr) - added, added, cc_array_size(unused_rule_arr));
+  } else {
+    error = 1;
+  }
+
+	ReleaseMutex(director->global_mutex);
+
+  if (error) {
+    /** Keep the current rules and drop all new ones */
+    cc_array_destroy(dropped_rule_arr);
+    dropped_rule_arr = NULL;
+
+    cc_array_iter_init(&iter, rule_arr);
+    while (cc_array_iter_next(&iter, (void *) &rule) != CC_ITER_END) {
+      b3_rule_free(rule);
+    }
+
+    cc_array_destroy(new_rule_arr);
+  } else {
+    cc_array_iter_init(&iter, dropped_rule_arr);
+    while (cc_array_iter_next(&iter, (void *) &rule) != CC_ITER_END) {
+      b3_rule_free(rule);
+    }
+
+    cc_array_destroy(dropped_rule_arr);
+  }
+
+  cc_array_destroy(unused_rule_arr);
+
+  return error;
+}
+
+int
+b3_director_set_reload_handler(b3_director_t *director, int (*reload_handler)(void *data), void *data)
+{
+	WaitForSingleObject(director->global_mutex, INFINITE);
+
+	director->reload_handler = reload_handler;
+	director->reload_data = data;
+
+	ReleaseMutex(director->global_mutex);
+
+	return 0;
+}
+
+int
+b3_director_reload(b3_director_t *director)
+{
+	int (*reload_handler)(void *data);
+	void *data;
+	int error;
+
+	WaitForSingleObject(director->global_mutex, INFINITE);
+	reload_handler = director->reload_handler;
+	data = director->reload_data;
+	ReleaseMutex(director->global_mutex);
+
+	/** Reloading takes the global mutex by itself only where necessary */
+	error = 1;
+	if (reload_handler) {
+		error = reload_handler(data);
+	} else {
+		wbk_logger_log(&logger, SEVERE, "Reloading is not supported.\n");
+	}
+
+	return error;
+}
+
+int
+b3_director_set_mode_handler(b3_director_t *director,
+							 int (*mode_handler)(void *data, const char *mode_name),
+							 void *data)
+{
+	WaitForSingleObject(director->global_mutex, INFINITE);
+
+	director->mode_handler = mode_handler;
+	director->mode_data = data;
+
+	ReleaseMutex(director->global_mutex);
+
+	return 0;
+}
+
+int
+b3_director_switch_mode(b3_director_t *director, const char *mode_name)
+{
+	int error;
+
+	/**
+	 * The global mutex might be held by a long running command. The key
+	 * combination must not wait for it.
+	 */
+	error = 1;
+	if (director->mode_handler) {
+		error = director->mode_handler(director->mode_data, mode_name);
+	} else {
+		wbk_logger_log(&logger, SEVERE, "Binding modes are not supported.\n");
+	}
+
+	return error;
 }
 
 int
@@ -369,10 +690,79 @@ b3_director_add_win(b3_director_t *director, const char *monitor_name, b3_win_t
 	char found;
 	int error;
   b3_rule_t *rule;
+  b3_rule_set_t *rule_set;
+  CC_Array *matched_rule_arr;
+  CC_Array *deferred_rule_arr;
+  b3_action_placement_t placement;
+  b3_ws_t *ws;
+  char ws_created;
+  DWORD process_id;
+  b3_launch_t *launch;
 
+  /**
+   * Stage 1: Take a reference on the current rule set.
+   */
 	WaitForSingleObject(director->global_mutex, INFINITE);
+  rule_set = b3_rule_set_acquire(director->rule_set);
+	ReleaseMutex(director->global_mutex);
+
+  /**
+   * Stage 2: Evaluate the rules without holding the global mutex. Querying a
+   * window that does not respond must not stall other commands.
+   */
+  b3_win_cache_attrs(win);
+
+  cc_array_new(&matched_rule_arr);
+  b3_rule_set_match(rule_set, director, win, matched_rule_arr);
+
+  /**
+   * Decide the destination of the window up front. Only rules whose actions
+   * cannot be expressed as a placement are executed after adding the window.
+   */
+  placement.ws_id = NULL;
+  placement.floating = b3_win_get_floating(win);
+
+  /**
+   * The first window of a launched process goes to the workspace and monitor
+   * of its launch context. Rules may still move it elsewhere.
+   */
+  launch = NULL;
+  if (director->launchman) {
+    GetWindowThreadProcessId(b3_win_get_window_handler(win), &process_id);
+    launch = b3_launchman_claim(director->launchman, process_id);
+  }
+
+  if (launch) {
+    placement.ws_id = b3_launch_get_ws_name(launch);
+  }
+
+  cc_array_new(&deferred_rule_arr);
+  cc_array_iter_init(&iter, matched_rule_arr);
+  while (cc_array_iter_next(&iter, (void*) &rule) != CC_ITER_END) {
+    if (b3_rule_prepare(rule, director, win, &placement)) {
+      cc_array_add(deferred_rule_arr, rule);
+    }
+  }
+
+  b3_win_set_floating(win, placement.floating);
+
+  /**
+   * Stage 3: Add the window to its final workspace and apply the deferred
+   * rules in one transaction, so the windows are arranged once at its commit.
+   */
+  b3_director_begin_transaction(director);
 
 	found = 0;
+  if (launch && b3_launch_get_monitor_name(launch)) {
+    cc_array_iter_init(&iter, director->monitor_arr);
+    while (!found && cc_array_iter_next(&iter, (void*) &monitor) != CC_ITER_END) {
+      if (strcmp(b3_monitor_get_monitor_name(monitor), b3_launch_get_monitor_name(launch)) == 0) {
+        found = 1;
+      }
+    }
+  }
+
+  /** The monitor of the launch is gone or the window was not launched */
 	cc_array_iter_init(&iter, director->monitor_arr);
   while (!found && cc_array_iter_next(&iter, (void*) &monitor) != CC_ITER_END) {
     if (strcmp(b3_monitor_get_monitor_name(monitor), monitor_name) == 0) {
@@ -380,27 +770,89 @@ b3_director_add_win(b3_director_t *director, const char *monitor_name, b3_win_t
     }
   }
 
-  error = 1;
+  ws = NULL;
+  ws_created = 0;
   if (found) {
-    error = b3_monitor_add_win(monitor, win);
-
-    cc_array_iter_init(&iter, director->rule_arr);
-    while (cc_array_iter_next(&iter, (void*) &rule) != CC_ITER_END) {
-      if (b3_rule_applies(rule, director, win)) {
-        b3_rule_exec(rule, director, win);
+    ws = b3_monitor_get_focused_ws(monitor);
+
+    if (placement.ws_id) {
+      ws = b3_director_find_ws(director, placement.ws_id);
+      if (ws == NULL) {
+        /** Create the workspace on the monitor of the window without switching to it */
+        ws = b3_wsman_add(b3_monitor_get_wsman(monitor), placement.ws_id);
+        ws_created = 1;
       }
     }
   }
 
+  error = 1;
+  if (ws) {
+    error = b3_ws_add_win(ws, win);
+  }
+
   if (!error) {
+    cc_array_iter_init(&iter, deferred_rule_arr);
+    while (cc_array_iter_next(&iter, (void*) &rule) != CC_ITER_END) {
+      b3_rule_exec(rule, director, win);
+    }
+
 		b3_director_arrange_wins(director);
+
+    if (ws_created) {
+      b3_director_request_repaint(director, monitor, B3_BAR_DIRTY_WS_ARR);
+    }
   }
 
-	ReleaseMutex(director->global_mutex);
+  b3_director_commit_transaction(director);
+
+  cc_array_destroy(deferred_rule_arr);
+  cc_array_destroy(matched_rule_arr);
+  b3_rule_set_release(rule_set);
+  if (launch) {
+    b3_launch_free(launch);
+  }
 
 	return error;
 }
 
+int
+b3_director_dump_rule_profile(b3_director_t *director)
+{
+  int error;
+  b3_rule_set_t *rule_set;
+
+	WaitForSingleObject(director->global_mutex, INFINITE);
+  rule_set = b3_rule_set_acquire(director->rule_set);
+	ReleaseMutex(director->global_mutex);
+
+  error = b3_rule_set_dump_profile(rule_set);
+
+  b3_rule_set_release(rule_set);
+
+  return error;
+}
+
+b3_win_t *
+b3_director_copy_focused_win(b3_director_t *director)
+{
+  b3_win_t *focused_win;
+
+	WaitForSingleObject(director->global_mutex, INFINITE);
+
+  focused_win = NULL;
+  if (director->focused_monitor) {
+    focused_win = b3_monitor_get_focused_win(director->focused_monitor);
+  }
+
+  if (focused_win) {
+    focused_win = b3_win_copy(focused_win);
+  }
+
+	ReleaseMutex(director->global_mutex);
+
+  return focused_win;
+}
+
 int
 b3_director_remove_win(b3_director_t *director, b3_win_t *win)
 {
@@ -435,10 +887,16 @@ b3_director_arrange_wins(b3_director_t *director)
 	WaitForSingleObject(director->global_mutex, INFINITE);
 
 	error = 0;
-	cc_array_iter_init(&iter, director->monitor_arr);
-    while (!error && cc_array_iter_next(&iter, (void*) &monitor) != CC_ITER_END) {
-		error = b3_monitor_arrange_wins(monitor);
-    }
+	if (director->transaction_depth > 0) {
+		director->arrange_pending = 1;
+		director->wintable_stale = 1;
+	} else {
+		cc_array_iter_init(&iter, director->monitor_arr);
+		while (!error && cc_array_iter_next(&iter, (void*) &monitor) != CC_ITER_END) {
+			error = b3_monitor_arrange_wins(monitor);
+		}
+		b3_director_update_wintable(director);
+	}
 
     ReleaseMutex(director->global_mutex);
 
@@ -491,6 +949,80 @@ b3_director_set_active_win(b3_director_t *director, b3_win_t *win)
 	return ret;
 }
 
+int
+b3_director_set_urgent_win(b3_director_t *director, b3_win_t *win)
+{
+	CC_ArrayIter iter;
+	b3_monitor_t *monitor;
+	b3_ws_t *ws;
+	int ret;
+
+	WaitForSingleObject(director->global_mutex, INFINITE);
+
+	ws = NULL;
+	cc_array_iter_init(&iter, director->monitor_arr);
+	while (ws == NULL && cc_array_iter_next(&iter, (void*) &monitor) != CC_ITER_END) {
+		ws = b3_monitor_find_win(monitor, win);
+	}
+
+	ret = 1;
+	if (ws) {
+		ret = 0;
+
+		/**
+		 * The focused workspace of a monitor is visible anyway
+		 */
+		if (ws != b3_monitor_get_focused_ws(monitor) && !b3_ws_is_urgent(ws)) {
+			wbk_logger_log(&logger, INFO, "Workspace %s demands attention\n", b3_ws_get_name(ws));
+			b3_ws_set_urgent(ws, 1);
+			b3_director_request_repaint(director, monitor, B3_BAR_DIRTY_URGENT);
+		}
+	}
+
+	ReleaseMutex(director->global_mutex);
+
+	return ret;
+}
+
+int
+b3_director_focus_win(b3_director_t *director, b3_win_t *win)
+{
+	CC_ArrayIter iter;
+	b3_monitor_t *monitor;
+	b3_ws_t *ws;
+	b3_win_t *found_win;
+	int ret;
+
+	WaitForSingleObject(director->global_mutex, INFINITE);
+
+	ws = NULL;
+	cc_array_iter_init(&iter, director->monitor_arr);
+	while (ws == NULL && cc_array_iter_next(&iter, (void*) &monitor) != CC_ITER_END) {
+		ws = b3_monitor_find_win(monitor, win);
+	}
+
+	ret = 1;
+	if (ws && ws == b3_monitor_get_focused_ws(monitor)) {
+		found_win = b3_ws_contains_win(ws, win);
+		if (found_win) {
+			ret = 0;
+
+			b3_ws_set_focused_win(ws, found_win);
+			if (monitor != director->focused_monitor) {
+				b3_director_set_focused_monitor(director, monitor);
+				b3_director_request_repaint(director, NULL, 0);
+			}
+
+			director->ignore_set_foucsed_win = 1;
+			b3_director_w32_set_active_window(b3_win_get_window_handler(found_win), 0);
+		}
+	}
+
+	ReleaseMutex(director->global_mutex);
+
+	return ret;
+}
+
 int
 b3_director_active_win_toggle_floating(b3_director_t *director)
 {
@@ -508,6 +1040,7 @@ b3_director_active_win_toggle_floating(b3_director_t *director)
 		if (!toggle_failed) {
 			wbk_logger_log(&logger, INFO, "Toggled floating on focused window.\n");
 			b3_monitor_arrange_wins(director->focused_monitor);
+			b3_director_update_wintable(director);
 		} else {
 			wbk_logger_log(&logger, SEVERE, "Unable to toggle floating on focused window.\n");
         }
@@ -579,7 +1112,8 @@ b3_director_move_active_win_to_ws(b3_director_t *director, const char *ws_id)
     	wbk_logger_log(&logger, WARNING, "Moving window to workspace %s - failed\n", ws_id);
     }
 
-    b3_director_repaint_all();
+    /** The workspace may have been created on or removed from any monitor */
+    b3_director_request_repaint(director, NULL, B3_BAR_DIRTY_WS_ARR);
 
 	ReleaseMutex(director->global_mutex);
 
@@ -692,7 +1226,7 @@ b3_director_toggle_active_win_fullscreen(b3_director_t *director)
 		wbk_logger_log(&logger, INFO, "No focused window available to toggle fullscreen.\n");
     }
 
-    b3_director_repaint_all();
+    b3_director_request_repaint(director, director->focused_monitor, B3_BAR_DIRTY_VISIBILITY);
 
 	ReleaseMutex(director->global_mutex);
 
@@ -916,7 +1450,7 @@ b3_director_remove_empty_ws(b3_director_t *director)
 		b3_monitor_remove_empty_ws(monitor);
 	}
 
-  b3_director_repaint_all();
+  b3_director_request_repaint(director, NULL, B3_BAR_DIRTY_WS_ARR);
 
 	ReleaseMutex(director->global_mutex);
 
@@ -927,42 +1461,21 @@ int
 b3_director_move_win_to_ws(b3_director_t *director, b3_win_t *win, const char *ws_id)
 {
   int error;
-  char found;
-  CC_ArrayIter iter;
-  b3_monitor_t *monitor;
-  b3_ws_t *focused_ws;
   b3_ws_t *ws;
 
   error = 0;
 
-  WaitForSingleObject(director->global_mutex, INFINITE);
-
-  if (!error) {
-    focused_ws = b3_monitor_get_focused_ws(b3_director_get_focused_monitor(director));
-
-    found = 0;
-    cc_array_iter_init(&iter, director->monitor_arr);
-    while (!found && cc_array_iter_next(&iter, (void*) &monitor) != CC_ITER_END) {
-      ws = b3_monitor_contains_ws(monitor, ws_id);
-      if (ws) {
-        found = 1;
-      }
-    }
+  b3_director_begin_transaction(director);
 
-    if (!found) {
-      error = b3_director_switch_to_ws(director, ws_id);
+  ws = b3_director_find_ws(director, ws_id);
+  if (ws == NULL) {
+    /** Create the workspace on the focused monitor without switching to it */
+    ws = b3_wsman_add(b3_monitor_get_wsman(b3_director_get_focused_monitor(director)), ws_id);
+    b3_director_request_repaint(director, b3_director_get_focused_monitor(director), B3_BAR_DIRTY_WS_ARR);
+  }
 
-      if (!error) {
-        found = 0;
-        cc_array_iter_init(&iter, director->monitor_arr);
-        while (!found && cc_array_iter_next(&iter, (void*) &monitor) != CC_ITER_END) {
-          ws = b3_monitor_contains_ws(monitor, ws_id);
-          if (ws) {
-            found = 1;
-          }
-        }
-      }
-    }
+  if (ws == NULL) {
+    error = 1;
   }
 
   if (!error) {
@@ -974,9 +1487,7 @@ b3_director_move_win_to_ws(b3_director_t *director, b3_win_t *win, const char *w
     b3_director_arrange_wins(director);
   }
 
-  b3_director_switch_to_ws(director, b3_ws_get_name(focused_ws));
-
-	ReleaseMutex(director->global_mutex);
+  b3_director_commit_transaction(director);
 
   return error;
 }
@@ -1020,7 +1531,7 @@ b3_director_create_ws_switcher(b3_director_t *director)
 b3_win_t *
 b3_director_get_win_at_pos(b3_director_t *director, POINT *position)
 {
-
+	return director->b3_director_get_win_at_pos(director, position);
 }
 
 int
@@ -1080,28 +1591,84 @@ b3_director_w32_set_active_window(HWND window_handler, char generate_lag)
 	return error;
 }
 
-DWORD WINAPI
-b3_director_repaint_all_threaded(_In_ LPVOID param)
+int
+b3_director_request_repaint(b3_director_t *director, b3_monitor_t *monitor, LONG dirty)
+{
+	CC_ArrayIter iter;
+	b3_monitor_t *monitor_iter;
+
+	if (dirty) {
+		if (monitor) {
+			b3_bar_set_dirty(b3_monitor_get_bar(monitor), dirty);
+		} else {
+			cc_array_iter_init(&iter, director->monitor_arr);
+			while (cc_array_iter_next(&iter, (void*) &monitor_iter) != CC_ITER_END) {
+				b3_bar_set_dirty(b3_monitor_get_bar(monitor_iter), dirty);
+			}
+		}
+	}
+
+	if (director->transaction_depth > 0) {
+		director->repaint_pending = 1;
+	} else {
+		b3_director_update_bars(director);
+	}
+
+	return 0;
+}
+
+int
+b3_director_update_wintable(b3_director_t *director)
 {
-	SendMessage(HWND_BROADCAST, WM_NCPAINT, (WPARAM) NULL, (LPARAM) NULL);
+	CC_ArrayIter iter;
+	b3_monitor_t *monitor;
+	b3_ws_t *ws;
+
+	b3_wintable_clear(director->wintable);
+
+	cc_array_iter_init(&iter, director->monitor_arr);
+	while (cc_array_iter_next(&iter, (void*) &monitor) != CC_ITER_END) {
+		ws = b3_monitor_get_focused_ws(monitor);
+		if (ws) {
+			b3_ws_fill_wintable(ws, director->wintable);
+		}
+	}
+
+	director->wintable_stale = 0;
+
 	return 0;
 }
 
 int
-b3_director_repaint_all(void)
+b3_director_update_bars(b3_director_t *director)
 {
-	HANDLE thread_handler;
+	CC_ArrayIter iter;
+	b3_monitor_t *monitor;
 
-	thread_handler = CreateThread(NULL,
-					 0,
-					 b3_director_repaint_all_threaded,
-					 NULL,
-					 0,
-					 NULL);
+	cc_array_iter_init(&iter, director->monitor_arr);
+	while (cc_array_iter_next(&iter, (void*) &monitor) != CC_ITER_END) {
+		b3_bar_update(b3_monitor_get_bar(monitor));
+	}
 
 	return 0;
 }
 
+b3_ws_t *
+b3_director_find_ws(b3_director_t *director, const char *ws_id)
+{
+	CC_ArrayIter iter;
+	b3_monitor_t *monitor;
+	b3_ws_t *ws;
+
+	ws = NULL;
+	cc_array_iter_init(&iter, director->monitor_arr);
+	while (ws == NULL && cc_array_iter_next(&iter, (void*) &monitor) != CC_ITER_END) {
+		ws = b3_monitor_contains_ws(monitor, ws_id);
+	}
+
+	return ws;
+}
+
 int
 b3_director_free_impl(b3_director_t *director)
 {
@@ -1112,6 +1679,18 @@ b3_director_free_impl(b3_director_t *director)
 
 	b3_director_free_monitor_arr(director);
 
+	b3_director_free_rule_arr(director);
+
+	if (director->launchman) {
+		b3_launchman_free(director->launchman);
+		director->launchman = NULL;
+	}
+
+	if (director->wintable) {
+		b3_wintable_free(director->wintable);
+		director->wintable = NULL;
+	}
+
 	director->monitor_factory = NULL;
 
 	free(director);
@@ -1126,11 +1705,19 @@ b3_director_get_win_at_pos_impl(b3_director_t *director, POINT *position)
     CC_ArrayIter monitor_iter;
 	b3_monitor_t *monitor;
 
+	WaitForSingleObject(director->global_mutex, INFINITE);
+
     win_at_pos = NULL;
-	cc_array_iter_init(&monitor_iter, director->monitor_arr);
-	while (win_at_pos == NULL && cc_array_iter_next(&monitor_iter, (void *) &monitor) != CC_ITER_END) {
-        win_at_pos = b3_monitor_get_win_at_pos(monitor, position);
+	if (!director->wintable_stale) {
+		win_at_pos = b3_wintable_get_win_at_pos(director->wintable, position);
+	} else {
+		cc_array_iter_init(&monitor_iter, director->monitor_arr);
+		while (win_at_pos == NULL && cc_array_iter_next(&monitor_iter, (void *) &monitor) != CC_ITER_END) {
+			win_at_pos = b3_monitor_get_win_at_pos(monitor, position);
+		}
 	}
 
+	ReleaseMutex(director->global_mutex);
+
     return win_at_pos;
 }
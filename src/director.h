@@ -37,6 +37,9 @@
 #include "monitor_factory.h"
 #include "win.h"
 #include "director_ws_switcher.h"
+#include "launchman.h"
+#include "status.h"
+#include "wintable.h"
 
 typedef struct b3_director_s  b3_director_t;
 
@@ -72,6 +75,64 @@ struct b3_director_s
 	 * CC_Array of b3_rule_t *
 	 */
 	CC_Array *rule_arr;
+
+	/**
+	 * Immutable snapshot of rule_arr. It is replaced whenever a rule is added
+	 * and is used to evaluate the rules without holding global_mutex.
+	 */
+	struct b3_rule_set_s *rule_set;
+
+	/**
+	 * Depth of the nested transactions of the thread holding global_mutex (see
+	 * b3_director_begin_transaction()).
+	 */
+	int transaction_depth;
+
+	/**
+	 * Non-0 if arranging the windows was requested during the current
+	 * transaction.
+	 */
+	char arrange_pending;
+
+	/**
+	 * Non-0 if repainting was requested during the current transaction.
+	 */
+	char repaint_pending;
+
+	/**
+	 * The windows shown on the focused workspaces of all monitors, as they were
+	 * arranged last. Resolves b3_director_get_win_at_pos().
+	 */
+	b3_wintable_t *wintable;
+
+	/**
+	 * Non-0 if the windows changed since wintable was filled, the tree is
+	 * searched instead then.
+	 */
+	char wintable_stale;
+
+	/**
+	 * Called by b3_director_reload(). Can be NULL.
+	 */
+	int (*reload_handler)(void *data);
+	void *reload_data;
+
+	/**
+	 * Called by b3_director_switch_mode(). Can be NULL.
+	 */
+	int (*mode_handler)(void *data, const char *mode_name);
+	void *mode_data;
+
+	/**
+	 * Places the first window of a launched process. Can be NULL.
+	 */
+	b3_launchman_t *launchman;
+
+	/**
+	 * The status shown on every bar. Can be NULL. It will not be freed by the
+	 * director.
+	 */
+	b3_status_t *status;
 };
 
 /**
@@ -109,6 +170,28 @@ b3_director_get_monitor_arr(b3_director_t *director);
 extern b3_monitor_t *
 b3_director_get_focused_monitor(b3_director_t *director);
 
+/**
+ * @return The launch manager of the director or NULL if it could not be
+ * created. Do not free it!
+ */
+extern b3_launchman_t *
+b3_director_get_launchman(b3_director_t *director);
+
+/**
+ * Shows the status on the bars of all monitors, also on monitors added later.
+ *
+ * @param status Can be NULL. It will not be freed by the director.
+ */
+extern int
+b3_director_set_status(b3_director_t *director, b3_status_t *status);
+
+/**
+ * Lets the bars draw the changed status. Meant as the update handler of the
+ * status.
+ */
+extern int
+b3_director_update_status(b3_director_t *director);
+
 extern int
 b3_director_set_focused_monitor_by_name(b3_director_t *director, const char *monitor_name);
 
@@ -118,6 +201,24 @@ b3_director_set_focused_monitor_by_name(b3_director_t *director, const char *mon
 extern int
 b3_director_switch_to_ws(b3_director_t *director, const char *ws_id);
 
+/**
+ * @brief Starts a transaction by taking the global mutex. Until the matching
+ * b3_director_commit_transaction(), arranging the windows and repainting are
+ * only recorded. Transactions can be nested.
+ * @return Non-0 if the transaction could not be started.
+ */
+extern int
+b3_director_begin_transaction(b3_director_t *director);
+
+/**
+ * @brief Ends a transaction. The outermost one arranges the windows and
+ * repaints once if this was requested in between, then releases the global
+ * mutex.
+ * @return Non-0 if arranging the windows failed.
+ */
+extern int
+b3_director_commit_transaction(b3_director_t *director);
+
 typedef struct b3_rule_s b3_rule_t;
 
 /**
@@ -128,12 +229,81 @@ extern int
 b3_director_add_rule(b3_director_t *director, b3_rule_t *rule);
 
 /**
+ * @brief Replaces all rules by the ones of rule_arr, e.g. on reloading the
+ * configuration. Rules that equal a current rule (see b3_rule_equals()) are
+ * not replaced, so they keep their compiled patterns and counters. Windows
+ * are not touched.
+ * @param rule_arr Array of b3_rule_t *. The rules will be freed by the
+ * director. Do not free them by yourself! The array itself is not freed.
+ * @return 0 if replaced. Non-0 otherwise, in which case the current rules are
+ * kept.
+ */
+extern int
+b3_director_replace_rules(b3_director_t *director, CC_Array *rule_arr);
+
+/**
+ * @brief Sets the handler that reloads the configuration.
+ * @param data Passed to the handler. It will not be freed by the director!
+ */
+extern int
+b3_director_set_reload_handler(b3_director_t *director, int (*reload_handler)(void *data), void *data);
+
+/**
+ * @brief Reloads the configuration by calling the reload handler.
+ * @return Non-0 if there is no reload handler or reloading failed.
+ */
+extern int
+b3_director_reload(b3_director_t *director);
+
+/**
+ * @brief Sets the handler that switches the binding mode. Set it before key
+ * commands are executed, b3_director_switch_mode() reads it without locking.
+ * @param data Passed to the handler. It will not be freed by the director!
+ */
+extern int
+b3_director_set_mode_handler(b3_director_t *director,
+							 int (*mode_handler)(void *data, const char *mode_name),
+							 void *data);
+
+/**
+ * @brief Switches the binding mode by calling the mode handler. It is called
+ * from the keyboard path, so it does not take the global mutex.
+ * @return Non-0 if there is no mode handler or the mode does not exist.
+ */
+extern int
+b3_director_switch_mode(b3_director_t *director, const char *mode_name);
+
+/**
+ * @brief Adds a window and applies all matching rules to it.
+ *
+ * The rules are evaluated against a snapshot of the rule set and the cached
+ * window attributes without holding the global mutex. The mutex is only held
+ * while adding the window and executing the actions of the matching rules.
+ *
+ * The target workspace and the floating state are decided by the rules before
+ * the window is added, so it is arranged and placed exactly once.
+ *
  * @param win The object will be freed by the director.
  * @return 0 if added. Non-0 otherwise.
  */
 extern int
 b3_director_add_win(b3_director_t *director, const char *monitor_name, b3_win_t *win);
 
+/**
+ * @brief Logs the evaluation counters of all rules, the most expensive rule
+ * first. The rules are not locked while their counters are read.
+ * @return 0 if dumped. Non-0 otherwise.
+ */
+extern int
+b3_director_dump_rule_profile(b3_director_t *director);
+
+/**
+ * @return A copy of the focused window of the focused monitor or NULL if there
+ * is none. Free it by yourself!
+ */
+extern b3_win_t *
+b3_director_copy_focused_win(b3_director_t *director);
+
 /**
  * @param win The object will not be freed. Free it by yourself!
  * @return 0 if removed. Non-0 otherwise.
@@ -159,6 +329,30 @@ b3_director_arrange_wins(b3_director_t *director);
 extern int
 b3_director_set_active_win(b3_director_t *director, b3_win_t *win);
 
+/**
+ * Marks the workspace of a window demanding attention as urgent, unless it is
+ * the focused workspace of its monitor. Only the bar of that monitor is
+ * updated.
+ *
+ * @param win The object will not be stored to the director and will will not be
+ * freed. Free it by yourself!
+ * @return 0 if the window is managed. Non-0 otherwise.
+ */
+extern int
+b3_director_set_urgent_win(b3_director_t *director, b3_win_t *win);
+
+/**
+ * Focuses a window on a focused workspace of any monitor and activates it
+ * through the WIN32 API. Its monitor becomes the focused monitor.
+ *
+ * @param win The object will not be stored to the director and will will not be
+ * freed. Free it by yourself!
+ * @return 0 if it was focused. Non-0 if the window is not managed or not
+ * visible.
+ */
+extern int
+b3_director_focus_win(b3_director_t *director, b3_win_t *win);
+
 /**
  * @return 0 if it was possible to toggle the window. Non-0 otherwise (e.g. when it is not managed).
  */
@@ -260,7 +454,8 @@ b3_director_create_ws_switcher(b3_director_t *director);
 
 /**
  * @return Returns the window at position. If no window can be found at the
- * given position, then NULL is returned.
+ * given position, then NULL is returned. The window is owned by the director,
+ * hold a transaction while using it.
  */
 extern b3_win_t *
 b3_director_get_win_at_pos(b3_director_t *director, POINT *position);
@@ -46,6 +46,18 @@ b3_floating_action_free_impl(b3_action_t *action);
 static int
 b3_floating_action_exec_impl(b3_action_t *action, b3_director_t *director, b3_win_t *win);
 
+/**
+ * Implementation of b3_action_prepare().
+ */
+static int
+b3_floating_action_prepare_impl(b3_action_t *action, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement);
+
+/**
+ * Implementation of b3_action_equals().
+ */
+static int
+b3_floating_action_equals_impl(b3_action_t *action, b3_action_t *other);
+
 b3_floating_action_t *
 b3_floating_action_new(void)
 {
@@ -61,9 +73,13 @@ b3_floating_action_new(void)
 
     floating_action->super_action_free = floating_action->action.action_free;
     floating_action->super_action_exec = floating_action->action.action_exec;
+    floating_action->super_action_prepare = floating_action->action.action_prepare;
+    floating_action->super_action_equals = floating_action->action.action_equals;
 
     floating_action->action.action_free = b3_floating_action_free_impl;
     floating_action->action.action_exec = b3_floating_action_exec_impl;
+    floating_action->action.action_prepare = b3_floating_action_prepare_impl;
+    floating_action->action.action_equals = b3_floating_action_equals_impl;
   }
 
   return floating_action;
@@ -106,3 +122,24 @@ b3_floating_action_exec_impl(b3_action_t *action, b3_director_t *director, b3_wi
 
   return error;
 }
+
+int
+b3_floating_action_prepare_impl(b3_action_t *action, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement)
+{
+  /** The window is not yet managed, so "floating enable" cannot toggle */
+  placement->floating = 1;
+
+  return 0;
+}
+
+int
+b3_floating_action_equals_impl(b3_action_t *action, b3_action_t *other)
+{
+  return other->action_equals == action->action_equals;
+}
+
+int
+b3_floating_action_instance_of(const b3_action_t *action)
+{
+  return action->action_free == b3_floating_action_free_impl;
+}
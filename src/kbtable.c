@@ -0,0 +1,196 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the key binding table class implementation
+ */
+
+#include "kbtable.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <w32bindkeys/logger.h>
+
+/**
+ * Multiplier of the Fibonacci hashing, 2^64 divided by the golden ratio
+ */
+#define B3_KBTABLE_HASH_MULTIPLIER 11400714819323198485ULL
+
+static wbk_logger_t logger = { "kbtable" };
+
+/**
+ * @return The index of the entry holding key or of the empty entry where key
+ * belongs.
+ */
+static int
+b3_kbtable_probe(const b3_kbtable_t *kbtable, unsigned long long key);
+
+b3_kbtable_t *
+b3_kbtable_new(wbk_kbman_t *kbman)
+{
+  int error;
+  b3_kbtable_t *kbtable;
+  unsigned long long key;
+  int index;
+  int i;
+
+  error = 0;
+  kbtable = NULL;
+
+  if (!error) {
+    kbtable = malloc(sizeof(b3_kbtable_t));
+    if (kbtable == NULL) {
+      wbk_logger_log(&logger, SEVERE, "Could not allocate memory.\n");
+      error = 1;
+    }
+  }
+
+  if (!error) {
+    kbtable->kbman = kbman;
+    kbtable->key_len = 0;
+
+    kbtable->entry_arr_len = 16;
+    while (kbtable->entry_arr_len < 2 * kbman->kc_arr_len) {
+      kbtable->entry_arr_len *= 2;
+    }
+
+    kbtable->entry_arr = malloc(sizeof(b3_kbtable_entry_t) * kbtable->entry_arr_len);
+    if (kbtable->entry_arr == NULL) {
+      wbk_logger_log(&logger, SEVERE, "Could not allocate memory.\n");
+      free(kbtable);
+      kbtable = NULL;
+      error = 2;
+    }
+  }
+
+  if (!error) {
+    memset(kbtable->entry_arr, 0, sizeof(b3_kbtable_entry_t) * kbtable->entry_arr_len);
+
+    for (i = 0; i < kbman->kc_arr_len; i++) {
+      if (b3_kbtable_key(wbk_kc_get_binding(kbman->kc_arr[i]), &key)) {
+        wbk_logger_log(&logger, WARNING, "Key binding %d holds more than one key, it is ignored.\n", i + 1);
+      } else {
+        index = b3_kbtable_probe(kbtable, key);
+        if (kbtable->entry_arr[index].kc == NULL) {
+          kbtable->entry_arr[index].key = key;
+          kbtable->entry_arr[index].kc = kbman->kc_arr[i];
+          kbtable->key_len++;
+        }
+      }
+    }
+  }
+
+  return kbtable;
+}
+
+int
+b3_kbtable_free(b3_kbtable_t *kbtable)
+{
+  free(kbtable->entry_arr);
+  kbtable->entry_arr = NULL;
+
+  wbk_kbman_free(kbtable->kbman);
+  kbtable->kbman = NULL;
+
+  free(kbtable);
+
+  return 0;
+}
+
+int
+b3_kbtable_key(const wbk_b_t *b, unsigned long long *key)
+{
+  unsigned long long modifier_mask;
+  int key_code;
+  int i;
+
+  modifier_mask = 0;
+  for (i = 0; i < WBK_B_MODIFER_MAP_LEN; i++) {
+    if (b->modifier_map[i] != NOT_A_MODIFIER) {
+      modifier_mask |= 1ULL << i;
+    }
+  }
+
+  key_code = B3_KBTABLE_NO_KEY;
+  for (i = 0; i < WBK_B_KEY_MAP_LEN; i++) {
+    if (b->key_map[i]) {
+      if (key_code != B3_KBTABLE_NO_KEY) {
+        return 1;
+      }
+      key_code = i;
+    }
+  }
+
+  /** The key code needs 9 bits, see B3_KBTABLE_NO_KEY */
+  *key = (modifier_mask << 9) | key_code;
+
+  return 0;
+}
+
+wbk_kc_t *
+b3_kbtable_find(const b3_kbtable_t *kbtable, const wbk_b_t *b)
+{
+  unsigned long long key;
+
+  if (b3_kbtable_key(b, &key)) {
+    return NULL;
+  }
+
+  return kbtable->entry_arr[b3_kbtable_probe(kbtable, key)].kc;
+}
+
+int
+b3_kbtable_exec(const b3_kbtable_t *kbtable, const wbk_b_t *b)
+{
+  wbk_kc_t *kc;
+
+  kc = b3_kbtable_find(kbtable, b);
+  if (kc == NULL) {
+    return 1;
+  }
+
+  wbk_kc_exec(kc);
+
+  return 0;
+}
+
+int
+b3_kbtable_probe(const b3_kbtable_t *kbtable, unsigned long long key)
+{
+  int mask;
+  int index;
+
+  mask = kbtable->entry_arr_len - 1;
+  index = (int) ((key * B3_KBTABLE_HASH_MULTIPLIER) >> 32) & mask;
+
+  /** The table is at most half full, so there always is an empty entry */
+  while (kbtable->entry_arr[index].kc
+         && kbtable->entry_arr[index].key != key) {
+    index = (index + 1) & mask;
+  }
+
+  return index;
+}
@@ -0,0 +1,118 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the key binding table class definition
+ *
+ * The table dispatches a pressed combination to its key command in constant
+ * time. Every binding is reduced to a canonical key made of a bitmask of its
+ * modifiers and its key code. The keys are stored in an open addressing hash
+ * table with linear probing, which is at most half full.
+ *
+ * If a combination is bound more than once, then the first key command takes
+ * effect, just like with wbk_kbman_exec().
+ */
+
+#ifndef B3_KBTABLE_H
+#define B3_KBTABLE_H
+
+#include <w32bindkeys/b.h>
+#include <w32bindkeys/kc.h>
+#include <w32bindkeys/kbman.h>
+
+/**
+ * The key code of a binding without a key, e.g. Mod4+Return
+ */
+#define B3_KBTABLE_NO_KEY WBK_B_KEY_MAP_LEN
+
+typedef struct b3_kbtable_entry_s
+{
+  /**
+   * Modifier bitmask shifted above the key code. See b3_kbtable_key().
+   */
+  unsigned long long key;
+
+  /**
+   * NULL if the entry is empty
+   */
+  wbk_kc_t *kc;
+} b3_kbtable_entry_t;
+
+typedef struct b3_kbtable_s
+{
+  /**
+   * The key commands of the table
+   */
+  wbk_kbman_t *kbman;
+
+  /**
+   * Power of two
+   */
+  int entry_arr_len;
+
+  b3_kbtable_entry_t *entry_arr;
+
+  /**
+   * Number of distinct combinations in the table
+   */
+  int key_len;
+} b3_kbtable_t;
+
+/**
+ * @brief Creates a new key binding table.
+ * @param kbman The key commands. They will be freed by the table!
+ * @return A new key binding table or NULL if allocation failed.
+ */
+extern b3_kbtable_t *
+b3_kbtable_new(wbk_kbman_t *kbman);
+
+extern int
+b3_kbtable_free(b3_kbtable_t *kbtable);
+
+/**
+ * @brief Reduces a binding to its canonical key.
+ * @param key Set to the canonical key.
+ * @return Non-0 if the binding holds more than one key. Such a binding has no
+ * canonical key and is never dispatched.
+ */
+extern int
+b3_kbtable_key(const wbk_b_t *b, unsigned long long *key);
+
+/**
+ * @return The key command bound to the combination b or NULL if it is not
+ * bound. Do not free it!
+ */
+extern wbk_kc_t *
+b3_kbtable_find(const b3_kbtable_t *kbtable, const wbk_b_t *b);
+
+/**
+ * @brief Executes the key command bound to the combination b.
+ * @return Non-0 if the combination is not bound.
+ */
+extern int
+b3_kbtable_exec(const b3_kbtable_t *kbtable, const wbk_b_t *b);
+
+#endif // B3_KBTABLE_H
@@ -58,15 +58,14 @@ b3_kc_director_free_impl(wbk_kc_t *kc);
 /**
  * Implementation of wbk_kc_exec().
  *
- * @brief Execute the director command of a key binding director command
+ * @brief Execute the director command of a key binding director command. It
+ * runs on the calling thread, which is the worker of the key command queue
+ * (see kcqueue.h) and never the thread of the keyboard hook.
  * @return Non-0 if the execution failed
  */
 static int
 b3_kc_director_exec_impl(const wbk_kc_t *kc);
 
-static DWORD WINAPI
-b3_kc_director_exec_threaded(LPVOID param);
-
 static int
 b3_kc_director_exec_cw(const b3_kc_director_t *kc_director);
 
@@ -151,6 +150,15 @@ b3_kc_director_exec_sh(const b3_kc_director_t *kc_director);
 static int
 b3_kc_director_exec_sv(const b3_kc_director_t *kc_director);
 
+static int
+b3_kc_director_exec_drp(const b3_kc_director_t *kc_director);
+
+static int
+b3_kc_director_exec_rl(const b3_kc_director_t *kc_director);
+
+static int
+b3_kc_director_exec_sm(const b3_kc_director_t *kc_director);
+
 /**
  * Position the cursor in the middle of the monitor.
  */
@@ -214,6 +222,7 @@ b3_kc_director_clone_impl(const wbk_kc_t *kc)
 		case CHANGE_WORKSPACE:
 		case CHANGE_MONITOR:
 		case MOVE_ACTIVE_WINDOW_TO_WORKSPACE:
+		case SWITCH_MODE:
 			len = strlen((char *) other->data) + 1;
 			data_str = malloc(sizeof(char) * len);
 			memcpy(data_str, (char *) other->data, sizeof(char) * len);
@@ -233,6 +242,43 @@ b3_kc_director_clone_impl(const wbk_kc_t *kc)
 	return (wbk_kc_t *) kc_director;
 }
 
+int
+b3_kc_director_equals(const wbk_kc_t *kc, const wbk_kc_t *other)
+{
+	const b3_kc_director_t *kc_director;
+	const b3_kc_director_t *other_kc_director;
+	int equals;
+
+	kc_director = (const b3_kc_director_t *) kc;
+	other_kc_director = (const b3_kc_director_t *) other;
+
+	equals = 0;
+	if (b3_kc_director_instance_of(kc)
+		&& b3_kc_director_instance_of(other)
+		&& kc_director->kind == other_kc_director->kind
+		&& wbk_b_compare(wbk_kc_get_binding(kc), wbk_kc_get_binding(other)) == 0) {
+		switch (kc_director->kind) {
+		case CHANGE_WORKSPACE:
+		case CHANGE_MONITOR:
+		case MOVE_ACTIVE_WINDOW_TO_WORKSPACE:
+		case SWITCH_MODE:
+			equals = strcmp((char *) kc_director->data, (char *) other_kc_director->data) == 0;
+			break;
+
+		default:
+			equals = 1;
+		}
+	}
+
+	return equals;
+}
+
+int
+b3_kc_director_instance_of(const wbk_kc_t *kc)
+{
+	return kc->kc_exec == b3_kc_director_exec_impl;
+}
+
 int
 b3_kc_director_free_impl(wbk_kc_t *kc)
 {
@@ -263,6 +309,11 @@ b3_kc_director_free_impl(wbk_kc_t *kc)
 			kc_director->data = NULL;
 			break;
 
+		case SWITCH_MODE:
+			free(kc_director->data);
+			kc_director->data = NULL;
+			break;
+
 		case ACTIVE_WINDOW_TOGGLE_FLOATING:
 			kc_director->data = NULL;
 			break;
@@ -278,23 +329,11 @@ b3_kc_director_free_impl(wbk_kc_t *kc)
 
 int
 b3_kc_director_exec_impl(const wbk_kc_t *kc)
-{
-  CreateThread(NULL,
-               0,
-               b3_kc_director_exec_threaded,
-               (const LPVOID) kc,
-               0,
-               NULL);
-  return 0;
-}
-
-DWORD WINAPI
-b3_kc_director_exec_threaded(LPVOID param)
 {
   const b3_kc_director_t *kc_director;
 	int ret;
 
-  kc_director = (const b3_kc_director_t *) param;
+  kc_director = (const b3_kc_director_t *) kc;
 
 	WaitForSingleObject(kc_director->global_mutex, INFINITE);
 
@@ -418,6 +457,18 @@ b3_kc_director_exec_threaded(LPVOID param)
 
   case SPLIT_V:
     ret = b3_kc_director_exec_sv(kc_director);
+    break;
+
+  case DUMP_RULE_PROFILE:
+    ret = b3_kc_director_exec_drp(kc_director);
+    break;
+
+  case RELOAD:
+    ret = b3_kc_director_exec_rl(kc_director);
+    break;
+
+  case SWITCH_MODE:
+    ret = b3_kc_director_exec_sm(kc_director);
     break;
 
 	default:
@@ -843,6 +894,36 @@ b3_kc_director_exec_sv(const b3_kc_director_t *kc_director)
 	return error;
 }
 
+int
+b3_kc_director_exec_drp(const b3_kc_director_t *kc_director)
+{
+	int error;
+
+  error = b3_director_dump_rule_profile(kc_director->director);
+
+	return error;
+}
+
+int
+b3_kc_director_exec_rl(const b3_kc_director_t *kc_director)
+{
+	int error;
+
+  error = b3_director_reload(kc_director->director);
+
+	return error;
+}
+
+int
+b3_kc_director_exec_sm(const b3_kc_director_t *kc_director)
+{
+	int error;
+
+  error = b3_director_switch_mode(kc_director->director, kc_director->data);
+
+	return error;
+}
+
 int
 b3_kc_director_position_cursor(b3_monitor_t *monitor)
 {
@@ -66,7 +66,10 @@ typedef enum b3_kc_director_kind_e
 	MOVE_FOCUSED_WINDOW_TO_MONITOR_LEFT,
 	MOVE_FOCUSED_WINDOW_TO_MONITOR_RIGHT,
 	SPLIT_H,
-	SPLIT_V
+	SPLIT_V,
+	DUMP_RULE_PROFILE,
+	RELOAD,
+	SWITCH_MODE
 } b3_kc_director_kind_t;
 
 typedef struct b3_kc_director_s
@@ -89,6 +92,7 @@ typedef struct b3_kc_director_s
 	 * - CHANGE_MONITOR: will need a char * as the name of the target monitor
 	 * - MOVE_ACTIVE_WINDOW_TO_WORKSPACE: will need a char * as the name of the
 	 * target workspace
+	 * - SWITCH_MODE: will need a char * as the name of the target mode
 	 * - All others will need NULL
 	 */
 	void *data;
@@ -105,4 +109,18 @@ typedef struct b3_kc_director_s
 extern b3_kc_director_t *
 b3_kc_director_new(wbk_b_t *comb, b3_director_t *director, b3_kc_director_kind_t kind, void *data);
 
+/**
+ * @brief Compares two key commands.
+ * @return Non-0 if both key commands are key binding director commands with
+ * the same binding, kind and data. Otherwise 0.
+ */
+extern int
+b3_kc_director_equals(const wbk_kc_t *kc, const wbk_kc_t *other);
+
+/**
+ * @return Non-0 if kc is a key binding director command.
+ */
+extern int
+b3_kc_director_instance_of(const wbk_kc_t *kc);
+
 #endif // B3_KC_DIRECTOR_H
@@ -432,3 +432,44 @@ b3_kc_director_factory_create_sv(b3_kc_director_factory_t *kc_director_factory,
 	return sv;
 
 }
+
+b3_kc_director_t *
+b3_kc_director_factory_create_drp(b3_kc_director_factory_t *kc_director_factory,
+								  wbk_b_t *comb,
+								  b3_director_t *director)
+{
+	b3_kc_director_t *drp;
+
+	drp = b3_kc_director_new(comb, director, DUMP_RULE_PROFILE, NULL);
+
+	return drp;
+}
+
+b3_kc_director_t *
+b3_kc_director_factory_create_rl(b3_kc_director_factory_t *kc_director_factory,
+								 wbk_b_t *comb,
+								 b3_director_t *director)
+{
+	b3_kc_director_t *rl;
+
+	rl = b3_kc_director_new(comb, director, RELOAD, NULL);
+
+	return rl;
+}
+
+b3_kc_director_t *
+b3_kc_director_factory_create_sm(b3_kc_director_factory_t *kc_director_factory,
+								 wbk_b_t *comb,
+								 b3_director_t *director,
+								 const char *mode_name)
+{
+	b3_kc_director_t *sm;
+	char *data;
+
+	data = malloc(sizeof(char) * (strlen(mode_name) + 1));
+	strcpy(data, mode_name);
+
+	sm = b3_kc_director_new(comb, director, SWITCH_MODE, data);
+
+	return sm;
+}
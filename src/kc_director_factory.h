@@ -311,4 +311,33 @@ b3_kc_director_factory_create_sv(b3_kc_director_factory_t *kc_director_factory,
 								 wbk_b_t *comb,
 								 b3_director_t *director);
 
+/**
+ * @return A new key binding director command of the type DUMP_RULE_PROFILE.
+ * Free it by yourself!
+ */
+extern b3_kc_director_t *
+b3_kc_director_factory_create_drp(b3_kc_director_factory_t *kc_director_factory,
+								  wbk_b_t *comb,
+								  b3_director_t *director);
+
+/**
+ * @return A new key binding director command of the type RELOAD.
+ * Free it by yourself!
+ */
+extern b3_kc_director_t *
+b3_kc_director_factory_create_rl(b3_kc_director_factory_t *kc_director_factory,
+								 wbk_b_t *comb,
+								 b3_director_t *director);
+
+/**
+ * @param mode_name The name of the mode to switch to. The string is copied.
+ * @return A new key binding director command of the type SWITCH_MODE.
+ * Free it by yourself!
+ */
+extern b3_kc_director_t *
+b3_kc_director_factory_create_sm(b3_kc_director_factory_t *kc_director_factory,
+								 wbk_b_t *comb,
+								 b3_director_t *director,
+								 const char *mode_name);
+
 #endif // B3_KC_DIRECTOR_FACTORY_H
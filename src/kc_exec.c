@@ -38,16 +38,6 @@
 
 #include "ws.h"
 
-#define B3_KC_EXEC_MAX_ITERATIONS 60
-
-typedef struct wkb_kc_exec_comm_s
-{
-  DWORD process_id;
-  b3_director_t *director;
-  char *focused_ws_name;
-  int iterations;
-} wkb_kc_exec_comm_t;
-
 static wbk_logger_t logger =  { "kc_exec" };
 
 /**
@@ -83,13 +73,6 @@ b3_kc_exec_get_cmd_impl(const b3_kc_exec_t *kc_exec);
 static int
 b3_kc_exec_exec_impl(const wbk_kc_t *kc);
 
-static BOOL CALLBACK
-b3_kc_exec_enum_wins(_In_ HWND   window_handler,
-                     _In_ LPARAM param);
-
-static DWORD WINAPI
-b3_kbthread_exec(LPVOID param);
-
 b3_kc_exec_t *
 b3_kc_exec_new(wbk_b_t *comb, b3_director_t *director, b3_kc_exec_type_t type, char *cmd)
 {
@@ -154,6 +137,34 @@ b3_kc_exec_get_cmd(const b3_kc_exec_t *kc_sys)
 	return kc_sys->kc_exec_get_cmd(kc_sys);
 }
 
+int
+b3_kc_exec_equals(const wbk_kc_t *kc, const wbk_kc_t *other)
+{
+	const b3_kc_exec_t *kc_exec;
+	const b3_kc_exec_t *other_kc_exec;
+	int equals;
+
+	kc_exec = (const b3_kc_exec_t *) kc;
+	other_kc_exec = (const b3_kc_exec_t *) other;
+
+	equals = 0;
+	if (b3_kc_exec_instance_of(kc)
+		&& b3_kc_exec_instance_of(other)
+		&& kc_exec->type == other_kc_exec->type
+		&& strcmp(b3_kc_exec_get_cmd(kc_exec), b3_kc_exec_get_cmd(other_kc_exec)) == 0
+		&& wbk_b_compare(wbk_kc_get_binding(kc), wbk_kc_get_binding(other)) == 0) {
+		equals = 1;
+	}
+
+	return equals;
+}
+
+int
+b3_kc_exec_instance_of(const wbk_kc_t *kc)
+{
+	return kc->kc_exec == b3_kc_exec_exec_impl;
+}
+
 
 int
 b3_kc_exec_free_impl(wbk_kc_t *kc)
@@ -176,97 +187,15 @@ b3_kc_exec_get_cmd_impl(const b3_kc_exec_t *kc_exec)
 	return kc_exec->cmd;
 }
 
-BOOL CALLBACK
-b3_kc_exec_enum_wins(_In_ HWND   window_handler,
-                     _In_ LPARAM param)
-{
-  wkb_kc_exec_comm_t *kc_exec_comm;
-  DWORD process_id;
-  b3_win_t *win;
-
-  kc_exec_comm = (wkb_kc_exec_comm_t *) param;
-
-  GetWindowThreadProcessId(window_handler, &process_id);
-
-  if (kc_exec_comm->process_id == process_id) {
-    kc_exec_comm->iterations = B3_KC_EXEC_MAX_ITERATIONS;
-
-    win = b3_win_new(window_handler, 0);
-    b3_director_set_active_win(kc_exec_comm->director, win);
-    b3_director_move_active_win_to_ws(kc_exec_comm->director,
-                                      kc_exec_comm->focused_ws_name);
-  }
-
-  return TRUE;
-}
-
-DWORD WINAPI
-b3_kbthread_exec(LPVOID param)
-{
-  const b3_kc_exec_t *kc_exec;
-  b3_ws_t *focused_ws;
-  wkb_kc_exec_comm_t kc_exec_comm;
-	STARTUPINFOA startup_info;
-  PROCESS_INFORMATION process_info;
-
-	kc_exec = (const b3_kc_exec_t *) param;
-
-  if (kc_exec->type == ON_START_WS) {
-    /**
-     * Get the ws on which the process is started as soon as possible
-     */
-    focused_ws = b3_monitor_get_focused_ws(b3_director_get_focused_monitor(kc_exec->director));
-
-    kc_exec_comm.focused_ws_name = NULL;
-    if (focused_ws) {
-      kc_exec_comm.focused_ws_name = malloc(sizeof(char) * (strlen(b3_ws_get_name(focused_ws) + 1)));
-      if (kc_exec_comm.focused_ws_name) {
-        strcpy(kc_exec_comm.focused_ws_name, b3_ws_get_name(focused_ws));
-      } else {
-        kc_exec_comm.iterations = B3_KC_EXEC_MAX_ITERATIONS;
-      }
-    } else {
-      kc_exec_comm.iterations = B3_KC_EXEC_MAX_ITERATIONS;
-    }
-  }
-
-  CreateProcess(NULL,
-                kc_exec->cmd,
-                NULL,
-                NULL,
-                0,
-                NORMAL_PRIORITY_CLASS,
-                NULL,
-                NULL,
-                &startup_info,
-                &process_info);
-
-  if (kc_exec->type == ON_START_WS
-      && kc_exec_comm.focused_ws_name) {
-    kc_exec_comm.process_id = process_info.dwProcessId;
-    kc_exec_comm.director = kc_exec->director;
-
-    Sleep(250);
-
-    while (kc_exec_comm.iterations < B3_KC_EXEC_MAX_ITERATIONS) {
-      EnumWindows(b3_kc_exec_enum_wins, (LPARAM) &kc_exec_comm);
-      kc_exec_comm.iterations++;
-      Sleep(1000);
-    }
-
-    CloseHandle(process_info.hThread);
-    CloseHandle(process_info.hProcess);
-
-    free(kc_exec_comm.focused_ws_name);
-  }
-
-  return 0;
-}
-
 int
 b3_kc_exec_exec_impl(const wbk_kc_t *kc)
 {
   const b3_kc_exec_t *kc_exec;
+  b3_launchman_t *launchman;
+  b3_launch_t *launch;
+  b3_monitor_t *focused_monitor;
+  b3_ws_t *focused_ws;
+  int error;
 
   kc_exec = (const b3_kc_exec_t *) kc;
 
@@ -279,20 +208,34 @@ b3_kc_exec_exec_impl(const wbk_kc_t *kc)
 	binding = NULL;
 #endif
 
-	HANDLE thread_handler;
+  launch = NULL;
+  if (kc_exec->type == ON_START_WS) {
+    /**
+     * The first window of the process goes to the workspace and the monitor
+     * focused now, even if the focus moves on while the process starts.
+     */
+    focused_monitor = b3_director_get_focused_monitor(kc_exec->director);
+    focused_ws = focused_monitor ? b3_monitor_get_focused_ws(focused_monitor) : NULL;
+    if (focused_ws) {
+      launch = b3_launch_new(b3_ws_get_name(focused_ws),
+                             b3_monitor_get_monitor_name(focused_monitor),
+                             B3_LAUNCH_TIMEOUT);
+    }
+  }
+
+  error = 1;
+  launchman = b3_director_get_launchman(kc_exec->director);
+  if (launchman) {
+    error = b3_launchman_launch(launchman, kc_exec->cmd, launch);
+  } else if (launch) {
+    b3_launch_free(launch);
+  }
 
-	thread_handler = CreateThread(NULL,
-                                0,
-                                b3_kbthread_exec,
-                                (LPVOID) kc_exec,
-                                0,
-                                NULL);
-	if (thread_handler) {
+	if (!error) {
 		wbk_logger_log(&logger, INFO, "Exec: %s\n", kc_exec->cmd);
 	} else {
 		wbk_logger_log(&logger, SEVERE, "Exec failed: %s\n", kc_exec->cmd);
 	}
 
-	return 0;
+	return error;
 }
-
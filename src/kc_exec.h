@@ -76,4 +76,18 @@ b3_kc_exec_new(wbk_b_t *comb, b3_director_t *director, b3_kc_exec_type_t type, c
 extern const char *
 b3_kc_exec_get_cmd(const b3_kc_exec_t *kc_sys);
 
+/**
+ * @brief Compares two key commands.
+ * @return Non-0 if both key commands are key binding exec commands with the
+ * same binding, type and command. Otherwise 0.
+ */
+extern int
+b3_kc_exec_equals(const wbk_kc_t *kc, const wbk_kc_t *other);
+
+/**
+ * @return Non-0 if kc is a key binding exec command.
+ */
+extern int
+b3_kc_exec_instance_of(const wbk_kc_t *kc);
+
 #endif // B3_KC_EXEC_H
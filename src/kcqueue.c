@@ -0,0 +1,217 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the key command queue class implementation
+ */
+
+#include "kcqueue.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <w32bindkeys/logger.h>
+
+static wbk_logger_t logger = { "kcqueue" };
+
+static DWORD WINAPI
+b3_kcqueue_worker(LPVOID param);
+
+/**
+ * Pops all entries. They are executed unless the queue is stopped.
+ */
+static int
+b3_kcqueue_drain(b3_kcqueue_t *kcqueue);
+
+b3_kcqueue_t *
+b3_kcqueue_new(void)
+{
+  int error;
+  b3_kcqueue_t *kcqueue;
+
+  error = 0;
+
+  kcqueue = malloc(sizeof(b3_kcqueue_t));
+  if (kcqueue == NULL) {
+    error = 1;
+  }
+
+  if (!error) {
+    memset(kcqueue, 0, sizeof(b3_kcqueue_t));
+    b3_profile_init(&(kcqueue->wait_profile));
+    b3_profile_init(&(kcqueue->exec_profile));
+
+    kcqueue->event = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if (kcqueue->event == NULL) {
+      error = 2;
+    }
+  }
+
+  if (!error) {
+    kcqueue->thread = CreateThread(NULL,
+                                   0,
+                                   b3_kcqueue_worker,
+                                   (LPVOID) kcqueue,
+                                   0,
+                                   NULL);
+    if (kcqueue->thread == NULL) {
+      wbk_logger_log(&logger, SEVERE, "Could not start the worker\n");
+      error = 3;
+    }
+  }
+
+  if (error && kcqueue) {
+    if (kcqueue->event) {
+      CloseHandle(kcqueue->event);
+    }
+    free(kcqueue);
+    kcqueue = NULL;
+  }
+
+  return kcqueue;
+}
+
+int
+b3_kcqueue_free(b3_kcqueue_t *kcqueue)
+{
+  InterlockedExchange(&(kcqueue->stop), 1);
+  SetEvent(kcqueue->event);
+
+  WaitForSingleObject(kcqueue->thread, INFINITE);
+  CloseHandle(kcqueue->thread);
+  kcqueue->thread = NULL;
+
+  /**
+   * Release what was pushed after the worker stopped
+   */
+  b3_kcqueue_drain(kcqueue);
+
+  CloseHandle(kcqueue->event);
+  kcqueue->event = NULL;
+
+  free(kcqueue);
+
+  return 0;
+}
+
+int
+b3_kcqueue_push(b3_kcqueue_t *kcqueue, const wbk_kc_t *kc, volatile LONG *users)
+{
+  b3_kcqueue_entry_t *entry;
+  LONG tail;
+
+  tail = kcqueue->tail;
+  if (tail - InterlockedCompareExchange(&(kcqueue->head), 0, 0) >= B3_KCQUEUE_LEN) {
+    InterlockedIncrement(&(kcqueue->dropped_len));
+    return 1;
+  }
+
+  entry = &(kcqueue->entry_arr[tail & (B3_KCQUEUE_LEN - 1)]);
+  entry->kc = kc;
+  entry->users = users;
+  entry->pushed = b3_profile_start();
+
+  /**
+   * Publishes the entry. The Interlocked operation is a full barrier, so the
+   * worker never sees the new tail before the entry.
+   */
+  InterlockedExchange(&(kcqueue->tail), tail + 1);
+  SetEvent(kcqueue->event);
+
+  return 0;
+}
+
+int
+b3_kcqueue_log_latency(b3_kcqueue_t *kcqueue)
+{
+  b3_profile_t wait_profile;
+  b3_profile_t exec_profile;
+
+  b3_profile_copy(&(kcqueue->wait_profile), &wait_profile);
+  b3_profile_copy(&(kcqueue->exec_profile), &exec_profile);
+
+  if (wait_profile.evaluations > 0 && exec_profile.evaluations > 0) {
+    wbk_logger_log(&logger, INFO,
+                   "%lld key commands, queued %.3f ms on average (at most %.3f ms), executed in %.3f ms on average (at most %.3f ms), %lld failed, %ld dropped\n",
+                   wait_profile.evaluations,
+                   wait_profile.total_ns / (double) wait_profile.evaluations / 1000000.0,
+                   wait_profile.max_ns / 1000000.0,
+                   exec_profile.total_ns / (double) exec_profile.evaluations / 1000000.0,
+                   exec_profile.max_ns / 1000000.0,
+                   exec_profile.evaluations - exec_profile.matches,
+                   InterlockedCompareExchange(&(kcqueue->dropped_len), 0, 0));
+  }
+
+  return 0;
+}
+
+DWORD WINAPI
+b3_kcqueue_worker(LPVOID param)
+{
+  b3_kcqueue_t *kcqueue;
+
+  kcqueue = (b3_kcqueue_t *) param;
+
+  while (!InterlockedCompareExchange(&(kcqueue->stop), 0, 0)) {
+    WaitForSingleObject(kcqueue->event, INFINITE);
+    b3_kcqueue_drain(kcqueue);
+  }
+
+  return 0;
+}
+
+int
+b3_kcqueue_drain(b3_kcqueue_t *kcqueue)
+{
+  b3_kcqueue_entry_t entry;
+  LONGLONG start;
+  LONG head;
+  int error;
+
+  head = kcqueue->head;
+  while (head != InterlockedCompareExchange(&(kcqueue->tail), 0, 0)) {
+    entry = kcqueue->entry_arr[head & (B3_KCQUEUE_LEN - 1)];
+
+    /**
+     * Frees the slot for the producer
+     */
+    head++;
+    InterlockedExchange(&(kcqueue->head), head);
+
+    if (!InterlockedCompareExchange(&(kcqueue->stop), 0, 0)) {
+      b3_profile_record(&(kcqueue->wait_profile), entry.pushed, 1);
+
+      start = b3_profile_start();
+      error = wbk_kc_exec(entry.kc);
+      b3_profile_record(&(kcqueue->exec_profile), start, !error);
+    }
+
+    if (entry.users) {
+      InterlockedDecrement(entry.users);
+    }
+  }
+
+  return 0;
+}
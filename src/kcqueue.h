@@ -0,0 +1,136 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the key command queue class definition
+ *
+ * The queue takes key commands off the thread of the keyboard hook. Windows
+ * removes low level hooks that do not return in time, so the hook only pushes
+ * the key command and returns. A worker thread of the queue pops and executes
+ * the key commands one after another in the order they were pushed.
+ *
+ * The queue is a ring buffer for a single producer and a single consumer.
+ * Neither side takes a lock. The producer only signals an event after pushing.
+ */
+
+#ifndef B3_KCQUEUE_H
+#define B3_KCQUEUE_H
+
+#include <windows.h>
+#include <w32bindkeys/kc.h>
+
+#include "profile.h"
+
+/**
+ * Capacity of the queue. Must be a power of two.
+ */
+#define B3_KCQUEUE_LEN 256
+
+typedef struct b3_kcqueue_entry_s
+{
+  const wbk_kc_t *kc;
+
+  /**
+   * Decremented after the key command was executed. Can be NULL.
+   */
+  volatile LONG *users;
+
+  /**
+   * Timestamp of b3_profile_start() when the entry was pushed
+   */
+  LONGLONG pushed;
+} b3_kcqueue_entry_t;
+
+typedef struct b3_kcqueue_s
+{
+  b3_kcqueue_entry_t entry_arr[B3_KCQUEUE_LEN];
+
+  /**
+   * Number of entries ever pushed. Only written by the producer.
+   */
+  volatile LONG tail;
+
+  /**
+   * Number of entries ever popped. Only written by the worker.
+   */
+  volatile LONG head;
+
+  /**
+   * Signaled after each push
+   */
+  HANDLE event;
+
+  HANDLE thread;
+
+  volatile LONG stop;
+
+  /**
+   * Time between pushing and popping an entry
+   */
+  b3_profile_t wait_profile;
+
+  /**
+   * Time of executing a key command. It matches if the command succeeded.
+   */
+  b3_profile_t exec_profile;
+
+  /**
+   * Number of key commands dropped because the queue was full
+   */
+  volatile LONG dropped_len;
+} b3_kcqueue_t;
+
+/**
+ * @brief Creates a new key command queue and starts its worker.
+ * @return A new key command queue or NULL if the worker could not be started.
+ */
+extern b3_kcqueue_t *
+b3_kcqueue_new(void);
+
+/**
+ * @brief Stops the worker and frees the queue. Key commands which were not
+ * executed yet are dropped.
+ */
+extern int
+b3_kcqueue_free(b3_kcqueue_t *kcqueue);
+
+/**
+ * @brief Pushes a key command. Only a single thread may push.
+ * @param kc The key command. It has to stay valid until it was executed.
+ * @param users Decremented after the key command was executed or dropped by
+ * the worker. Can be NULL.
+ * @return Non-0 if the queue is full. Then users is not touched.
+ */
+extern int
+b3_kcqueue_push(b3_kcqueue_t *kcqueue, const wbk_kc_t *kc, volatile LONG *users);
+
+/**
+ * @brief Logs the latency of the queue.
+ */
+extern int
+b3_kcqueue_log_latency(b3_kcqueue_t *kcqueue);
+
+#endif // B3_KCQUEUE_H
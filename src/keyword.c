@@ -0,0 +1,149 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-18
+ * @brief File contains the keyword table implementation
+ */
+
+#include "keyword.h"
+
+#include <ctype.h>
+
+#include "parser_gen.h"
+
+/**
+ * keyword_gen.h is generated from b3_keyword_arr by keyword_gen.awk when this
+ * file changes. It defines B3_KEYWORD_SEED, a seed for which no two keywords
+ * share a slot, B3_KEYWORD_SLOT_LEN and B3_KEYWORD_SLOT_ARR.
+ */
+#include "keyword_gen.h"
+
+static unsigned int
+b3_keyword_hash(const char *str, int len);
+
+static const b3_keyword_t b3_keyword_arr[] = {
+  { "bindsym", 7, TOKEN_BINDSYM, NOT_A_MODIFIER },
+  { "move", 4, TOKEN_MOVE, NOT_A_MODIFIER },
+  { "focus", 5, TOKEN_FOCUS, NOT_A_MODIFIER },
+  { "container", 9, TOKEN_CONTAINER, NOT_A_MODIFIER },
+  { "workspace", 9, TOKEN_WORKSPACE, NOT_A_MODIFIER },
+  { "up", 2, TOKEN_UP, NOT_A_MODIFIER },
+  { "down", 4, TOKEN_DOWN, NOT_A_MODIFIER },
+  { "left", 4, TOKEN_LEFT, NOT_A_MODIFIER },
+  { "right", 5, TOKEN_RIGHT, NOT_A_MODIFIER },
+  { "kill", 4, TOKEN_KILL, NOT_A_MODIFIER },
+  { "floating", 8, TOKEN_FLOATING, NOT_A_MODIFIER },
+  { "enable", 6, TOKEN_ENABLE, NOT_A_MODIFIER },
+  { "fullscreen", 10, TOKEN_FULLSCREEN, NOT_A_MODIFIER },
+  { "exec", 4, TOKEN_EXEC, NOT_A_MODIFIER },
+  { "split", 5, TOKEN_SPLIT, NOT_A_MODIFIER },
+  { "--no-startup-id", 15, TOKEN_NO_STARTUP_ID, NOT_A_MODIFIER },
+  { "toggle", 6, TOKEN_TOGGLE, NOT_A_MODIFIER },
+  { "to", 2, TOKEN_TO, NOT_A_MODIFIER },
+  { "output", 6, TOKEN_OUTPUT, NOT_A_MODIFIER },
+  { "for_window", 10, TOKEN_FOR_WINDOW, NOT_A_MODIFIER },
+  { "title", 5, TOKEN_TITLE, NOT_A_MODIFIER },
+  { "class", 5, TOKEN_CLASS, NOT_A_MODIFIER },
+  { "dump_rule_profile", 17, TOKEN_DUMP_RULE_PROFILE, NOT_A_MODIFIER },
+  { "reload", 6, TOKEN_RELOAD, NOT_A_MODIFIER },
+  { "include", 7, TOKEN_INCLUDE, NOT_A_MODIFIER },
+  { "mode", 4, TOKEN_MODE, NOT_A_MODIFIER },
+  { "mod1", 4, TOKEN_MODIFIER, ALT },
+  { "mod4", 4, TOKEN_MODIFIER, WIN },
+  { "shift", 5, TOKEN_MODIFIER, SHIFT },
+  { "space", 5, TOKEN_MODIFIER, SPACE },
+  { "ctrl", 4, TOKEN_MODIFIER, CTRL },
+  { "return", 6, TOKEN_MODIFIER, ENTER },
+  { "f1", 2, TOKEN_MODIFIER, F1 },
+  { "f2", 2, TOKEN_MODIFIER, F2 },
+  { "f3", 2, TOKEN_MODIFIER, F3 },
+  { "f4", 2, TOKEN_MODIFIER, F4 },
+  { "f5", 2, TOKEN_MODIFIER, F5 },
+  { "f6", 2, TOKEN_MODIFIER, F6 },
+  { "f7", 2, TOKEN_MODIFIER, F7 },
+  { "f8", 2, TOKEN_MODIFIER, F8 },
+  { "f9", 2, TOKEN_MODIFIER, F9 },
+  { "f10", 3, TOKEN_MODIFIER, F10 },
+  { "f11", 3, TOKEN_MODIFIER, F11 },
+  { "f12", 3, TOKEN_MODIFIER, F12 }
+};
+
+/**
+ * Index into b3_keyword_arr for each slot of b3_keyword_hash() or -1 if no
+ * keyword hashes to the slot.
+ */
+static const signed char b3_keyword_slot_arr[B3_KEYWORD_SLOT_LEN] = B3_KEYWORD_SLOT_ARR;
+
+const b3_keyword_t *
+b3_keyword_find(const char *str, int len)
+{
+  const b3_keyword_t *keyword;
+  int index;
+  int i;
+
+  keyword = NULL;
+
+  index = b3_keyword_slot_arr[b3_keyword_hash(str, len)];
+  if (index >= 0 && b3_keyword_arr[index].len == len) {
+    keyword = &(b3_keyword_arr[index]);
+
+    for (i = 0; keyword && i < len; i++) {
+      if (keyword->name[i] != str[i]
+          && (keyword->modifier == NOT_A_MODIFIER
+              || keyword->name[i] != tolower(str[i]))) {
+        keyword = NULL;
+      }
+    }
+  }
+
+  return keyword;
+}
+
+const b3_keyword_t *
+b3_keyword_get_all(int *keyword_len)
+{
+  *keyword_len = sizeof(b3_keyword_arr) / sizeof(b3_keyword_t);
+  return b3_keyword_arr;
+}
+
+unsigned int
+b3_keyword_hash(const char *str, int len)
+{
+  unsigned int hash;
+  int i;
+
+  /**
+   * FNV-1a over the lower case characters. keyword_gen.awk computes the same
+   * hash, so both have to be changed together.
+   */
+  hash = B3_KEYWORD_SEED;
+  for (i = 0; i < len; i++) {
+    hash ^= (unsigned char) tolower(str[i]);
+    hash *= 16777619;
+  }
+
+  return (hash ^ (hash >> 16)) & (B3_KEYWORD_SLOT_LEN - 1);
+}
@@ -0,0 +1,73 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-18
+ * @brief File contains the keyword table shared by the lexer and the parser
+ *
+ * The lexer resolves the token of a keyword and the parser resolves the
+ * modifier of a TOKEN_MODIFIER with the same table. Keywords are found with a
+ * perfect hash, so a lookup needs exactly one comparison and no allocation.
+ */
+
+#ifndef B3_KEYWORD_H
+#define B3_KEYWORD_H
+
+#include <w32bindkeys/be.h>
+
+typedef struct b3_keyword_s
+{
+  const char *name;
+
+  int len;
+
+  /**
+   * Token of the parser
+   */
+  int token;
+
+  /**
+   * NOT_A_MODIFIER if the keyword is not a modifier. Modifiers are matched
+   * case insensitive.
+   */
+  wbk_mk_t modifier;
+} b3_keyword_t;
+
+/**
+ * @param str The keyword. It does not need to be terminated.
+ * @param len The length of the keyword.
+ * @return The keyword or NULL if str is no keyword.
+ */
+extern const b3_keyword_t *
+b3_keyword_find(const char *str, int len);
+
+/**
+ * @param keyword_len Set to the number of keywords.
+ * @return All keywords.
+ */
+extern const b3_keyword_t *
+b3_keyword_get_all(int *keyword_len);
+
+#endif // B3_KEYWORD_H
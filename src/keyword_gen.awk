@@ -0,0 +1,135 @@
+################################################################################
+# This file is part of b3.
+#
+# Copyright 2020 Richard Paul Baeck <richard.baeck@mailbox.org>
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+################################################################################
+
+# Generates keyword_gen.h, the perfect hash of the keywords of keyword.c:
+#
+#   awk -f keyword_gen.awk keyword.c > keyword_gen.h
+#
+# The keywords are read from b3_keyword_arr in keyword.c. The smallest seed of
+# b3_keyword_hash() for which no two keywords share a slot is searched, then
+# the seed and the slot of each keyword are written.
+#
+# Only POSIX awk is used. It has no bitwise operators and its numbers are
+# doubles, so the 32 bit arithmetic of the hash is done on 16 and 8 bit parts.
+
+function xor8(a, b,    result, bit) {
+  result = 0
+  for (bit = 1; bit < 256; bit *= 2) {
+    if ((int(a / bit) % 2) != (int(b / bit) % 2)) {
+      result += bit
+    }
+  }
+  return result
+}
+
+# a * b modulo 2^32 for a < 2^32 and b < 2^24
+function mul32(a, b,    high, low) {
+  high = int(a / 65536)
+  low = a % 65536
+  return ((high * b) % 65536 * 65536 + low * b) % 4294967296
+}
+
+# Same as b3_keyword_hash() of keyword.c
+function hash(str, seed,    h, i) {
+  h = seed
+  for (i = 1; i <= length(str); i++) {
+    h = h - h % 256 + xor8(h % 256, ord[substr(str, i, 1)])
+    h = mul32(h, 16777619)
+  }
+  return xor8(h % 128, int(h / 65536) % 128)
+}
+
+BEGIN {
+  slot_len = 128
+  seed_max = 100000
+
+  for (i = 32; i < 127; i++) {
+    ord[sprintf("%c", i)] = i
+  }
+
+  keyword_len = 0
+  in_arr = 0
+}
+
+/b3_keyword_arr\[\] = \{/ {
+  in_arr = 1
+  next
+}
+
+in_arr && /^\};/ {
+  in_arr = 0
+}
+
+in_arr && /\{ *"/ {
+  name = $0
+  sub(/^[^"]*"/, "", name)
+  sub(/".*$/, "", name)
+  keyword_arr[keyword_len++] = tolower(name)
+}
+
+END {
+  if (keyword_len == 0 || keyword_len > slot_len) {
+    print "keyword_gen.awk: no keywords or too many keywords found" > "/dev/stderr"
+    exit 1
+  }
+
+  found = 0
+  for (seed = 0; !found && seed < seed_max; seed++) {
+    for (i = 0; i < slot_len; i++) {
+      slot_arr[i] = -1
+    }
+
+    found = 1
+    for (i = 0; found && i < keyword_len; i++) {
+      slot = hash(keyword_arr[i], seed)
+      if (slot_arr[slot] >= 0) {
+        found = 0
+      } else {
+        slot_arr[slot] = i
+      }
+    }
+  }
+  seed--
+
+  if (!found) {
+    print "keyword_gen.awk: no seed without collisions found" > "/dev/stderr"
+    exit 1
+  }
+
+  print "/* Generated by keyword_gen.awk from keyword.c, do not edit */"
+  print ""
+  print "#define B3_KEYWORD_SEED " seed
+  print ""
+  print "#define B3_KEYWORD_SLOT_LEN " slot_len
+  print ""
+  print "#define B3_KEYWORD_SLOT_ARR { \\"
+  for (i = 0; i < slot_len; i += 16) {
+    line = " "
+    for (j = i; j < i + 16; j++) {
+      line = line sprintf(" %2d", slot_arr[j]) (j < slot_len - 1 ? "," : "")
+    }
+    print line " \\"
+  }
+  print "}"
+}
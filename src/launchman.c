@@ -0,0 +1,769 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the launch manager class implementation
+ */
+
+#include "launchman.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <w32bindkeys/logger.h>
+
+/**
+ * Multiplier of the Fibonacci hashing, 2^32 divided by the golden ratio
+ */
+#define B3_LAUNCHMAN_HASH_MULTIPLIER 2654435769U
+
+/**
+ * Completion key which stops the worker. Launches start with id 1.
+ */
+#define B3_LAUNCHMAN_STOP_ID 0
+
+static wbk_logger_t logger = { "launchman" };
+
+static DWORD WINAPI
+b3_launchman_worker(LPVOID param);
+
+/**
+ * @return The index where the hash table probing for process_id starts.
+ */
+static int
+b3_launchman_home(const b3_launchman_t *launchman, DWORD process_id);
+
+/**
+ * @return The index of the entry holding process_id or of the empty entry
+ * where process_id belongs.
+ */
+static int
+b3_launchman_probe(const b3_launchman_t *launchman, DWORD process_id);
+
+/**
+ * @brief Maps a process id to a launch. Hold the mutex!
+ * @return Non-0 if allocation failed.
+ */
+static int
+b3_launchman_insert(b3_launchman_t *launchman, DWORD process_id, b3_launch_t *launch);
+
+/**
+ * @brief Empties an entry and moves the following entries of its cluster
+ * back, so no entry becomes unreachable. Hold the mutex!
+ */
+static int
+b3_launchman_erase(b3_launchman_t *launchman, int index);
+
+/**
+ * @return The pending launch with the id or NULL. Hold the mutex!
+ */
+static b3_launch_t *
+b3_launchman_find_launch(b3_launchman_t *launchman, ULONG_PTR id);
+
+/**
+ * @brief Removes a launch and all its processes and closes its job. Hold the
+ * mutex!
+ */
+static int
+b3_launchman_detach(b3_launchman_t *launchman, b3_launch_t *launch);
+
+/**
+ * @brief Detaches a launch and frees it. Hold the mutex!
+ */
+static int
+b3_launchman_drop(b3_launchman_t *launchman, b3_launch_t *launch);
+
+/**
+ * @brief Puts a launch into the slot of the timer wheel of its deadline. Hold
+ * the mutex!
+ */
+static int
+b3_launchman_wheel_insert(b3_launchman_t *launchman, b3_launch_t *launch);
+
+static int
+b3_launchman_wheel_remove(b3_launchman_t *launchman, b3_launch_t *launch);
+
+/**
+ * @return Time in milliseconds until the worker has to expire launches.
+ */
+static DWORD
+b3_launchman_timeout(b3_launchman_t *launchman);
+
+b3_launch_t *
+b3_launch_new(const char *ws_name, const char *monitor_name, DWORD timeout)
+{
+  int error;
+  b3_launch_t *launch;
+
+  error = 0;
+
+  launch = malloc(sizeof(b3_launch_t));
+  if (launch == NULL) {
+    error = 1;
+  }
+
+  if (!error) {
+    memset(launch, 0, sizeof(b3_launch_t));
+    launch->deadline = GetTickCount64() + timeout;
+
+    if (ws_name) {
+      launch->ws_name = strdup(ws_name);
+      if (launch->ws_name == NULL) {
+        error = 2;
+      }
+    }
+  }
+
+  if (!error && monitor_name) {
+    launch->monitor_name = strdup(monitor_name);
+    if (launch->monitor_name == NULL) {
+      error = 3;
+    }
+  }
+
+  if (error) {
+    wbk_logger_log(&logger, SEVERE, "Could not allocate memory.\n");
+    if (launch) {
+      b3_launch_free(launch);
+      launch = NULL;
+    }
+  }
+
+  return launch;
+}
+
+int
+b3_launch_free(b3_launch_t *launch)
+{
+  if (launch->job) {
+    CloseHandle(launch->job);
+    launch->job = NULL;
+  }
+
+  free(launch->monitor_name);
+  launch->monitor_name = NULL;
+
+  free(launch->ws_name);
+  launch->ws_name = NULL;
+
+  free(launch);
+
+  return 0;
+}
+
+const char *
+b3_launch_get_ws_name(const b3_launch_t *launch)
+{
+  return launch->ws_name;
+}
+
+const char *
+b3_launch_get_monitor_name(const b3_launch_t *launch)
+{
+  return launch->monitor_name;
+}
+
+b3_launchman_t *
+b3_launchman_new(void)
+{
+  int error;
+  b3_launchman_t *launchman;
+
+  error = 0;
+
+  launchman = malloc(sizeof(b3_launchman_t));
+  if (launchman == NULL) {
+    wbk_logger_log(&logger, SEVERE, "Could not allocate memory.\n");
+    error = 1;
+  }
+
+  if (!error) {
+    memset(launchman, 0, sizeof(b3_launchman_t));
+
+    launchman->mutex = CreateMutex(NULL, FALSE, NULL);
+    launchman->next_id = B3_LAUNCHMAN_STOP_ID + 1;
+    launchman->wheel_tick = GetTickCount64() / B3_LAUNCHMAN_TICK;
+    cc_array_new(&(launchman->launch_arr));
+
+    launchman->entry_arr_len = 16;
+    launchman->entry_arr = malloc(sizeof(b3_launchman_entry_t) * launchman->entry_arr_len);
+    if (launchman->entry_arr == NULL) {
+      wbk_logger_log(&logger, SEVERE, "Could not allocate memory.\n");
+      error = 2;
+    }
+  }
+
+  if (!error) {
+    memset(launchman->entry_arr, 0, sizeof(b3_launchman_entry_t) * launchman->entry_arr_len);
+
+    launchman->port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+    if (launchman->port == NULL) {
+      wbk_logger_log(&logger, SEVERE, "Could not create a completion port.\n");
+      error = 3;
+    }
+  }
+
+  if (!error) {
+    launchman->thread = CreateThread(NULL,
+                                     0,
+                                     b3_launchman_worker,
+                                     (LPVOID) launchman,
+                                     0,
+                                     NULL);
+    if (launchman->thread == NULL) {
+      wbk_logger_log(&logger, SEVERE, "Could not start the worker.\n");
+      error = 4;
+    }
+  }
+
+  if (error && launchman) {
+    if (launchman->port) {
+      CloseHandle(launchman->port);
+    }
+    free(launchman->entry_arr);
+    if (launchman->launch_arr) {
+      cc_array_destroy(launchman->launch_arr);
+    }
+    if (launchman->mutex) {
+      CloseHandle(launchman->mutex);
+    }
+    free(launchman);
+    launchman = NULL;
+  }
+
+  return launchman;
+}
+
+int
+b3_launchman_free(b3_launchman_t *launchman)
+{
+  b3_launch_t *launch;
+
+  PostQueuedCompletionStatus(launchman->port, 0, B3_LAUNCHMAN_STOP_ID, NULL);
+  WaitForSingleObject(launchman->thread, INFINITE);
+  CloseHandle(launchman->thread);
+  launchman->thread = NULL;
+
+  CloseHandle(launchman->port);
+  launchman->port = NULL;
+
+  WaitForSingleObject(launchman->mutex, INFINITE);
+  while (cc_array_size(launchman->launch_arr) > 0) {
+    cc_array_get_at(launchman->launch_arr, 0, (void *) &launch);
+    b3_launchman_drop(launchman, launch);
+  }
+  ReleaseMutex(launchman->mutex);
+
+  cc_array_destroy(launchman->launch_arr);
+  launchman->launch_arr = NULL;
+
+  free(launchman->entry_arr);
+  launchman->entry_arr = NULL;
+
+  CloseHandle(launchman->mutex);
+  launchman->mutex = NULL;
+
+  free(launchman);
+
+  return 0;
+}
+
+int
+b3_launchman_launch(b3_launchman_t *launchman, char *cmd, b3_launch_t *launch)
+{
+  int error;
+  ULONG_PTR id;
+  HANDLE job;
+  JOBOBJECT_ASSOCIATE_COMPLETION_PORT port_info;
+  STARTUPINFOA startup_info;
+  PROCESS_INFORMATION process_info;
+
+  error = 0;
+
+  memset(&startup_info, 0, sizeof(STARTUPINFOA));
+  startup_info.cb = sizeof(STARTUPINFOA);
+
+  /**
+   * A tracked process is started suspended, so it cannot start any child
+   * before it is in its job.
+   */
+  if (!CreateProcess(NULL,
+                     cmd,
+                     NULL,
+                     NULL,
+                     FALSE,
+                     NORMAL_PRIORITY_CLASS | (launch ? CREATE_SUSPENDED : 0),
+                     NULL,
+                     NULL,
+                     &startup_info,
+                     &process_info)) {
+    wbk_logger_log(&logger, SEVERE, "Could not start %s\n", cmd);
+    if (launch) {
+      b3_launch_free(launch);
+    }
+    error = 1;
+  }
+
+  if (!error && launch) {
+    job = CreateJobObject(NULL, NULL);
+
+    id = b3_launchman_add(launchman, process_info.dwProcessId, job, launch);
+
+    port_info.CompletionKey = (PVOID) id;
+    port_info.CompletionPort = launchman->port;
+
+    if (id == B3_LAUNCHMAN_STOP_ID
+        || job == NULL
+        || !SetInformationJobObject(job,
+                                    JobObjectAssociateCompletionPortInformation,
+                                    &port_info,
+                                    sizeof(JOBOBJECT_ASSOCIATE_COMPLETION_PORT))
+        || !AssignProcessToJobObject(job, process_info.hProcess)) {
+      wbk_logger_log(&logger, WARNING, "Children of %s are not tracked\n", cmd);
+    }
+
+    ResumeThread(process_info.hThread);
+  }
+
+  if (!error) {
+    CloseHandle(process_info.hThread);
+    CloseHandle(process_info.hProcess);
+  }
+
+  return error;
+}
+
+ULONG_PTR
+b3_launchman_add(b3_launchman_t *launchman, DWORD process_id, HANDLE job, b3_launch_t *launch)
+{
+  ULONG_PTR id;
+
+  id = B3_LAUNCHMAN_STOP_ID;
+
+  launch->job = job;
+
+  WaitForSingleObject(launchman->mutex, INFINITE);
+
+  launch->id = launchman->next_id++;
+  cc_array_add(launchman->launch_arr, launch);
+  b3_launchman_wheel_insert(launchman, launch);
+
+  if (b3_launchman_insert(launchman, process_id, launch)) {
+    b3_launchman_drop(launchman, launch);
+  } else {
+    id = launch->id;
+  }
+
+  ReleaseMutex(launchman->mutex);
+
+  /**
+   * Makes the worker wait for the deadline of the new launch
+   */
+  if (id != B3_LAUNCHMAN_STOP_ID) {
+    PostQueuedCompletionStatus(launchman->port, 0, id, NULL);
+  }
+
+  return id;
+}
+
+int
+b3_launchman_add_process(b3_launchman_t *launchman, ULONG_PTR id, DWORD process_id)
+{
+  b3_launch_t *launch;
+  int error;
+
+  WaitForSingleObject(launchman->mutex, INFINITE);
+
+  error = 1;
+  launch = b3_launchman_find_launch(launchman, id);
+  if (launch) {
+    error = b3_launchman_insert(launchman, process_id, launch);
+  }
+
+  ReleaseMutex(launchman->mutex);
+
+  return error;
+}
+
+int
+b3_launchman_remove_process(b3_launchman_t *launchman, DWORD process_id)
+{
+  int index;
+
+  WaitForSingleObject(launchman->mutex, INFINITE);
+
+  index = b3_launchman_probe(launchman, process_id);
+  if (launchman->entry_arr[index].launch) {
+    b3_launchman_erase(launchman, index);
+  }
+
+  ReleaseMutex(launchman->mutex);
+
+  return 0;
+}
+
+b3_launch_t *
+b3_launchman_claim(b3_launchman_t *launchman, DWORD process_id)
+{
+  b3_launch_t *launch;
+
+  WaitForSingleObject(launchman->mutex, INFINITE);
+
+  launch = launchman->entry_arr[b3_launchman_probe(launchman, process_id)].launch;
+  if (launch) {
+    b3_launchman_detach(launchman, launch);
+  }
+
+  ReleaseMutex(launchman->mutex);
+
+  return launch;
+}
+
+int
+b3_launchman_expire(b3_launchman_t *launchman, ULONGLONG now)
+{
+  b3_launch_t *launch;
+  b3_launch_t *next;
+  ULONGLONG now_tick;
+  int expired_len;
+  int slot_len;
+  int i;
+
+  WaitForSingleObject(launchman->mutex, INFINITE);
+
+  now_tick = now / B3_LAUNCHMAN_TICK;
+  expired_len = 0;
+
+  /**
+   * Visits every slot whose tick passed, but each slot once at most. A slot
+   * also holds launches of later rounds, so the deadline is checked.
+   */
+  slot_len = 0;
+  if (now_tick >= launchman->wheel_tick) {
+    slot_len = B3_LAUNCHMAN_WHEEL_LEN;
+    if (now_tick - launchman->wheel_tick < B3_LAUNCHMAN_WHEEL_LEN) {
+      slot_len = (int) (now_tick - launchman->wheel_tick) + 1;
+    }
+  }
+
+  for (i = 0; i < slot_len; i++) {
+    launch = launchman->wheel_arr[(launchman->wheel_tick + i) & (B3_LAUNCHMAN_WHEEL_LEN - 1)];
+    while (launch) {
+      next = launch->wheel_next;
+      if (launch->deadline <= now) {
+        wbk_logger_log(&logger, INFO, "Launch for workspace %s expired without a window\n",
+                       launch->ws_name ? launch->ws_name : "(focused)");
+        b3_launchman_drop(launchman, launch);
+        expired_len++;
+      }
+      launch = next;
+    }
+  }
+
+  if (now_tick >= launchman->wheel_tick) {
+    launchman->wheel_tick = now_tick + 1;
+  }
+
+  ReleaseMutex(launchman->mutex);
+
+  return expired_len;
+}
+
+DWORD WINAPI
+b3_launchman_worker(LPVOID param)
+{
+  b3_launchman_t *launchman;
+  b3_launch_t *launch;
+  DWORD msg;
+  ULONG_PTR id;
+  LPOVERLAPPED overlapped;
+  BOOL dequeued;
+  int stop;
+
+  launchman = (b3_launchman_t *) param;
+
+  stop = 0;
+  while (!stop) {
+    dequeued = GetQueuedCompletionStatus(launchman->port, &msg, &id, &overlapped,
+                                         b3_launchman_timeout(launchman));
+    if (!dequeued && GetLastError() != WAIT_TIMEOUT) {
+      wbk_logger_log(&logger, SEVERE, "Could not read the completion port\n");
+      stop = 1;
+    } else if (dequeued && id == B3_LAUNCHMAN_STOP_ID) {
+      stop = 1;
+    }
+
+    if (!stop) {
+      b3_launchman_expire(launchman, GetTickCount64());
+    }
+
+    if (stop || !dequeued) {
+      continue;
+    }
+
+    /**
+     * For job messages, the process id is passed in place of the overlapped
+     * structure.
+     */
+    switch (msg) {
+    case JOB_OBJECT_MSG_NEW_PROCESS:
+      b3_launchman_add_process(launchman, id, (DWORD) (ULONG_PTR) overlapped);
+      break;
+
+    case JOB_OBJECT_MSG_EXIT_PROCESS:
+    case JOB_OBJECT_MSG_ABNORMAL_EXIT_PROCESS:
+      b3_launchman_remove_process(launchman, (DWORD) (ULONG_PTR) overlapped);
+      break;
+
+    case JOB_OBJECT_MSG_ACTIVE_PROCESS_ZERO:
+      WaitForSingleObject(launchman->mutex, INFINITE);
+      launch = b3_launchman_find_launch(launchman, id);
+      if (launch) {
+        wbk_logger_log(&logger, INFO, "Launch %lu exited without opening a window\n", (unsigned long) id);
+        b3_launchman_drop(launchman, launch);
+      }
+      ReleaseMutex(launchman->mutex);
+      break;
+    }
+  }
+
+  return 0;
+}
+
+int
+b3_launchman_home(const b3_launchman_t *launchman, DWORD process_id)
+{
+  return (int) ((process_id * B3_LAUNCHMAN_HASH_MULTIPLIER) >> 8) & (launchman->entry_arr_len - 1);
+}
+
+int
+b3_launchman_probe(const b3_launchman_t *launchman, DWORD process_id)
+{
+  int mask;
+  int index;
+
+  mask = launchman->entry_arr_len - 1;
+  index = b3_launchman_home(launchman, process_id);
+
+  /** The table is at most half full, so there always is an empty entry */
+  while (launchman->entry_arr[index].launch
+         && launchman->entry_arr[index].process_id != process_id) {
+    index = (index + 1) & mask;
+  }
+
+  return index;
+}
+
+int
+b3_launchman_insert(b3_launchman_t *launchman, DWORD process_id, b3_launch_t *launch)
+{
+  b3_launchman_entry_t *old_entry_arr;
+  b3_launchman_entry_t *entry_arr;
+  int old_entry_arr_len;
+  int index;
+  int i;
+
+  index = b3_launchman_probe(launchman, process_id);
+  if (launchman->entry_arr[index].launch) {
+    /** Already known, e. g. the launched process itself joining its job */
+    return 0;
+  }
+
+  if (2 * (launchman->process_id_len + 1) > launchman->entry_arr_len) {
+    entry_arr = malloc(sizeof(b3_launchman_entry_t) * launchman->entry_arr_len * 2);
+    if (entry_arr == NULL) {
+      wbk_logger_log(&logger, SEVERE, "Could not allocate memory.\n");
+      return 1;
+    }
+    memset(entry_arr, 0, sizeof(b3_launchman_entry_t) * launchman->entry_arr_len * 2);
+
+    old_entry_arr = launchman->entry_arr;
+    old_entry_arr_len = launchman->entry_arr_len;
+
+    launchman->entry_arr = entry_arr;
+    launchman->entry_arr_len *= 2;
+
+    for (i = 0; i < old_entry_arr_len; i++) {
+      if (old_entry_arr[i].launch) {
+        launchman->entry_arr[b3_launchman_probe(launchman, old_entry_arr[i].process_id)] = old_entry_arr[i];
+      }
+    }
+
+    free(old_entry_arr);
+
+    index = b3_launchman_probe(launchman, process_id);
+  }
+
+  launchman->entry_arr[index].process_id = process_id;
+  launchman->entry_arr[index].launch = launch;
+  launchman->process_id_len++;
+
+  return 0;
+}
+
+int
+b3_launchman_erase(b3_launchman_t *launchman, int index)
+{
+  int mask;
+  int next;
+  int home;
+
+  mask = launchman->entry_arr_len - 1;
+
+  launchman->entry_arr[index].launch = NULL;
+  launchman->process_id_len--;
+
+  next = (index + 1) & mask;
+  while (launchman->entry_arr[next].launch) {
+    home = b3_launchman_home(launchman, launchman->entry_arr[next].process_id);
+
+    /**
+     * The entry stays if its home lies cyclically in (index, next]. Otherwise
+     * the emptied entry would end its probing too early.
+     */
+    if (((next - home) & mask) >= ((next - index) & mask)) {
+      launchman->entry_arr[index] = launchman->entry_arr[next];
+      launchman->entry_arr[next].launch = NULL;
+      index = next;
+    }
+
+    next = (next + 1) & mask;
+  }
+
+  return 0;
+}
+
+b3_launch_t *
+b3_launchman_find_launch(b3_launchman_t *launchman, ULONG_PTR id)
+{
+  CC_ArrayIter iter;
+  b3_launch_t *launch;
+
+  cc_array_iter_init(&iter, launchman->launch_arr);
+  while (cc_array_iter_next(&iter, (void *) &launch) != CC_ITER_END) {
+    if (launch->id == id) {
+      return launch;
+    }
+  }
+
+  return NULL;
+}
+
+int
+b3_launchman_detach(b3_launchman_t *launchman, b3_launch_t *launch)
+{
+  int index;
+
+  index = 0;
+  while (index < launchman->entry_arr_len) {
+    if (launchman->entry_arr[index].launch == launch) {
+      /** Erasing may move another entry here */
+      b3_launchman_erase(launchman, index);
+    } else {
+      index++;
+    }
+  }
+
+  cc_array_remove(launchman->launch_arr, launch, NULL);
+  b3_launchman_wheel_remove(launchman, launch);
+
+  if (launch->job) {
+    CloseHandle(launch->job);
+    launch->job = NULL;
+  }
+
+  return 0;
+}
+
+int
+b3_launchman_drop(b3_launchman_t *launchman, b3_launch_t *launch)
+{
+  b3_launchman_detach(launchman, launch);
+  b3_launch_free(launch);
+
+  return 0;
+}
+
+int
+b3_launchman_wheel_insert(b3_launchman_t *launchman, b3_launch_t *launch)
+{
+  ULONGLONG tick;
+
+  /** Rounds up, so a launch never expires early */
+  tick = (launch->deadline + B3_LAUNCHMAN_TICK - 1) / B3_LAUNCHMAN_TICK;
+  if (tick < launchman->wheel_tick) {
+    tick = launchman->wheel_tick;
+  }
+
+  launch->wheel_slot = (int) (tick & (B3_LAUNCHMAN_WHEEL_LEN - 1));
+  launch->wheel_prev = NULL;
+  launch->wheel_next = launchman->wheel_arr[launch->wheel_slot];
+  if (launch->wheel_next) {
+    launch->wheel_next->wheel_prev = launch;
+  }
+  launchman->wheel_arr[launch->wheel_slot] = launch;
+
+  return 0;
+}
+
+int
+b3_launchman_wheel_remove(b3_launchman_t *launchman, b3_launch_t *launch)
+{
+  if (launch->wheel_prev) {
+    launch->wheel_prev->wheel_next = launch->wheel_next;
+  } else {
+    launchman->wheel_arr[launch->wheel_slot] = launch->wheel_next;
+  }
+
+  if (launch->wheel_next) {
+    launch->wheel_next->wheel_prev = launch->wheel_prev;
+  }
+
+  launch->wheel_prev = NULL;
+  launch->wheel_next = NULL;
+
+  return 0;
+}
+
+DWORD
+b3_launchman_timeout(b3_launchman_t *launchman)
+{
+  ULONGLONG next;
+  ULONGLONG now;
+  DWORD timeout;
+
+  WaitForSingleObject(launchman->mutex, INFINITE);
+
+  timeout = INFINITE;
+  if (cc_array_size(launchman->launch_arr) > 0) {
+    next = launchman->wheel_tick * B3_LAUNCHMAN_TICK;
+    now = GetTickCount64();
+    timeout = next > now ? (DWORD) (next - now) : 0;
+  }
+
+  ReleaseMutex(launchman->mutex);
+
+  return timeout;
+}
@@ -0,0 +1,246 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the launch manager class definition
+ *
+ * The launch manager keeps a launch context for every started process until
+ * the process opens its first window. The context holds the workspace and the
+ * monitor the window goes to. The manager is keyed by process id, so the
+ * window watcher finds the launch of a new window in constant time.
+ *
+ * Every launched process is put into a job object of its own. Windows reports
+ * processes joining or leaving the job to a completion port, so the children
+ * of a launched process are tracked as well. No thread is polling for windows.
+ *
+ * A launch whose process never opens a window expires at its deadline. The
+ * deadlines are kept in a timer wheel, a ring of slots of one tick each, so
+ * the worker of the completion port only wakes up once per tick while
+ * launches are pending.
+ */
+
+#ifndef B3_LAUNCHMAN_H
+#define B3_LAUNCHMAN_H
+
+#include <windows.h>
+#include <collectc/cc_array.h>
+
+/**
+ * Time in milliseconds after which a launch expires by default
+ */
+#define B3_LAUNCH_TIMEOUT 60000
+
+/**
+ * Length of a tick of the timer wheel in milliseconds
+ */
+#define B3_LAUNCHMAN_TICK 250
+
+/**
+ * Number of slots of the timer wheel. Must be a power of two.
+ */
+#define B3_LAUNCHMAN_WHEEL_LEN 256
+
+typedef struct b3_launch_s b3_launch_t;
+
+struct b3_launch_s
+{
+  /**
+   * Completion key of the job of the launch. Never 0. Set by the launch
+   * manager.
+   */
+  ULONG_PTR id;
+
+  /**
+   * The workspace of the first window. NULL for the focused workspace of its
+   * monitor.
+   */
+  char *ws_name;
+
+  /**
+   * The monitor of the first window. NULL for the monitor the window opens on.
+   */
+  char *monitor_name;
+
+  /**
+   * Expiry time as returned by GetTickCount64()
+   */
+  ULONGLONG deadline;
+
+  /**
+   * NULL if the process could not be put into a job
+   */
+  HANDLE job;
+
+  /**
+   * Links of the launches in the same slot of the timer wheel
+   */
+  b3_launch_t *wheel_prev;
+  b3_launch_t *wheel_next;
+  int wheel_slot;
+};
+
+typedef struct b3_launchman_entry_s
+{
+  DWORD process_id;
+
+  /**
+   * NULL if the entry is empty
+   */
+  b3_launch_t *launch;
+} b3_launchman_entry_t;
+
+typedef struct b3_launchman_s
+{
+  HANDLE mutex;
+
+  /**
+   * Completion port receiving the messages of the jobs
+   */
+  HANDLE port;
+
+  HANDLE thread;
+
+  ULONG_PTR next_id;
+
+  /**
+   * CC_Array of b3_launch_t *. The pending launches.
+   */
+  CC_Array *launch_arr;
+
+  /**
+   * Open addressing hash table of the process ids with linear probing. Its
+   * length is a power of two and it is at most half full.
+   */
+  int entry_arr_len;
+
+  b3_launchman_entry_t *entry_arr;
+
+  int process_id_len;
+
+  /**
+   * Slots of the timer wheel. Each holds a list of launches linked by
+   * wheel_next.
+   */
+  b3_launch_t *wheel_arr[B3_LAUNCHMAN_WHEEL_LEN];
+
+  /**
+   * The next tick to expire, in ticks since the start of the system
+   */
+  ULONGLONG wheel_tick;
+} b3_launchman_t;
+
+/**
+ * @brief Creates a new launch context.
+ * @param ws_name The workspace of the first window or NULL. It is copied.
+ * @param monitor_name The monitor of the first window or NULL. It is copied.
+ * @param timeout Time in milliseconds after which the launch expires.
+ * @return A new launch context or NULL if allocation failed.
+ */
+extern b3_launch_t *
+b3_launch_new(const char *ws_name, const char *monitor_name, DWORD timeout);
+
+extern int
+b3_launch_free(b3_launch_t *launch);
+
+/**
+ * @return The workspace of the first window or NULL. Do not free it!
+ */
+extern const char *
+b3_launch_get_ws_name(const b3_launch_t *launch);
+
+/**
+ * @return The monitor of the first window or NULL. Do not free it!
+ */
+extern const char *
+b3_launch_get_monitor_name(const b3_launch_t *launch);
+
+/**
+ * @brief Creates a new launch manager.
+ * @return A new launch manager or NULL if allocation failed.
+ */
+extern b3_launchman_t *
+b3_launchman_new(void);
+
+/**
+ * @brief Frees a launch manager. Pending launches are dropped, their processes
+ * keep running.
+ */
+extern int
+b3_launchman_free(b3_launchman_t *launchman);
+
+/**
+ * @brief Starts a process.
+ * @param cmd The command line to start.
+ * @param launch The launch context of the process. It will be freed by the
+ * launch manager. If NULL, then the process is only started.
+ * @return Non-0 if the process could not be started.
+ */
+extern int
+b3_launchman_launch(b3_launchman_t *launchman, char *cmd, b3_launch_t *launch);
+
+/**
+ * @brief Adds a pending launch.
+ * @param process_id The process id of the launched process.
+ * @param job The job of the process or NULL. It will be closed by the launch
+ * manager.
+ * @param launch The launch context. It will be freed by the launch manager.
+ * @return The id of the launch or 0 if allocation failed.
+ */
+extern ULONG_PTR
+b3_launchman_add(b3_launchman_t *launchman, DWORD process_id, HANDLE job, b3_launch_t *launch);
+
+/**
+ * @brief Adds a process to a pending launch, e. g. a child of a launched
+ * process.
+ * @return Non-0 if the launch is not pending anymore.
+ */
+extern int
+b3_launchman_add_process(b3_launchman_t *launchman, ULONG_PTR id, DWORD process_id);
+
+/**
+ * @brief Removes a process, e. g. because it exited. The launch stays pending.
+ */
+extern int
+b3_launchman_remove_process(b3_launchman_t *launchman, DWORD process_id);
+
+/**
+ * @brief Resolves the launch of a process, e. g. because it opened a window.
+ * Afterwards no process of the launch is found anymore.
+ * @return The launch context or NULL if the process was not launched or its
+ * launch expired. Free it by yourself!
+ */
+extern b3_launch_t *
+b3_launchman_claim(b3_launchman_t *launchman, DWORD process_id);
+
+/**
+ * @brief Drops all launches whose deadline passed.
+ * @param now The current time as returned by GetTickCount64().
+ * @return The number of dropped launches.
+ */
+extern int
+b3_launchman_expire(b3_launchman_t *launchman, ULONGLONG now);
+
+#endif // B3_LAUNCHMAN_H
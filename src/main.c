@@ -23,6 +23,8 @@
 *******************************************************************************/
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <collectc/cc_array.h>
 #include <windows.h>
 #include <w32bindkeys/logger.h>
@@ -42,15 +44,20 @@
 #include "action_factory.h"
 #include "parser.h"
 #include "director.h"
+#include "reloader.h"
 #include "win_watcher.h"
+#include "status.h"
+#include "mousedaemon.h"
+#include "mc_focus.h"
 
-#define B3_GETOPT_OPTIONS "dvV"
-
-#define B3_KBDAEMON_ARR_LEN 30
+#define B3_GETOPT_OPTIONS "dvVs:i:f"
 
 static struct option B3_GETOPT_LONG_OPTIONS[] = {
     /*   NAME          ARGUMENT           FLAG  SHORTNAME */
         {"all",        no_argument,       NULL, 'd'},
+        {"status-command", required_argument, NULL, 's'},
+        {"status-interval", required_argument, NULL, 'i'},
+        {"focus-follows-mouse", no_argument, NULL, 'f'},
         {NULL,         0,                 NULL, 0}
     };
 
@@ -60,8 +67,21 @@ static const char g_szClassName[] = "myWindowClass";
 
 static b3_director_t *g_director;
 
-static wbk_kbdaemon_t **g_kbdaemon_arr = NULL;
-static wbk_kbman_t **g_kbman_arr = NULL;
+static b3_reloader_t *g_reloader = NULL;
+
+static wbk_kbdaemon_t *g_kbdaemon = NULL;
+
+static char *g_status_cmd = NULL;
+
+static DWORD g_status_interval = B3_STATUS_DEFAULT_INTERVAL;
+
+static b3_status_t *g_status = NULL;
+
+static char g_focus_follows_mouse = 0;
+
+static b3_mouseman_t *g_mouseman = NULL;
+
+static b3_mousedaemon_t *g_mousedaemon = NULL;
 
 static int
 print_version(void);
@@ -78,6 +98,9 @@ window_callback(HWND window_handler, UINT msg, WPARAM wParam, LPARAM lParam);
 static int
 kbdaemon_exec_fn(wbk_kbdaemon_t *kbdaemon, wbk_b_t *b);
 
+static int
+status_update_fn(void *data);
+
 int
 WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
 {
@@ -125,6 +148,19 @@ WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, in
 				error = print_version();
 				exec = 0;
 				break;
+
+			case 's':
+				free(g_status_cmd);
+				g_status_cmd = strdup(optarg);
+				break;
+
+			case 'i':
+				g_status_interval = strtoul(optarg, NULL, 10);
+				break;
+
+			case 'f':
+				g_focus_follows_mouse = 1;
+				break;
 			}
 		}
 
@@ -136,6 +172,8 @@ WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, in
 		error = parameterized_main();
 	}
 
+	free(g_status_cmd);
+
 	return error;
 }
 
@@ -145,7 +183,6 @@ parameterized_main(void)
 	int error;
 	char *dir;
 	char *config_filename;
-	FILE *config_file;
 	wbk_datafinder_t *datafinder;
 	b3_win_factory_t *win_factory;
 	b3_ws_factory_t *ws_factory;
@@ -156,10 +193,10 @@ parameterized_main(void)
 	b3_action_factory_t *action_factory;
 	b3_parser_t *parser;
 	b3_win_watcher_t *win_watcher;
-	wbk_kbman_t *g_kbman;
-	int i;
 
 	error = 0;
+	g_director = NULL;
+	win_watcher = NULL;
 
 	win_factory = b3_win_factory_new();
 	ws_factory = b3_ws_factory_new();
@@ -181,14 +218,10 @@ parameterized_main(void)
 
 	config_filename = wbk_datafinder_gen_path(datafinder, "config");
 	if (config_filename) {
-		config_file = fopen(config_filename, "r");
-		g_director = NULL;
-
-		if (config_file) {
-			g_director = b3_director_new(monitor_factory);
-		} else {
-			wbk_logger_log(&logger, SEVERE, "Could not open %s\n", config_filename);
-			error = 1;
+		g_director = b3_director_new(monitor_factory);
+		g_reloader = b3_reloader_new(parser, g_director, config_filename);
+		if (g_reloader == NULL) {
+			error = 3;
 		}
 
 		free(config_filename);
@@ -203,24 +236,13 @@ parameterized_main(void)
 	/**
 	 * Setup key bindings
 	 */
-	if (g_director) {
-		g_kbman = b3_parser_parse_file(parser, g_director, config_file);
-
-		if (g_kbman) {
-			g_kbman_arr = wbk_kbman_split(g_kbman, B3_KBDAEMON_ARR_LEN);
-
-			wbk_kbman_free(g_kbman);
-			g_kbman = NULL;
-		} else {
-			wbk_logger_log(&logger, SEVERE, "Could not parse config file.\n");
+	if (g_reloader) {
+		if (b3_reloader_load(g_reloader)) {
+			wbk_logger_log(&logger, SEVERE, "Could not load config file.\n");
 			error = 1;
 		}
 	}
 
-	if (config_file) {
-		fclose(config_file);
-	}
-
 	/**
 	 * Setup window watcher
 	 */
@@ -240,6 +262,33 @@ parameterized_main(void)
 
 	}
 
+	/**
+	 * Start status command. A failing status command is not fatal.
+	 */
+	if (!error && g_status_cmd) {
+		g_status = b3_status_new(g_status_cmd, g_status_interval, status_update_fn, g_director);
+		if (g_status) {
+			b3_director_set_status(g_director, g_status);
+			if (b3_status_start(g_status)) {
+				wbk_logger_log(&logger, SEVERE, "Could not start status command: %s\n", g_status_cmd);
+			}
+		}
+	}
+
+	/**
+	 * Setup mouse daemon. Without it the focus only follows the keyboard.
+	 */
+	if (!error && g_focus_follows_mouse) {
+		g_mouseman = b3_mouseman_new();
+		if (g_mouseman) {
+			b3_mouseman_add(g_mouseman, b3_mc_focus_new(g_director));
+			g_mousedaemon = b3_mousedaemon_new(g_mouseman);
+		}
+		if (g_mousedaemon == NULL || b3_mousedaemon_start(g_mousedaemon)) {
+			wbk_logger_log(&logger, SEVERE, "Could not start focus follows mouse\n");
+		}
+	}
+
 	/**
 	 * Start win watcher
 	 */
@@ -252,14 +301,11 @@ parameterized_main(void)
 	 * Setup keyboard daemon
 	 */
 	if (!error) {
-		g_kbdaemon_arr = malloc(sizeof(wbk_kbdaemon_t **) * B3_KBDAEMON_ARR_LEN);
-		for (i = 0; i < B3_KBDAEMON_ARR_LEN; i++) {
-			g_kbdaemon_arr[i] = wbk_kbdaemon_new(kbdaemon_exec_fn);
-			if (g_kbdaemon_arr[i]) {
-				error = wbk_kbdaemon_start(g_kbdaemon_arr[i]);
-			} else {
-				error = 1;
-			}
+		g_kbdaemon = wbk_kbdaemon_new(kbdaemon_exec_fn);
+		if (g_kbdaemon) {
+			error = wbk_kbdaemon_start(g_kbdaemon);
+		} else {
+			error = 1;
 		}
 	}
 
@@ -274,32 +320,36 @@ parameterized_main(void)
 		b3_win_watcher_stop(win_watcher);
 	}
 
-	if (g_kbdaemon_arr) {
-		for (i = 0; i < B3_KBDAEMON_ARR_LEN; i++) {
-			if (g_kbdaemon_arr[i]) {
-				wbk_kbdaemon_free(g_kbdaemon_arr[i]);
-				g_kbdaemon_arr[i] = NULL;
-			}
-		}
-		free(g_kbdaemon_arr);
-		g_kbdaemon_arr = NULL;
+	if (g_kbdaemon) {
+		wbk_kbdaemon_free(g_kbdaemon);
+		g_kbdaemon = NULL;
 	}
 
-	if (g_kbman_arr) {
-		for (i = 0; i < B3_KBDAEMON_ARR_LEN; i++) {
-			if (g_kbman_arr[i]) {
-				wbk_kbman_free(g_kbman_arr[i]);
-				g_kbman_arr[i] = NULL;
-			}
-		}
-		free(g_kbman_arr);
-		g_kbman_arr = NULL;
+	if (g_mousedaemon) {
+		b3_mousedaemon_free(g_mousedaemon);
+		g_mousedaemon = NULL;
+	}
+
+	if (g_mouseman) {
+		b3_mouseman_free(g_mouseman);
+		g_mouseman = NULL;
+	}
+
+	if (g_reloader) {
+		b3_reloader_free(g_reloader);
+		g_reloader = NULL;
 	}
 
 	if (win_watcher) {
 		b3_win_watcher_free(win_watcher);
 	}
 
+	if (g_status) {
+		b3_director_set_status(g_director, NULL);
+		b3_status_free(g_status);
+		g_status = NULL;
+	}
+
 	if (g_director) {
 		b3_director_free(g_director);
 	}
@@ -361,14 +411,13 @@ window_callback(HWND window_handler, UINT msg, WPARAM wParam, LPARAM lParam)
 inline int
 kbdaemon_exec_fn(wbk_kbdaemon_t *kbdaemon, wbk_b_t *b)
 {
-	int i;
+	return b3_reloader_exec(g_reloader, b);
+}
 
-	for (i = 0; i < B3_KBDAEMON_ARR_LEN; i++) {
-		if (kbdaemon == g_kbdaemon_arr[i]) {
-			return wbk_kbman_exec(g_kbman_arr[i], b);
-		}
-	}
-	return 1;
+int
+status_update_fn(void *data)
+{
+	return b3_director_update_status((b3_director_t *) data);
 }
 
 int
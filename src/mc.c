@@ -36,7 +36,7 @@ static int
 b3_mc_free_impl(b3_mc_t *mc);
 
 static int
-b3_mc_exec_impl(b3_mc_t *mc);
+b3_mc_exec_impl(b3_mc_t *mc, POINT *position);
 
 b3_mc_t *
 b3_mc_new(void)
@@ -46,6 +46,7 @@ b3_mc_new(void)
     mc = malloc(sizeof(b3_mc_t));
     if (mc) {
         mc->b3_mc_free = b3_mc_free_impl;
+        mc->b3_mc_exec = b3_mc_exec_impl;
     }
 
     return mc;
@@ -58,9 +59,9 @@ b3_mc_free(b3_mc_t *mc)
 }
 
 int
-b3_mc_exec(b3_mc_t *mc)
+b3_mc_exec(b3_mc_t *mc, POINT *position)
 {
-    return mc->b3_mc_exec(mc);
+    return mc->b3_mc_exec(mc, position);
 }
 
 int
@@ -73,7 +74,7 @@ b3_mc_free_impl(b3_mc_t *mc)
 }
 
 int
-b3_mc_exec_impl(b3_mc_t *mc)
+b3_mc_exec_impl(b3_mc_t *mc, POINT *position)
 {
-    // TODO
+    return 0;
 }
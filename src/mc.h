@@ -28,6 +28,8 @@
  * @brief File contains the mouse command class definition
  */
 
+#include <windows.h>
+
 #ifndef B3_MC_H
 #define B3_MC_H
 
@@ -36,16 +38,25 @@ typedef struct b3_mc_s b3_mc_t;
 struct b3_mc_s
 {
    int (*b3_mc_free)(b3_mc_t *mc);
-   int (*b3_mc_exec)(b3_mc_t *mc);
+   int (*b3_mc_exec)(b3_mc_t *mc, POINT *position);
 };
 
+/**
+ * @brief Creates a new mouse command, which does nothing on its own.
+ * @return A new mouse command or NULL if allocation failed
+ */
 extern b3_mc_t *
 b3_mc_new(void);
 
 extern int
 b3_mc_free(b3_mc_t *mc);
 
+/**
+ * @brief Executes the mouse command after the cursor moved
+ * @param position The position of the cursor on the screen
+ * @return Non-0 if the execution failed
+ */
 extern int
-b3_mc_exec(b3_mc_t *mc);
+b3_mc_exec(b3_mc_t *mc, POINT *position);
 
 #endif // B3_MC_H
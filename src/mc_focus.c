@@ -0,0 +1,127 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the focus follows mouse command class implementation
+ * and its private methods.
+ */
+
+#include "mc_focus.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <w32bindkeys/logger.h>
+
+static wbk_logger_t logger = { "mc_focus" };
+
+static int
+b3_mc_focus_free_impl(b3_mc_t *mc);
+
+static int
+b3_mc_focus_exec_impl(b3_mc_t *mc, POINT *position);
+
+b3_mc_t *
+b3_mc_focus_new(b3_director_t *director)
+{
+    b3_mc_t *mc;
+    b3_mc_focus_t *mc_focus;
+
+    mc_focus = malloc(sizeof(b3_mc_focus_t));
+    if (mc_focus) {
+        memset(mc_focus, 0, sizeof(b3_mc_focus_t));
+
+        mc = b3_mc_new();
+        memcpy(mc_focus, mc, sizeof(b3_mc_t));
+        free(mc); /* Just free the top level element */
+
+        mc_focus->super_mc_free = mc_focus->mc.b3_mc_free;
+        mc_focus->super_mc_exec = mc_focus->mc.b3_mc_exec;
+
+        mc_focus->mc.b3_mc_free = b3_mc_focus_free_impl;
+        mc_focus->mc.b3_mc_exec = b3_mc_focus_exec_impl;
+
+        mc_focus->b3_mc_focus_win = b3_director_focus_win;
+
+        mc_focus->director = director;
+        mc_focus->target = NULL;
+    }
+
+    return (b3_mc_t *) mc_focus;
+}
+
+int
+b3_mc_focus_free_impl(b3_mc_t *mc)
+{
+    b3_mc_focus_t *mc_focus;
+
+    mc_focus = (b3_mc_focus_t *) mc;
+    mc_focus->director = NULL;
+
+    return mc_focus->super_mc_free(mc);
+}
+
+int
+b3_mc_focus_exec_impl(b3_mc_t *mc, POINT *position)
+{
+    b3_mc_focus_t *mc_focus;
+    b3_win_t *win;
+    int error;
+
+    mc_focus = (b3_mc_focus_t *) mc;
+    error = 0;
+
+    /**
+     * Do not focus another window while dragging
+     */
+    if (GetAsyncKeyState(VK_LBUTTON) & 0x8000
+        || GetAsyncKeyState(VK_RBUTTON) & 0x8000) {
+        return error;
+    }
+
+    /**
+     * The window must not be removed before it is focused
+     */
+    b3_director_begin_transaction(mc_focus->director);
+
+    win = b3_director_get_win_at_pos(mc_focus->director, position);
+    if (win && b3_win_get_window_handler(win) != mc_focus->target) {
+        mc_focus->target = b3_win_get_window_handler(win);
+
+        wbk_logger_log(&logger, DEBUG, "Focusing window under the cursor - X: %d, Y: %d\n",
+                       position->x, position->y);
+        error = mc_focus->b3_mc_focus_win(mc_focus->director, win);
+    } else if (win == NULL) {
+        /**
+         * The cursor left the managed windows, so the window it returns to is
+         * focused again
+         */
+        mc_focus->target = NULL;
+    }
+
+    b3_director_commit_transaction(mc_focus->director);
+
+    return error;
+}
@@ -0,0 +1,70 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the focus follows mouse command class definition
+ *
+ * b3_mc_focus_t inherits all methods of b3_mc_t (see mc.h). It focuses the
+ * window under the cursor, like focus_follows_mouse of i3. The window is only
+ * focused when the cursor enters it, moving within the window or over space
+ * without a managed window does not change the focus.
+ */
+
+#include "mc.h"
+#include "director.h"
+
+#ifndef B3_MC_FOCUS_H
+#define B3_MC_FOCUS_H
+
+typedef struct b3_mc_focus_s
+{
+    b3_mc_t mc;
+    int (*super_mc_free)(b3_mc_t *mc);
+    int (*super_mc_exec)(b3_mc_t *mc, POINT *position);
+
+    /**
+     * Focuses a window of the director. Replaceable for testing.
+     */
+    int (*b3_mc_focus_win)(b3_director_t *director, b3_win_t *win);
+
+    b3_director_t *director;
+
+    /**
+     * The window the cursor was over during the last execution. NULL if there
+     * was none.
+     */
+    HWND target;
+} b3_mc_focus_t;
+
+/**
+ * @brief Creates a new focus follows mouse command
+ * @param director It will not be freed by the mouse command.
+ * @return A new mouse command or NULL if allocation failed
+ */
+extern b3_mc_t *
+b3_mc_focus_new(b3_director_t *director);
+
+#endif // B3_MC_FOCUS_H
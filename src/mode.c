@@ -0,0 +1,145 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the binding mode class implementation
+ */
+
+#include "mode.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+b3_mode_t *
+b3_mode_new(const char *name)
+{
+  b3_mode_t *mode;
+
+  mode = malloc(sizeof(b3_mode_t));
+  if (mode) {
+    mode->name = strdup(name);
+    mode->kbman = wbk_kbman_new();
+  }
+
+  return mode;
+}
+
+int
+b3_mode_free(b3_mode_t *mode)
+{
+  free(mode->name);
+  mode->name = NULL;
+
+  if (mode->kbman) {
+    wbk_kbman_free(mode->kbman);
+    mode->kbman = NULL;
+  }
+
+  free(mode);
+
+  return 0;
+}
+
+const char *
+b3_mode_get_name(const b3_mode_t *mode)
+{
+  return mode->name;
+}
+
+wbk_kbman_t *
+b3_mode_get_kbman(const b3_mode_t *mode)
+{
+  return mode->kbman;
+}
+
+wbk_kbman_t *
+b3_mode_take_kbman(b3_mode_t *mode)
+{
+  wbk_kbman_t *kbman;
+
+  kbman = mode->kbman;
+  mode->kbman = NULL;
+
+  return kbman;
+}
+
+int
+b3_mode_merge(b3_mode_t *mode, b3_mode_t *other)
+{
+  int i;
+
+  for (i = 0; i < other->kbman->kc_arr_len; i++) {
+    wbk_kbman_add(mode->kbman, other->kbman->kc_arr[i]);
+  }
+
+  /**
+   * The key commands are owned by mode now
+   */
+  other->kbman->kc_arr_len = 0;
+
+  return 0;
+}
+
+b3_mode_t *
+b3_mode_find(CC_Array *mode_arr, const char *name)
+{
+  CC_ArrayIter iter;
+  b3_mode_t *mode;
+  b3_mode_t *found;
+
+  found = NULL;
+
+  cc_array_iter_init(&iter, mode_arr);
+  while (found == NULL && cc_array_iter_next(&iter, (void*) &mode) != CC_ITER_END) {
+    if (strcmp(mode->name, name) == 0) {
+      found = mode;
+    }
+  }
+
+  return found;
+}
+
+int
+b3_mode_merge_all(CC_Array *mode_arr, CC_Array *other_mode_arr)
+{
+  CC_ArrayIter iter;
+  b3_mode_t *other;
+  b3_mode_t *mode;
+
+  cc_array_iter_init(&iter, other_mode_arr);
+  while (cc_array_iter_next(&iter, (void*) &other) != CC_ITER_END) {
+    mode = b3_mode_find(mode_arr, other->name);
+    if (mode) {
+      b3_mode_merge(mode, other);
+      b3_mode_free(other);
+    } else {
+      cc_array_add(mode_arr, other);
+    }
+  }
+  cc_array_remove_all(other_mode_arr);
+
+  return 0;
+}
@@ -0,0 +1,106 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the binding mode class definition
+ *
+ * A binding mode is a named set of key bindings, which replaces the bindings
+ * of the configuration while it is active. It is declared by a block like
+ * mode "resize" { ... } and activated by the key command mode "resize". The
+ * mode "default" stands for the bindings outside of any block.
+ */
+
+#ifndef B3_MODE_H
+#define B3_MODE_H
+
+#include <collectc/cc_array.h>
+#include <w32bindkeys/kbman.h>
+
+/**
+ * Name of the mode of the bindings outside of any block
+ */
+#define B3_MODE_DEFAULT "default"
+
+typedef struct b3_mode_s
+{
+  char *name;
+
+  /**
+   * The key bindings of the mode or NULL if they were taken
+   */
+  wbk_kbman_t *kbman;
+} b3_mode_t;
+
+/**
+ * @param name The name of the mode. The string is copied.
+ * @return A new mode without key bindings
+ */
+extern b3_mode_t *
+b3_mode_new(const char *name);
+
+extern int
+b3_mode_free(b3_mode_t *mode);
+
+/**
+ * @return The name of the mode. Do not free it!
+ */
+extern const char *
+b3_mode_get_name(const b3_mode_t *mode);
+
+/**
+ * @return The key bindings of the mode. Do not free them!
+ */
+extern wbk_kbman_t *
+b3_mode_get_kbman(const b3_mode_t *mode);
+
+/**
+ * @return The key bindings of the mode. They are not owned by the mode
+ * anymore, free them by yourself!
+ */
+extern wbk_kbman_t *
+b3_mode_take_kbman(b3_mode_t *mode);
+
+/**
+ * @brief Moves the key bindings of other behind the ones of mode.
+ */
+extern int
+b3_mode_merge(b3_mode_t *mode, b3_mode_t *other);
+
+/**
+ * @param mode_arr An array of b3_mode_t
+ * @return The mode called name or NULL if there is none. Do not free it!
+ */
+extern b3_mode_t *
+b3_mode_find(CC_Array *mode_arr, const char *name);
+
+/**
+ * @brief Moves the modes of other_mode_arr into mode_arr. Modes with the same
+ * name are merged, see b3_mode_merge(). other_mode_arr is empty afterwards.
+ */
+extern int
+b3_mode_merge_all(CC_Array *mode_arr, CC_Array *other_mode_arr);
+
+#endif // B3_MODE_H
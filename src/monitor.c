@@ -32,28 +32,22 @@
 static wbk_logger_t logger = { "monitor" };
 
 /**
- * Communication structure for b3_monitor_arrange_wins() and
- * b3_monitor_arrange_wins_ws_visitor().
+ * Minimizes the windows of a workspace which is not focused on the monitor.
+ *
+ * @param data The monitor
  */
-typedef struct b3_monitor_arrange_wins_comm_s
-{
-  b3_monitor_t *monitor;
-} b3_monitor_arrange_wins_comm_t;
-
-/**
- * Belongs to b3_monitor_arrange_wins() and
- * b3_monitor_arrange_wins_ws_visitor(). Do not set it somewhere else!
- */
-static b3_monitor_arrange_wins_comm_t g_arrange_comm;
-
 static void
-b3_monitor_arrange_wins_ws_visitor(b3_ws_t *ws);
+b3_monitor_arrange_wins_ws_visitor(b3_ws_t *ws, void *data);
 
 void
-b3_monitor_arrange_wins_ws_visitor(b3_ws_t *ws)
+b3_monitor_arrange_wins_ws_visitor(b3_ws_t *ws, void *data)
 {
+  b3_monitor_t *monitor;
+
+  monitor = (b3_monitor_t *) data;
+
   if (strcmp(b3_ws_get_name(ws),
-             b3_ws_get_name(b3_monitor_get_focused_ws(g_arrange_comm.monitor)))) {
+             b3_ws_get_name(b3_monitor_get_focused_ws(monitor)))) {
     b3_ws_minimize_wins(ws);
   }
 }
@@ -68,7 +62,8 @@ b3_monitor_get_win_at_pos_impl(b3_monitor_t *monitor, POINT *position);
 b3_monitor_new(const char *monitor_name,
 			   RECT monitor_area,
 			   b3_wsman_factory_t *wsman_factory,
-			   b3_ws_switcher_t *ws_switcher)
+			   b3_ws_switcher_t *ws_switcher,
+			   b3_textcache_t *textcache)
 {
 	b3_monitor_t *monitor;
 	int length;
@@ -89,7 +84,7 @@ b3_monitor_new(const char *monitor_name,
 
 		monitor->wsman = b3_wsman_factory_create(wsman_factory);
 
-		monitor->bar = b3_bar_new(monitor->monitor_name, monitor->monitor_area, monitor->wsman, ws_switcher);
+		monitor->bar = b3_bar_new(monitor->monitor_name, monitor->monitor_area, monitor->wsman, ws_switcher, textcache);
 	}
 
 	return monitor;
@@ -205,8 +200,7 @@ b3_monitor_arrange_wins(b3_monitor_t *monitor)
 		wbk_logger_log(&logger, SEVERE, "Arraning wins - bar position %d is not supported\n", b3_bar_get_position(bar));
 	}
 
-  g_arrange_comm.monitor = monitor;
-  b3_wsman_iterate_ws_arr(monitor->wsman, b3_monitor_arrange_wins_ws_visitor);
+  b3_wsman_iterate_ws_arr(monitor->wsman, b3_monitor_arrange_wins_ws_visitor, monitor);
 
 	b3_ws_arrange_wins(b3_monitor_get_focused_ws(monitor), monitor_area);
 
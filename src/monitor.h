@@ -63,13 +63,15 @@ struct b3_monitor_s
  * @param monitor_area The rectangle of the work area
  * @param wsman_factory A workspace manager factory object. It will not be freed by the monitor.
  * @param ws_switcher
- * @return A new monitor object or NULL if allocation failed
- */
-extern b3_monitor_t *
+ * @param textcache Passed to the bar. It will not be freed by the monitor.
+ * @return A new monitor object or NULL if allocation failed
+ */
+extern b3_monitor_t *
 b3_monitor_new(const char *monitor_name,
 			   RECT monitor_area,
 			   b3_wsman_factory_t *wsman_factory,
-			   b3_ws_switcher_t *ws_switcher);
+			   b3_ws_switcher_t *ws_switcher,
+			   b3_textcache_t *textcache);
 
 /**
  * @brief Frees a monitor object
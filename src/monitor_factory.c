@@ -35,6 +35,8 @@ b3_monitor_factory_new(b3_wsman_factory_t *wsman_factory)
 
 	monitor_factory->wsman_factory = wsman_factory;
 
+	monitor_factory->textcache = b3_textcache_new(B3_TEXTCACHE_DEFAULT_CAPACITY);
+
 	return monitor_factory;
 }
 
@@ -43,6 +45,9 @@ b3_monitor_factory_free(b3_monitor_factory_t *monitor_factory)
 {
 	monitor_factory->wsman_factory = NULL;
 
+	b3_textcache_free(monitor_factory->textcache);
+	monitor_factory->textcache = NULL;
+
 	free(monitor_factory);
 
 	return 0;
@@ -59,7 +64,8 @@ b3_monitor_factory_create(b3_monitor_factory_t *monitor_factory,
 	monitor = b3_monitor_new(monitor_name,
 							 monitor_area,
 							 monitor_factory->wsman_factory,
-							 ws_switcher);
+							 ws_switcher,
+							 monitor_factory->textcache);
 
 	return monitor;
 }
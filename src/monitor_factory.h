@@ -31,6 +31,7 @@
 #include "wsman_factory.h"
 #include "monitor.h"
 #include "ws_switcher.h"
+#include "textcache.h"
 
 #ifndef B3_MONITOR_FACTORY_H
 #define B3_MONITOR_FACTORY_H
@@ -38,6 +39,11 @@
 typedef struct b3_monitor_factory_s
 {
 	b3_wsman_factory_t *wsman_factory;
+
+	/**
+	 * Shared by the bars of all monitors created by the factory
+	 */
+	b3_textcache_t *textcache;
 } b3_monitor_factory_t;
 
 /**
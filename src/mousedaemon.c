@@ -31,20 +31,83 @@
 #include "mousedaemon.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <w32bindkeys/logger.h>
+
+static wbk_logger_t logger = { "mousedaemon" };
+
+/**
+ * The started mouse daemon, the hook procedure cannot be passed any data.
+ * Belongs to b3_mousedaemon_start_impl() and b3_mousedaemon_stop_impl(). Do
+ * not set it somewhere else!
+ */
+static b3_mousedaemon_t *g_mousedaemon = NULL;
 
 static int
 b3_mousedaemon_free_impl(b3_mousedaemon_t *mousedaemon);
 
+static int
+b3_mousedaemon_start_impl(b3_mousedaemon_t *mousedaemon);
+
+static int
+b3_mousedaemon_stop_impl(b3_mousedaemon_t *mousedaemon);
+
+/**
+ * Records the position of the cursor. It must return quickly, otherwise
+ * Windows removes the hook.
+ */
+static LRESULT CALLBACK
+b3_mousedaemon_hook_proc(int code, WPARAM wParam, LPARAM lParam);
+
+/**
+ * Installs the hook and runs the message loop it is called from.
+ */
+static DWORD WINAPI
+b3_mousedaemon_hook_thread(LPVOID param);
+
+/**
+ * Executes the mouse manager with the latest position after the cursor moved.
+ */
+static DWORD WINAPI
+b3_mousedaemon_exec_thread(LPVOID param);
+
+/**
+ * @return The refresh rate of the primary display in Hz. 0 or 1 if it is
+ * unknown.
+ */
+static int
+b3_mousedaemon_get_refresh_rate(void);
+
+/**
+ * @return The position packed into 64 bits, x in the low and y in the high
+ * half
+ */
+static LONGLONG
+b3_mousedaemon_pack_position(POINT position);
+
+static POINT
+b3_mousedaemon_unpack_position(LONGLONG packed);
+
 b3_mousedaemon_t *
-b3_mousedaemon_new(void)
+b3_mousedaemon_new(b3_mouseman_t *mouseman)
 {
     b3_mousedaemon_t *mousedaemon;
 
     mousedaemon = malloc(sizeof(b3_mousedaemon_t));
     if (mousedaemon) {
+        memset(mousedaemon, 0, sizeof(b3_mousedaemon_t));
+
         mousedaemon->b3_mousedaemon_free = b3_mousedaemon_free_impl;
+        mousedaemon->b3_mousedaemon_start = b3_mousedaemon_start_impl;
+        mousedaemon->b3_mousedaemon_stop = b3_mousedaemon_stop_impl;
 
-        mousedaemon->global_mutex = CreateMutex(NULL, FALSE, NULL);
+        mousedaemon->mouseman = mouseman;
+
+        mousedaemon->interval = b3_mousedaemon_get_interval(0);
+
+        mousedaemon->moved_event = CreateEvent(NULL, FALSE, FALSE, NULL);
+        mousedaemon->stop_event = CreateEvent(NULL, TRUE, FALSE, NULL);
     }
 
     return mousedaemon;
@@ -56,10 +119,216 @@ b3_mousedaemon_free(b3_mousedaemon_t *mousedaemon)
     return mousedaemon->b3_mousedaemon_free(mousedaemon);
 }
 
+int
+b3_mousedaemon_start(b3_mousedaemon_t *mousedaemon)
+{
+    return mousedaemon->b3_mousedaemon_start(mousedaemon);
+}
+
+int
+b3_mousedaemon_stop(b3_mousedaemon_t *mousedaemon)
+{
+    return mousedaemon->b3_mousedaemon_stop(mousedaemon);
+}
+
+DWORD
+b3_mousedaemon_get_interval(int refresh_rate)
+{
+    if (refresh_rate <= 1) {
+        refresh_rate = B3_MOUSEDAEMON_DEFAULT_REFRESH_RATE;
+    }
+
+    return refresh_rate < 1000 ? 1000 / refresh_rate : 1;
+}
+
 int
 b3_mousedaemon_free_impl(b3_mousedaemon_t *mousedaemon)
 {
+    b3_mousedaemon_stop(mousedaemon);
+
+    mousedaemon->mouseman = NULL;
+
+    CloseHandle(mousedaemon->moved_event);
+    CloseHandle(mousedaemon->stop_event);
+
     free(mousedaemon);
 
     return 0;
 }
+
+int
+b3_mousedaemon_start_impl(b3_mousedaemon_t *mousedaemon)
+{
+    int error;
+
+    error = 0;
+
+    if (g_mousedaemon) {
+        wbk_logger_log(&logger, SEVERE, "Another mouse daemon is already started\n");
+        error = 1;
+    }
+
+    if (!error) {
+        g_mousedaemon = mousedaemon;
+
+        mousedaemon->interval = b3_mousedaemon_get_interval(b3_mousedaemon_get_refresh_rate());
+        wbk_logger_log(&logger, INFO, "Executing mouse commands at most every %lu ms\n",
+                       mousedaemon->interval);
+
+        ResetEvent(mousedaemon->stop_event);
+
+        mousedaemon->exec_thread = CreateThread(NULL, 0, b3_mousedaemon_exec_thread,
+                                                mousedaemon, 0, NULL);
+        mousedaemon->hook_thread = CreateThread(NULL, 0, b3_mousedaemon_hook_thread,
+                                                mousedaemon, 0, &(mousedaemon->hook_thread_id));
+        if (mousedaemon->exec_thread == NULL || mousedaemon->hook_thread == NULL) {
+            wbk_logger_log(&logger, SEVERE, "Could not start the threads of the mouse daemon\n");
+            b3_mousedaemon_stop(mousedaemon);
+            error = 1;
+        }
+    }
+
+    return error;
+}
+
+int
+b3_mousedaemon_stop_impl(b3_mousedaemon_t *mousedaemon)
+{
+    if (mousedaemon->hook_thread) {
+        /**
+         * Posting fails until the thread has created its message queue
+         */
+        while (!PostThreadMessage(mousedaemon->hook_thread_id, WM_QUIT, 0, 0)
+               && WaitForSingleObject(mousedaemon->hook_thread, 10) == WAIT_TIMEOUT);
+
+        WaitForSingleObject(mousedaemon->hook_thread, INFINITE);
+        CloseHandle(mousedaemon->hook_thread);
+        mousedaemon->hook_thread = NULL;
+    }
+
+    if (mousedaemon->exec_thread) {
+        SetEvent(mousedaemon->stop_event);
+        WaitForSingleObject(mousedaemon->exec_thread, INFINITE);
+        CloseHandle(mousedaemon->exec_thread);
+        mousedaemon->exec_thread = NULL;
+    }
+
+    if (g_mousedaemon == mousedaemon) {
+        g_mousedaemon = NULL;
+    }
+
+    return 0;
+}
+
+LRESULT CALLBACK
+b3_mousedaemon_hook_proc(int code, WPARAM wParam, LPARAM lParam)
+{
+    MSLLHOOKSTRUCT *info;
+
+    if (code == HC_ACTION && wParam == WM_MOUSEMOVE && g_mousedaemon) {
+        info = (MSLLHOOKSTRUCT *) lParam;
+
+        InterlockedExchange64(&(g_mousedaemon->position), b3_mousedaemon_pack_position(info->pt));
+
+        SetEvent(g_mousedaemon->moved_event);
+    }
+
+    return CallNextHookEx(NULL, code, wParam, lParam);
+}
+
+DWORD WINAPI
+b3_mousedaemon_hook_thread(LPVOID param)
+{
+    HHOOK hook;
+    MSG msg;
+
+    hook = SetWindowsHookEx(WH_MOUSE_LL, b3_mousedaemon_hook_proc, GetModuleHandle(NULL), 0);
+    if (hook == NULL) {
+        wbk_logger_log(&logger, SEVERE, "Could not install the mouse hook\n");
+        return 1;
+    }
+
+    while (GetMessage(&msg, NULL, 0, 0) > 0) {
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+    }
+
+    UnhookWindowsHookEx(hook);
+
+    return 0;
+}
+
+DWORD WINAPI
+b3_mousedaemon_exec_thread(LPVOID param)
+{
+    b3_mousedaemon_t *mousedaemon;
+    HANDLE handle_arr[2];
+    POINT position;
+    POINT last_position;
+    char executed;
+
+    mousedaemon = (b3_mousedaemon_t *) param;
+    handle_arr[0] = mousedaemon->stop_event;
+    handle_arr[1] = mousedaemon->moved_event;
+    executed = 0;
+
+    while (WaitForMultipleObjects(2, handle_arr, FALSE, INFINITE) == WAIT_OBJECT_0 + 1) {
+        position = b3_mousedaemon_unpack_position(InterlockedCompareExchange64(&(mousedaemon->position), 0, 0));
+
+        if (!executed
+            || position.x != last_position.x
+            || position.y != last_position.y) {
+            b3_mouseman_exec(mousedaemon->mouseman, &position);
+            last_position = position;
+            executed = 1;
+        }
+
+        /**
+         * Movements until the next refresh are coalesced into the latest
+         * position
+         */
+        if (WaitForSingleObject(mousedaemon->stop_event, mousedaemon->interval) == WAIT_OBJECT_0) {
+            break;
+        }
+    }
+
+    return 0;
+}
+
+int
+b3_mousedaemon_get_refresh_rate(void)
+{
+    HDC hdc;
+    int refresh_rate;
+
+    refresh_rate = 0;
+
+    hdc = GetDC(NULL);
+    if (hdc) {
+        refresh_rate = GetDeviceCaps(hdc, VREFRESH);
+        ReleaseDC(NULL, hdc);
+    }
+
+    return refresh_rate;
+}
+
+LONGLONG
+b3_mousedaemon_pack_position(POINT position)
+{
+    /**
+     * Monitors left of or above the primary one have negative coordinates,
+     * they are packed as unsigned halves
+     */
+    return (LONGLONG) (((ULONGLONG) (DWORD) position.y << 32) | (DWORD) position.x);
+}
+
+POINT
+b3_mousedaemon_unpack_position(LONGLONG packed)
+{
+    POINT position;
+
+    position.x = (LONG) (DWORD) ((ULONGLONG) packed & 0xFFFFFFFF);
+    position.y = (LONG) (DWORD) ((ULONGLONG) packed >> 32);
+
+    return position;
+}
@@ -26,26 +26,93 @@
  * @author Richard Bäck <richard.baeck@mailbox.org>
  * @date 2021-09-15
  * @brief File contains the mouse daemon class definition.
+ *
+ * The mouse daemon installs a low level mouse hook, which only records the
+ * latest position of the cursor. An executing thread passes the position to
+ * the mouse manager, at most once per refresh of the display. All movements in
+ * between are coalesced into the latest position.
  */
 
 #include <windows.h>
 
+#include "mouseman.h"
+
 #ifndef B3_MOUSEDAEMON_H
 #define B3_MOUSEDAEMON_H
 
+/**
+ * Used if the refresh rate of the display is unknown
+ */
+#define B3_MOUSEDAEMON_DEFAULT_REFRESH_RATE 60
+
 typedef struct b3_mousedaemon_s b3_mousedaemon_t;
 
 struct b3_mousedaemon_s
 {
 	int (*b3_mousedaemon_free)(b3_mousedaemon_t *mousedaemon);
+	int (*b3_mousedaemon_start)(b3_mousedaemon_t *mousedaemon);
+	int (*b3_mousedaemon_stop)(b3_mousedaemon_t *mousedaemon);
+
+    b3_mouseman_t *mouseman;
+
+    /**
+     * Minimum time between two executions in milliseconds
+     */
+    DWORD interval;
+
+    /**
+     * Latest position of the cursor. It is packed into 64 bits, so that the
+     * hook publishes it with a single InterlockedExchange64().
+     */
+    volatile LONGLONG position;
 
-    HANDLE global_mutex;
+    /**
+     * Signaled after the cursor moved
+     */
+    HANDLE moved_event;
+
+    HANDLE stop_event;
+
+    HANDLE hook_thread;
+    DWORD hook_thread_id;
+
+    HANDLE exec_thread;
 };
 
+/**
+ * @param mouseman The mouse manager executed after the cursor moved. It will
+ * not be freed by the mouse daemon.
+ * @return A new mouse daemon or NULL if allocation failed
+ */
 extern b3_mousedaemon_t *
-b3_mousedaemon_new(void);
+b3_mousedaemon_new(b3_mouseman_t *mouseman);
 
+/**
+ * Stops the mouse daemon if it is running and frees it.
+ */
 extern int
 b3_mousedaemon_free(b3_mousedaemon_t *mousedaemon);
 
+/**
+ * @brief Installs the mouse hook and starts the threads. Only one mouse daemon
+ * can be started at a time.
+ * @return Non-0 if the mouse daemon could not be started
+ */
+extern int
+b3_mousedaemon_start(b3_mousedaemon_t *mousedaemon);
+
+/**
+ * @brief Removes the mouse hook and waits for the threads to end.
+ */
+extern int
+b3_mousedaemon_stop(b3_mousedaemon_t *mousedaemon);
+
+/**
+ * @param refresh_rate The refresh rate of the display in Hz. 0 or 1 if it is
+ * unknown.
+ * @return The interval between two executions in milliseconds.
+ */
+extern DWORD
+b3_mousedaemon_get_interval(int refresh_rate);
+
 #endif // B3_MOUSEDAEMON_H
@@ -42,7 +42,7 @@ static int
 b3_mouseman_add_impl(b3_mouseman_t *mouseman, b3_mc_t *mc);
 
 static int
-b3_mouseman_exec_impl(b3_mouseman_t *mouseman);
+b3_mouseman_exec_impl(b3_mouseman_t *mouseman, POINT *position);
 
 b3_mouseman_t *
 b3_mouseman_new(void)
@@ -53,6 +53,7 @@ b3_mouseman_new(void)
     if (mouseman) {
         mouseman->b3_mouseman_free = b3_mouseman_free_impl;
         mouseman->b3_mouseman_add = b3_mouseman_add_impl;
+        mouseman->b3_mouseman_exec = b3_mouseman_exec_impl;
 
         mouseman->mc_arr_len = 0;
         mouseman->mc_arr = NULL;
@@ -74,14 +75,21 @@ b3_mouseman_add(b3_mouseman_t *mouseman, b3_mc_t *mc)
 }
 
 int
-b3_mouseman_exec(b3_mouseman_t *mouseman)
+b3_mouseman_exec(b3_mouseman_t *mouseman, POINT *position)
 {
-    return mouseman->b3_mouseman_exec(mouseman);
+    return mouseman->b3_mouseman_exec(mouseman, position);
 }
 
 int
 b3_mouseman_free_impl(b3_mouseman_t *mouseman)
 {
+    int i;
+
+    for (i = 0; i < mouseman->mc_arr_len; i++) {
+        b3_mc_free(mouseman->mc_arr[i]);
+    }
+    free(mouseman->mc_arr);
+
     free(mouseman);
 
     return 0;
@@ -96,13 +104,20 @@ b3_mouseman_add_impl(b3_mouseman_t *mouseman, b3_mc_t *mc)
 	mouseman->mc_arr[mouseman->mc_arr_len - 1] = mc;
     return 0;
 }
-/**
- * https://docs.microsoft.com/en-us/windows/win32/winmsg/using-hooks
- * https://docs.microsoft.com/en-us/previous-versions/windows/desktop/legacy/ms644986(v=vs.85)
- * https://docs.microsoft.com/de-at/windows/win32/inputdev/wm-mousemove?redirectedfrom=MSDN
- */
 int
-b3_mouseman_exec_impl(b3_mouseman_t *mouseman)
+b3_mouseman_exec_impl(b3_mouseman_t *mouseman, POINT *position)
 {
-    // TODO
+    int error;
+    int i;
+
+    error = 0;
+    for (i = 0; i < mouseman->mc_arr_len; i++) {
+        if (b3_mc_exec(mouseman->mc_arr[i], position)) {
+            wbk_logger_log(&logger, WARNING, "Mouse command failed at - X: %d, Y: %d\n",
+                           position->x, position->y);
+            error = 1;
+        }
+    }
+
+    return error;
 }
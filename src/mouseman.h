@@ -39,7 +39,7 @@ struct b3_mouseman_s
 {
    int (*b3_mouseman_free)(b3_mouseman_t *mouseman);
    int (*b3_mouseman_add)(b3_mouseman_t *mouseman, b3_mc_t *mc);
-   int (*b3_mouseman_exec)(b3_mouseman_t *mouseman);
+   int (*b3_mouseman_exec)(b3_mouseman_t *mouseman, POINT *position);
 
    int mc_arr_len;
    b3_mc_t **mc_arr;
@@ -57,7 +57,12 @@ b3_mouseman_free(b3_mouseman_t *mouseman);
 extern int
 b3_mouseman_add(b3_mouseman_t *mouseman, b3_mc_t *mc);
 
+/**
+ * @brief Executes all mouse commands after the cursor moved
+ * @param position The position of the cursor on the screen
+ * @return Non-0 if any mouse command failed
+ */
 extern int
-b3_mouseman_exec(b3_mouseman_t *mouseman);
+b3_mouseman_exec(b3_mouseman_t *mouseman, POINT *position);
 
 #endif // B3_MOUSEMAN_H
@@ -46,6 +46,18 @@ b3_mwtw_action_free_impl(b3_action_t *action);
 static int
 b3_mwtw_action_exec_impl(b3_action_t *action, b3_director_t *director, b3_win_t *win);
 
+/**
+ * Implementation of b3_action_prepare().
+ */
+static int
+b3_mwtw_action_prepare_impl(b3_action_t *action, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement);
+
+/**
+ * Implementation of b3_action_equals().
+ */
+static int
+b3_mwtw_action_equals_impl(b3_action_t *action, b3_action_t *other);
+
 b3_mwtw_action_t *
 b3_mwtw_action_new(char *ws_id)
 {
@@ -61,9 +73,13 @@ b3_mwtw_action_new(char *ws_id)
 
     mwtw_action->super_action_free = mwtw_action->action.action_free;
     mwtw_action->super_action_exec = mwtw_action->action.action_exec;
+    mwtw_action->super_action_prepare = mwtw_action->action.action_prepare;
+    mwtw_action->super_action_equals = mwtw_action->action.action_equals;
 
     mwtw_action->action.action_free = b3_mwtw_action_free_impl;
     mwtw_action->action.action_exec = b3_mwtw_action_exec_impl;
+    mwtw_action->action.action_prepare = b3_mwtw_action_prepare_impl;
+    mwtw_action->action.action_equals = b3_mwtw_action_equals_impl;
 
     mwtw_action->ws_id = ws_id;
   }
@@ -98,3 +114,36 @@ b3_mwtw_action_exec_impl(b3_action_t *action, b3_director_t *director, b3_win_t
 
   return error;
 }
+
+int
+b3_mwtw_action_prepare_impl(b3_action_t *action, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement)
+{
+  b3_mwtw_action_t *mwtw_action;
+
+  mwtw_action = (b3_mwtw_action_t *) action;
+
+  placement->ws_id = mwtw_action->ws_id;
+
+  return 0;
+}
+
+int
+b3_mwtw_action_equals_impl(b3_action_t *action, b3_action_t *other)
+{
+  int equals;
+
+  equals = (other->action_equals == action->action_equals);
+
+  if (equals) {
+    equals = (strcmp(((b3_mwtw_action_t *) action)->ws_id,
+                     ((b3_mwtw_action_t *) other)->ws_id) == 0);
+  }
+
+  return equals;
+}
+
+int
+b3_mwtw_action_instance_of(const b3_action_t *action)
+{
+  return action->action_free == b3_mwtw_action_free_impl;
+}
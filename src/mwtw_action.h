@@ -47,6 +47,8 @@ struct b3_mwtw_action_s
   b3_action_t action;
   int (*super_action_free)(b3_action_t *action);
   int (*super_action_exec)(b3_action_t *action, b3_director_t *director, b3_win_t *win);
+  int (*super_action_prepare)(b3_action_t *action, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement);
+  int (*super_action_equals)(b3_action_t *action, b3_action_t *other);
 
   int (*mwtw_action_add)(b3_mwtw_action_t *mwtw_action, b3_action_t *new_action);
 
@@ -60,4 +62,10 @@ struct b3_mwtw_action_s
 extern b3_mwtw_action_t *
 b3_mwtw_action_new(char *ws_id);
 
+/**
+ * @return Non-0 if action is a move window to workspace action.
+ */
+extern int
+b3_mwtw_action_instance_of(const b3_action_t *action);
+
 #endif // B3_MWTW_ACTION_H
@@ -31,12 +31,328 @@
 #include "parser.h"
 
 #include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <w32bindkeys/logger.h>
+#include <w32bindkeys/util.h>
 
 #include "parser_gen.h"
 #include "lexer_gen.h"
+#include "rule.h"
+#include "mode.h"
 
+/**
+ * Maximum depth of nested include statements
+ */
+#define B3_PARSER_INCLUDE_DEPTH 8
+
+/**
+ * Maximum number of threads which parse the fragments of a configuration
+ */
+#define B3_PARSER_THREAD_MAX 16
+
+static wbk_logger_t logger = { "parser" };
+
+typedef struct b3_parser_fragment_s b3_parser_fragment_t;
+
+/**
+ * A configuration file matched by the pattern of an include statement
+ */
+struct b3_parser_fragment_s
+{
+	/**
+	 * Index of the include statement in the including configuration
+	 */
+	int include_index;
+
+	/**
+	 * Full path of the file
+	 */
+	char *filename;
+
+	/**
+	 * The including fragment or NULL if the configuration itself includes this
+	 * fragment. Following it yields the chain of including files.
+	 */
+	b3_parser_fragment_t *parent;
+
+	/**
+	 * Depth of the fragment in the tree of includes. The fragments included by
+	 * the configuration itself have a depth of 1.
+	 */
+	int depth;
+
+	/**
+	 * The parsed key bindings or NULL if parsing failed. Merging adds the key
+	 * bindings of the included fragments.
+	 */
+	wbk_kbman_t *kbman;
+
+	CC_Array *rule_arr;
+
+	CC_Array *mode_arr;
+
+	/**
+	 * The include statements of the fragment (b3_parser_include_t)
+	 */
+	CC_Array *include_arr;
+
+	/**
+	 * The fragments included by this fragment in include order. They are
+	 * owned by the job.
+	 */
+	CC_Array *child_arr;
+
+	/**
+	 * Number of fragments included by this fragment
+	 */
+	int fragment_len;
+};
+
+/**
+ * The fragments of a configuration. A single pool of threads takes the next
+ * fragment until all of them are parsed. Parsing a fragment appends the
+ * fragments it includes, so nested fragments are parsed by the same threads.
+ */
+typedef struct b3_parser_job_s
+{
+	b3_parser_t *parser;
+	b3_director_t *director;
+
+	/**
+	 * Full path of the configuration or NULL. It starts every chain of
+	 * including files.
+	 */
+	char *filename;
+
+	/**
+	 * Guards fragment_arr, next, pending and error
+	 */
+	HANDLE mutex;
+
+	/**
+	 * Released once for each appended fragment and once for each thread after
+	 * all fragments are parsed
+	 */
+	HANDLE semaphore;
+
+	/**
+	 * All fragments of the configuration (b3_parser_fragment_t)
+	 */
+	CC_Array *fragment_arr;
+
+	/**
+	 * Index of the next fragment to parse
+	 */
+	int next;
+
+	/**
+	 * Number of appended fragments which are not parsed yet
+	 */
+	int pending;
+
+	/**
+	 * Number of threads taking fragments, including the calling one
+	 */
+	int thread_len;
+
+	/**
+	 * Non-0 if a fragment could not be parsed. The remaining fragments are
+	 * skipped then.
+	 */
+	int error;
+} b3_parser_job_t;
+
+/**
+ * @param rule_arr The parsed rules are added to this array. If parsing fails,
+ * then nothing is added.
+ * @param include_arr The parsed include statements are added to this array.
+ * They are not freed by this method, even if parsing fails.
+ * @param mode_arr The parsed modes are added to this array. They are not freed
+ * by this method, even if parsing fails.
+ */
 static wbk_kbman_t *
-b3_parser_parse(b3_parser_t *parser, b3_director_t *director, yyscan_t scanner);
+b3_parser_parse(b3_parser_t *parser, b3_director_t *director, yyscan_t scanner,
+                CC_Array *rule_arr, CC_Array *include_arr, CC_Array *mode_arr);
+
+/**
+ * Parses a configuration and the fragments it includes.
+ *
+ * @param include_dir Relative patterns of include statements are resolved
+ * against this directory. If NULL, then the current working directory is used.
+ * @param filename Name of the configuration or NULL. The fragments may not
+ * include it.
+ * @param mode_arr The parsed modes are merged into this array. If NULL, then
+ * they are freed.
+ * @param fragment_len Increased by the number of included fragments.
+ */
+static wbk_kbman_t *
+b3_parser_parse_included(b3_parser_t *parser, b3_director_t *director, yyscan_t scanner,
+                         const char *include_dir, const char *filename, CC_Array *rule_arr,
+                         CC_Array *mode_arr, int *fragment_len);
+
+/**
+ * Parses the fragments of the include statements and merges them with the
+ * including configuration in include order.
+ *
+ * @param kbman The key bindings of the including configuration. They are
+ * freed by this method.
+ * @param own_rule_arr The rules of the including configuration. They are
+ * moved into rule_arr or freed.
+ * @param mode_arr The modes of the including configuration. The modes of the
+ * fragments are merged into it in include order.
+ * @return The merged key bindings or NULL if a fragment could not be parsed.
+ */
+static wbk_kbman_t *
+b3_parser_merge_includes(b3_parser_t *parser, b3_director_t *director, wbk_kbman_t *kbman,
+                         CC_Array *own_rule_arr, CC_Array *include_arr, const char *include_dir,
+                         const char *filename, CC_Array *rule_arr, CC_Array *mode_arr,
+                         int *fragment_len);
+
+/**
+ * Moves the key commands and rules of a configuration and of the fragments it
+ * includes into the merged configuration. The fragments of an include
+ * statement take its place.
+ *
+ * @param kbman The key bindings of the including configuration. They are
+ * freed by this method.
+ * @param own_rule_arr The rules of the including configuration. They are
+ * moved into rule_arr.
+ * @param child_arr The merged fragments of the include statements in include
+ * order.
+ * @param mode_arr The modes of the fragments are merged into it.
+ * @return The merged key bindings or NULL if they could not be allocated.
+ */
+static wbk_kbman_t *
+b3_parser_merge(wbk_kbman_t *kbman, CC_Array *own_rule_arr, CC_Array *include_arr,
+                CC_Array *child_arr, CC_Array *rule_arr, CC_Array *mode_arr, int *fragment_len);
+
+/**
+ * Merges the fragments included by a fragment into it, the nested ones first.
+ */
+static int
+b3_parser_merge_fragment(b3_parser_fragment_t *fragment);
+
+/**
+ * Adds a fragment for each file matching the pattern of an include
+ * statement. The fragments of a pattern are sorted by their file names.
+ *
+ * @param parent The including fragment or NULL if the configuration itself
+ * includes the pattern.
+ * @param child_arr The fragments are added to this array and to the job.
+ * @return Non-0 if a matching file is already on the chain of including files,
+ * if the includes are nested too deep or if memory is short.
+ */
+static int
+b3_parser_expand_include(b3_parser_job_t *job, b3_parser_fragment_t *parent,
+                         const char *include_dir, const char *pattern, int include_index,
+                         CC_Array *child_arr);
+
+/**
+ * @return Non-0 if filename is the configuration or one of the fragments on
+ * the chain of including files which ends with parent.
+ */
+static int
+b3_parser_is_including(b3_parser_job_t *job, b3_parser_fragment_t *parent, const char *filename);
+
+/**
+ * Appends a fragment to the fragments which are parsed by the threads of the
+ * job. The job owns it afterwards.
+ */
+static int
+b3_parser_job_push(b3_parser_job_t *job, b3_parser_fragment_t *fragment);
+
+/**
+ * Parses the fragments of the job and the fragments they include
+ * concurrently.
+ *
+ * @return Non-0 if at least one fragment could not be parsed.
+ */
+static int
+b3_parser_job_run(b3_parser_job_t *job);
+
+static DWORD WINAPI
+b3_parser_fragments_thread(LPVOID param);
+
+/**
+ * Parses a fragment and appends the fragments it includes to the job.
+ */
+static int
+b3_parser_parse_fragment(b3_parser_job_t *job, b3_parser_fragment_t *fragment);
+
+/**
+ * @return The fragment or NULL if memory is short.
+ */
+static b3_parser_fragment_t *
+b3_parser_fragment_new(b3_parser_fragment_t *parent, const char *dir, const char *name,
+                       int include_index);
+
+static int
+b3_parser_fragment_free(b3_parser_fragment_t *fragment);
+
+/**
+ * Frees the include statements of include_arr and removes them from it.
+ */
+static int
+b3_parser_free_includes(CC_Array *include_arr);
+
+/**
+ * Frees the modes of mode_arr and removes them from it.
+ */
+static int
+b3_parser_free_modes(CC_Array *mode_arr);
+
+/**
+ * Reads the rest of a file into a buffer which can be scanned with
+ * yy_scan_buffer(). The lexer does not copy token values, so the whole input
+ * has to stay in one buffer while it is parsed.
+ *
+ * @param buffer_len Set to the length of the buffer including its two
+ * terminating bytes.
+ * @return The buffer or NULL if memory is short. Free it by yourself!
+ */
+static char *
+b3_parser_read_file(FILE *file, size_t *buffer_len);
+
+/**
+ * @return A newly allocated path or NULL if memory is short. If pattern is
+ * relative and include_dir is not NULL, then the path is relative to
+ * include_dir.
+ */
+static char *
+b3_parser_resolve_pattern(const char *include_dir, const char *pattern);
+
+/**
+ * @return A newly allocated copy of the directory part of path including its
+ * trailing separator. An empty string if path has no directory part. NULL if
+ * memory is short.
+ */
+static char *
+b3_parser_dirname(const char *path);
+
+/**
+ * @return A newly allocated full path of filename or NULL if it could not be
+ * determined.
+ */
+static char *
+b3_parser_full_path(const char *filename);
+
+static int
+b3_parser_compare_names(const void *name, const void *other);
+
+/**
+ * Frees the parts of a statement which were left over by a failed parse.
+ */
+static int
+b3_parser_context_release(b3_parser_context_t *context);
+
+/**
+ * Adds the rules to the director. If kbman is NULL, then the rules are freed
+ * instead.
+ */
+static int
+b3_parser_commit_rules(b3_director_t *director, wbk_kbman_t *kbman, CC_Array *rule_arr);
 
 b3_parser_t *
 b3_parser_new(b3_kc_director_factory_t *kc_director_factory,
@@ -67,10 +383,33 @@ b3_parser_free(b3_parser_t *parser)
 
 wbk_kbman_t *
 b3_parser_parse_str(b3_parser_t *parser, b3_director_t *director, const char *str)
+{
+	wbk_kbman_t *kbman;
+	CC_Array *rule_arr;
+
+	cc_array_new(&rule_arr);
+	kbman = b3_parser_parse_str_staged(parser, director, str, rule_arr);
+	b3_parser_commit_rules(director, kbman, rule_arr);
+	cc_array_destroy(rule_arr);
+
+	return kbman;
+}
+
+wbk_kbman_t *
+b3_parser_parse_str_staged(b3_parser_t *parser, b3_director_t *director, const char *str, CC_Array *rule_arr)
+{
+	return b3_parser_parse_str_in_dir(parser, director, str, NULL, NULL, rule_arr, NULL, NULL);
+}
+
+wbk_kbman_t *
+b3_parser_parse_str_in_dir(b3_parser_t *parser, b3_director_t *director, const char *str,
+                           const char *include_dir, const char *filename, CC_Array *rule_arr,
+                           CC_Array *mode_arr, int *fragment_len)
 {
 	yyscan_t scanner;
 	YY_BUFFER_STATE state;
 	wbk_kbman_t *kbman;
+	int len;
 
 	if (yylex_init(&scanner)) {
 		// couldn't initialize return NULL;
@@ -79,7 +418,12 @@ b3_parser_parse_str(b3_parser_t *parser, b3_director_t *director, const char *st
 
 	state = yy_scan_string(str, scanner);
 
-	kbman = b3_parser_parse(parser, director, scanner);
+	len = 0;
+	kbman = b3_parser_parse_included(parser, director, scanner, include_dir, filename, rule_arr,
+	                                 mode_arr, &len);
+	if (fragment_len) {
+		*fragment_len = len;
+	}
 
 	yy_delete_buffer(state, scanner);
 
@@ -90,20 +434,47 @@ b3_parser_parse_str(b3_parser_t *parser, b3_director_t *director, const char *st
 
 wbk_kbman_t *
 b3_parser_parse_file(b3_parser_t *parser, b3_director_t *director, FILE *file)
+{
+	wbk_kbman_t *kbman;
+	CC_Array *rule_arr;
+
+	cc_array_new(&rule_arr);
+	kbman = b3_parser_parse_file_staged(parser, director, file, rule_arr);
+	b3_parser_commit_rules(director, kbman, rule_arr);
+	cc_array_destroy(rule_arr);
+
+	return kbman;
+}
+
+wbk_kbman_t *
+b3_parser_parse_file_staged(b3_parser_t *parser, b3_director_t *director, FILE *file, CC_Array *rule_arr)
 {
 	yyscan_t scanner;
 	YY_BUFFER_STATE state;
 	wbk_kbman_t *kbman;
+	char *buffer;
+	size_t buffer_len;
+	int fragment_len;
 
 	if (yylex_init(&scanner)) {
 		// couldn't initialize return NULL;
 		// TODO
 	}
 
-	yyset_in(file, scanner);
-	kbman = b3_parser_parse(parser, director, scanner);
+	kbman = NULL;
+	buffer = b3_parser_read_file(file, &buffer_len);
+	if (buffer) {
+		state = yy_scan_buffer(buffer, buffer_len, scanner);
 
-	yy_delete_buffer(state, scanner);
+		fragment_len = 0;
+		kbman = b3_parser_parse_included(parser, director, scanner, NULL, NULL, rule_arr, NULL,
+		                                 &fragment_len);
+
+		yy_delete_buffer(state, scanner);
+		free(buffer);
+	} else {
+		wbk_logger_log(&logger, SEVERE, "Could not read the configuration\n");
+	}
 
 	yylex_destroy(scanner);
 
@@ -111,21 +482,930 @@ b3_parser_parse_file(b3_parser_t *parser, b3_director_t *director, FILE *file)
 }
 
 wbk_kbman_t *
-b3_parser_parse(b3_parser_t *parser, b3_director_t *director, yyscan_t scanner)
+b3_parser_parse(b3_parser_t *parser, b3_director_t *director, yyscan_t scanner,
+                CC_Array *rule_arr, CC_Array *include_arr, CC_Array *mode_arr)
 {
 	wbk_kbman_t *kbman;
+	b3_parser_context_t context;
+	CC_ArrayIter iter;
+	b3_rule_t *rule;
 
-	kbman = wbk_kbman_new();
+	memset(&context, 0, sizeof(b3_parser_context_t));
+	context.kc_director_factory = parser->kc_director_factory;
+	context.condition_factory = parser->condition_factory;
+	context.action_factory = parser->action_factory;
+	context.director = director;
+	context.kbman = wbk_kbman_new();
+	cc_array_new(&(context.rule_arr));
+	context.include_arr = include_arr;
+	context.mode_arr = mode_arr;
 
-	if (yyparse(&(parser->kc_director_factory),
-              &(parser->condition_factory),
-              &(parser->action_factory),
-              &director,
-              &kbman,
-              scanner)) {
+	kbman = context.kbman;
+	if (yyparse(&context, scanner)) {
 		wbk_kbman_free(kbman);
 		kbman = NULL;
 	}
 
+	b3_parser_context_release(&context);
+
+	cc_array_iter_init(&iter, context.rule_arr);
+	while (cc_array_iter_next(&iter, (void*) &rule) != CC_ITER_END) {
+		if (kbman) {
+			cc_array_add(rule_arr, rule);
+		} else {
+			b3_rule_free(rule);
+		}
+	}
+	cc_array_destroy(context.rule_arr);
+
+	return kbman;
+}
+
+wbk_kbman_t *
+b3_parser_parse_included(b3_parser_t *parser, b3_director_t *director, yyscan_t scanner,
+                         const char *include_dir, const char *filename, CC_Array *rule_arr,
+                         CC_Array *mode_arr, int *fragment_len)
+{
+	wbk_kbman_t *kbman;
+	CC_Array *own_rule_arr;
+	CC_Array *own_mode_arr;
+	CC_Array *include_arr;
+	CC_ArrayIter iter;
+	b3_rule_t *rule;
+
+	cc_array_new(&own_rule_arr);
+	cc_array_new(&own_mode_arr);
+	cc_array_new(&include_arr);
+
+	kbman = b3_parser_parse(parser, director, scanner, own_rule_arr, include_arr, own_mode_arr);
+
+	if (kbman && cc_array_size(include_arr) > 0) {
+		kbman = b3_parser_merge_includes(parser, director, kbman, own_rule_arr, include_arr,
+		                                 include_dir, filename, rule_arr, own_mode_arr,
+		                                 fragment_len);
+	} else {
+		cc_array_iter_init(&iter, own_rule_arr);
+		while (cc_array_iter_next(&iter, (void*) &rule) != CC_ITER_END) {
+			cc_array_add(rule_arr, rule);
+		}
+	}
+	cc_array_destroy(own_rule_arr);
+
+	if (kbman && mode_arr) {
+		b3_mode_merge_all(mode_arr, own_mode_arr);
+	}
+	b3_parser_free_modes(own_mode_arr);
+	cc_array_destroy(own_mode_arr);
+
+	b3_parser_free_includes(include_arr);
+	cc_array_destroy(include_arr);
+
 	return kbman;
 }
+
+wbk_kbman_t *
+b3_parser_merge_includes(b3_parser_t *parser, b3_director_t *director, wbk_kbman_t *kbman,
+                         CC_Array *own_rule_arr, CC_Array *include_arr, const char *include_dir,
+                         const char *filename, CC_Array *rule_arr, CC_Array *mode_arr,
+                         int *fragment_len)
+{
+	int error;
+	b3_parser_job_t job;
+	wbk_kbman_t *merged_kbman;
+	CC_Array *child_arr;
+	CC_ArrayIter iter;
+	b3_parser_include_t *include;
+	b3_parser_fragment_t *fragment;
+	b3_rule_t *rule;
+	int i;
+
+	error = 0;
+	merged_kbman = NULL;
+	child_arr = NULL;
+
+	memset(&job, 0, sizeof(b3_parser_job_t));
+	job.parser = parser;
+	job.director = director;
+
+	if (cc_array_new(&(job.fragment_arr)) != CC_OK
+	    || cc_array_new(&child_arr) != CC_OK) {
+		error = 1;
+	}
+
+	if (!error && filename) {
+		job.filename = b3_parser_full_path(filename);
+		if (job.filename == NULL) {
+			error = 2;
+		}
+	}
+
+	if (!error) {
+		job.mutex = CreateMutex(NULL, FALSE, NULL);
+		job.semaphore = CreateSemaphore(NULL, 0, LONG_MAX, NULL);
+		if (job.mutex == NULL || job.semaphore == NULL) {
+			error = 3;
+		}
+	}
+
+	for (i = 0; !error && i < cc_array_size(include_arr); i++) {
+		cc_array_get_at(include_arr, i, (void *) &include);
+		error = b3_parser_expand_include(&job, NULL, include_dir, include->pattern, i, child_arr);
+	}
+
+	if (!error) {
+		error = b3_parser_job_run(&job);
+	}
+
+	/**
+	 * The fragments are merged once all of them are parsed
+	 */
+	if (!error) {
+		cc_array_iter_init(&iter, child_arr);
+		while (!error && cc_array_iter_next(&iter, (void*) &fragment) != CC_ITER_END) {
+			error = b3_parser_merge_fragment(fragment);
+		}
+	}
+
+	if (!error) {
+		merged_kbman = b3_parser_merge(kbman, own_rule_arr, include_arr, child_arr,
+		                               rule_arr, mode_arr, fragment_len);
+		kbman = NULL;
+	}
+
+	if (kbman) {
+		wbk_kbman_free(kbman);
+	}
+
+	cc_array_iter_init(&iter, own_rule_arr);
+	while (cc_array_iter_next(&iter, (void*) &rule) != CC_ITER_END) {
+		b3_rule_free(rule);
+	}
+	cc_array_remove_all(own_rule_arr);
+
+	if (job.fragment_arr) {
+		cc_array_iter_init(&iter, job.fragment_arr);
+		while (cc_array_iter_next(&iter, (void*) &fragment) != CC_ITER_END) {
+			b3_parser_fragment_free(fragment);
+		}
+		cc_array_destroy(job.fragment_arr);
+	}
+
+	if (child_arr) {
+		cc_array_destroy(child_arr);
+	}
+
+	if (job.semaphore) {
+		CloseHandle(job.semaphore);
+	}
+
+	if (job.mutex) {
+		CloseHandle(job.mutex);
+	}
+
+	free(job.filename);
+
+	return merged_kbman;
+}
+
+wbk_kbman_t *
+b3_parser_merge(wbk_kbman_t *kbman, CC_Array *own_rule_arr, CC_Array *include_arr,
+                CC_Array *child_arr, CC_Array *rule_arr, CC_Array *mode_arr, int *fragment_len)
+{
+	wbk_kbman_t *merged_kbman;
+	CC_ArrayIter iter;
+	b3_parser_include_t *include;
+	b3_parser_fragment_t *fragment;
+	b3_rule_t *rule;
+	int kc_pos;
+	int rule_pos;
+	int child_pos;
+	int i;
+	int j;
+
+	merged_kbman = wbk_kbman_new();
+	kc_pos = 0;
+	rule_pos = 0;
+	child_pos = 0;
+
+	for (i = 0; merged_kbman && i <= cc_array_size(include_arr); i++) {
+		include = NULL;
+		if (i < cc_array_size(include_arr)) {
+			cc_array_get_at(include_arr, i, (void *) &include);
+		}
+
+		for (; kc_pos < (include ? include->kc_pos : kbman->kc_arr_len); kc_pos++) {
+			wbk_kbman_add(merged_kbman, kbman->kc_arr[kc_pos]);
+		}
+
+		for (; rule_pos < (include ? include->rule_pos : cc_array_size(own_rule_arr)); rule_pos++) {
+			cc_array_get_at(own_rule_arr, rule_pos, (void *) &rule);
+			cc_array_add(rule_arr, rule);
+		}
+
+		while (include && child_pos < cc_array_size(child_arr)) {
+			cc_array_get_at(child_arr, child_pos, (void *) &fragment);
+			if (fragment->include_index != i) {
+				break;
+			}
+
+			for (j = 0; j < fragment->kbman->kc_arr_len; j++) {
+				wbk_kbman_add(merged_kbman, fragment->kbman->kc_arr[j]);
+			}
+			fragment->kbman->kc_arr_len = 0;
+
+			cc_array_iter_init(&iter, fragment->rule_arr);
+			while (cc_array_iter_next(&iter, (void*) &rule) != CC_ITER_END) {
+				cc_array_add(rule_arr, rule);
+			}
+			cc_array_remove_all(fragment->rule_arr);
+
+			b3_mode_merge_all(mode_arr, fragment->mode_arr);
+
+			*fragment_len += 1 + fragment->fragment_len;
+			child_pos++;
+		}
+	}
+
+	/**
+	 * The key commands are owned by the merged key binding manager now
+	 */
+	if (merged_kbman) {
+		kbman->kc_arr_len = 0;
+		cc_array_remove_all(own_rule_arr);
+	}
+
+	wbk_kbman_free(kbman);
+
+	return merged_kbman;
+}
+
+int
+b3_parser_merge_fragment(b3_parser_fragment_t *fragment)
+{
+	int error;
+	CC_Array *rule_arr;
+	CC_ArrayIter iter;
+	b3_parser_fragment_t *child;
+
+	error = 0;
+
+	cc_array_iter_init(&iter, fragment->child_arr);
+	while (!error && cc_array_iter_next(&iter, (void*) &child) != CC_ITER_END) {
+		error = b3_parser_merge_fragment(child);
+	}
+
+	if (!error && cc_array_size(fragment->include_arr) > 0) {
+		if (cc_array_new(&rule_arr) != CC_OK) {
+			error = 1;
+		}
+
+		if (!error) {
+			fragment->kbman = b3_parser_merge(fragment->kbman, fragment->rule_arr,
+			                                  fragment->include_arr, fragment->child_arr,
+			                                  rule_arr, fragment->mode_arr,
+			                                  &(fragment->fragment_len));
+			if (fragment->kbman == NULL) {
+				error = 2;
+			}
+		}
+
+		/**
+		 * The own rules stay with the fragment if merging failed
+		 */
+		if (!error) {
+			cc_array_destroy(fragment->rule_arr);
+			fragment->rule_arr = rule_arr;
+		} else if (error == 2) {
+			cc_array_destroy(rule_arr);
+		}
+	}
+
+	return error;
+}
+
+int
+b3_parser_expand_include(b3_parser_job_t *job, b3_parser_fragment_t *parent,
+                         const char *include_dir, const char *pattern, int include_index,
+                         CC_Array *child_arr)
+{
+	int error;
+	char *path;
+	char *dir;
+	CC_Array *name_arr;
+	CC_ArrayIter iter;
+	char *name;
+	HANDLE handle;
+	WIN32_FIND_DATA find_data;
+	b3_parser_fragment_t *fragment;
+	int i;
+
+	error = 0;
+	dir = NULL;
+	name_arr = NULL;
+
+	path = b3_parser_resolve_pattern(include_dir, pattern);
+	if (path) {
+		dir = b3_parser_dirname(path);
+	}
+
+	if (dir == NULL || cc_array_new(&name_arr) != CC_OK) {
+		wbk_logger_log(&logger, SEVERE, "Could not allocate memory.\n");
+		error = 1;
+	}
+
+	if (!error) {
+		handle = FindFirstFile(path, &find_data);
+		if (handle != INVALID_HANDLE_VALUE) {
+			do {
+				if (!(find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+					name = strdup(find_data.cFileName);
+					if (name == NULL || cc_array_add(name_arr, name) != CC_OK) {
+						free(name);
+						wbk_logger_log(&logger, SEVERE, "Could not allocate memory.\n");
+						error = 2;
+					}
+				}
+			} while (!error && FindNextFile(handle, &find_data));
+
+			FindClose(handle);
+		}
+	}
+
+	if (!error && cc_array_size(name_arr) == 0) {
+		wbk_logger_log(&logger, WARNING, "No configuration file matches %s\n", path);
+	}
+
+	/**
+	 * The order of FindNextFile() depends on the file system
+	 */
+	if (!error) {
+		cc_array_sort(name_arr, b3_parser_compare_names);
+	}
+
+	for (i = 0; !error && i < cc_array_size(name_arr); i++) {
+		cc_array_get_at(name_arr, i, (void *) &name);
+
+		fragment = b3_parser_fragment_new(parent, dir, name, include_index);
+		if (fragment == NULL) {
+			wbk_logger_log(&logger, SEVERE, "Could not include %s%s\n", dir, name);
+			error = 3;
+		} else if (b3_parser_is_including(job, parent, fragment->filename)) {
+			wbk_logger_log(&logger, SEVERE, "%s includes itself\n", fragment->filename);
+			b3_parser_fragment_free(fragment);
+			error = 4;
+		} else if (fragment->depth > B3_PARSER_INCLUDE_DEPTH) {
+			wbk_logger_log(&logger, SEVERE, "Include statements are nested more than %d times\n",
+			               B3_PARSER_INCLUDE_DEPTH);
+			b3_parser_fragment_free(fragment);
+			error = 5;
+		} else if (b3_parser_job_push(job, fragment)) {
+			b3_parser_fragment_free(fragment);
+			error = 6;
+		} else if (cc_array_add(child_arr, fragment) != CC_OK) {
+			error = 6;
+		}
+	}
+
+	if (name_arr) {
+		cc_array_iter_init(&iter, name_arr);
+		while (cc_array_iter_next(&iter, (void*) &name) != CC_ITER_END) {
+			free(name);
+		}
+		cc_array_destroy(name_arr);
+	}
+
+	free(dir);
+	free(path);
+
+	return error;
+}
+
+int
+b3_parser_is_including(b3_parser_job_t *job, b3_parser_fragment_t *parent, const char *filename)
+{
+	int including;
+
+	/**
+	 * File names are not case sensitive
+	 */
+	including = job->filename && lstrcmpi(job->filename, filename) == 0;
+	for (; !including && parent; parent = parent->parent) {
+		including = lstrcmpi(parent->filename, filename) == 0;
+	}
+
+	return including;
+}
+
+int
+b3_parser_job_push(b3_parser_job_t *job, b3_parser_fragment_t *fragment)
+{
+	int error;
+
+	WaitForSingleObject(job->mutex, INFINITE);
+	error = cc_array_add(job->fragment_arr, fragment) != CC_OK;
+	if (!error) {
+		job->pending++;
+	}
+	ReleaseMutex(job->mutex);
+
+	if (!error) {
+		ReleaseSemaphore(job->semaphore, 1, NULL);
+	}
+
+	return error;
+}
+
+int
+b3_parser_job_run(b3_parser_job_t *job)
+{
+	SYSTEM_INFO system_info;
+	HANDLE thread_arr[B3_PARSER_THREAD_MAX];
+	int thread_len;
+	int i;
+
+	/**
+	 * Nested fragments are only known once their including fragment is
+	 * parsed, so the pool is not limited by the number of fragments at hand.
+	 */
+	GetSystemInfo(&system_info);
+	thread_len = system_info.dwNumberOfProcessors;
+	if (thread_len > B3_PARSER_THREAD_MAX) {
+		thread_len = B3_PARSER_THREAD_MAX;
+	}
+	if (thread_len < 1 || job->pending == 0) {
+		thread_len = 1;
+	}
+	job->thread_len = thread_len;
+
+	/**
+	 * The calling thread parses fragments as well
+	 */
+	for (i = 0; job->pending > 0 && i < thread_len - 1; i++) {
+		thread_arr[i] = CreateThread(NULL,
+		                             0,
+		                             b3_parser_fragments_thread,
+		                             (LPVOID) job,
+		                             0,
+		                             NULL);
+		if (thread_arr[i] == NULL) {
+			break;
+		}
+	}
+	thread_len = i;
+
+	if (job->pending > 0) {
+		b3_parser_fragments_thread(job);
+	}
+
+	if (thread_len > 0) {
+		WaitForMultipleObjects(thread_len, thread_arr, TRUE, INFINITE);
+		for (i = 0; i < thread_len; i++) {
+			CloseHandle(thread_arr[i]);
+		}
+	}
+
+	return job->error;
+}
+
+DWORD WINAPI
+b3_parser_fragments_thread(LPVOID param)
+{
+	b3_parser_job_t *job;
+	b3_parser_fragment_t *fragment;
+	int error;
+
+	job = (b3_parser_job_t *) param;
+
+	do {
+		WaitForSingleObject(job->semaphore, INFINITE);
+
+		fragment = NULL;
+		WaitForSingleObject(job->mutex, INFINITE);
+		if (job->next < cc_array_size(job->fragment_arr)) {
+			cc_array_get_at(job->fragment_arr, job->next, (void *) &fragment);
+			job->next++;
+		}
+		error = job->error;
+		ReleaseMutex(job->mutex);
+
+		/**
+		 * Once a fragment failed, the remaining ones are only counted
+		 */
+		if (fragment && !error) {
+			error = b3_parser_parse_fragment(job, fragment);
+		}
+
+		if (fragment) {
+			WaitForSingleObject(job->mutex, INFINITE);
+			if (error) {
+				job->error = 1;
+			}
+
+			/**
+			 * A fragment appends the fragments it includes before it is
+			 * counted as parsed, so no fragment can follow the last one.
+			 */
+			job->pending--;
+			if (job->pending == 0) {
+				ReleaseSemaphore(job->semaphore, job->thread_len, NULL);
+			}
+			ReleaseMutex(job->mutex);
+		}
+	} while (fragment);
+
+	return 0;
+}
+
+int
+b3_parser_parse_fragment(b3_parser_job_t *job, b3_parser_fragment_t *fragment)
+{
+	int error;
+	FILE *file;
+	yyscan_t scanner;
+	YY_BUFFER_STATE state;
+	char *buffer;
+	size_t buffer_len;
+	char *dir;
+	b3_parser_include_t *include;
+	int i;
+
+	error = 0;
+	buffer = NULL;
+	dir = NULL;
+
+	file = fopen(fragment->filename, "r");
+	if (file == NULL) {
+		wbk_logger_log(&logger, SEVERE, "Could not open %s\n", fragment->filename);
+		error = 1;
+	}
+
+	if (!error) {
+		buffer = b3_parser_read_file(file, &buffer_len);
+		fclose(file);
+
+		if (buffer == NULL) {
+			wbk_logger_log(&logger, SEVERE, "Could not read %s\n", fragment->filename);
+			error = 2;
+		}
+	}
+
+	if (!error) {
+		if (yylex_init(&scanner)) {
+			error = 3;
+		}
+	}
+
+	if (!error) {
+		state = yy_scan_buffer(buffer, buffer_len, scanner);
+		fragment->kbman = b3_parser_parse(job->parser, job->director, scanner,
+		                                  fragment->rule_arr, fragment->include_arr,
+		                                  fragment->mode_arr);
+
+		yy_delete_buffer(state, scanner);
+		yylex_destroy(scanner);
+
+		if (fragment->kbman == NULL) {
+			wbk_logger_log(&logger, SEVERE, "Could not parse %s\n", fragment->filename);
+			error = 4;
+		}
+	}
+
+	free(buffer);
+
+	/**
+	 * The included fragments are parsed by the threads of the job as well
+	 */
+	if (!error && cc_array_size(fragment->include_arr) > 0) {
+		dir = b3_parser_dirname(fragment->filename);
+		if (dir == NULL) {
+			error = 5;
+		}
+	}
+
+	for (i = 0; !error && i < cc_array_size(fragment->include_arr); i++) {
+		cc_array_get_at(fragment->include_arr, i, (void *) &include);
+		error = b3_parser_expand_include(job, fragment, dir, include->pattern, i,
+		                                 fragment->child_arr);
+	}
+
+	free(dir);
+
+	return error;
+}
+
+b3_parser_fragment_t *
+b3_parser_fragment_new(b3_parser_fragment_t *parent, const char *dir, const char *name,
+                       int include_index)
+{
+	int error;
+	b3_parser_fragment_t *fragment;
+	char *filename;
+
+	error = 0;
+	filename = NULL;
+
+	fragment = malloc(sizeof(b3_parser_fragment_t));
+	if (fragment == NULL) {
+		error = 1;
+	}
+
+	if (!error) {
+		memset(fragment, 0, sizeof(b3_parser_fragment_t));
+		fragment->include_index = include_index;
+		fragment->parent = parent;
+		fragment->depth = parent ? parent->depth + 1 : 1;
+
+		filename = malloc(sizeof(char) * (strlen(dir) + strlen(name) + 1));
+		if (filename == NULL) {
+			error = 2;
+		}
+	}
+
+	/**
+	 * The chain of including files is compared by full paths
+	 */
+	if (!error) {
+		strcpy(filename, dir);
+		strcat(filename, name);
+
+		fragment->filename = b3_parser_full_path(filename);
+		if (fragment->filename == NULL) {
+			error = 3;
+		}
+	}
+
+	if (!error) {
+		if (cc_array_new(&(fragment->rule_arr)) != CC_OK
+		    || cc_array_new(&(fragment->mode_arr)) != CC_OK
+		    || cc_array_new(&(fragment->include_arr)) != CC_OK
+		    || cc_array_new(&(fragment->child_arr)) != CC_OK) {
+			error = 4;
+		}
+	}
+
+	free(filename);
+
+	if (error && fragment) {
+		b3_parser_fragment_free(fragment);
+		fragment = NULL;
+	}
+
+	return fragment;
+}
+
+int
+b3_parser_fragment_free(b3_parser_fragment_t *fragment)
+{
+	CC_ArrayIter iter;
+	b3_rule_t *rule;
+
+	if (fragment->kbman) {
+		wbk_kbman_free(fragment->kbman);
+		fragment->kbman = NULL;
+	}
+
+	if (fragment->rule_arr) {
+		cc_array_iter_init(&iter, fragment->rule_arr);
+		while (cc_array_iter_next(&iter, (void*) &rule) != CC_ITER_END) {
+			b3_rule_free(rule);
+		}
+		cc_array_destroy(fragment->rule_arr);
+		fragment->rule_arr = NULL;
+	}
+
+	if (fragment->mode_arr) {
+		b3_parser_free_modes(fragment->mode_arr);
+		cc_array_destroy(fragment->mode_arr);
+		fragment->mode_arr = NULL;
+	}
+
+	if (fragment->include_arr) {
+		b3_parser_free_includes(fragment->include_arr);
+		cc_array_destroy(fragment->include_arr);
+		fragment->include_arr = NULL;
+	}
+
+	/**
+	 * The included fragments are freed by the job
+	 */
+	if (fragment->child_arr) {
+		cc_array_destroy(fragment->child_arr);
+		fragment->child_arr = NULL;
+	}
+
+	fragment->parent = NULL;
+
+	free(fragment->filename);
+	fragment->filename = NULL;
+
+	free(fragment);
+	return 0;
+}
+
+int
+b3_parser_free_includes(CC_Array *include_arr)
+{
+	CC_ArrayIter iter;
+	b3_parser_include_t *include;
+
+	cc_array_iter_init(&iter, include_arr);
+	while (cc_array_iter_next(&iter, (void*) &include) != CC_ITER_END) {
+		free(include->pattern);
+		free(include);
+	}
+	cc_array_remove_all(include_arr);
+
+	return 0;
+}
+
+int
+b3_parser_free_modes(CC_Array *mode_arr)
+{
+	CC_ArrayIter iter;
+	b3_mode_t *mode;
+
+	cc_array_iter_init(&iter, mode_arr);
+	while (cc_array_iter_next(&iter, (void*) &mode) != CC_ITER_END) {
+		b3_mode_free(mode);
+	}
+	cc_array_remove_all(mode_arr);
+
+	return 0;
+}
+
+char *
+b3_parser_read_file(FILE *file, size_t *buffer_len)
+{
+	char *buffer;
+	char *grown_buffer;
+	size_t capacity;
+	size_t len;
+
+	len = 0;
+	capacity = 4096;
+	buffer = malloc(sizeof(char) * capacity);
+
+	while (buffer && !feof(file) && !ferror(file)) {
+		if (capacity - len < 2 + 1) {
+			capacity *= 2;
+			grown_buffer = realloc(buffer, sizeof(char) * capacity);
+			if (grown_buffer == NULL) {
+				free(buffer);
+			}
+			buffer = grown_buffer;
+		}
+
+		if (buffer) {
+			len += fread(buffer + len, sizeof(char), capacity - len - 2, file);
+		}
+	}
+
+	/**
+	 * Flex expects two end of buffer characters
+	 */
+	if (buffer) {
+		buffer[len] = '\0';
+		buffer[len + 1] = '\0';
+		*buffer_len = len + 2;
+	}
+
+	return buffer;
+}
+
+char *
+b3_parser_resolve_pattern(const char *include_dir, const char *pattern)
+{
+	char *path;
+	int length;
+
+	if ((pattern[0] == '~') && (pattern[1] == '\\' || pattern[1] == '/')) {
+		return wbk_path_from_home(pattern + 2);
+	}
+
+	if (include_dir == NULL
+	    || include_dir[0] == '\0'
+	    || pattern[0] == '\\'
+	    || pattern[0] == '/'
+	    || (isalpha(pattern[0]) && pattern[1] == ':')) {
+		return strdup(pattern);
+	}
+
+	length = strlen(include_dir);
+	path = malloc(sizeof(char) * (length + strlen(pattern) + 2));
+	if (path) {
+		strcpy(path, include_dir);
+		if (include_dir[length - 1] != '\\' && include_dir[length - 1] != '/') {
+			strcat(path, "\\");
+		}
+		strcat(path, pattern);
+	}
+
+	return path;
+}
+
+char *
+b3_parser_dirname(const char *path)
+{
+	char *dir;
+	int length;
+
+	length = strlen(path);
+	while (length > 0 && path[length - 1] != '\\' && path[length - 1] != '/') {
+		length--;
+	}
+
+	dir = malloc(sizeof(char) * (length + 1));
+	if (dir) {
+		memcpy(dir, path, length);
+		dir[length] = '\0';
+	}
+
+	return dir;
+}
+
+char *
+b3_parser_full_path(const char *filename)
+{
+	char *full_path;
+	DWORD length;
+
+	full_path = NULL;
+
+	length = GetFullPathName(filename, 0, NULL, NULL);
+	if (length > 0) {
+		full_path = malloc(sizeof(char) * length);
+	}
+
+	if (full_path && GetFullPathName(filename, length, full_path, NULL) == 0) {
+		free(full_path);
+		full_path = NULL;
+	}
+
+	return full_path;
+}
+
+int
+b3_parser_compare_names(const void *name, const void *other)
+{
+	return strcmp(*((char * const *) name), *((char * const *) other));
+}
+
+int
+b3_parser_context_release(b3_parser_context_t *context)
+{
+	if (context->kc) {
+		/** The key command owns the binding */
+		wbk_kc_free(context->kc);
+		context->kc = NULL;
+		context->b = NULL;
+	}
+
+	if (context->b) {
+		wbk_b_free(context->b);
+		context->b = NULL;
+	}
+
+	free(context->str);
+	context->str = NULL;
+	context->str_capacity = 0;
+
+	if (context->condition_and) {
+		b3_condition_free((b3_condition_t *) context->condition_and);
+		context->condition_and = NULL;
+	}
+
+	if (context->condition) {
+		b3_condition_free(context->condition);
+		context->condition = NULL;
+	}
+
+	if (context->action_list) {
+		b3_action_free((b3_action_t *) context->action_list);
+		context->action_list = NULL;
+	}
+
+	if (context->action) {
+		b3_action_free(context->action);
+		context->action = NULL;
+	}
+
+	return 0;
+}
+
+int
+b3_parser_commit_rules(b3_director_t *director, wbk_kbman_t *kbman, CC_Array *rule_arr)
+{
+	CC_ArrayIter iter;
+	b3_rule_t *rule;
+
+	cc_array_iter_init(&iter, rule_arr);
+	while (cc_array_iter_next(&iter, (void*) &rule) != CC_ITER_END) {
+		if (kbman) {
+			b3_director_add_rule(director, rule);
+		} else {
+			b3_rule_free(rule);
+		}
+	}
+
+	return 0;
+}
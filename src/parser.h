@@ -26,9 +26,18 @@
  * @author Richard Bck <richard.baeck@mailbox.org>
  * @date 2020-02-27
  * @brief File contains the parser class definition
+ *
+ * A parser can be used by several threads at once. Each parse works on its own
+ * scanner and parse context.
+ *
+ * The fragments of include statements are parsed concurrently by a single pool
+ * of threads, nested fragments included, and merged into the including
+ * configuration in include order. A fragment may not include a file which
+ * already includes it.
  */
 
 #include <stdio.h>
+#include <collectc/cc_array.h>
 #include <w32bindkeys/kbman.h>
 
 #include "kc_director_factory.h"
@@ -68,4 +77,39 @@ b3_parser_parse_str(b3_parser_t *parser, b3_director_t *director, const char *st
 extern wbk_kbman_t *
 b3_parser_parse_file(b3_parser_t *parser, b3_director_t *director, FILE *file);
 
+/**
+ * @brief Parses a file without altering the director.
+ * @param rule_arr The parsed rules will be added to this array instead of the
+ * director. They are not freed by the parser! If parsing fails, then nothing
+ * is added.
+ * @return The key bindings outside of mode blocks or NULL if parsing failed.
+ */
+extern wbk_kbman_t *
+b3_parser_parse_file_staged(b3_parser_t *parser, b3_director_t *director, FILE *file, CC_Array *rule_arr);
+
+/**
+ * @brief Parses a string without altering the director. See
+ * b3_parser_parse_file_staged().
+ */
+extern wbk_kbman_t *
+b3_parser_parse_str_staged(b3_parser_t *parser, b3_director_t *director, const char *str, CC_Array *rule_arr);
+
+/**
+ * @brief Parses a string without altering the director. See
+ * b3_parser_parse_file_staged().
+ * @param include_dir Relative patterns of include statements are resolved
+ * against this directory. If NULL, then they are resolved against the current
+ * working directory.
+ * @param filename The name of the configuration file or NULL. Fragments which
+ * include it are rejected like fragments which include themselves.
+ * @param mode_arr The parsed binding modes (b3_mode_t) will be added to this
+ * array. They are not freed by the parser! If NULL, then they are dropped. If
+ * parsing fails, then nothing is added.
+ * @param fragment_len Set to the number of included fragments. May be NULL.
+ */
+extern wbk_kbman_t *
+b3_parser_parse_str_in_dir(b3_parser_t *parser, b3_director_t *director, const char *str,
+                           const char *include_dir, const char *filename, CC_Array *rule_arr,
+                           CC_Array *mode_arr, int *fragment_len);
+
 #endif // B3_PARSER_H
@@ -29,19 +29,21 @@
  * @date 2020-08-03
  * @brief File contains the parser definition
  *
- * The parser is not thread safe!
+ * The parser is reentrant. All state of a parse is kept in its
+ * b3_parser_context_t, so independent parses can run concurrently.
  */
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <ctype.h>
+#include <collectc/cc_array.h>
 #include <w32bindkeys/logger.h>
 #include <w32bindkeys/be.h>
 #include <w32bindkeys/b.h>
 #include <w32bindkeys/kc_sys.h>
 #include <w32bindkeys/kbman.h>
 
-#include "utils.h"
 #include "kc_director_factory.h"
 #include "condition_factory.h"
 #include "action_factory.h"
@@ -53,28 +55,61 @@
 #include "condition_and.h"
 #include "action_list.h"
 #include "rule.h"
-
-#define B3_WORD_BUFFER_LEN 256
+#include "keyword.h"
+#include "mode.h"
 
 static wbk_logger_t logger = { "parser_gen" };
 
-static wbk_b_t *g_b = NULL;
-static wbk_kc_t *g_kc = NULL;
-static char *g_text = NULL;
-static char g_word[B3_WORD_BUFFER_LEN];
-static b3_condition_and_t *g_condition_and = NULL;
-static b3_condition_t *g_condition = NULL;
-static b3_action_list_t *g_action_list = NULL;
-static b3_action_t *g_action = NULL;
-
 static wbk_mk_t
-get_modifier(char *str);
+get_modifier(b3_parser_slice_t slice);
+
+/**
+ * @return slice as a terminated string. It is valid until the function is
+ * called again with the same context. NULL if allocation failed.
+ */
+static const char *
+slice_to_str(b3_parser_context_t *context, b3_parser_slice_t slice);
+
+/**
+ * @return A terminated copy of slice. Free it by yourself! NULL if allocation
+ * failed.
+ */
+static char *
+slice_dup(b3_parser_slice_t slice);
+
+/**
+ * @return slice without surrounding white space and double quotes
+ */
+static b3_parser_slice_t
+slice_unquote(b3_parser_slice_t slice);
 
 static int
-add_to_g_b(wbk_mk_t modifier, char key);
+add_to_b(b3_parser_context_t *context, wbk_mk_t modifier, char key);
 
+/**
+ * Adds the parsed key binding to the current mode or to the configuration if
+ * it is outside of any mode block.
+ */
 static int
-add_to_kbman(wbk_kbman_t *kbman);
+add_to_kbman(b3_parser_context_t *context);
+
+/**
+ * Makes the mode called name the current mode. Blocks of the same mode are
+ * merged.
+ *
+ * @return 1 if name is not a valid name of a mode. 2 if allocation failed.
+ */
+static int
+begin_mode(b3_parser_context_t *context, b3_parser_slice_t name);
+
+/**
+ * Remembers the pattern of an include statement together with the position
+ * its fragments are merged into.
+ *
+ * @return Non-0 if allocation failed.
+ */
+static int
+add_to_includes(b3_parser_context_t *context, b3_parser_slice_t pattern);
 
 /**
  * Adds condition to condition_and and returns condition_and. If condition_and is NULL,
@@ -94,89 +129,160 @@ add_to_action_list(b3_action_factory_t *action_factory,
                    b3_action_list_t *action_list,
                    b3_action_t *action);
 
-static wbk_mk_t
-get_modifier(char *str);
-
 wbk_mk_t
-get_modifier(char *str)
+get_modifier(b3_parser_slice_t slice)
 {
-	char *str_copy;
-	int length;
-	int i;
-	wbk_mk_t modifier;
-
-	length = strlen(str) + 1;
-	str_copy = malloc(sizeof(char) * length);
-	for (i = 0; i < length; i++) {
-		str_copy[i] = tolower(str[i]);
+	const b3_keyword_t *keyword;
+
+	keyword = b3_keyword_find(slice.str, slice.len);
+
+	return keyword ? keyword->modifier : NOT_A_MODIFIER;
+}
+
+const char *
+slice_to_str(b3_parser_context_t *context, b3_parser_slice_t slice)
+{
+	char *str;
+
+	str = context->str;
+	if (context->str_capacity < slice.len + 1) {
+		str = realloc(context->str, sizeof(char) * (slice.len + 1));
+		if (str) {
+			context->str = str;
+			context->str_capacity = slice.len + 1;
+		}
 	}
 
-	if (strcmp(str_copy, "mod4") == 0) {
-		modifier = WIN;
-	} else if (strcmp(str_copy, "mod1") == 0) {
-		modifier = ALT;
-	} else if (strcmp(str_copy, "shift") == 0) {
-		modifier = SHIFT;
-	} else if (strcmp(str_copy, "space") == 0) {
-		modifier = SPACE;
-	} else if (strcmp(str_copy, "ctrl") == 0) {
-		modifier = CTRL;
-	} else if (strcmp(str_copy, "return") == 0) {
-	  modifier = ENTER;
-	} else if (strcmp(str_copy, "f1") == 0) {
-		modifier = F1;
-	} else if (strcmp(str_copy, "f2") == 0) {
-		modifier = F2;
-	} else if (strcmp(str_copy, "f3") == 0) {
-		modifier = F3;
-	} else if (strcmp(str_copy, "f4") == 0) {
-		modifier = F4;
-	} else if (strcmp(str_copy, "f5") == 0) {
-		modifier = F5;
-	} else if (strcmp(str_copy, "f6") == 0) {
-		modifier = F6;
-	} else if (strcmp(str_copy, "f7") == 0) {
-		modifier = F7;
-	} else if (strcmp(str_copy, "f8") == 0) {
-		modifier = F8;
-	} else if (strcmp(str_copy, "f9") == 0) {
-		modifier = F9;
-	} else if (strcmp(str_copy, "f10") == 0) {
-		modifier = F10;
-	} else if (strcmp(str_copy, "f11") == 0) {
-		modifier = F11;
-	} else if (strcmp(str_copy, "f12") == 0) {
-		modifier = F12;
-	} else {
-		modifier = NOT_A_MODIFIER;
+	if (str) {
+		memcpy(str, slice.str, slice.len);
+		str[slice.len] = '\0';
+	}
+
+	return str;
+}
+
+char *
+slice_dup(b3_parser_slice_t slice)
+{
+	char *str;
+
+	str = malloc(sizeof(char) * (slice.len + 1));
+	if (str) {
+		memcpy(str, slice.str, slice.len);
+		str[slice.len] = '\0';
+	}
+
+	return str;
+}
+
+b3_parser_slice_t
+slice_unquote(b3_parser_slice_t slice)
+{
+	while (slice.len > 0 && isspace(slice.str[0])) {
+		slice.str++;
+		slice.len--;
+	}
+
+	while (slice.len > 0 && isspace(slice.str[slice.len - 1])) {
+		slice.len--;
+	}
+
+	if (slice.len >= 2 && slice.str[0] == '"' && slice.str[slice.len - 1] == '"') {
+		slice.str++;
+		slice.len -= 2;
 	}
 
-	return modifier;
+	return slice;
 }
 
 int
-add_to_g_b(wbk_mk_t modifier, char key)
+add_to_b(b3_parser_context_t *context, wbk_mk_t modifier, char key)
 {
 	wbk_be_t *be;
 
-	if (g_b == NULL) {
-		g_b = wbk_b_new();
+	if (context->b == NULL) {
+		context->b = wbk_b_new();
 	}
 
 	be = wbk_be_new(modifier, key);
-	wbk_b_add(g_b, be);
+	wbk_b_add(context->b, be);
 	wbk_be_free(be);
 
 	return 0;
 }
 
 int
-add_to_kbman(wbk_kbman_t *kbman)
+add_to_kbman(b3_parser_context_t *context)
+{
+	if (context->mode) {
+		wbk_kbman_add(b3_mode_get_kbman(context->mode), context->kc);
+	} else {
+		wbk_kbman_add(context->kbman, context->kc);
+	}
+
+	context->b = NULL;
+	context->kc = NULL;
+
+	return 0;
+}
+
+int
+begin_mode(b3_parser_context_t *context, b3_parser_slice_t name)
 {
-	wbk_kbman_add(kbman, g_kc);
+	const char *name_str;
+
+	name = slice_unquote(name);
+	if (name.len == 0) {
+		return 1;
+	}
 
-	g_b = NULL;
-	g_kc = NULL;
+	name_str = slice_to_str(context, name);
+	if (name_str == NULL) {
+		return 2;
+	}
+
+	context->mode = NULL;
+	if (strcmp(name_str, B3_MODE_DEFAULT)) {
+		context->mode = b3_mode_find(context->mode_arr, name_str);
+		if (context->mode == NULL) {
+			context->mode = b3_mode_new(name_str);
+			cc_array_add(context->mode_arr, context->mode);
+		}
+	}
+
+	return 0;
+}
+
+int
+add_to_includes(b3_parser_context_t *context, b3_parser_slice_t pattern)
+{
+	int error;
+	b3_parser_include_t *include;
+
+	error = 0;
+
+	while (pattern.len > 0 && isspace(pattern.str[pattern.len - 1])) {
+		pattern.len--;
+	}
+
+	include = malloc(sizeof(b3_parser_include_t));
+	if (include == NULL) {
+		error = 1;
+	}
+
+	if (!error) {
+		include->pattern = slice_dup(pattern);
+		include->kc_pos = context->kbman->kc_arr_len;
+		include->rule_pos = cc_array_size(context->rule_arr);
+		if (include->pattern == NULL
+			|| cc_array_add(context->include_arr, include) != CC_OK) {
+			free(include->pattern);
+			free(include);
+			error = 2;
+		}
+	}
+
+	return error;
 }
 
 b3_condition_and_t *
@@ -208,11 +314,7 @@ add_to_action_list(b3_action_factory_t *action_factory,
 }
 
 int
-yyerror(b3_kc_director_factory_t **kc_director_factory,
-        b3_condition_factory_t **condition_factory,
-        b3_action_factory_t **action_factory,
-        b3_director_t **director,
-        wbk_kbman_t **kbman,
+yyerror(b3_parser_context_t *context,
         yyscan_t scanner,
         const char *msg) {
   wbk_logger_log(&logger, SEVERE, "Error during parsing the configuration file: %s\n", msg);
@@ -224,11 +326,105 @@ yyerror(b3_kc_director_factory_t **kc_director_factory,
 
 %code requires {
 
+#include <collectc/cc_array.h>
+#include <w32bindkeys/b.h>
+#include <w32bindkeys/kc.h>
+#include <w32bindkeys/kbman.h>
+
+#include "kc_director_factory.h"
+#include "condition_factory.h"
+#include "action_factory.h"
+#include "director.h"
+#include "condition_and.h"
+#include "action_list.h"
+#include "mode.h"
+
 #ifndef YY_TYPEDEF_YY_SCANNER_T
 #define YY_TYPEDEF_YY_SCANNER_T
 typedef void* yyscan_t;
 #endif
 
+/**
+ * A part of the parsed input. It is not terminated.
+ */
+typedef struct b3_parser_slice_s
+{
+  const char *str;
+  int len;
+} b3_parser_slice_t;
+
+/**
+ * An include statement. The fragments matching the pattern are merged into
+ * the including configuration at the position of the statement.
+ */
+typedef struct b3_parser_include_s
+{
+  char *pattern;
+
+  /**
+   * Number of key bindings parsed before the statement
+   */
+  int kc_pos;
+
+  /**
+   * Number of rules parsed before the statement
+   */
+  int rule_pos;
+} b3_parser_include_t;
+
+/**
+ * Everything a single parse works on. Each parse needs its own context.
+ */
+typedef struct b3_parser_context_s
+{
+  b3_kc_director_factory_t *kc_director_factory;
+  b3_condition_factory_t *condition_factory;
+  b3_action_factory_t *action_factory;
+  b3_director_t *director;
+
+  /**
+   * Parsed key bindings are added to it
+   */
+  wbk_kbman_t *kbman;
+
+  /**
+   * Parsed rules are added to it
+   */
+  CC_Array *rule_arr;
+
+  /**
+   * Parsed include statements (b3_parser_include_t) are added to it
+   */
+  CC_Array *include_arr;
+
+  /**
+   * Parsed modes (b3_mode_t) are added to it
+   */
+  CC_Array *mode_arr;
+
+  /**
+   * The mode whose block is currently parsed or NULL outside of mode blocks
+   */
+  b3_mode_t *mode;
+
+  /**
+   * Parts of the statement which is currently parsed. They have to be NULL
+   * when parsing starts.
+   */
+  wbk_b_t *b;
+  wbk_kc_t *kc;
+  b3_condition_and_t *condition_and;
+  b3_condition_t *condition;
+  b3_action_list_t *action_list;
+  b3_action_t *action;
+
+  /**
+   * Buffer for slices which have to be terminated while a statement is parsed
+   */
+  char *str;
+  int str_capacity;
+} b3_parser_context_t;
+
 }
 
 %output  "parser_gen.c"
@@ -236,55 +432,58 @@ typedef void* yyscan_t;
 
 %define api.pure
 %lex-param   { yyscan_t scanner }
-%parse-param { b3_kc_director_factory_t **kc_director_factory }
-%parse-param { b3_condition_factory_t **condition_factory }
-%parse-param { b3_action_factory_t **action_factory }
-%parse-param { b3_director_t **director }
-%parse-param { wbk_kbman_t **kbman }
+%parse-param { b3_parser_context_t *context }
 %parse-param { yyscan_t scanner }
 
 %union {
-  char modifier_str[256];
-
-	char key;
-	char special;
+  b3_parser_slice_t slice;
 }
 
-%token <modifier_str>TOKEN_MODIFIER
-%token <key>         TOKEN_KEY
-%token               TOKEN_PLUS
-%token               TOKEN_BRACKET_OPEN
-%token               TOKEN_BRACKET_CLOSE
-%token               TOKEN_EQUAL
-%token               TOKEN_DOUBLE_QUOTES
-%token               TOKEN_COMMA
-%token               TOKEN_BINDSYM
-%token               TOKEN_MOVE
-%token               TOKEN_FOCUS
-%token               TOKEN_CONTAINER
-%token               TOKEN_WORKSPACE
-%token               TOKEN_UP
-%token               TOKEN_DOWN
-%token               TOKEN_LEFT
-%token               TOKEN_RIGHT
-%token               TOKEN_KILL
-%token               TOKEN_FLOATING
-%token               TOKEN_ENABLE
-%token               TOKEN_FULLSCREEN
-%token               TOKEN_EXEC
-%token               TOKEN_SPLIT
-%token               TOKEN_NO_STARTUP_ID
-%token               TOKEN_TOGGLE
-%token               TOKEN_TO
-%token               TOKEN_OUTPUT
-%token               TOKEN_FOR_WINDOW
-%token               TOKEN_TITLE
-%token               TOKEN_CLASS
-%token               TOKEN_COMMENT
-%token               TOKEN_SPACE
-%token <special>     TOKEN_SPECIAL
-%token               TOKEN_EOL
-%token               TOKEN_EOF
+%token <slice>       TOKEN_MODIFIER
+%token <slice>       TOKEN_KEY
+%token <slice>       TOKEN_PLUS
+%token <slice>       TOKEN_BRACKET_OPEN
+%token <slice>       TOKEN_BRACKET_CLOSE
+%token <slice>       TOKEN_EQUAL
+%token <slice>       TOKEN_DOUBLE_QUOTES
+%token <slice>       TOKEN_COMMA
+%token <slice>       TOKEN_BRACE_OPEN
+%token <slice>       TOKEN_BRACE_CLOSE
+%token <slice>       TOKEN_BINDSYM
+%token <slice>       TOKEN_MOVE
+%token <slice>       TOKEN_FOCUS
+%token <slice>       TOKEN_CONTAINER
+%token <slice>       TOKEN_WORKSPACE
+%token <slice>       TOKEN_UP
+%token <slice>       TOKEN_DOWN
+%token <slice>       TOKEN_LEFT
+%token <slice>       TOKEN_RIGHT
+%token <slice>       TOKEN_KILL
+%token <slice>       TOKEN_FLOATING
+%token <slice>       TOKEN_ENABLE
+%token <slice>       TOKEN_FULLSCREEN
+%token <slice>       TOKEN_EXEC
+%token <slice>       TOKEN_SPLIT
+%token <slice>       TOKEN_NO_STARTUP_ID
+%token <slice>       TOKEN_TOGGLE
+%token <slice>       TOKEN_TO
+%token <slice>       TOKEN_OUTPUT
+%token <slice>       TOKEN_FOR_WINDOW
+%token <slice>       TOKEN_TITLE
+%token <slice>       TOKEN_CLASS
+%token <slice>       TOKEN_DUMP_RULE_PROFILE
+%token <slice>       TOKEN_RELOAD
+%token <slice>       TOKEN_INCLUDE
+%token <slice>       TOKEN_MODE
+%token <slice>       TOKEN_COMMENT
+%token <slice>       TOKEN_SPACE
+%token <slice>       TOKEN_SPECIAL
+%token <slice>       TOKEN_EOL
+%token <slice>       TOKEN_EOF
+
+%type <slice>        text
+%type <slice>        text-token
+%type <slice>        word-in-text
 
 %%
 
@@ -316,20 +515,68 @@ comment: TOKEN_COMMENT ;
 statement:
 bindsym
 | for_window 
+| include
+| mode
 ;
 
+include: TOKEN_INCLUDE TOKEN_SPACE text
+{
+  if (add_to_includes(context, $3)) {
+    yyerror(context, scanner, "Could not allocate memory");
+    YYERROR;
+  }
+}
+       ;
+
+/**
+ * The lexer only returns the braces at the end of the first line and at the
+ * start of the last line of a block.
+ */
+mode: mode-begin TOKEN_EOL mode-lines TOKEN_BRACE_CLOSE
+      { context->mode = NULL; }
+    ;
+
+mode-begin: TOKEN_MODE TOKEN_SPACE text TOKEN_BRACE_OPEN
+{
+  switch (begin_mode(context, $3)) {
+  case 0:
+    break;
+
+  case 1:
+    yyerror(context, scanner, "Invalid mode name");
+    YYERROR;
+
+  default:
+    yyerror(context, scanner, "Could not allocate memory");
+    YYERROR;
+  }
+}
+          ;
+
+mode-lines:
+          | mode-lines mode-line TOKEN_EOL
+          ;
+
+mode-line:
+         | TOKEN_SPACE
+         | bindsym
+         | TOKEN_SPACE bindsym
+         | comment
+         | TOKEN_SPACE comment
+         ;
+
 bindsym: TOKEN_BINDSYM TOKEN_SPACE binding TOKEN_SPACE bindsym-cmd
-         { add_to_kbman(*kbman); }
+         { add_to_kbman(context); }
        ;
 
 binding: TOKEN_MODIFIER
-         { add_to_g_b(get_modifier($1), 0); }
+         { add_to_b(context, get_modifier($1), 0); }
        | TOKEN_MODIFIER TOKEN_PLUS binding
-         { add_to_g_b(get_modifier($1), 0); }
+         { add_to_b(context, get_modifier($1), 0); }
        | TOKEN_KEY
-         { add_to_g_b(NOT_A_MODIFIER, tolower($1)); }
+         { add_to_b(context, NOT_A_MODIFIER, tolower($1.str[0])); }
        | TOKEN_KEY TOKEN_PLUS binding
-         { add_to_g_b(NOT_A_MODIFIER, tolower($1)); }
+         { add_to_b(context, NOT_A_MODIFIER, tolower($1.str[0])); }
        ;
 
 bindsym-cmd: bindsym-cmd-focus
@@ -340,6 +587,9 @@ bindsym-cmd: bindsym-cmd-focus
        | bindsym-cmd-fullscreen
        | bindsym-cmd-exec
        | bindsym-cmd-split
+       | bindsym-cmd-dump-rule-profile
+       | bindsym-cmd-reload
+       | bindsym-cmd-mode
        ;
 
 bindsym-cmd-focus: TOKEN_FOCUS TOKEN_SPACE bindsym-cmd-focus-direction
@@ -347,23 +597,23 @@ bindsym-cmd-focus: TOKEN_FOCUS TOKEN_SPACE bindsym-cmd-focus-direction
          ;
 
 bindsym-cmd-focus-direction: TOKEN_UP
-                     { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_sawu(*kc_director_factory, g_b, *director); }
+                     { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_sawu(context->kc_director_factory, context->b, context->director); }
 			       | TOKEN_DOWN
-             { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_sawd(*kc_director_factory, g_b, *director); }
+             { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_sawd(context->kc_director_factory, context->b, context->director); }
 		           | TOKEN_LEFT
-			         { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_sawl(*kc_director_factory, g_b, *director); }
+			         { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_sawl(context->kc_director_factory, context->b, context->director); }
                    | TOKEN_RIGHT
-                   { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_sawr(*kc_director_factory, g_b, *director); }
+                   { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_sawr(context->kc_director_factory, context->b, context->director); }
                    ;
 
 bindsym-cmd-focus-output: TOKEN_OUTPUT TOKEN_SPACE TOKEN_UP
-                  { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_sfmu(*kc_director_factory, g_b, *director); }
+                  { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_sfmu(context->kc_director_factory, context->b, context->director); }
                 | TOKEN_OUTPUT TOKEN_SPACE TOKEN_DOWN
-                  { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_sfmd(*kc_director_factory, g_b, *director); }
+                  { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_sfmd(context->kc_director_factory, context->b, context->director); }
                 | TOKEN_OUTPUT TOKEN_SPACE TOKEN_LEFT
-                  { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_sfml(*kc_director_factory, g_b, *director); }
+                  { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_sfml(context->kc_director_factory, context->b, context->director); }
                 | TOKEN_OUTPUT TOKEN_SPACE TOKEN_RIGHT
-                  { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_sfmr(*kc_director_factory, g_b, *director); }
+                  { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_sfmr(context->kc_director_factory, context->b, context->director); }
                 ;
 
 bindsym-cmd-move: TOKEN_MOVE TOKEN_SPACE bindsym-cmd-move-direction
@@ -372,13 +622,13 @@ bindsym-cmd-move: TOKEN_MOVE TOKEN_SPACE bindsym-cmd-move-direction
         ;
 
 bindsym-cmd-move-direction: TOKEN_UP
-                    { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_mawu(*kc_director_factory, g_b, *director); }
+                    { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_mawu(context->kc_director_factory, context->b, context->director); }
 			      | TOKEN_DOWN
-            { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_mawd(*kc_director_factory, g_b, *director); }
+            { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_mawd(context->kc_director_factory, context->b, context->director); }
 		          | TOKEN_LEFT
-			        { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_mawl(*kc_director_factory, g_b, *director); }
+			        { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_mawl(context->kc_director_factory, context->b, context->director); }
                   | TOKEN_RIGHT
-                  { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_mawr(*kc_director_factory, g_b, *director); }
+                  { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_mawr(context->kc_director_factory, context->b, context->director); }
                   ;
 
 bindsym-cmd-move-container: TOKEN_CONTAINER TOKEN_SPACE TOKEN_TO TOKEN_SPACE bindsym-cmd-move-container-output-direction
@@ -386,76 +636,145 @@ bindsym-cmd-move-container: TOKEN_CONTAINER TOKEN_SPACE TOKEN_TO TOKEN_SPACE bin
                   ;
 
 bindsym-cmd-move-container-output-direction: TOKEN_OUTPUT TOKEN_SPACE TOKEN_UP
-{ g_kc = (wbk_kc_t *) b3_kc_director_factory_create_mfwtmu(*kc_director_factory, g_b, *director); }
+{ context->kc = (wbk_kc_t *) b3_kc_director_factory_create_mfwtmu(context->kc_director_factory, context->b, context->director); }
 			                       | TOKEN_OUTPUT TOKEN_SPACE TOKEN_DOWN
-                             { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_mfwtmd(*kc_director_factory, g_b, *director); }
+                             { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_mfwtmd(context->kc_director_factory, context->b, context->director); }
 			                       | TOKEN_OUTPUT TOKEN_SPACE TOKEN_LEFT
-                             { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_mfwtml(*kc_director_factory, g_b, *director); }
+                             { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_mfwtml(context->kc_director_factory, context->b, context->director); }
 			                       | TOKEN_OUTPUT TOKEN_SPACE TOKEN_RIGHT
-                             { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_mfwtmr(*kc_director_factory, g_b, *director); }
+                             { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_mfwtmr(context->kc_director_factory, context->b, context->director); }
 			                       ;
 
 bindsym-cmd-move-container-workspace: TOKEN_WORKSPACE TOKEN_SPACE text
-{ g_kc = (wbk_kc_t *) b3_kc_director_factory_create_mawtw(*kc_director_factory, g_b, *director, g_text); free(g_text); g_text = NULL; }
+{
+  const char *ws_name;
+
+  ws_name = slice_to_str(context, $3);
+  if (ws_name == NULL) {
+    yyerror(context, scanner, "Could not allocate memory");
+    YYERROR;
+  }
+
+  context->kc = (wbk_kc_t *) b3_kc_director_factory_create_mawtw(context->kc_director_factory, context->b, context->director, ws_name);
+}
 			                        ;
 
 bindsym-cmd-move-workspace: TOKEN_WORKSPACE TOKEN_SPACE TOKEN_TO TOKEN_SPACE TOKEN_OUTPUT TOKEN_SPACE bindsym-cmd-move-workspace-direction
                   ;
 
 bindsym-cmd-move-workspace-direction: TOKEN_UP
-			                  { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_mfwu(*kc_director_factory, g_b, *director); }
+			                  { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_mfwu(context->kc_director_factory, context->b, context->director); }
 			                | TOKEN_DOWN
-			                  { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_mfwd(*kc_director_factory, g_b, *director); }
+			                  { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_mfwd(context->kc_director_factory, context->b, context->director); }
 			                | TOKEN_LEFT
-			                  { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_mfwl(*kc_director_factory, g_b, *director); }
+			                  { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_mfwl(context->kc_director_factory, context->b, context->director); }
 			                | TOKEN_RIGHT
-			                  { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_mfwr(*kc_director_factory, g_b, *director); }
+			                  { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_mfwr(context->kc_director_factory, context->b, context->director); }
 			                ;
 
 bindsym-cmd-workspace: TOKEN_WORKSPACE TOKEN_SPACE text
-{ g_kc = (wbk_kc_t *) b3_kc_director_factory_create_cw(*kc_director_factory, g_b, *director, g_text); free(g_text); g_text = NULL; }
+{
+  const char *ws_name;
+
+  ws_name = slice_to_str(context, $3);
+  if (ws_name == NULL) {
+    yyerror(context, scanner, "Could not allocate memory");
+    YYERROR;
+  }
+
+  context->kc = (wbk_kc_t *) b3_kc_director_factory_create_cw(context->kc_director_factory, context->b, context->director, ws_name);
+}
              ;
 
 bindsym-cmd-kill: TOKEN_KILL
-          { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_caw(*kc_director_factory, g_b, *director); }
+          { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_caw(context->kc_director_factory, context->b, context->director); }
         ;
 
 bindsym-cmd-floating: TOKEN_FLOATING TOKEN_SPACE bindsym-cmd-floating-toggle
             ;
 
 bindsym-cmd-floating-toggle: TOKEN_TOGGLE
-                     { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_awtf(*kc_director_factory, g_b, *director); }
+                     { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_awtf(context->kc_director_factory, context->b, context->director); }
                    ;
 
 bindsym-cmd-fullscreen: TOKEN_FULLSCREEN TOKEN_SPACE bindsym-cmd-fullscreen-toggle
               ;
 
 bindsym-cmd-fullscreen-toggle: TOKEN_TOGGLE
-                       { g_kc = (wbk_kc_t *) b3_kc_director_factory_create_tawf(*kc_director_factory, g_b, *director); }
+                       { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_tawf(context->kc_director_factory, context->b, context->director); }
+                     ;
+
+bindsym-cmd-dump-rule-profile: TOKEN_DUMP_RULE_PROFILE
+                       { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_drp(context->kc_director_factory, context->b, context->director); }
                      ;
 
+bindsym-cmd-reload: TOKEN_RELOAD
+                  { context->kc = (wbk_kc_t *) b3_kc_director_factory_create_rl(context->kc_director_factory, context->b, context->director); }
+                ;
+
+bindsym-cmd-mode: TOKEN_MODE TOKEN_SPACE text
+{
+  b3_parser_slice_t name;
+  const char *name_str;
+
+  name = slice_unquote($3);
+  if (name.len == 0) {
+    yyerror(context, scanner, "Invalid mode name");
+    YYERROR;
+  }
+
+  name_str = slice_to_str(context, name);
+  if (name_str == NULL) {
+    yyerror(context, scanner, "Could not allocate memory");
+    YYERROR;
+  }
+
+  context->kc = (wbk_kc_t *) b3_kc_director_factory_create_sm(context->kc_director_factory, context->b, context->director, name_str);
+}
+                ;
+
 bindsym-cmd-exec: TOKEN_EXEC TOKEN_SPACE TOKEN_NO_STARTUP_ID TOKEN_SPACE text
-        { g_kc = (wbk_kc_t *) b3_kc_exec_new(g_b, *director, ON_CURRENT_WS, g_text); g_text = NULL; }
+{
+  char *cmd;
+
+  cmd = slice_dup($5);
+  if (cmd == NULL) {
+    yyerror(context, scanner, "Could not allocate memory");
+    YYERROR;
+  }
+
+  context->kc = (wbk_kc_t *) b3_kc_exec_new(context->b, context->director, ON_CURRENT_WS, cmd);
+}
         | TOKEN_EXEC TOKEN_SPACE text
-        { g_kc = (wbk_kc_t *) b3_kc_exec_new(g_b, *director, ON_START_WS, g_text); g_text = NULL; }
+{
+  char *cmd;
+
+  cmd = slice_dup($3);
+  if (cmd == NULL) {
+    yyerror(context, scanner, "Could not allocate memory");
+    YYERROR;
+  }
+
+  context->kc = (wbk_kc_t *) b3_kc_exec_new(context->b, context->director, ON_START_WS, cmd);
+}
         ;
 
 bindsym-cmd-split: TOKEN_SPLIT TOKEN_SPACE TOKEN_KEY
 {
   char msg[256];
 
-  switch($3) {
+  switch($3.str[0]) {
   case 'h':
-    g_kc = (wbk_kc_t *) b3_kc_director_factory_create_sh(*kc_director_factory, g_b, *director);
+    context->kc = (wbk_kc_t *) b3_kc_director_factory_create_sh(context->kc_director_factory, context->b, context->director);
     break;
 
   case 'v':
-    g_kc = (wbk_kc_t *) b3_kc_director_factory_create_sv(*kc_director_factory, g_b, *director);
+    context->kc = (wbk_kc_t *) b3_kc_director_factory_create_sv(context->kc_director_factory, context->b, context->director);
     break;
 
   default:
-      sprintf(msg, "Unexpected token: %c", $3);
-      yyerror(*kc_director_factory, *condition_factory, *action_factory, *director, *kbman, scanner, msg);
+      sprintf(msg, "Unexpected token: %c", $3.str[0]);
+      yyerror(context, scanner, msg);
       YYERROR;
   }
 }
@@ -463,33 +782,61 @@ bindsym-cmd-split: TOKEN_SPLIT TOKEN_SPACE TOKEN_KEY
 
 for_window:
   TOKEN_FOR_WINDOW TOKEN_SPACE TOKEN_BRACKET_OPEN for_window-conditions TOKEN_BRACKET_CLOSE TOKEN_SPACE for_window-actions
-  { b3_director_add_rule(*director, b3_rule_new((b3_condition_t *) g_condition_and, (b3_action_t *) g_action_list)); g_condition_and = NULL; g_action_list = NULL; }
+  { cc_array_add(context->rule_arr, b3_rule_new((b3_condition_t *) context->condition_and, (b3_action_t *) context->action_list)); context->condition_and = NULL; context->action_list = NULL; }
 ;
 
 for_window-conditions:
   for_window-condition
-  { g_condition_and = add_to_condition_and(*condition_factory, g_condition_and, g_condition); g_condition = NULL; }
+  { context->condition_and = add_to_condition_and(context->condition_factory, context->condition_and, context->condition); context->condition = NULL; }
 | for_window-conditions TOKEN_SPACE for_window-condition
-  { g_condition_and = add_to_condition_and(*condition_factory, g_condition_and, g_condition); g_condition = NULL; }
+  { context->condition_and = add_to_condition_and(context->condition_factory, context->condition_and, context->condition); context->condition = NULL; }
 ;
 
 for_window-condition:
   TOKEN_TITLE TOKEN_EQUAL TOKEN_DOUBLE_QUOTES text TOKEN_DOUBLE_QUOTES
-  { g_condition = (b3_condition_t *) b3_condition_factory_create_tc(*condition_factory, g_text); free(g_text); g_text = NULL; }
+{
+  const char *pattern;
+
+  pattern = slice_to_str(context, $4);
+  if (pattern == NULL) {
+    yyerror(context, scanner, "Could not allocate memory");
+    YYERROR;
+  }
+
+  context->condition = (b3_condition_t *) b3_condition_factory_create_tc(context->condition_factory, pattern);
+  if (context->condition == NULL) {
+    yyerror(context, scanner, "Invalid title pattern");
+    YYERROR;
+  }
+}
 | TOKEN_CLASS TOKEN_EQUAL TOKEN_DOUBLE_QUOTES text TOKEN_DOUBLE_QUOTES
-{ g_condition = (b3_condition_t *) b3_condition_factory_create_cc(*condition_factory, g_text); free(g_text); g_text = NULL; }
+{
+  const char *pattern;
+
+  pattern = slice_to_str(context, $4);
+  if (pattern == NULL) {
+    yyerror(context, scanner, "Could not allocate memory");
+    YYERROR;
+  }
+
+  context->condition = (b3_condition_t *) b3_condition_factory_create_cc(context->condition_factory, pattern);
+  if (context->condition == NULL) {
+    yyerror(context, scanner, "Invalid class pattern");
+    YYERROR;
+  }
+}
 ;
 
 for_window-actions:
   for_window-action
-  { g_action_list = add_to_action_list(*action_factory, g_action_list, g_action); g_action = NULL; }
+  { context->action_list = add_to_action_list(context->action_factory, context->action_list, context->action); context->action = NULL; }
 | for_window-actions TOKEN_COMMA TOKEN_SPACE for_window-action
-  { g_action_list = add_to_action_list(*action_factory, g_action_list, g_action); g_action = NULL; }
+  { context->action_list = add_to_action_list(context->action_factory, context->action_list, context->action); context->action = NULL; }
 ;
 
 for_window-action:
   TOKEN_FLOATING TOKEN_SPACE TOKEN_ENABLE
-  { g_action = (b3_action_t *) b3_action_factory_create_fa(*action_factory); }
+  { context->action = (b3_action_t *) b3_action_factory_create_fa(context->action_factory); }
 | action-command
 ;
 
@@ -511,97 +858,65 @@ action-cmd-move-container:
 
 action-cmd-move-container-workspace:
   TOKEN_WORKSPACE TOKEN_SPACE text
-  { g_action = (b3_action_t *) b3_action_factory_create_mwtw(*action_factory, g_text); g_text = NULL; }
+{
+  char *ws_name;
+
+  ws_name = slice_dup($3);
+  if (ws_name == NULL) {
+    yyerror(context, scanner, "Could not allocate memory");
+    YYERROR;
+  }
+
+  context->action = (b3_action_t *) b3_action_factory_create_mwtw(context->action_factory, ws_name);
+}
 ;
 
-text: TOKEN_KEY
-    { g_text = b3_add_c_to_s(g_text, $1); }
-    | text TOKEN_KEY[K]
-    { g_text = b3_add_c_to_s(g_text, $K); }
-    | TOKEN_SPACE
-    { g_text = b3_add_c_to_s(g_text, ' '); }
-    | text TOKEN_SPACE
-    { g_text = b3_add_c_to_s(g_text, ' '); }
-    | TOKEN_PLUS
-    { g_text = b3_add_c_to_s(g_text, '+'); }
-    | text TOKEN_PLUS
-    { g_text = b3_add_c_to_s(g_text, '+'); }
-    | TOKEN_BRACKET_OPEN
-    { g_text = b3_add_c_to_s(g_text, '['); }
-    | text TOKEN_BRACKET_OPEN
-    { g_text = b3_add_c_to_s(g_text, '['); }
-    | TOKEN_BRACKET_CLOSE
-    { g_text = b3_add_c_to_s(g_text, ']'); }
-    | text TOKEN_BRACKET_CLOSE
-    { g_text = b3_add_c_to_s(g_text, ']'); }
-    | TOKEN_EQUAL
-    { g_text = b3_add_c_to_s(g_text, '='); }
-    | text TOKEN_EQUAL
-    { g_text = b3_add_c_to_s(g_text, '='); }
-    | TOKEN_DOUBLE_QUOTES
-    { g_text = b3_add_c_to_s(g_text, '"'); }
-    | text TOKEN_DOUBLE_QUOTES
-    { g_text = b3_add_c_to_s(g_text, ','); }
-    | TOKEN_COMMA
-    { g_text = b3_add_c_to_s(g_text, ','); }
-    | text TOKEN_COMMA
-    { g_text = b3_add_c_to_s(g_text, '='); }
-    | TOKEN_SPECIAL
-    { g_text = b3_add_c_to_s(g_text, $1); }
-    | text TOKEN_SPECIAL[S]
-    { g_text = b3_add_c_to_s(g_text, $S); }
-    | word-in-text
-    { g_text = b3_add_s_to_s(g_text, g_word); }
-    | text word-in-text
-    { g_text = b3_add_s_to_s(g_text, g_word); }
+/**
+ * A text is the slice of the input from its first to its last token
+ */
+text: text-token
+    | text text-token
+    { $$.str = $1.str; $$.len = $2.str + $2.len - $1.str; }
     ;
 
+text-token: TOKEN_KEY
+          | TOKEN_SPACE
+          | TOKEN_PLUS
+          | TOKEN_BRACKET_OPEN
+          | TOKEN_BRACKET_CLOSE
+          | TOKEN_EQUAL
+          | TOKEN_DOUBLE_QUOTES
+          | TOKEN_COMMA
+          | TOKEN_SPECIAL
+          | word-in-text
+          ;
+
 word-in-text: TOKEN_MODIFIER
-              { strcpy(g_word, $1); }
             | TOKEN_TOGGLE
-              { strcpy(g_word, "toggle"); }
             | TOKEN_BINDSYM
-              { strcpy(g_word, "bindsym"); }
             | TOKEN_MOVE
-              { strcpy(g_word, "move"); }
             | TOKEN_FOCUS
-              { strcpy(g_word, "focus"); }
             | TOKEN_CONTAINER
-              { strcpy(g_word, "container"); }
             | TOKEN_WORKSPACE
-              { strcpy(g_word, "workspace"); }
             | TOKEN_UP
-              { strcpy(g_word, "up"); }
             | TOKEN_DOWN
-              { strcpy(g_word, "down"); }
             | TOKEN_LEFT
-              { strcpy(g_word, "left"); }
             | TOKEN_RIGHT
-              { strcpy(g_word, "right"); }
             | TOKEN_KILL
-              { strcpy(g_word, "kill"); }
             | TOKEN_FLOATING
-              { strcpy(g_word, "floating"); }
             | TOKEN_ENABLE
-              { strcpy(g_word, "enable"); }
             | TOKEN_FULLSCREEN
-              { strcpy(g_word, "fullscreen"); }
             | TOKEN_EXEC
-              { strcpy(g_word, "exec"); }
             | TOKEN_NO_STARTUP_ID
-              { strcpy("--no-startup-id", g_word); }
-            | TOKEN_TOGGLE
-              { strcpy(g_word, "toggle"); }
             | TOKEN_TO
-              { strcpy(g_word, "to"); }
             | TOKEN_OUTPUT
-              { strcpy(g_word, "output"); }
             | TOKEN_FOR_WINDOW
-              { strcpy(g_word, "for_window"); }
             | TOKEN_TITLE
-              { strcpy(g_word, "title"); }
             | TOKEN_CLASS
-              { strcpy(g_word, "class"); }
+            | TOKEN_DUMP_RULE_PROFILE
+            | TOKEN_RELOAD
+            | TOKEN_INCLUDE
+            | TOKEN_MODE
             ;
 
 %%
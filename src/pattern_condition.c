@@ -59,28 +59,90 @@ b3_pattern_condition_get_re_extra_impl(b3_pattern_condition_t *pattern_condition
 static char
 b3_pattern_condition_get_use_focused_as_pattern_impl(b3_pattern_condition_t *pattern_condition);
 
+static b3_pattern_kind_t
+b3_pattern_condition_get_kind_impl(b3_pattern_condition_t *pattern_condition);
+
+static const char *
+b3_pattern_condition_get_literal_impl(b3_pattern_condition_t *pattern_condition);
+
+static int
+b3_pattern_condition_match_impl(b3_pattern_condition_t *pattern_condition, const char *subject);
+
+/**
+ * Implementation of b3_condition_get_key(). Exact and prefix literals are
+ * returned as key. The attribute has to be set by the subclass.
+ */
+static int
+b3_pattern_condition_get_key_impl(b3_condition_t *condition, b3_condition_key_t *key);
+
+/**
+ * Implementation of b3_condition_equals(). Both have to be of the same class
+ * (e.g. both class conditions) and have the same pattern.
+ */
+static int
+b3_pattern_condition_equals_impl(b3_condition_t *condition, b3_condition_t *other);
+
+static const char *
+b3_pattern_condition_get_pattern_impl(b3_pattern_condition_t *pattern_condition);
+
+/**
+ * Checks if pattern is a plain literal, optionally anchored by ^ and $.
+ *
+ * @param literal Will be set to a newly allocated, unescaped literal if the
+ * pattern is not a regular expression. Otherwise NULL. Free it by yourself!
+ * @return The kind of the pattern
+ */
+static b3_pattern_kind_t
+b3_pattern_condition_analyze(const char *pattern, char **literal);
+
 b3_pattern_condition_t *
 b3_pattern_condition_new(const char *pattern)
+{
+  return b3_pattern_condition_new_compiled(pattern, NULL, NULL);
+}
+
+b3_pattern_condition_t *
+b3_pattern_condition_new_compiled(const char *pattern, pcre *re_compiled, pcre_extra *re_extra)
 {
   int error;
-  pcre *re_compiled;
-  pcre_extra *re_extra;
   char use_focused_as_pattern;
+  b3_pattern_kind_t kind;
+  char *literal;
   b3_pattern_condition_t *pattern_condition;
   b3_condition_t *condition;
 
   error = 0;
   pattern_condition = NULL;
-  re_compiled = NULL;
-  re_extra = NULL;
   use_focused_as_pattern = 0;
+  kind = B3_PATTERN_KIND_REGEX;
+  literal = NULL;
 
   if (strcmp(pattern, B3_PATTERN_CONDITION_PATTERN_FOCUSED)) {
-    error = b3_compile_pattern(pattern, &re_compiled, &re_extra);
+    kind = b3_pattern_condition_analyze(pattern, &literal);
+    if (kind == B3_PATTERN_KIND_REGEX && re_compiled == NULL) {
+      error = b3_compile_pattern(pattern, &re_compiled, &re_extra);
+    }
   } else {
     use_focused_as_pattern = 1;
   }
 
+  /** Only regular expressions keep their compiled form */
+  if (kind != B3_PATTERN_KIND_REGEX || use_focused_as_pattern) {
+    if (re_compiled) {
+      pcre_free(re_compiled);
+      re_compiled = NULL;
+    }
+
+    if (re_extra) {
+#ifdef PCRE_CONFIG_JIT
+      pcre_free_study(re_extra);
+#else
+      pcre_free(re_extra);
+#endif
+      re_extra = NULL;
+    }
+  }
+
   if (!error) {
     pattern_condition = malloc(sizeof(b3_pattern_condition_t));
 
@@ -98,24 +160,43 @@ b3_pattern_condition_new(const char *pattern)
     /** Retrieve super methods */
     pattern_condition->super_condition_free = pattern_condition->condition.condition_free;
     pattern_condition->super_condition_applies = pattern_condition->condition.condition_applies;
+    pattern_condition->super_condition_get_key = pattern_condition->condition.condition_get_key;
+    pattern_condition->super_condition_equals = pattern_condition->condition.condition_equals;
 
     /** Overwrite b3_condition_t methods */
     pattern_condition->condition.condition_free = b3_pattern_condition_free_impl;
     pattern_condition->condition.condition_applies = b3_pattern_condition_applies_impl;
+    pattern_condition->condition.condition_get_key = b3_pattern_condition_get_key_impl;
+    pattern_condition->condition.condition_equals = b3_pattern_condition_equals_impl;
 
     /** Place b3_pattern_condition_t methods */
+    pattern_condition->pattern_condition_get_pattern = b3_pattern_condition_get_pattern_impl;
     pattern_condition->pattern_condition_get_re_compiled = b3_pattern_condition_get_re_compiled_impl;
     pattern_condition->pattern_condition_get_re_extra = b3_pattern_condition_get_re_extra_impl;
     pattern_condition->pattern_condition_get_use_focused_as_pattern = b3_pattern_condition_get_use_focused_as_pattern_impl;
+    pattern_condition->pattern_condition_get_kind = b3_pattern_condition_get_kind_impl;
+    pattern_condition->pattern_condition_get_literal = b3_pattern_condition_get_literal_impl;
+    pattern_condition->pattern_condition_match = b3_pattern_condition_match_impl;
 
+    pattern_condition->pattern = strdup(pattern);
     pattern_condition->re_compiled = re_compiled;
     pattern_condition->re_extra = re_extra;
     pattern_condition->use_focused_as_pattern = use_focused_as_pattern;
+    pattern_condition->kind = kind;
+    pattern_condition->literal = literal;
+  } else {
+    free(literal);
   }
 
   return pattern_condition;
 }
 
+const char *
+b3_pattern_condition_get_pattern(b3_pattern_condition_t *pattern_condition)
+{
+  return pattern_condition->pattern_condition_get_pattern(pattern_condition);
+}
+
 pcre *
 b3_pattern_condition_get_re_compiled(b3_pattern_condition_t *pattern_condition)
 {
@@ -134,6 +215,24 @@ b3_pattern_condition_get_use_focused_as_pattern(b3_pattern_condition_t *pattern_
   return pattern_condition->pattern_condition_get_use_focused_as_pattern(pattern_condition);
 }
 
+b3_pattern_kind_t
+b3_pattern_condition_get_kind(b3_pattern_condition_t *pattern_condition)
+{
+  return pattern_condition->pattern_condition_get_kind(pattern_condition);
+}
+
+const char *
+b3_pattern_condition_get_literal(b3_pattern_condition_t *pattern_condition)
+{
+  return pattern_condition->pattern_condition_get_literal(pattern_condition);
+}
+
+int
+b3_pattern_condition_match(b3_pattern_condition_t *pattern_condition, const char *subject)
+{
+  return pattern_condition->pattern_condition_match(pattern_condition, subject);
+}
+
 int
 b3_pattern_condition_free_impl(b3_condition_t *condition)
 {
@@ -148,6 +247,12 @@ b3_pattern_condition_free_impl(b3_condition_t *condition)
   pcre_free(pattern_condition->re_extra);
 #endif
 
+  free(pattern_condition->literal);
+  pattern_condition->literal = NULL;
+
+  free(pattern_condition->pattern);
+  pattern_condition->pattern = NULL;
+
   pattern_condition->super_condition_free(condition);
 
   return 0;
@@ -176,3 +281,208 @@ b3_pattern_condition_get_use_focused_as_pattern_impl(b3_pattern_condition_t *pat
 {
   return pattern_condition->use_focused_as_pattern;
 }
+
+b3_pattern_kind_t
+b3_pattern_condition_get_kind_impl(b3_pattern_condition_t *pattern_condition)
+{
+  return pattern_condition->kind;
+}
+
+const char *
+b3_pattern_condition_get_literal_impl(b3_pattern_condition_t *pattern_condition)
+{
+  return pattern_condition->literal;
+}
+
+int
+b3_pattern_condition_match_impl(b3_pattern_condition_t *pattern_condition, const char *subject)
+{
+  int matches;
+  int pcre_rc;
+
+  matches = 0;
+
+  switch (pattern_condition->kind) {
+  case B3_PATTERN_KIND_EXACT:
+    matches = (strcmp(subject, pattern_condition->literal) == 0);
+    break;
+
+  case B3_PATTERN_KIND_PREFIX:
+    matches = (strncmp(subject, pattern_condition->literal, strlen(pattern_condition->literal)) == 0);
+    break;
+
+  case B3_PATTERN_KIND_SUBSTRING:
+    matches = (strstr(subject, pattern_condition->literal) != NULL);
+    break;
+
+  case B3_PATTERN_KIND_REGEX:
+    if (pattern_condition->re_compiled) {
+      pcre_rc = pcre_exec(pattern_condition->re_compiled,
+                          pattern_condition->re_extra,
+                          subject,
+                          strlen(subject),
+                          0,
+                          0,
+                          NULL,
+                          0);
+      matches = (pcre_rc >= 0);
+    }
+    break;
+  }
+
+  return matches;
+}
+
+int
+b3_pattern_condition_equals_impl(b3_condition_t *condition, b3_condition_t *other)
+{
+  b3_pattern_condition_t *pattern_condition;
+  b3_pattern_condition_t *other_pattern_condition;
+  int equals;
+
+  /**
+   * Subclasses only differ in the attribute they apply the pattern to, i.e.
+   * in their implementation of b3_condition_applies().
+   */
+  equals = (other->condition_equals == condition->condition_equals
+            && other->condition_applies == condition->condition_applies);
+
+  if (equals) {
+    pattern_condition = (b3_pattern_condition_t *) condition;
+    other_pattern_condition = (b3_pattern_condition_t *) other;
+
+    equals = (strcmp(pattern_condition->pattern, other_pattern_condition->pattern) == 0);
+  }
+
+  return equals;
+}
+
+const char *
+b3_pattern_condition_get_pattern_impl(b3_pattern_condition_t *pattern_condition)
+{
+  return pattern_condition->pattern;
+}
+
+int
+b3_pattern_condition_get_key_impl(b3_condition_t *condition, b3_condition_key_t *key)
+{
+  b3_pattern_condition_t *pattern_condition;
+  int error;
+
+  pattern_condition = (b3_pattern_condition_t *) condition;
+
+  error = 1;
+  if (!pattern_condition->use_focused_as_pattern) {
+    switch (pattern_condition->kind) {
+    case B3_PATTERN_KIND_EXACT:
+    case B3_PATTERN_KIND_PREFIX:
+      key->attr = B3_CONDITION_ATTR_NONE;
+      key->prefix = (pattern_condition->kind == B3_PATTERN_KIND_PREFIX);
+      key->literal = pattern_condition->literal;
+      error = 0;
+      break;
+
+    default:
+      break;
+    }
+  }
+
+  return error;
+}
+
+b3_pattern_kind_t
+b3_pattern_condition_analyze(const char *pattern, char **literal)
+{
+  b3_pattern_kind_t kind;
+  char anchored_start;
+  char anchored_end;
+  char regex;
+  int length;
+  int i;
+  int j;
+
+  *literal = NULL;
+
+  length = strlen(pattern);
+  anchored_start = 0;
+  anchored_end = 0;
+  regex = 0;
+
+  *literal = malloc(sizeof(char) * (length + 1));
+  if (*literal == NULL) {
+    wbk_logger_log(&logger, SEVERE, "Could not allocate memory.\n");
+    regex = 1;
+  }
+
+  i = 0;
+  j = 0;
+  if (pattern[i] == '^') {
+    anchored_start = 1;
+    i++;
+  }
+
+  while (!regex && i < length) {
+    switch (pattern[i]) {
+    case '\\':
+      /** Escaped punctuation is a literal, anything else (\d, \w, \Q, ...) is not */
+      if (i + 1 < length
+          && !((pattern[i + 1] >= 'a' && pattern[i + 1] <= 'z')
+               || (pattern[i + 1] >= 'A' && pattern[i + 1] <= 'Z')
+               || (pattern[i + 1] >= '0' && pattern[i + 1] <= '9'))) {
+        (*literal)[j++] = pattern[i + 1];
+        i += 2;
+      } else {
+        regex = 1;
+      }
+      break;
+
+    case '$':
+      if (i == length - 1) {
+        anchored_end = 1;
+        i++;
+      } else {
+        regex = 1;
+      }
+      break;
+
+    case '.':
+    case '^':
+    case '|':
+    case '?':
+    case '*':
+    case '+':
+    case '(':
+    case ')':
+    case '[':
+    case ']':
+    case '{':
+    case '}':
+      regex = 1;
+      break;
+
+    default:
+      (*literal)[j++] = pattern[i++];
+      break;
+    }
+  }
+  if (*literal) {
+    (*literal)[j] = '\0';
+  }
+
+  if (regex || (anchored_end && !anchored_start)) {
+    kind = B3_PATTERN_KIND_REGEX;
+  } else if (anchored_start && anchored_end) {
+    kind = B3_PATTERN_KIND_EXACT;
+  } else if (anchored_start) {
+    kind = B3_PATTERN_KIND_PREFIX;
+  } else {
+    kind = B3_PATTERN_KIND_SUBSTRING;
+  }
+
+  if (kind == B3_PATTERN_KIND_REGEX) {
+    free(*literal);
+    *literal = NULL;
+  }
+
+  return kind;
+}
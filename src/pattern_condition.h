@@ -46,6 +46,22 @@
  */
 #define B3_PATTERN_CONDITION_PATTERN_FOCUSED "__focused__"
 
+/**
+ * Patterns are analyzed when the condition is created. Only patterns of kind
+ * B3_PATTERN_KIND_REGEX are compiled and matched by PCRE.
+ */
+typedef enum b3_pattern_kind_e
+{
+  /** A pattern that needs PCRE */
+  B3_PATTERN_KIND_REGEX = 0,
+  /** A literal without anchors, e.g. "Firefox" */
+  B3_PATTERN_KIND_SUBSTRING,
+  /** A literal anchored at the start, e.g. "^Firefox" */
+  B3_PATTERN_KIND_PREFIX,
+  /** A literal anchored at both ends, e.g. "^Firefox$" */
+  B3_PATTERN_KIND_EXACT
+} b3_pattern_kind_t;
+
 typedef struct b3_pattern_condition_s b3_pattern_condition_t;
 
 struct b3_pattern_condition_s
@@ -53,20 +69,57 @@ struct b3_pattern_condition_s
   b3_condition_t condition;
   int (*super_condition_free)(b3_condition_t *condition);
   int (*super_condition_applies)(b3_condition_t *condition, b3_director_t *director, b3_win_t *win);
+  int (*super_condition_get_key)(b3_condition_t *condition, b3_condition_key_t *key);
+  int (*super_condition_equals)(b3_condition_t *condition, b3_condition_t *other);
 
+  const char *(*pattern_condition_get_pattern)(b3_pattern_condition_t *pattern_condition);
   pcre *(*pattern_condition_get_re_compiled)(b3_pattern_condition_t *pattern_condition);
   pcre_extra *(*pattern_condition_get_re_extra)(b3_pattern_condition_t *pattern_condition);
   char (*pattern_condition_get_use_focused_as_pattern)(b3_pattern_condition_t *pattern_condition);
+  b3_pattern_kind_t (*pattern_condition_get_kind)(b3_pattern_condition_t *pattern_condition);
+  const char *(*pattern_condition_get_literal)(b3_pattern_condition_t *pattern_condition);
+  int (*pattern_condition_match)(b3_pattern_condition_t *pattern_condition, const char *subject);
+
+  /**
+   * The pattern as it was passed to b3_pattern_condition_new()
+   */
+  char *pattern;
 
   pcre *re_compiled;
   pcre_extra *re_extra;
 
   char use_focused_as_pattern;
+
+  b3_pattern_kind_t kind;
+
+  /**
+   * The unescaped literal of the pattern without anchors. NULL if kind is
+   * B3_PATTERN_KIND_REGEX.
+   */
+  char *literal;
 };
 
 extern b3_pattern_condition_t *
 b3_pattern_condition_new(const char *pattern);
 
+/**
+ * Creates a new pattern condition from an already compiled pattern, e.g. one
+ * that was loaded from the configuration cache.
+ *
+ * @param re_compiled The compiled pattern. It will be freed by the condition.
+ * If it is NULL, then the pattern is compiled.
+ * @param re_extra The study data of re_compiled or NULL. It will be freed by
+ * the condition.
+ */
+extern b3_pattern_condition_t *
+b3_pattern_condition_new_compiled(const char *pattern, pcre *re_compiled, pcre_extra *re_extra);
+
+/**
+ * @return The pattern of the condition. Do not free it!
+ */
+extern const char *
+b3_pattern_condition_get_pattern(b3_pattern_condition_t *pattern_condition);
+
 extern pcre *
 b3_pattern_condition_get_re_compiled(b3_pattern_condition_t *pattern_condition);
 
@@ -76,4 +129,24 @@ b3_pattern_condition_get_re_extra(b3_pattern_condition_t *pattern_condition);
 extern char
 b3_pattern_condition_get_use_focused_as_pattern(b3_pattern_condition_t *pattern_condition);
 
+extern b3_pattern_kind_t
+b3_pattern_condition_get_kind(b3_pattern_condition_t *pattern_condition);
+
+/**
+ * @return The literal of the pattern or NULL if the pattern is a regular
+ * expression. Do not free it!
+ */
+extern const char *
+b3_pattern_condition_get_literal(b3_pattern_condition_t *pattern_condition);
+
+/**
+ * Matches subject against the pattern of the condition. Literal patterns are
+ * compared directly, only regular expressions are passed to PCRE. Must not be
+ * used if the focused window is used as the pattern.
+ *
+ * @return Non-0 if subject matches.
+ */
+extern int
+b3_pattern_condition_match(b3_pattern_condition_t *pattern_condition, const char *subject);
+
 #endif // B3_PATTERN_CONDITION_H
@@ -0,0 +1,115 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-18
+ * @brief File contains the profiling counter implementation
+ */
+
+#include "profile.h"
+
+/**
+ * Ticks of the performance counter per second. It never changes while the
+ * system is running, so a racing first initialization is harmless.
+ */
+static LONGLONG g_frequency = 0;
+
+static LONGLONG
+b3_profile_ticks_to_ns(LONGLONG ticks);
+
+int
+b3_profile_init(b3_profile_t *profile)
+{
+  profile->evaluations = 0;
+  profile->matches = 0;
+  profile->total_ns = 0;
+  profile->max_ns = 0;
+
+  return 0;
+}
+
+LONGLONG
+b3_profile_start(void)
+{
+  LARGE_INTEGER counter;
+
+  QueryPerformanceCounter(&counter);
+
+  return counter.QuadPart;
+}
+
+int
+b3_profile_record(b3_profile_t *profile, LONGLONG start, int matched)
+{
+  LONGLONG duration_ns;
+  LONGLONG max_ns;
+  LONGLONG old_max_ns;
+
+  duration_ns = b3_profile_ticks_to_ns(b3_profile_start() - start);
+
+  InterlockedIncrement64(&(profile->evaluations));
+  if (matched) {
+    InterlockedIncrement64(&(profile->matches));
+  }
+  InterlockedExchangeAdd64(&(profile->total_ns), duration_ns);
+
+  max_ns = profile->max_ns;
+  while (duration_ns > max_ns) {
+    old_max_ns = InterlockedCompareExchange64(&(profile->max_ns), duration_ns, max_ns);
+    if (old_max_ns == max_ns) {
+      max_ns = duration_ns;
+    } else {
+      max_ns = old_max_ns;
+    }
+  }
+
+  return 0;
+}
+
+int
+b3_profile_copy(b3_profile_t *profile, b3_profile_t *copy)
+{
+  copy->evaluations = InterlockedCompareExchange64(&(profile->evaluations), 0, 0);
+  copy->matches = InterlockedCompareExchange64(&(profile->matches), 0, 0);
+  copy->total_ns = InterlockedCompareExchange64(&(profile->total_ns), 0, 0);
+  copy->max_ns = InterlockedCompareExchange64(&(profile->max_ns), 0, 0);
+
+  return 0;
+}
+
+LONGLONG
+b3_profile_ticks_to_ns(LONGLONG ticks)
+{
+  LARGE_INTEGER frequency;
+
+  if (g_frequency == 0) {
+    QueryPerformanceFrequency(&frequency);
+    g_frequency = frequency.QuadPart;
+  }
+
+  /** Split to avoid overflowing for long durations */
+  return (ticks / g_frequency) * 1000000000LL
+    + ((ticks % g_frequency) * 1000000000LL) / g_frequency;
+}
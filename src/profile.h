@@ -0,0 +1,91 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-18
+ * @brief File contains the profiling counter definition
+ *
+ * The counters are updated by Interlocked operations only. They can be
+ * recorded by any number of threads at once without taking a lock.
+ */
+
+#ifndef B3_PROFILE_H
+#define B3_PROFILE_H
+
+#include <windows.h>
+
+typedef struct b3_profile_s
+{
+  /**
+   * Number of evaluations
+   */
+  volatile LONGLONG evaluations;
+
+  /**
+   * Number of evaluations that matched
+   */
+  volatile LONGLONG matches;
+
+  /**
+   * Cumulative time of all evaluations in nanoseconds
+   */
+  volatile LONGLONG total_ns;
+
+  /**
+   * Time of the slowest evaluation in nanoseconds
+   */
+  volatile LONGLONG max_ns;
+} b3_profile_t;
+
+/**
+ * @brief Resets all counters to 0.
+ */
+extern int
+b3_profile_init(b3_profile_t *profile);
+
+/**
+ * @return The current timestamp. Pass it to b3_profile_record() after the
+ * evaluation.
+ */
+extern LONGLONG
+b3_profile_start(void);
+
+/**
+ * @brief Records one evaluation that started at start.
+ * @param start The timestamp returned by b3_profile_start().
+ * @param matched Non-0 if the evaluation matched.
+ */
+extern int
+b3_profile_record(b3_profile_t *profile, LONGLONG start, int matched);
+
+/**
+ * @brief Reads all counters of profile into copy. Each counter is read
+ * atomically, but the counters are not consistent among each other if they
+ * are recorded at the same time.
+ */
+extern int
+b3_profile_copy(b3_profile_t *profile, b3_profile_t *copy);
+
+#endif // B3_PROFILE_H
@@ -0,0 +1,904 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-18
+ * @brief File contains the configuration reloader class implementation and its
+ * private methods
+ */
+
+#include "reloader.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <w32bindkeys/logger.h>
+
+#include "kc_director.h"
+#include "kc_exec.h"
+#include "rule.h"
+#include "config_cache.h"
+#include "kbtable.h"
+#include "mode.h"
+
+/**
+ * Appended to the name of the configuration file to get the name of its cache.
+ */
+#define B3_RELOADER_CACHE_SUFFIX ".cache"
+
+/**
+ * Windows removes low level hooks which take too long. Dispatching should
+ * stay well below this time in nanoseconds.
+ */
+#define B3_RELOADER_DISPATCH_BUDGET_NS 1000000
+
+static wbk_logger_t logger = { "reloader" };
+
+struct b3_bindings_s
+{
+  /**
+   * The bindings outside of mode blocks, i.e. of the mode "default"
+   */
+  b3_kbtable_t *kbtable;
+
+  int mode_len;
+  char **mode_name_arr;
+  b3_kbtable_t **mode_kbtable_arr;
+
+  /**
+   * The table of the active mode. Switching the mode only swaps this
+   * pointer with InterlockedExchangePointer(), the tables are built once per
+   * load.
+   */
+  b3_kbtable_t *volatile active_kbtable;
+
+  /**
+   * Number of key commands currently executed on the tables
+   */
+  volatile LONG users;
+};
+
+/**
+ * @param kbman The bindings outside of mode blocks. They will be freed by the
+ * bindings!
+ * @param mode_arr The modes. Their key bindings are taken, the modes
+ * themselves stay with the caller.
+ */
+static b3_bindings_t *
+b3_bindings_new(wbk_kbman_t *kbman, CC_Array *mode_arr);
+
+/**
+ * @brief Pins the current bindings, so that they are not freed until
+ * users is decremented again.
+ * @return The pinned bindings or NULL if nothing was loaded yet
+ */
+static b3_bindings_t *
+b3_reloader_pin_bindings(b3_reloader_t *reloader);
+
+static int
+b3_bindings_free(b3_bindings_t *bindings);
+
+/**
+ * @return The table of the mode called mode_name or NULL if there is no such
+ * mode.
+ */
+static b3_kbtable_t *
+b3_bindings_find_mode(b3_bindings_t *bindings, const char *mode_name);
+
+/**
+ * @return Non-0 if kc and other are equal.
+ */
+static int
+b3_reloader_kc_equals(const wbk_kc_t *kc, const wbk_kc_t *other);
+
+/**
+ * Compares the key commands of two key binding managers in order. The first
+ * key command of a combination wins, so reordering them changes the bindings.
+ *
+ * @param kept Increased by the number of key commands in both managers
+ * regardless of their order.
+ * @return Non-0 if both managers contain the same key commands in the same
+ * order. 0 if they differ or the comparison failed.
+ */
+static int
+b3_reloader_kbman_equals(const wbk_kbman_t *kbman, const wbk_kbman_t *other, int *kept);
+
+/**
+ * Compares the modes of bindings with the ones of mode_arr.
+ *
+ * @param kept Increased by the number of key commands in both.
+ * @return Non-0 if both contain the same modes with the same key commands.
+ */
+static int
+b3_reloader_modes_equal(const b3_bindings_t *bindings, CC_Array *mode_arr, int *kept);
+
+/**
+ * Swaps the bindings if their key commands changed. Swapped bindings start in
+ * the mode "default".
+ *
+ * @param kbman The new key bindings. They will be freed by the reloader!
+ * @param mode_arr The new modes. They will be freed by the reloader!
+ */
+static int
+b3_reloader_swap_bindings(b3_reloader_t *reloader, wbk_kbman_t *kbman, CC_Array *mode_arr);
+
+/**
+ * Frees the retired bindings that are not used anymore.
+ */
+static int
+b3_reloader_collect_bindings(b3_reloader_t *reloader);
+
+/**
+ * Reads the whole configuration file.
+ *
+ * @return The contents of the file or NULL if it could not be read. Free it by
+ * yourself!
+ */
+static char *
+b3_reloader_read_config(b3_reloader_t *reloader, size_t *config_len);
+
+/**
+ * @return The directory of the configuration file including its trailing
+ * separator. Free it by yourself!
+ */
+static char *
+b3_reloader_get_config_dir(b3_reloader_t *reloader);
+
+/**
+ * Reload handler of the director.
+ */
+static int
+b3_reloader_reload_handler(void *data);
+
+/**
+ * Mode handler of the director.
+ */
+static int
+b3_reloader_mode_handler(void *data, const char *mode_name);
+
+b3_reloader_t *
+b3_reloader_new(b3_parser_t *parser, b3_director_t *director, const char *config_filename)
+{
+	int error;
+	b3_reloader_t *reloader;
+
+	error = 0;
+
+	reloader = malloc(sizeof(b3_reloader_t));
+	if (reloader == NULL) {
+		error = 1;
+	}
+
+	if (!error) {
+		memset(reloader, 0, sizeof(b3_reloader_t));
+		reloader->parser = parser;
+		reloader->director = director;
+		b3_profile_init(&(reloader->dispatch_profile));
+
+		reloader->config_filename = strdup(config_filename);
+		reloader->cache_filename = malloc(sizeof(char) * (strlen(config_filename) + strlen(B3_RELOADER_CACHE_SUFFIX) + 1));
+		if (reloader->config_filename == NULL || reloader->cache_filename == NULL) {
+			error = 2;
+		}
+	}
+
+	if (!error) {
+		strcpy(reloader->cache_filename, config_filename);
+		strcat(reloader->cache_filename, B3_RELOADER_CACHE_SUFFIX);
+
+		reloader->global_mutex = CreateMutex(NULL, FALSE, NULL);
+		if (reloader->global_mutex == NULL) {
+			error = 3;
+		}
+	}
+
+	if (!error) {
+		if (cc_array_new(&(reloader->retired_bindings_arr)) != CC_OK) {
+			error = 4;
+		}
+	}
+
+	/**
+	 * Key commands are never executed on the thread of the keyboard hook, so
+	 * there is no reloader without a queue.
+	 */
+	if (!error) {
+		reloader->kcqueue = b3_kcqueue_new();
+		if (reloader->kcqueue == NULL) {
+			error = 5;
+		}
+	}
+
+	if (!error) {
+		b3_director_set_reload_handler(director, b3_reloader_reload_handler, reloader);
+		b3_director_set_mode_handler(director, b3_reloader_mode_handler, reloader);
+	}
+
+	if (error && reloader) {
+		wbk_logger_log(&logger, SEVERE, "Could not create the reloader\n");
+
+		if (reloader->retired_bindings_arr) {
+			cc_array_destroy(reloader->retired_bindings_arr);
+		}
+		if (reloader->global_mutex) {
+			CloseHandle(reloader->global_mutex);
+		}
+		free(reloader->cache_filename);
+		free(reloader->config_filename);
+		free(reloader);
+		reloader = NULL;
+	}
+
+	return reloader;
+}
+
+int
+b3_reloader_free(b3_reloader_t *reloader)
+{
+	CC_ArrayIter iter;
+	b3_bindings_t *bindings;
+
+	b3_director_set_reload_handler(reloader->director, NULL, NULL);
+	b3_director_set_mode_handler(reloader->director, NULL, NULL);
+
+	/**
+	 * The queued key commands belong to the bindings
+	 */
+	if (reloader->kcqueue) {
+		b3_reloader_log_latency(reloader);
+		b3_kcqueue_free(reloader->kcqueue);
+		reloader->kcqueue = NULL;
+	}
+
+	WaitForSingleObject(reloader->global_mutex, INFINITE);
+
+	if (reloader->bindings) {
+		b3_bindings_free(reloader->bindings);
+		reloader->bindings = NULL;
+	}
+
+	cc_array_iter_init(&iter, reloader->retired_bindings_arr);
+	while (cc_array_iter_next(&iter, (void*) &bindings) != CC_ITER_END) {
+		b3_bindings_free(bindings);
+	}
+	cc_array_destroy(reloader->retired_bindings_arr);
+	reloader->retired_bindings_arr = NULL;
+
+	free(reloader->config_filename);
+	reloader->config_filename = NULL;
+
+	free(reloader->cache_filename);
+	reloader->cache_filename = NULL;
+
+	reloader->parser = NULL;
+	reloader->director = NULL;
+
+	ReleaseMutex(reloader->global_mutex);
+
+	CloseHandle(reloader->global_mutex);
+
+	free(reloader);
+
+	return 0;
+}
+
+int
+b3_reloader_load(b3_reloader_t *reloader)
+{
+	int error;
+	char *config;
+	size_t config_len;
+	unsigned long long key;
+	const char *source;
+	wbk_kbman_t *kbman;
+	CC_Array *rule_arr;
+	CC_Array *mode_arr;
+	CC_ArrayIter iter;
+	b3_rule_t *rule;
+	b3_mode_t *mode;
+	DWORD start;
+	char *config_dir;
+	int fragment_len;
+
+	WaitForSingleObject(reloader->global_mutex, INFINITE);
+
+	start = GetTickCount();
+
+	error = 0;
+	kbman = NULL;
+	source = "cache";
+	cc_array_new(&rule_arr);
+	cc_array_new(&mode_arr);
+
+	config = b3_reloader_read_config(reloader, &config_len);
+	if (config == NULL) {
+		wbk_logger_log(&logger, SEVERE, "Could not open %s\n", reloader->config_filename);
+		error = 1;
+	}
+
+	if (!error) {
+		key = b3_config_cache_key(config, config_len);
+
+		if (b3_config_cache_load(reloader->cache_filename, key, reloader->director, &kbman, rule_arr)) {
+			source = "parser";
+			config_dir = b3_reloader_get_config_dir(reloader);
+			if (config_dir) {
+				kbman = b3_parser_parse_str_in_dir(reloader->parser, reloader->director, config,
+												   config_dir, reloader->config_filename, rule_arr,
+												   mode_arr, &fragment_len);
+				free(config_dir);
+			}
+
+			if (kbman && fragment_len > 0) {
+				/**
+				 * The key only covers the configuration file itself, so a
+				 * changed fragment would not invalidate the cache.
+				 */
+				wbk_logger_log(&logger, INFO, "Not caching %s, it includes %d fragments\n",
+							   reloader->config_filename, fragment_len);
+			} else if (kbman && cc_array_size(mode_arr) > 0) {
+				/**
+				 * The cache only holds the bindings outside of mode blocks
+				 */
+				wbk_logger_log(&logger, INFO, "Not caching %s, it declares %d modes\n",
+							   reloader->config_filename, cc_array_size(mode_arr));
+			} else if (kbman) {
+				b3_config_cache_save(reloader->cache_filename, key, kbman, rule_arr);
+			} else {
+				wbk_logger_log(&logger, SEVERE, "Could not parse %s. Keeping the current configuration.\n",
+							   reloader->config_filename);
+				error = 2;
+			}
+		}
+
+		free(config);
+	}
+
+	if (!error) {
+		b3_reloader_collect_bindings(reloader);
+		if (b3_reloader_swap_bindings(reloader, kbman, mode_arr)) {
+			wbk_logger_log(&logger, SEVERE, "Could not swap the bindings. Keeping the current configuration.\n");
+			error = 3;
+		}
+		kbman = NULL;
+		mode_arr = NULL;
+	}
+
+	if (kbman) {
+		wbk_kbman_free(kbman);
+		kbman = NULL;
+	}
+
+	if (mode_arr) {
+		cc_array_iter_init(&iter, mode_arr);
+		while (cc_array_iter_next(&iter, (void*) &mode) != CC_ITER_END) {
+			b3_mode_free(mode);
+		}
+		cc_array_destroy(mode_arr);
+		mode_arr = NULL;
+	}
+
+	if (!error) {
+		error = b3_director_replace_rules(reloader->director, rule_arr);
+	} else {
+		cc_array_iter_init(&iter, rule_arr);
+		while (cc_array_iter_next(&iter, (void*) &rule) != CC_ITER_END) {
+			b3_rule_free(rule);
+		}
+	}
+	cc_array_destroy(rule_arr);
+
+	if (!error) {
+		wbk_logger_log(&logger, INFO, "Loaded %s from the %s in %lu ms\n",
+					   reloader->config_filename, source, GetTickCount() - start);
+		b3_reloader_log_latency(reloader);
+	}
+
+	ReleaseMutex(reloader->global_mutex);
+
+	return error;
+}
+
+int
+b3_reloader_exec(b3_reloader_t *reloader, wbk_b_t *b)
+{
+	b3_bindings_t *bindings;
+	wbk_kc_t *kc;
+	LONGLONG start;
+	int error;
+	int queued;
+
+	start = b3_profile_start();
+
+	bindings = b3_reloader_pin_bindings(reloader);
+
+	error = 1;
+	kc = NULL;
+	queued = 0;
+	if (bindings) {
+		kc = b3_kbtable_find(bindings->active_kbtable, b);
+	}
+
+	if (kc && b3_kc_director_instance_of(kc)
+		&& ((b3_kc_director_t *) kc)->kind == SWITCH_MODE) {
+		/** Only swaps a pointer */
+		error = wbk_kc_exec(kc);
+	} else if (kc) {
+		/**
+		 * A full queue drops the key command. The queue counts the drops and
+		 * b3_reloader_log_latency() reports them.
+		 */
+		error = b3_kcqueue_push(reloader->kcqueue, kc, &(bindings->users));
+		queued = !error;
+	}
+
+	/**
+	 * The worker releases the bindings of a queued key command
+	 */
+	if (bindings && !queued) {
+		InterlockedDecrement(&(bindings->users));
+	}
+
+	b3_profile_record(&(reloader->dispatch_profile), start, kc != NULL);
+
+	return error;
+}
+
+int
+b3_reloader_log_latency(b3_reloader_t *reloader)
+{
+	b3_profile_t profile;
+
+	b3_profile_copy(&(reloader->dispatch_profile), &profile);
+	if (profile.evaluations > 0) {
+		wbk_logger_log(&logger, profile.max_ns > B3_RELOADER_DISPATCH_BUDGET_NS ? WARNING : INFO,
+					   "%lld combinations dispatched in %.3f ms on average (at most %.3f ms), %lld bound\n",
+					   profile.evaluations,
+					   profile.total_ns / (double) profile.evaluations / 1000000.0,
+					   profile.max_ns / 1000000.0,
+					   profile.matches);
+	}
+
+	if (reloader->kcqueue) {
+		b3_kcqueue_log_latency(reloader->kcqueue);
+	}
+
+	return 0;
+}
+
+int
+b3_reloader_switch_mode(b3_reloader_t *reloader, const char *mode_name)
+{
+	b3_bindings_t *bindings;
+	b3_kbtable_t *kbtable;
+	int error;
+
+	error = 1;
+
+	bindings = b3_reloader_pin_bindings(reloader);
+	if (bindings) {
+		kbtable = b3_bindings_find_mode(bindings, mode_name);
+		if (kbtable) {
+			InterlockedExchangePointer((PVOID volatile *) &(bindings->active_kbtable), kbtable);
+			error = 0;
+		}
+		InterlockedDecrement(&(bindings->users));
+	}
+
+	if (error) {
+		wbk_logger_log(&logger, WARNING, "Mode %s is not defined\n", mode_name);
+	}
+
+	return error;
+}
+
+b3_bindings_t *
+b3_bindings_new(wbk_kbman_t *kbman, CC_Array *mode_arr)
+{
+	int error;
+	b3_bindings_t *bindings;
+	b3_kbtable_t *kbtable;
+	b3_mode_t *mode;
+	char *mode_name;
+	int mode_len;
+
+	error = 0;
+
+	bindings = malloc(sizeof(b3_bindings_t));
+	if (bindings == NULL) {
+		error = 1;
+	}
+
+	if (!error) {
+		memset(bindings, 0, sizeof(b3_bindings_t));
+
+		bindings->kbtable = b3_kbtable_new(kbman);
+		if (bindings->kbtable == NULL) {
+			error = 2;
+		} else {
+			kbman = NULL;
+		}
+	}
+
+	if (!error) {
+		mode_len = cc_array_size(mode_arr);
+		bindings->mode_name_arr = malloc(sizeof(char *) * (mode_len + 1));
+		bindings->mode_kbtable_arr = malloc(sizeof(b3_kbtable_t *) * (mode_len + 1));
+		if (bindings->mode_name_arr == NULL || bindings->mode_kbtable_arr == NULL) {
+			error = 3;
+		}
+	}
+
+	/**
+	 * The key bindings of a mode are only taken once its table exists, so the
+	 * mode still frees them otherwise.
+	 */
+	while (!error && bindings->mode_len < mode_len) {
+		cc_array_get_at(mode_arr, bindings->mode_len, (void *) &mode);
+
+		kbtable = NULL;
+		mode_name = strdup(b3_mode_get_name(mode));
+		if (mode_name) {
+			kbtable = b3_kbtable_new((wbk_kbman_t *) b3_mode_get_kbman(mode));
+		}
+
+		if (kbtable) {
+			b3_mode_take_kbman(mode);
+			bindings->mode_name_arr[bindings->mode_len] = mode_name;
+			bindings->mode_kbtable_arr[bindings->mode_len] = kbtable;
+			bindings->mode_len++;
+		} else {
+			free(mode_name);
+			error = 4;
+		}
+	}
+
+	if (!error) {
+		bindings->active_kbtable = bindings->kbtable;
+		bindings->users = 0;
+	}
+
+	if (error) {
+		wbk_logger_log(&logger, SEVERE, "Could not allocate memory for the bindings\n");
+
+		if (kbman) {
+			wbk_kbman_free(kbman);
+		}
+		if (bindings) {
+			b3_bindings_free(bindings);
+			bindings = NULL;
+		}
+	}
+
+	return bindings;
+}
+
+int
+b3_bindings_free(b3_bindings_t *bindings)
+{
+	int i;
+
+	bindings->active_kbtable = NULL;
+
+	if (bindings->kbtable) {
+		b3_kbtable_free(bindings->kbtable);
+		bindings->kbtable = NULL;
+	}
+
+	for (i = 0; i < bindings->mode_len; i++) {
+		free(bindings->mode_name_arr[i]);
+		b3_kbtable_free(bindings->mode_kbtable_arr[i]);
+	}
+	free(bindings->mode_name_arr);
+	bindings->mode_name_arr = NULL;
+	free(bindings->mode_kbtable_arr);
+	bindings->mode_kbtable_arr = NULL;
+	bindings->mode_len = 0;
+
+	free(bindings);
+
+	return 0;
+}
+
+b3_kbtable_t *
+b3_bindings_find_mode(b3_bindings_t *bindings, const char *mode_name)
+{
+	b3_kbtable_t *kbtable;
+	int i;
+
+	kbtable = NULL;
+	if (strcmp(mode_name, B3_MODE_DEFAULT) == 0) {
+		kbtable = bindings->kbtable;
+	}
+
+	for (i = 0; kbtable == NULL && i < bindings->mode_len; i++) {
+		if (strcmp(bindings->mode_name_arr[i], mode_name) == 0) {
+			kbtable = bindings->mode_kbtable_arr[i];
+		}
+	}
+
+	return kbtable;
+}
+
+int
+b3_reloader_kc_equals(const wbk_kc_t *kc, const wbk_kc_t *other)
+{
+	return b3_kc_director_equals(kc, other)
+		|| b3_kc_exec_equals(kc, other);
+}
+
+int
+b3_reloader_kbman_equals(const wbk_kbman_t *kbman, const wbk_kbman_t *other, int *kept)
+{
+	char *used_arr;
+	int equal;
+	int found;
+	int i;
+	int j;
+
+	equal = kbman->kc_arr_len == other->kc_arr_len;
+	for (i = 0; equal && i < kbman->kc_arr_len; i++) {
+		equal = b3_reloader_kc_equals(kbman->kc_arr[i], other->kc_arr[i]);
+	}
+
+	used_arr = malloc(sizeof(char) * (other->kc_arr_len + 1));
+	if (used_arr == NULL) {
+		wbk_logger_log(&logger, SEVERE, "Bindings could not be compared\n");
+		equal = 0;
+	}
+
+	if (used_arr) {
+		memset(used_arr, 0, sizeof(char) * (other->kc_arr_len + 1));
+
+		found = 0;
+		for (i = 0; i < kbman->kc_arr_len; i++) {
+			for (j = 0; j < other->kc_arr_len; j++) {
+				if (!used_arr[j]
+					&& b3_reloader_kc_equals(kbman->kc_arr[i], other->kc_arr[j])) {
+					used_arr[j] = 1;
+					found++;
+					break;
+				}
+			}
+		}
+
+		free(used_arr);
+
+		*kept += found;
+	}
+
+	return equal;
+}
+
+int
+b3_reloader_modes_equal(const b3_bindings_t *bindings, CC_Array *mode_arr, int *kept)
+{
+	b3_mode_t *mode;
+	int equal;
+	int i;
+
+	equal = bindings->mode_len == cc_array_size(mode_arr);
+
+	for (i = 0; i < bindings->mode_len; i++) {
+		mode = b3_mode_find(mode_arr, bindings->mode_name_arr[i]);
+		if (mode == NULL) {
+			equal = 0;
+		} else if (!b3_reloader_kbman_equals(bindings->mode_kbtable_arr[i]->kbman,
+		                                     b3_mode_get_kbman(mode), kept)) {
+			equal = 0;
+		}
+	}
+
+	return equal;
+}
+
+int
+b3_reloader_swap_bindings(b3_reloader_t *reloader, wbk_kbman_t *kbman, CC_Array *mode_arr)
+{
+	int error;
+	b3_bindings_t *bindings;
+	CC_ArrayIter iter;
+	b3_mode_t *mode;
+	int old_len;
+	int new_len;
+	int kept;
+	int equal;
+	int i;
+
+	/**
+	 * The bindings are only replaced while holding global_mutex, so they can
+	 * be compared without pinning them.
+	 */
+	error = 0;
+	old_len = 0;
+	new_len = kbman->kc_arr_len;
+	kept = 0;
+	equal = 0;
+
+	cc_array_iter_init(&iter, mode_arr);
+	while (cc_array_iter_next(&iter, (void*) &mode) != CC_ITER_END) {
+		new_len += b3_mode_get_kbman(mode)->kc_arr_len;
+	}
+
+	if (reloader->bindings) {
+		old_len = reloader->bindings->kbtable->kbman->kc_arr_len;
+		for (i = 0; i < reloader->bindings->mode_len; i++) {
+			old_len += reloader->bindings->mode_kbtable_arr[i]->kbman->kc_arr_len;
+		}
+
+		equal = b3_reloader_kbman_equals(reloader->bindings->kbtable->kbman, kbman, &kept);
+		equal = b3_reloader_modes_equal(reloader->bindings, mode_arr, &kept) && equal;
+	}
+
+	if (equal) {
+		wbk_kbman_free(kbman);
+	} else {
+		bindings = b3_bindings_new(kbman, mode_arr);
+		if (bindings == NULL) {
+			error = 1;
+		}
+	}
+
+	if (!equal && !error) {
+		bindings = InterlockedExchangePointer((PVOID volatile *) &(reloader->bindings), bindings);
+		if (bindings) {
+			cc_array_add(reloader->retired_bindings_arr, bindings);
+		}
+	}
+
+	cc_array_iter_init(&iter, mode_arr);
+	while (cc_array_iter_next(&iter, (void*) &mode) != CC_ITER_END) {
+		b3_mode_free(mode);
+	}
+	cc_array_destroy(mode_arr);
+
+	if (!error) {
+		wbk_logger_log(&logger, INFO, "Bindings: %d kept, %d added, %d removed, %d combinations, %d modes\n",
+					   kept, new_len - kept, old_len - kept, reloader->bindings->kbtable->key_len,
+					   reloader->bindings->mode_len);
+	}
+
+	return error;
+}
+
+int
+b3_reloader_collect_bindings(b3_reloader_t *reloader)
+{
+	b3_bindings_t *bindings;
+	size_t i;
+
+	/**
+	 * A thread pinning right now may have read retired bindings before they
+	 * were replaced and not yet counted itself as their user. They are
+	 * collected by the next load then.
+	 */
+	i = 0;
+	while (InterlockedCompareExchange(&(reloader->pinning), 0, 0) == 0
+		   && i < cc_array_size(reloader->retired_bindings_arr)) {
+		cc_array_get_at(reloader->retired_bindings_arr, i, (void*) &bindings);
+		if (InterlockedCompareExchange(&(bindings->users), 0, 0) == 0) {
+			cc_array_remove_at(reloader->retired_bindings_arr, i, NULL);
+			b3_bindings_free(bindings);
+		} else {
+			i++;
+		}
+	}
+
+	return 0;
+}
+
+b3_bindings_t *
+b3_reloader_pin_bindings(b3_reloader_t *reloader)
+{
+	b3_bindings_t *bindings;
+	b3_bindings_t *current;
+
+	InterlockedIncrement(&(reloader->pinning));
+
+	/**
+	 * If the bindings were replaced before they were pinned, then the pin is
+	 * taken back and the new ones are pinned instead.
+	 */
+	current = reloader->bindings;
+	do {
+		bindings = current;
+		if (bindings) {
+			InterlockedIncrement(&(bindings->users));
+			current = reloader->bindings;
+			if (current != bindings) {
+				InterlockedDecrement(&(bindings->users));
+			}
+		}
+	} while (current != bindings);
+
+	InterlockedDecrement(&(reloader->pinning));
+
+	return bindings;
+}
+
+char *
+b3_reloader_read_config(b3_reloader_t *reloader, size_t *config_len)
+{
+	FILE *config_file;
+	long size;
+	char *config;
+
+	config = NULL;
+
+	config_file = fopen(reloader->config_filename, "r");
+	if (config_file) {
+		fseek(config_file, 0, SEEK_END);
+		size = ftell(config_file);
+		fseek(config_file, 0, SEEK_SET);
+
+		if (size >= 0) {
+			config = malloc(sizeof(char) * (size + 1));
+		}
+
+		if (config) {
+			/** Text mode might shrink the contents */
+			*config_len = fread(config, sizeof(char), size, config_file);
+			config[*config_len] = '\0';
+		}
+
+		fclose(config_file);
+	}
+
+	return config;
+}
+
+char *
+b3_reloader_get_config_dir(b3_reloader_t *reloader)
+{
+	char *config_dir;
+	int length;
+
+	length = strlen(reloader->config_filename);
+	while (length > 0
+		   && reloader->config_filename[length - 1] != '\\'
+		   && reloader->config_filename[length - 1] != '/') {
+		length--;
+	}
+
+	config_dir = malloc(sizeof(char) * (length + 1));
+	if (config_dir) {
+		memcpy(config_dir, reloader->config_filename, length);
+		config_dir[length] = '\0';
+	}
+
+	return config_dir;
+}
+
+int
+b3_reloader_reload_handler(void *data)
+{
+	return b3_reloader_load((b3_reloader_t *) data);
+}
+
+int
+b3_reloader_mode_handler(void *data, const char *mode_name)
+{
+	return b3_reloader_switch_mode((b3_reloader_t *) data, mode_name);
+}
@@ -0,0 +1,158 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-18
+ * @brief File contains the configuration reloader class definition
+ *
+ * The reloader owns the key bindings of the keyboard daemon. They are held in
+ * key binding tables, one for the bindings outside of mode blocks and one for
+ * each mode, see kbtable.h and mode.h. Combinations are dispatched by the table
+ * of the active mode. On reload, the configuration is parsed again and the
+ * tables are swapped if the bindings changed.
+ *
+ * Dispatching runs on the thread of the keyboard hook. It only looks the
+ * combination up and pushes the key command into a key command queue, see
+ * kcqueue.h. The worker of the queue executes it. The hook takes no lock: the
+ * bindings are published with InterlockedExchangePointer() and pinned by
+ * counting their users, replaced ones are only freed once nobody uses them.
+ * The rules are handed to b3_director_replace_rules(), which keeps the
+ * unchanged ones.
+ * Neither the workspaces nor the windows are touched.
+ */
+
+#ifndef B3_RELOADER_H
+#define B3_RELOADER_H
+
+#include <windows.h>
+#include <collectc/cc_array.h>
+#include <w32bindkeys/kbman.h>
+#include <w32bindkeys/b.h>
+
+#include "parser.h"
+#include "director.h"
+#include "kcqueue.h"
+#include "profile.h"
+
+typedef struct b3_bindings_s b3_bindings_t;
+
+typedef struct b3_reloader_s
+{
+  b3_parser_t *parser;
+
+  b3_director_t *director;
+
+  char *config_filename;
+
+  /**
+   * The compiled form of the configuration, see config_cache.h
+   */
+  char *cache_filename;
+
+  /**
+   * Serializes loading
+   */
+  HANDLE global_mutex;
+
+  /**
+   * The current bindings or NULL if nothing was loaded yet. They are replaced
+   * by InterlockedExchangePointer() while holding global_mutex.
+   */
+  b3_bindings_t *volatile bindings;
+
+  /**
+   * Number of threads currently pinning the bindings. A thread may still hold
+   * bindings it read before they were replaced, so replaced bindings are only
+   * freed while no thread is pinning.
+   */
+  volatile LONG pinning;
+
+  /**
+   * Replaced bindings. They are freed by the next load once no key command is
+   * executed on them anymore, because key commands finish their work in
+   * threads of their own.
+   */
+  CC_Array *retired_bindings_arr;
+
+  /**
+   * Executes the dispatched key commands
+   */
+  b3_kcqueue_t *kcqueue;
+
+  /**
+   * Time spent in b3_reloader_exec(). It matches if the combination is bound.
+   */
+  b3_profile_t dispatch_profile;
+} b3_reloader_t;
+
+/**
+ * @param parser The parser. It will not be freed by freeing the reloader!
+ * @param director The director. It will not be freed by freeing the reloader!
+ * The reloader registers itself as reload and mode handler of the director.
+ * @param config_filename The path of the configuration file. The string is
+ * copied.
+ * @return NULL if the reloader or its key command queue could not be created
+ */
+extern b3_reloader_t *
+b3_reloader_new(b3_parser_t *parser, b3_director_t *director, const char *config_filename);
+
+extern int
+b3_reloader_free(b3_reloader_t *reloader);
+
+/**
+ * @brief Parses the configuration file and swaps the bindings and rules that
+ * changed. If the configuration cache matches the file, then it is restored
+ * instead of parsing. If parsing fails, then the current configuration stays
+ * in place.
+ * @return Non-0 if the configuration could not be loaded.
+ */
+extern int
+b3_reloader_load(b3_reloader_t *reloader);
+
+/**
+ * @brief Dispatches the key command bound to a combination in the active mode.
+ * It is executed by the worker of the key command queue. Mode switches are
+ * executed right away, so the next combination is already dispatched by the
+ * new mode.
+ * @return Non-0 if the combination is not bound or the queue is full.
+ */
+extern int
+b3_reloader_exec(b3_reloader_t *reloader, wbk_b_t *b);
+
+/**
+ * @brief Logs how long dispatching and executing key commands took.
+ */
+extern int
+b3_reloader_log_latency(b3_reloader_t *reloader);
+
+/**
+ * @brief Makes a mode the active one. Reloading changed bindings activates the
+ * mode "default" again.
+ * @return Non-0 if there is no mode called mode_name.
+ */
+extern int
+b3_reloader_switch_mode(b3_reloader_t *reloader, const char *mode_name);
+
+#endif // B3_RELOADER_H
@@ -39,6 +39,9 @@ b3_rule_applies_impl(b3_rule_t *rule, b3_director_t *director, b3_win_t *win);
 static int
 b3_rule_exec_impl(b3_rule_t *rule, b3_director_t *director, b3_win_t *win);
 
+static int
+b3_rule_prepare_impl(b3_rule_t *rule, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement);
+
 b3_rule_t *
 b3_rule_new(b3_condition_t *condition, b3_action_t *action)
 {
@@ -50,9 +53,12 @@ b3_rule_new(b3_condition_t *condition, b3_action_t *action)
     rule->rule_free = b3_rule_free_impl;
     rule->rule_applies = b3_rule_applies_impl;
     rule->rule_exec = b3_rule_exec_impl;
+    rule->rule_prepare = b3_rule_prepare_impl;
 
     rule->condition = condition;
     rule->action = action;
+
+    b3_profile_init(&(rule->profile));
   }
 
   return rule;
@@ -64,10 +70,42 @@ b3_rule_free(b3_rule_t *rule)
   return rule->rule_free(rule);
 }
 
+b3_condition_t *
+b3_rule_get_condition(b3_rule_t *rule)
+{
+  return rule->condition;
+}
+
+b3_action_t *
+b3_rule_get_action(b3_rule_t *rule)
+{
+  return rule->action;
+}
+
+b3_profile_t *
+b3_rule_get_profile(b3_rule_t *rule)
+{
+  return &(rule->profile);
+}
+
+int
+b3_rule_equals(b3_rule_t *rule, b3_rule_t *other)
+{
+  return b3_condition_equals(rule->condition, other->condition)
+    && b3_action_equals(rule->action, other->action);
+}
+
 int
 b3_rule_applies(b3_rule_t *rule, b3_director_t *director, b3_win_t *win)
 {
-  return rule->rule_applies(rule, director, win);
+  LONGLONG start;
+  int applies;
+
+  start = b3_profile_start();
+  applies = rule->rule_applies(rule, director, win);
+  b3_profile_record(&(rule->profile), start, applies);
+
+  return applies;
 }
 
 int
@@ -76,6 +114,12 @@ b3_rule_exec(b3_rule_t *rule, b3_director_t *director, b3_win_t *win)
   return rule->rule_exec(rule, director, win);
 }
 
+int
+b3_rule_prepare(b3_rule_t *rule, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement)
+{
+  return rule->rule_prepare(rule, director, win, placement);
+}
+
 int
 b3_rule_free_impl(b3_rule_t *rule)
 {
@@ -99,5 +143,17 @@ b3_rule_applies_impl(b3_rule_t *rule, b3_director_t *director, b3_win_t *win)
 int
 b3_rule_exec_impl(b3_rule_t *rule, b3_director_t *director, b3_win_t *win)
 {
-  return b3_action_exec(rule->action, director, win);
+  int error;
+
+  b3_director_begin_transaction(director);
+  error = b3_action_exec(rule->action, director, win);
+  b3_director_commit_transaction(director);
+
+  return error;
+}
+
+int
+b3_rule_prepare_impl(b3_rule_t *rule, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement)
+{
+  return b3_action_prepare(rule->action, director, win, placement);
 }
@@ -35,6 +35,7 @@
 #include "win.h"
 #include "condition.h"
 #include "action.h"
+#include "profile.h"
 
 typedef struct b3_rule_s b3_rule_t;
 
@@ -43,9 +44,15 @@ struct b3_rule_s
   int (*rule_free)(b3_rule_t *rule);
   int (*rule_applies)(b3_rule_t *rule, b3_director_t *director, b3_win_t *win);
   int (*rule_exec)(b3_rule_t *rule, b3_director_t *director, b3_win_t *win);
+  int (*rule_prepare)(b3_rule_t *rule, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement);
 
   b3_condition_t *condition;
   b3_action_t *action;
+
+  /**
+   * Counters of b3_rule_applies()
+   */
+  b3_profile_t profile;
 };
 
 /**
@@ -58,6 +65,31 @@ b3_rule_new(b3_condition_t *condition, b3_action_t *action);
 extern int
 b3_rule_free(b3_rule_t *rule);
 
+/**
+ * @return The condition of the rule. Do not free it!
+ */
+extern b3_condition_t *
+b3_rule_get_condition(b3_rule_t *rule);
+
+/**
+ * @return The action of the rule. Do not free it!
+ */
+extern b3_action_t *
+b3_rule_get_action(b3_rule_t *rule);
+
+/**
+ * @return The counters of all evaluations of the rule. Do not free it!
+ */
+extern b3_profile_t *
+b3_rule_get_profile(b3_rule_t *rule);
+
+/**
+ * @return Non-0 if the condition and the action of rule equal the ones of
+ * other.
+ */
+extern int
+b3_rule_equals(b3_rule_t *rule, b3_rule_t *other);
+
 /**
  * Checks if rule applies to director and win.
  */
@@ -65,9 +97,20 @@ extern int
 b3_rule_applies(b3_rule_t *rule, b3_director_t *director, b3_win_t *win);
 
 /**
- * Executes rule with director and win.
+ * Executes rule with director and win within a transaction of director (see
+ * b3_director_begin_transaction()).
  */
 extern int
 b3_rule_exec(b3_rule_t *rule, b3_director_t *director, b3_win_t *win);
 
+/**
+ * Applies the action of rule to the placement of a window that is not yet
+ * added to director (see b3_action_prepare()).
+ *
+ * @return 0 if the rule is fully applied. Non-0 if it has to be executed by
+ * b3_rule_exec() after the window was added.
+ */
+extern int
+b3_rule_prepare(b3_rule_t *rule, b3_director_t *director, b3_win_t *win, b3_action_placement_t *placement);
+
 #endif // B3_RULE_H
@@ -0,0 +1,537 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-18
+ * @brief File contains the rule set class implementation and its private methods
+ */
+
+#include "rule_set.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <w32bindkeys/logger.h>
+
+#include "condition.h"
+
+static wbk_logger_t logger = { "rule_set" };
+
+/**
+ * Counters of a rule and its condition, read at the time of the dump.
+ */
+typedef struct b3_rule_set_profile_s
+{
+  b3_rule_set_entry_t *entry;
+  b3_profile_t rule_profile;
+  b3_profile_t condition_profile;
+} b3_rule_set_profile_t;
+
+/**
+ * Frees the rule set. Use b3_rule_set_release() instead of calling it
+ * directly.
+ */
+static int
+b3_rule_set_free_impl(b3_rule_set_t *rule_set);
+
+static int
+b3_rule_set_match_impl(b3_rule_set_t *rule_set, b3_director_t *director, b3_win_t *win, CC_Array *matched_rule_arr);
+
+static int
+b3_rule_set_dump_profile_impl(b3_rule_set_t *rule_set);
+
+/**
+ * Adds entry to the index or to the residual rules, depending on the key of
+ * the condition of its rule.
+ */
+static int
+b3_rule_set_add_entry(b3_rule_set_t *rule_set, b3_rule_set_entry_t *entry);
+
+static int
+b3_rule_set_index_init(b3_rule_set_index_t *index);
+
+static int
+b3_rule_set_index_add(b3_rule_set_index_t *index, b3_condition_key_t *key, b3_rule_set_entry_t *entry);
+
+/**
+ * Appends all entries whose literal matches attr to candidate_arr.
+ */
+static int
+b3_rule_set_index_lookup(b3_rule_set_index_t *index, const char *attr, CC_Array *candidate_arr);
+
+static int
+b3_rule_set_index_free(b3_rule_set_index_t *index);
+
+static int
+b3_rule_set_add_bucket(CC_HashTable *ht, const char *literal, b3_rule_set_entry_t *entry);
+
+static int
+b3_rule_set_append_bucket(CC_HashTable *ht, const char *literal, CC_Array *candidate_arr);
+
+static int
+b3_rule_set_entry_cmp(const void *entry, const void *other);
+
+/**
+ * Orders by the cumulative time of the rules, the most expensive one first.
+ */
+static int
+b3_rule_set_profile_cmp(const void *profile, const void *other);
+
+b3_rule_set_t *
+b3_rule_set_new(CC_Array *rule_arr)
+{
+  b3_rule_set_t *rule_set;
+  b3_rule_set_entry_t *entry;
+  CC_ArrayIter iter;
+  b3_rule_t *rule;
+  int position;
+
+  rule_set = malloc(sizeof(b3_rule_set_t));
+
+  if (rule_set) {
+    memset(rule_set, 0, sizeof(b3_rule_set_t));
+
+    rule_set->rule_set_free = b3_rule_set_free_impl;
+    rule_set->rule_set_match = b3_rule_set_match_impl;
+    rule_set->rule_set_dump_profile = b3_rule_set_dump_profile_impl;
+
+    rule_set->ref_count = 1;
+
+    cc_array_new(&(rule_set->entry_arr));
+    cc_array_new(&(rule_set->residual_arr));
+    cc_array_new(&(rule_set->retired_rule_arr));
+    b3_rule_set_index_init(&(rule_set->class_index));
+    b3_rule_set_index_init(&(rule_set->title_index));
+
+    if (rule_arr) {
+      position = 0;
+      cc_array_iter_init(&iter, rule_arr);
+      while (cc_array_iter_next(&iter, (void *) &rule) != CC_ITER_END) {
+        entry = malloc(sizeof(b3_rule_set_entry_t));
+        if (entry) {
+          entry->position = position++;
+          entry->rule = rule;
+
+          cc_array_add(rule_set->entry_arr, entry);
+          b3_rule_set_add_entry(rule_set, entry);
+        } else {
+          wbk_logger_log(&logger, SEVERE, "Could not allocate memory.\n");
+        }
+      }
+    }
+  } else {
+    wbk_logger_log(&logger, SEVERE, "Could not allocate memory.\n");
+  }
+
+  return rule_set;
+}
+
+b3_rule_set_t *
+b3_rule_set_acquire(b3_rule_set_t *rule_set)
+{
+  InterlockedIncrement(&(rule_set->ref_count));
+
+  return rule_set;
+}
+
+int
+b3_rule_set_release(b3_rule_set_t *rule_set)
+{
+  int error;
+
+  error = 0;
+  if (InterlockedDecrement(&(rule_set->ref_count)) == 0) {
+    error = rule_set->rule_set_free(rule_set);
+  }
+
+  return error;
+}
+
+int
+b3_rule_set_retire(b3_rule_set_t *rule_set, b3_rule_t *rule)
+{
+  return cc_array_add(rule_set->retired_rule_arr, rule) != CC_OK;
+}
+
+int
+b3_rule_set_match(b3_rule_set_t *rule_set, b3_director_t *director, b3_win_t *win, CC_Array *matched_rule_arr)
+{
+  return rule_set->rule_set_match(rule_set, director, win, matched_rule_arr);
+}
+
+int
+b3_rule_set_dump_profile(b3_rule_set_t *rule_set)
+{
+  return rule_set->rule_set_dump_profile(rule_set);
+}
+
+int
+b3_rule_set_free_impl(b3_rule_set_t *rule_set)
+{
+  CC_ArrayIter iter;
+  b3_rule_t *rule;
+
+  b3_rule_set_index_free(&(rule_set->class_index));
+  b3_rule_set_index_free(&(rule_set->title_index));
+
+  cc_array_destroy(rule_set->residual_arr);
+  rule_set->residual_arr = NULL;
+
+  /** The rules itself are owned by the director */
+  cc_array_destroy_cb(rule_set->entry_arr, free);
+  rule_set->entry_arr = NULL;
+
+  /** Except the ones that were removed meanwhile */
+  cc_array_iter_init(&iter, rule_set->retired_rule_arr);
+  while (cc_array_iter_next(&iter, (void *) &rule) != CC_ITER_END) {
+    b3_rule_free(rule);
+  }
+  cc_array_destroy(rule_set->retired_rule_arr);
+  rule_set->retired_rule_arr = NULL;
+
+  free(rule_set);
+
+  return 0;
+}
+
+int
+b3_rule_set_match_impl(b3_rule_set_t *rule_set, b3_director_t *director, b3_win_t *win, CC_Array *matched_rule_arr)
+{
+  CC_Array *candidate_arr;
+  CC_ArrayIter iter;
+  b3_rule_set_entry_t *entry;
+  int matches;
+
+  matches = 0;
+
+  b3_win_cache_attrs(win);
+
+  cc_array_new(&candidate_arr);
+
+  b3_rule_set_index_lookup(&(rule_set->class_index), b3_win_get_class_name(win), candidate_arr);
+  b3_rule_set_index_lookup(&(rule_set->title_index), b3_win_get_title(win), candidate_arr);
+
+  cc_array_iter_init(&iter, rule_set->residual_arr);
+  while (cc_array_iter_next(&iter, (void *) &entry) != CC_ITER_END) {
+    cc_array_add(candidate_arr, entry);
+  }
+
+  /** Rules have to be executed in the order they were defined */
+  cc_array_sort(candidate_arr, b3_rule_set_entry_cmp);
+
+  cc_array_iter_init(&iter, candidate_arr);
+  while (cc_array_iter_next(&iter, (void *) &entry) != CC_ITER_END) {
+    if (b3_rule_applies(entry->rule, director, win)) {
+      cc_array_add(matched_rule_arr, entry->rule);
+      matches++;
+    }
+  }
+
+  cc_array_destroy(candidate_arr);
+
+  return matches;
+}
+
+int
+b3_rule_set_dump_profile_impl(b3_rule_set_t *rule_set)
+{
+  CC_Array *profile_arr;
+  CC_ArrayIter iter;
+  b3_rule_set_entry_t *entry;
+  b3_rule_set_profile_t *profile;
+  b3_condition_key_t key;
+  const char *indexed_by;
+  int error;
+
+  error = 0;
+  profile_arr = NULL;
+
+  if (cc_array_new(&profile_arr) != CC_OK) {
+    wbk_logger_log(&logger, SEVERE, "Could not allocate memory.\n");
+    error = 1;
+  }
+
+  if (!error) {
+    cc_array_iter_init(&iter, rule_set->entry_arr);
+    while (!error && cc_array_iter_next(&iter, (void *) &entry) != CC_ITER_END) {
+      profile = malloc(sizeof(b3_rule_set_profile_t));
+      if (profile) {
+        profile->entry = entry;
+        b3_profile_copy(b3_rule_get_profile(entry->rule), &(profile->rule_profile));
+        b3_profile_copy(b3_condition_get_profile(b3_rule_get_condition(entry->rule)),
+                        &(profile->condition_profile));
+        cc_array_add(profile_arr, profile);
+      } else {
+        wbk_logger_log(&logger, SEVERE, "Could not allocate memory.\n");
+        error = 1;
+      }
+    }
+  }
+
+  if (!error) {
+    cc_array_sort(profile_arr, b3_rule_set_profile_cmp);
+
+    wbk_logger_log(&logger, INFO, "Rule profile of %d rules (%d not indexed):\n",
+                   cc_array_size(rule_set->entry_arr),
+                   cc_array_size(rule_set->residual_arr));
+
+    cc_array_iter_init(&iter, profile_arr);
+    while (cc_array_iter_next(&iter, (void *) &profile) != CC_ITER_END) {
+      indexed_by = "none";
+      if (!b3_condition_get_key(b3_rule_get_condition(profile->entry->rule), &key)) {
+        if (key.attr == B3_CONDITION_ATTR_CLASS) {
+          indexed_by = key.prefix ? "class prefix" : "class";
+        } else if (key.attr == B3_CONDITION_ATTR_TITLE) {
+          indexed_by = key.prefix ? "title prefix" : "title";
+        }
+      }
+
+      wbk_logger_log(&logger, INFO,
+                     "Rule %d (index: %s): %lld evaluations, %lld matches, %lld ns total, %lld ns max\n",
+                     profile->entry->position,
+                     indexed_by,
+                     (long long) profile->rule_profile.evaluations,
+                     (long long) profile->rule_profile.matches,
+                     (long long) profile->rule_profile.total_ns,
+                     (long long) profile->rule_profile.max_ns);
+      wbk_logger_log(&logger, INFO,
+                     "Rule %d condition: %lld evaluations, %lld matches, %lld ns total, %lld ns max\n",
+                     profile->entry->position,
+                     (long long) profile->condition_profile.evaluations,
+                     (long long) profile->condition_profile.matches,
+                     (long long) profile->condition_profile.total_ns,
+                     (long long) profile->condition_profile.max_ns);
+    }
+  }
+
+  if (profile_arr) {
+    cc_array_destroy_cb(profile_arr, free);
+  }
+
+  return error;
+}
+
+int
+b3_rule_set_add_entry(b3_rule_set_t *rule_set, b3_rule_set_entry_t *entry)
+{
+  b3_condition_key_t key;
+  int error;
+
+  error = b3_condition_get_key(b3_rule_get_condition(entry->rule), &key);
+
+  if (!error) {
+    switch (key.attr) {
+    case B3_CONDITION_ATTR_CLASS:
+      error = b3_rule_set_index_add(&(rule_set->class_index), &key, entry);
+      break;
+
+    case B3_CONDITION_ATTR_TITLE:
+      error = b3_rule_set_index_add(&(rule_set->title_index), &key, entry);
+      break;
+
+    default:
+      error = 1;
+      break;
+    }
+  }
+
+  if (error) {
+    cc_array_add(rule_set->residual_arr, entry);
+  }
+
+  return 0;
+}
+
+int
+b3_rule_set_index_init(b3_rule_set_index_t *index)
+{
+  cc_hashtable_new(&(index->exact_ht));
+  cc_hashtable_new(&(index->prefix_ht));
+  index->prefix_len_arr_len = 0;
+
+  return 0;
+}
+
+int
+b3_rule_set_index_add(b3_rule_set_index_t *index, b3_condition_key_t *key, b3_rule_set_entry_t *entry)
+{
+  int error;
+  int length;
+  int i;
+  char found;
+
+  error = 0;
+
+  length = strlen(key->literal);
+  if (length >= B3_WIN_ATTR_LENGTH) {
+    /** Cannot be looked up with the cached attributes */
+    error = 1;
+  }
+
+  if (!error) {
+    if (key->prefix) {
+      error = b3_rule_set_add_bucket(index->prefix_ht, key->literal, entry);
+
+      found = 0;
+      for (i = 0; !found && i < index->prefix_len_arr_len; i++) {
+        if (index->prefix_len_arr[i] == length) {
+          found = 1;
+        }
+      }
+
+      if (!error && !found) {
+        index->prefix_len_arr[index->prefix_len_arr_len] = length;
+        index->prefix_len_arr_len++;
+      }
+    } else {
+      error = b3_rule_set_add_bucket(index->exact_ht, key->literal, entry);
+    }
+  }
+
+  return error;
+}
+
+int
+b3_rule_set_index_lookup(b3_rule_set_index_t *index, const char *attr, CC_Array *candidate_arr)
+{
+  char prefix[B3_WIN_ATTR_LENGTH];
+  int length;
+  int i;
+
+  b3_rule_set_append_bucket(index->exact_ht, attr, candidate_arr);
+
+  length = strlen(attr);
+  for (i = 0; i < index->prefix_len_arr_len; i++) {
+    if (index->prefix_len_arr[i] <= length) {
+      memcpy(prefix, attr, index->prefix_len_arr[i]);
+      prefix[index->prefix_len_arr[i]] = '\0';
+
+      b3_rule_set_append_bucket(index->prefix_ht, prefix, candidate_arr);
+    }
+  }
+
+  return 0;
+}
+
+int
+b3_rule_set_index_free(b3_rule_set_index_t *index)
+{
+  CC_HashTableIter iter;
+  TableEntry *table_entry;
+
+  cc_hashtable_iter_init(&iter, index->exact_ht);
+  while (cc_hashtable_iter_next(&iter, &table_entry) != CC_ITER_END) {
+    cc_array_destroy((CC_Array *) table_entry->value);
+  }
+  cc_hashtable_destroy(index->exact_ht);
+  index->exact_ht = NULL;
+
+  cc_hashtable_iter_init(&iter, index->prefix_ht);
+  while (cc_hashtable_iter_next(&iter, &table_entry) != CC_ITER_END) {
+    cc_array_destroy((CC_Array *) table_entry->value);
+  }
+  cc_hashtable_destroy(index->prefix_ht);
+  index->prefix_ht = NULL;
+
+  index->prefix_len_arr_len = 0;
+
+  return 0;
+}
+
+int
+b3_rule_set_add_bucket(CC_HashTable *ht, const char *literal, b3_rule_set_entry_t *entry)
+{
+  CC_Array *bucket;
+  int error;
+
+  error = 0;
+
+  if (cc_hashtable_get(ht, (void *) literal, (void *) &bucket) != CC_OK) {
+    if (cc_array_new(&bucket) == CC_OK) {
+      /** The key is owned by the condition, which outlives the rule set */
+      if (cc_hashtable_add(ht, (void *) literal, bucket) != CC_OK) {
+        cc_array_destroy(bucket);
+        error = 1;
+      }
+    } else {
+      error = 1;
+    }
+  }
+
+  if (!error) {
+    cc_array_add(bucket, entry);
+  }
+
+  return error;
+}
+
+int
+b3_rule_set_append_bucket(CC_HashTable *ht, const char *literal, CC_Array *candidate_arr)
+{
+  CC_Array *bucket;
+  CC_ArrayIter iter;
+  b3_rule_set_entry_t *entry;
+
+  if (cc_hashtable_get(ht, (void *) literal, (void *) &bucket) == CC_OK) {
+    cc_array_iter_init(&iter, bucket);
+    while (cc_array_iter_next(&iter, (void *) &entry) != CC_ITER_END) {
+      cc_array_add(candidate_arr, entry);
+    }
+  }
+
+  return 0;
+}
+
+int
+b3_rule_set_entry_cmp(const void *entry, const void *other)
+{
+  const b3_rule_set_entry_t *entry_a;
+  const b3_rule_set_entry_t *entry_b;
+
+  entry_a = *((const b3_rule_set_entry_t **) entry);
+  entry_b = *((const b3_rule_set_entry_t **) other);
+
+  return entry_a->position - entry_b->position;
+}
+
+int
+b3_rule_set_profile_cmp(const void *profile, const void *other)
+{
+  const b3_rule_set_profile_t *profile_a;
+  const b3_rule_set_profile_t *profile_b;
+  int cmp;
+
+  profile_a = *((const b3_rule_set_profile_t **) profile);
+  profile_b = *((const b3_rule_set_profile_t **) other);
+
+  if (profile_a->rule_profile.total_ns > profile_b->rule_profile.total_ns) {
+    cmp = -1;
+  } else if (profile_a->rule_profile.total_ns < profile_b->rule_profile.total_ns) {
+    cmp = 1;
+  } else {
+    cmp = profile_a->entry->position - profile_b->entry->position;
+  }
+
+  return cmp;
+}
@@ -0,0 +1,163 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-18
+ * @brief File contains the rule set class definition
+ */
+
+#ifndef B3_RULE_SET_H
+#define B3_RULE_SET_H
+
+#include <collectc/cc_array.h>
+#include <collectc/cc_hashtable.h>
+#include <windows.h>
+
+#include "director.h"
+#include "win.h"
+#include "rule.h"
+
+typedef struct b3_rule_set_s b3_rule_set_t;
+
+/**
+ * A rule together with its position in the order of definition.
+ */
+typedef struct b3_rule_set_entry_s
+{
+  int position;
+  b3_rule_t *rule;
+} b3_rule_set_entry_t;
+
+/**
+ * Index of all rules whose condition requires a literal for one window
+ * attribute (see b3_condition_get_key()).
+ */
+typedef struct b3_rule_set_index_s
+{
+  /**
+   * Maps the exact literal to a CC_Array of b3_rule_set_entry_t *
+   */
+  CC_HashTable *exact_ht;
+
+  /**
+   * Maps the prefix literal to a CC_Array of b3_rule_set_entry_t *
+   */
+  CC_HashTable *prefix_ht;
+
+  /**
+   * Distinct lengths of all prefixes in prefix_ht.
+   */
+  int prefix_len_arr[B3_WIN_ATTR_LENGTH];
+  int prefix_len_arr_len;
+} b3_rule_set_index_t;
+
+/**
+ * An immutable snapshot of the rules of a director. It is shared between the
+ * director and all threads that are currently evaluating rules and is freed
+ * as soon as the last reference to it is released.
+ *
+ * Rules with an exact or prefix literal on the window class or title are
+ * bucketed by that literal. Only those buckets and the residual rules are
+ * evaluated for a window.
+ */
+struct b3_rule_set_s
+{
+  int (*rule_set_free)(b3_rule_set_t *rule_set);
+  int (*rule_set_match)(b3_rule_set_t *rule_set, b3_director_t *director, b3_win_t *win, CC_Array *matched_rule_arr);
+  int (*rule_set_dump_profile)(b3_rule_set_t *rule_set);
+
+  volatile LONG ref_count;
+
+  /**
+   * CC_Array of b3_rule_set_entry_t * in the order of definition
+   */
+  CC_Array *entry_arr;
+
+  b3_rule_set_index_t class_index;
+  b3_rule_set_index_t title_index;
+
+  /**
+   * CC_Array of b3_rule_set_entry_t * that could not be indexed
+   */
+  CC_Array *residual_arr;
+
+  /**
+   * CC_Array of b3_rule_t * that were removed from the director while the rule
+   * set could still be evaluated. They are owned by the rule set.
+   */
+  CC_Array *retired_rule_arr;
+};
+
+/**
+ * @brief Creates a new rule set holding a single reference.
+ * @param rule_arr Array of b3_rule_t *. Only the pointers are copied. The
+ * rules are still owned by the caller and have to outlive the rule set!
+ * @return A new rule set or NULL if allocation failed
+ */
+extern b3_rule_set_t *
+b3_rule_set_new(CC_Array *rule_arr);
+
+/**
+ * @brief Adds a reference to the rule set.
+ * @return The rule set itself.
+ */
+extern b3_rule_set_t *
+b3_rule_set_acquire(b3_rule_set_t *rule_set);
+
+/**
+ * @brief Drops a reference to the rule set. The rule set is freed if it was
+ * the last one.
+ */
+extern int
+b3_rule_set_release(b3_rule_set_t *rule_set);
+
+/**
+ * @brief Hands a rule of the rule set over to it. The rule is freed together
+ * with the rule set, i.e. once no thread evaluates the rule set anymore.
+ * @param rule A rule of the rule set that is no longer owned by anyone else.
+ */
+extern int
+b3_rule_set_retire(b3_rule_set_t *rule_set, b3_rule_t *rule);
+
+/**
+ * @brief Evaluates all rules against a window. This does not take any lock
+ * of the director. The attributes of win should be cached beforehand by
+ * b3_win_cache_attrs().
+ * @param matched_rule_arr Array to which all rules that apply to win are
+ * appended in their order of definition.
+ * @return The number of matching rules.
+ */
+extern int
+b3_rule_set_match(b3_rule_set_t *rule_set, b3_director_t *director, b3_win_t *win, CC_Array *matched_rule_arr);
+
+/**
+ * @brief Logs the counters of all rules and their conditions (see profile.h),
+ * the most expensive rule first.
+ * @return Non-0 if the dump failed.
+ */
+extern int
+b3_rule_set_dump_profile(b3_rule_set_t *rule_set);
+
+#endif // B3_RULE_SET_H
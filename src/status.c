@@ -0,0 +1,414 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the status class implementation
+ */
+
+#include "status.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <w32bindkeys/logger.h>
+
+static wbk_logger_t logger = { "status" };
+
+/**
+ * Passes the status lines of the reader to b3_status_set_blocks().
+ */
+static int
+b3_status_reader_handler(void *data, b3_status_block_t *block_arr, int block_arr_len);
+
+/**
+ * Reads the output of the command until it is closed or invalid.
+ */
+static DWORD WINAPI
+b3_status_reader(LPVOID param);
+
+/**
+ * Calls the update handler after changes, at most once per interval.
+ */
+static DWORD WINAPI
+b3_status_notifier(LPVOID param);
+
+/**
+ * Starts the command with its standard output redirected to status->pipe. The
+ * command is put into status->job, so its children are killed with it.
+ */
+static int
+b3_status_create_process(b3_status_t *status);
+
+b3_status_t *
+b3_status_new(const char *cmd, DWORD interval,
+              int (*update_handler)(void *data), void *update_data)
+{
+  int error;
+  b3_status_t *status;
+
+  error = 0;
+
+  status = malloc(sizeof(b3_status_t));
+  if (status == NULL) {
+    error = 1;
+  }
+
+  if (!error) {
+    memset(status, 0, sizeof(b3_status_t));
+
+    status->interval = interval;
+    status->update_handler = update_handler;
+    status->update_data = update_data;
+
+    status->cmd = strdup(cmd);
+    status->reader = b3_statusreader_new(b3_status_reader_handler, status);
+    status->mutex = CreateMutex(NULL, FALSE, NULL);
+    status->changed_event = CreateEvent(NULL, FALSE, FALSE, NULL);
+    status->stop_event = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+    if (status->cmd == NULL
+        || status->reader == NULL
+        || status->mutex == NULL
+        || status->changed_event == NULL
+        || status->stop_event == NULL) {
+      error = 2;
+    }
+  }
+
+  if (error && status) {
+    b3_status_free(status);
+    status = NULL;
+  }
+
+  return status;
+}
+
+int
+b3_status_free(b3_status_t *status)
+{
+  if (status->stop_event) {
+    SetEvent(status->stop_event);
+  }
+
+  if (status->job) {
+    TerminateJobObject(status->job, 0);
+    CloseHandle(status->job);
+    status->job = NULL;
+  }
+
+  if (status->process) {
+    TerminateProcess(status->process, 0);
+    CloseHandle(status->process);
+    status->process = NULL;
+  }
+
+  if (status->reader_thread) {
+    /**
+     * A child of the command outside of the job may still hold the pipe open.
+     * The reader may also be between two reads when it is cancelled, so it is
+     * cancelled until it stopped.
+     */
+    do {
+      CancelSynchronousIo(status->reader_thread);
+    } while (WaitForSingleObject(status->reader_thread, B3_STATUS_CANCEL_INTERVAL) == WAIT_TIMEOUT);
+    CloseHandle(status->reader_thread);
+    status->reader_thread = NULL;
+  }
+
+  if (status->notifier_thread) {
+    WaitForSingleObject(status->notifier_thread, INFINITE);
+    CloseHandle(status->notifier_thread);
+    status->notifier_thread = NULL;
+  }
+
+  if (status->pipe) {
+    CloseHandle(status->pipe);
+    status->pipe = NULL;
+  }
+
+  if (status->reader) {
+    b3_statusreader_free(status->reader);
+    status->reader = NULL;
+  }
+
+  b3_status_block_arr_free(status->block_arr, status->block_arr_len);
+  status->block_arr = NULL;
+  status->block_arr_len = 0;
+
+  if (status->mutex) {
+    CloseHandle(status->mutex);
+  }
+  if (status->changed_event) {
+    CloseHandle(status->changed_event);
+  }
+  if (status->stop_event) {
+    CloseHandle(status->stop_event);
+  }
+
+  free(status->cmd);
+  free(status);
+
+  return 0;
+}
+
+int
+b3_status_start(b3_status_t *status)
+{
+  int error;
+
+  error = b3_status_create_process(status);
+
+  if (!error) {
+    status->notifier_thread = CreateThread(NULL,
+                                           0,
+                                           b3_status_notifier,
+                                           (LPVOID) status,
+                                           0,
+                                           NULL);
+    status->reader_thread = CreateThread(NULL,
+                                         0,
+                                         b3_status_reader,
+                                         (LPVOID) status,
+                                         0,
+                                         NULL);
+    if (status->notifier_thread == NULL || status->reader_thread == NULL) {
+      wbk_logger_log(&logger, SEVERE, "Could not start reading the status of %s\n", status->cmd);
+      error = 2;
+    }
+  }
+
+  return error;
+}
+
+int
+b3_status_create_process(b3_status_t *status)
+{
+  int error;
+  HANDLE pipe_write;
+  JOBOBJECT_EXTENDED_LIMIT_INFORMATION limit_info;
+  SECURITY_ATTRIBUTES security_attributes;
+  STARTUPINFOA startup_info;
+  PROCESS_INFORMATION process_info;
+
+  error = 0;
+  pipe_write = NULL;
+
+  memset(&security_attributes, 0, sizeof(SECURITY_ATTRIBUTES));
+  security_attributes.nLength = sizeof(SECURITY_ATTRIBUTES);
+  security_attributes.bInheritHandle = TRUE;
+
+  if (!CreatePipe(&(status->pipe), &pipe_write, &security_attributes, 0)) {
+    wbk_logger_log(&logger, SEVERE, "Could not create the pipe for %s\n", status->cmd);
+    error = 1;
+  }
+
+  /**
+   * Only the writing end is inherited by the command
+   */
+  if (!error) {
+    SetHandleInformation(status->pipe, HANDLE_FLAG_INHERIT, 0);
+
+    memset(&startup_info, 0, sizeof(STARTUPINFOA));
+    startup_info.cb = sizeof(STARTUPINFOA);
+    startup_info.dwFlags = STARTF_USESTDHANDLES;
+    startup_info.hStdOutput = pipe_write;
+
+    /**
+     * The command is started suspended, so it cannot start any child before
+     * it is in its job.
+     */
+    if (!CreateProcess(NULL,
+                       status->cmd,
+                       NULL,
+                       NULL,
+                       TRUE,
+                       NORMAL_PRIORITY_CLASS | CREATE_NO_WINDOW | CREATE_SUSPENDED,
+                       NULL,
+                       NULL,
+                       &startup_info,
+                       &process_info)) {
+      wbk_logger_log(&logger, SEVERE, "Could not start %s\n", status->cmd);
+      error = 2;
+    }
+  }
+
+  if (!error) {
+    memset(&limit_info, 0, sizeof(JOBOBJECT_EXTENDED_LIMIT_INFORMATION));
+    limit_info.BasicLimitInformation.LimitFlags = JOB_OBJECT_LIMIT_KILL_ON_JOB_CLOSE;
+
+    status->job = CreateJobObject(NULL, NULL);
+    if (status->job == NULL
+        || !SetInformationJobObject(status->job,
+                                    JobObjectExtendedLimitInformation,
+                                    &limit_info,
+                                    sizeof(JOBOBJECT_EXTENDED_LIMIT_INFORMATION))
+        || !AssignProcessToJobObject(status->job, process_info.hProcess)) {
+      wbk_logger_log(&logger, WARNING, "Children of %s are not terminated with it\n", status->cmd);
+    }
+
+    ResumeThread(process_info.hThread);
+    CloseHandle(process_info.hThread);
+    status->process = process_info.hProcess;
+  }
+
+  /**
+   * The pipe is closed as soon as the command closes its end
+   */
+  if (pipe_write) {
+    CloseHandle(pipe_write);
+  }
+
+  return error;
+}
+
+int
+b3_status_set_blocks(b3_status_t *status, b3_status_block_t *block_arr, int block_arr_len)
+{
+  int changed;
+
+  WaitForSingleObject(status->mutex, INFINITE);
+
+  changed = !b3_status_block_arr_equals(status->block_arr, status->block_arr_len,
+                                        block_arr, block_arr_len);
+  if (changed) {
+    b3_status_block_arr_free(status->block_arr, status->block_arr_len);
+    status->block_arr = block_arr;
+    status->block_arr_len = block_arr_len;
+    InterlockedIncrement(&(status->serial));
+  } else {
+    b3_status_block_arr_free(block_arr, block_arr_len);
+  }
+
+  ReleaseMutex(status->mutex);
+
+  if (changed) {
+    InterlockedExchange(&(status->changed), 1);
+    SetEvent(status->changed_event);
+  }
+
+  return changed;
+}
+
+LONG
+b3_status_copy_blocks(b3_status_t *status, b3_status_block_t **block_arr, int *block_arr_len)
+{
+  LONG serial;
+
+  WaitForSingleObject(status->mutex, INFINITE);
+
+  *block_arr = b3_status_block_arr_copy(status->block_arr, status->block_arr_len);
+  *block_arr_len = *block_arr ? status->block_arr_len : 0;
+  serial = status->serial;
+
+  ReleaseMutex(status->mutex);
+
+  return serial;
+}
+
+LONG
+b3_status_get_serial(b3_status_t *status)
+{
+  return InterlockedCompareExchange(&(status->serial), 0, 0);
+}
+
+DWORD
+b3_status_get_delay(ULONGLONG last_update, ULONGLONG now, DWORD interval)
+{
+  if (last_update == 0 || now >= last_update + interval) {
+    return 0;
+  }
+  return (DWORD) (last_update + interval - now);
+}
+
+int
+b3_status_reader_handler(void *data, b3_status_block_t *block_arr, int block_arr_len)
+{
+  b3_status_set_blocks((b3_status_t *) data, block_arr, block_arr_len);
+  return 0;
+}
+
+DWORD WINAPI
+b3_status_reader(LPVOID param)
+{
+  b3_status_t *status;
+  char buf[B3_STATUS_READ_LEN];
+  DWORD read_len;
+  int error;
+
+  status = (b3_status_t *) param;
+
+  error = 0;
+  while (!error
+         && WaitForSingleObject(status->stop_event, 0) != WAIT_OBJECT_0
+         && ReadFile(status->pipe, buf, B3_STATUS_READ_LEN, &read_len, NULL)
+         && read_len > 0) {
+    error = b3_statusreader_feed(status->reader, buf, read_len);
+  }
+
+  if (error) {
+    wbk_logger_log(&logger, SEVERE, "%s does not speak the i3bar protocol, stopped reading its status\n", status->cmd);
+  } else {
+    wbk_logger_log(&logger, INFO, "%s closed its output\n", status->cmd);
+  }
+
+  return 0;
+}
+
+DWORD WINAPI
+b3_status_notifier(LPVOID param)
+{
+  b3_status_t *status;
+  HANDLE handle_arr[2];
+  DWORD delay;
+  char run;
+
+  status = (b3_status_t *) param;
+
+  handle_arr[0] = status->stop_event;
+  handle_arr[1] = status->changed_event;
+
+  run = 1;
+  while (run) {
+    run = WaitForMultipleObjects(2, handle_arr, FALSE, INFINITE) == WAIT_OBJECT_0 + 1;
+
+    /**
+     * Changes during the delay are part of this update
+     */
+    if (run) {
+      delay = b3_status_get_delay(status->last_update, GetTickCount64(), status->interval);
+      if (delay > 0) {
+        run = WaitForSingleObject(status->stop_event, delay) != WAIT_OBJECT_0;
+      }
+    }
+
+    if (run && InterlockedExchange(&(status->changed), 0)) {
+      status->last_update = GetTickCount64();
+      if (status->update_handler) {
+        status->update_handler(status->update_data);
+      }
+    }
+  }
+
+  return 0;
+}
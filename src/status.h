@@ -0,0 +1,183 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the status class definition
+ *
+ * The status runs a status command speaking the i3bar protocol and keeps the
+ * blocks of its latest status line. A reader thread feeds the output of the
+ * command from a pipe to a status reader. Status lines equal to the current
+ * one are dropped.
+ *
+ * Changes are reported to the update handler by a notifier thread. It calls
+ * the handler at most once per interval, the last change within an interval
+ * is reported at its end.
+ */
+
+#ifndef B3_STATUS_H
+#define B3_STATUS_H
+
+#include <windows.h>
+
+#include "statusreader.h"
+
+/**
+ * Minimum time between two updates in milliseconds
+ */
+#define B3_STATUS_DEFAULT_INTERVAL 250
+
+/**
+ * Size of the chunks read from the pipe
+ */
+#define B3_STATUS_READ_LEN 4096
+
+/**
+ * Time in milliseconds between two attempts to cancel a blocked read while
+ * the status is freed
+ */
+#define B3_STATUS_CANCEL_INTERVAL 50
+
+typedef struct b3_status_s
+{
+  char *cmd;
+
+  DWORD interval;
+
+  /**
+   * Called by the notifier thread after the blocks changed
+   */
+  int (*update_handler)(void *data);
+  void *update_data;
+
+  b3_statusreader_t *reader;
+
+  /**
+   * Guards the blocks
+   */
+  HANDLE mutex;
+
+  /**
+   * The blocks of the latest status line
+   */
+  b3_status_block_t *block_arr;
+  int block_arr_len;
+
+  /**
+   * Incremented whenever the blocks change
+   */
+  volatile LONG serial;
+
+  /**
+   * Non-0 if the blocks changed since the last update
+   */
+  volatile LONG changed;
+
+  /**
+   * Signaled after the blocks changed
+   */
+  HANDLE changed_event;
+
+  HANDLE stop_event;
+
+  /**
+   * Time of the last update, GetTickCount64()
+   */
+  ULONGLONG last_update;
+
+  HANDLE process;
+
+  /**
+   * Job of the command and all its children. They are killed with it.
+   */
+  HANDLE job;
+
+  /**
+   * Reading end of the pipe the command writes to
+   */
+  HANDLE pipe;
+
+  HANDLE reader_thread;
+
+  HANDLE notifier_thread;
+} b3_status_t;
+
+/**
+ * @brief Creates a new status. The command is not started yet.
+ * @param cmd The status command
+ * @param interval Minimum time between two updates in milliseconds
+ * @param update_handler Called from a thread of the status after the blocks
+ * changed
+ * @return A new status or NULL if allocation failed
+ */
+extern b3_status_t *
+b3_status_new(const char *cmd, DWORD interval,
+              int (*update_handler)(void *data), void *update_data);
+
+/**
+ * @brief Terminates the status command and frees the status
+ */
+extern int
+b3_status_free(b3_status_t *status);
+
+/**
+ * Starts the status command and the threads reading its output.
+ *
+ * @return Non-0 if the command could not be started.
+ */
+extern int
+b3_status_start(b3_status_t *status);
+
+/**
+ * Replaces the blocks if they differ from the current ones. Called for each
+ * status line read.
+ *
+ * @param block_arr The status takes the ownership.
+ * @return Non-0 if the blocks changed.
+ */
+extern int
+b3_status_set_blocks(b3_status_t *status, b3_status_block_t *block_arr, int block_arr_len);
+
+/**
+ * Copies the current blocks.
+ *
+ * @param block_arr Set to the copy. Free it by b3_status_block_arr_free().
+ * @return The serial of the copied blocks
+ */
+extern LONG
+b3_status_copy_blocks(b3_status_t *status, b3_status_block_t **block_arr, int *block_arr_len);
+
+/**
+ * @return The serial of the current blocks. It changes whenever they change.
+ */
+extern LONG
+b3_status_get_serial(b3_status_t *status);
+
+/**
+ * @return The time in milliseconds to wait before the next update is allowed.
+ */
+extern DWORD
+b3_status_get_delay(ULONGLONG last_update, ULONGLONG now, DWORD interval);
+
+#endif // B3_STATUS_H
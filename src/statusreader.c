@@ -0,0 +1,750 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the status reader class implementation
+ */
+
+#include "statusreader.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <w32bindkeys/logger.h>
+
+/**
+ * Tokens which are not a single structural character
+ */
+#define B3_STATUSREADER_TOKEN_STRING 's'
+#define B3_STATUSREADER_TOKEN_SCALAR 'v'
+
+static wbk_logger_t logger = { "statusreader" };
+
+/**
+ * Advances the grammar by one token.
+ *
+ * @param token One of {}[]:, or B3_STATUSREADER_TOKEN_*
+ * @return Non-0 if the token is not expected.
+ */
+static int
+b3_statusreader_token(b3_statusreader_t *reader, char token);
+
+/**
+ * Stores the value of the current key into the header or the current block.
+ *
+ * @return Non-0 if the value is not valid JSON.
+ */
+static int
+b3_statusreader_set_value(b3_statusreader_t *reader, char token);
+
+static int
+b3_statusreader_begin_block(b3_statusreader_t *reader);
+
+/**
+ * Passes the blocks of the current status line to the handler.
+ */
+static int
+b3_statusreader_end_line(b3_statusreader_t *reader);
+
+static int
+b3_statusreader_append(b3_statusreader_t *reader, char c);
+
+/**
+ * Appends a code point of a \u escape encoded as UTF-8. Surrogate pairs are
+ * combined, lone surrogates become '?'.
+ */
+static int
+b3_statusreader_append_code_point(b3_statusreader_t *reader, long code_point);
+
+/**
+ * Appends a high surrogate that was not followed by a low surrogate.
+ */
+static int
+b3_statusreader_flush_surrogate(b3_statusreader_t *reader);
+
+/**
+ * @return 't', 'f' or 'n' for the literals, '0' for a number and 0 if the
+ * scalar is not valid.
+ */
+static char
+b3_statusreader_scalar_kind(const char *scalar);
+
+/**
+ * @return 0xRRGGBB or B3_STATUS_COLOR_UNSET if color is not #RRGGBB or
+ * #RRGGBBAA.
+ */
+static long
+b3_statusreader_parse_color(const char *color);
+
+/**
+ * Replaces *field by a copy of the current string.
+ */
+static int
+b3_statusreader_set_string(b3_statusreader_t *reader, char **field);
+
+static int
+b3_status_str_equals(const char *str, const char *other);
+
+b3_statusreader_t *
+b3_statusreader_new(b3_statusreader_handler_t handler, void *data)
+{
+  b3_statusreader_t *reader;
+
+  reader = malloc(sizeof(b3_statusreader_t));
+  if (reader) {
+    memset(reader, 0, sizeof(b3_statusreader_t));
+
+    reader->handler = handler;
+    reader->data = data;
+    reader->state = B3_STATUSREADER_START;
+    reader->lex = B3_STATUSREADER_LEX_NONE;
+  }
+
+  return reader;
+}
+
+int
+b3_statusreader_free(b3_statusreader_t *reader)
+{
+  b3_status_block_arr_free(reader->block_arr, reader->block_arr_len);
+  reader->block_arr = NULL;
+
+  free(reader->string);
+  reader->string = NULL;
+
+  free(reader);
+  return 0;
+}
+
+int
+b3_statusreader_feed(b3_statusreader_t *reader, const char *buf, int len)
+{
+  int error;
+  int i;
+  char c;
+
+  error = reader->state == B3_STATUSREADER_ERROR;
+
+  i = 0;
+  while (!error && i < len) {
+    c = buf[i];
+
+    switch (reader->lex) {
+    case B3_STATUSREADER_LEX_NONE:
+      if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+        i++;
+      } else if (c == '"') {
+        reader->string_len = 0;
+        if (reader->string) {
+          reader->string[0] = '\0';
+        }
+        reader->surrogate = 0;
+        reader->lex = B3_STATUSREADER_LEX_STRING;
+        i++;
+      } else if (strchr("{}[]:,", c) && c != '\0') {
+        error = b3_statusreader_token(reader, c);
+        i++;
+      } else if (c == '-' || isalnum((unsigned char) c)) {
+        /** The character is consumed as part of the scalar */
+        reader->scalar_len = 0;
+        reader->lex = B3_STATUSREADER_LEX_SCALAR;
+      } else {
+        error = 1;
+      }
+      break;
+
+    case B3_STATUSREADER_LEX_STRING:
+      if (c == '"') {
+        b3_statusreader_flush_surrogate(reader);
+        reader->lex = B3_STATUSREADER_LEX_NONE;
+        error = b3_statusreader_token(reader, B3_STATUSREADER_TOKEN_STRING);
+      } else if (c == '\\') {
+        reader->lex = B3_STATUSREADER_LEX_ESCAPE;
+      } else if ((unsigned char) c < 0x20) {
+        error = 1;
+      } else {
+        b3_statusreader_flush_surrogate(reader);
+        b3_statusreader_append(reader, c);
+      }
+      i++;
+      break;
+
+    case B3_STATUSREADER_LEX_ESCAPE:
+      reader->lex = B3_STATUSREADER_LEX_STRING;
+      if (c == 'u') {
+        reader->unicode = 0;
+        reader->unicode_len = 0;
+        reader->lex = B3_STATUSREADER_LEX_UNICODE;
+      } else {
+        b3_statusreader_flush_surrogate(reader);
+        switch (c) {
+        case '"':
+        case '\\':
+        case '/':
+          b3_statusreader_append(reader, c);
+          break;
+        case 'b':
+          b3_statusreader_append(reader, '\b');
+          break;
+        case 'f':
+          b3_statusreader_append(reader, '\f');
+          break;
+        case 'n':
+          b3_statusreader_append(reader, '\n');
+          break;
+        case 'r':
+          b3_statusreader_append(reader, '\r');
+          break;
+        case 't':
+          b3_statusreader_append(reader, '\t');
+          break;
+        default:
+          error = 1;
+        }
+      }
+      i++;
+      break;
+
+    case B3_STATUSREADER_LEX_UNICODE:
+      if (isxdigit((unsigned char) c)) {
+        reader->unicode = reader->unicode * 16
+          + (isdigit((unsigned char) c) ? c - '0' : tolower((unsigned char) c) - 'a' + 10);
+        reader->unicode_len++;
+        if (reader->unicode_len == 4) {
+          b3_statusreader_append_code_point(reader, reader->unicode);
+          reader->lex = B3_STATUSREADER_LEX_STRING;
+        }
+      } else {
+        error = 1;
+      }
+      i++;
+      break;
+
+    case B3_STATUSREADER_LEX_SCALAR:
+      if (c == '-' || c == '+' || c == '.' || isalnum((unsigned char) c)) {
+        if (reader->scalar_len + 1 >= B3_STATUSREADER_SCALAR_LEN) {
+          error = 1;
+        } else {
+          reader->scalar[reader->scalar_len++] = c;
+        }
+        i++;
+      } else {
+        /** The character ending the scalar is read again */
+        reader->scalar[reader->scalar_len] = '\0';
+        reader->lex = B3_STATUSREADER_LEX_NONE;
+        error = b3_statusreader_token(reader, B3_STATUSREADER_TOKEN_SCALAR);
+      }
+      break;
+    }
+  }
+
+  if (error && reader->state != B3_STATUSREADER_ERROR) {
+    wbk_logger_log(&logger, SEVERE, "Unexpected character '%c' in the status output\n", c);
+    reader->state = B3_STATUSREADER_ERROR;
+  }
+
+  return error;
+}
+
+int
+b3_statusreader_get_version(const b3_statusreader_t *reader)
+{
+  return reader->version;
+}
+
+int
+b3_statusreader_is_end(const b3_statusreader_t *reader)
+{
+  return reader->state == B3_STATUSREADER_END;
+}
+
+int
+b3_statusreader_token(b3_statusreader_t *reader, char token)
+{
+  int error;
+
+  error = 0;
+
+  switch (reader->state) {
+  case B3_STATUSREADER_START:
+    if (token == '{') {
+      reader->header = 1;
+      reader->state = B3_STATUSREADER_OBJECT;
+    } else if (token == '[') {
+      reader->state = B3_STATUSREADER_STREAM;
+    } else {
+      error = 1;
+    }
+    break;
+
+  case B3_STATUSREADER_STREAM_BEGIN:
+    if (token == '[') {
+      reader->state = B3_STATUSREADER_STREAM;
+    } else {
+      error = 1;
+    }
+    break;
+
+  case B3_STATUSREADER_STREAM:
+  case B3_STATUSREADER_STREAM_ELEMENT:
+    if (token == '[') {
+      reader->state = B3_STATUSREADER_LINE;
+    } else if (token == ']' && reader->state == B3_STATUSREADER_STREAM) {
+      reader->state = B3_STATUSREADER_END;
+    } else {
+      error = 1;
+    }
+    break;
+
+  case B3_STATUSREADER_STREAM_NEXT:
+    if (token == ',') {
+      reader->state = B3_STATUSREADER_STREAM_ELEMENT;
+    } else if (token == ']') {
+      reader->state = B3_STATUSREADER_END;
+    } else {
+      error = 1;
+    }
+    break;
+
+  case B3_STATUSREADER_LINE:
+  case B3_STATUSREADER_LINE_ELEMENT:
+    if (token == '{') {
+      error = b3_statusreader_begin_block(reader);
+      reader->state = B3_STATUSREADER_OBJECT;
+    } else if (token == ']' && reader->state == B3_STATUSREADER_LINE) {
+      b3_statusreader_end_line(reader);
+      reader->state = B3_STATUSREADER_STREAM_NEXT;
+    } else {
+      error = 1;
+    }
+    break;
+
+  case B3_STATUSREADER_LINE_NEXT:
+    if (token == ',') {
+      reader->state = B3_STATUSREADER_LINE_ELEMENT;
+    } else if (token == ']') {
+      b3_statusreader_end_line(reader);
+      reader->state = B3_STATUSREADER_STREAM_NEXT;
+    } else {
+      error = 1;
+    }
+    break;
+
+  case B3_STATUSREADER_OBJECT:
+  case B3_STATUSREADER_OBJECT_KEY:
+    if (token == B3_STATUSREADER_TOKEN_STRING) {
+      strncpy(reader->key, reader->string ? reader->string : "", B3_STATUSREADER_KEY_LEN - 1);
+      reader->key[B3_STATUSREADER_KEY_LEN - 1] = '\0';
+      reader->state = B3_STATUSREADER_OBJECT_COLON;
+    } else if (token == '}' && reader->state == B3_STATUSREADER_OBJECT) {
+      if (reader->header) {
+        reader->header = 0;
+        reader->state = B3_STATUSREADER_STREAM_BEGIN;
+      } else {
+        reader->state = B3_STATUSREADER_LINE_NEXT;
+      }
+    } else {
+      error = 1;
+    }
+    break;
+
+  case B3_STATUSREADER_OBJECT_COLON:
+    if (token == ':') {
+      reader->state = B3_STATUSREADER_OBJECT_VALUE;
+    } else {
+      error = 1;
+    }
+    break;
+
+  case B3_STATUSREADER_OBJECT_VALUE:
+    if (token == '{' || token == '[') {
+      reader->skip_depth = 1;
+      reader->state = B3_STATUSREADER_SKIP;
+    } else if (token == B3_STATUSREADER_TOKEN_STRING || token == B3_STATUSREADER_TOKEN_SCALAR) {
+      error = b3_statusreader_set_value(reader, token);
+      reader->state = B3_STATUSREADER_OBJECT_NEXT;
+    } else {
+      error = 1;
+    }
+    break;
+
+  case B3_STATUSREADER_OBJECT_NEXT:
+    if (token == ',') {
+      reader->state = B3_STATUSREADER_OBJECT_KEY;
+    } else if (token == '}') {
+      reader->state = B3_STATUSREADER_OBJECT;
+      error = b3_statusreader_token(reader, token);
+    } else {
+      error = 1;
+    }
+    break;
+
+  case B3_STATUSREADER_SKIP:
+    /**
+     * Only the nesting matters. Strings cannot contain brackets here, they
+     * are tokens of their own.
+     */
+    if (token == '{' || token == '[') {
+      reader->skip_depth++;
+    } else if (token == '}' || token == ']') {
+      reader->skip_depth--;
+      if (reader->skip_depth == 0) {
+        reader->state = B3_STATUSREADER_OBJECT_NEXT;
+      }
+    } else if (token == B3_STATUSREADER_TOKEN_SCALAR) {
+      error = b3_statusreader_scalar_kind(reader->scalar) == 0;
+    }
+    break;
+
+  default:
+    error = 1;
+  }
+
+  return error;
+}
+
+int
+b3_statusreader_set_value(b3_statusreader_t *reader, char token)
+{
+  b3_status_block_t *block;
+  char kind;
+  const char *key;
+
+  kind = 0;
+  if (token == B3_STATUSREADER_TOKEN_SCALAR) {
+    kind = b3_statusreader_scalar_kind(reader->scalar);
+    if (kind == 0) {
+      return 1;
+    }
+  }
+
+  key = reader->key;
+
+  if (reader->header) {
+    if (strcmp(key, "version") == 0 && kind == '0') {
+      reader->version = atoi(reader->scalar);
+    }
+    return 0;
+  }
+
+  block = &(reader->block_arr[reader->block_arr_len - 1]);
+
+  if (token == B3_STATUSREADER_TOKEN_STRING) {
+    if (strcmp(key, "full_text") == 0) {
+      b3_statusreader_set_string(reader, &(block->full_text));
+    } else if (strcmp(key, "short_text") == 0) {
+      b3_statusreader_set_string(reader, &(block->short_text));
+    } else if (strcmp(key, "name") == 0) {
+      b3_statusreader_set_string(reader, &(block->name));
+    } else if (strcmp(key, "instance") == 0) {
+      b3_statusreader_set_string(reader, &(block->instance));
+    } else if (strcmp(key, "color") == 0) {
+      block->color = b3_statusreader_parse_color(reader->string);
+    } else if (strcmp(key, "background") == 0) {
+      block->background = b3_statusreader_parse_color(reader->string);
+    } else if (strcmp(key, "border") == 0) {
+      block->border = b3_statusreader_parse_color(reader->string);
+    }
+  } else {
+    if (strcmp(key, "min_width") == 0 && kind == '0') {
+      block->min_width = atoi(reader->scalar);
+    } else if (strcmp(key, "separator_block_width") == 0 && kind == '0') {
+      block->separator_block_width = atoi(reader->scalar);
+    } else if (strcmp(key, "urgent") == 0 && (kind == 't' || kind == 'f')) {
+      block->urgent = kind == 't';
+    } else if (strcmp(key, "separator") == 0 && (kind == 't' || kind == 'f')) {
+      block->separator = kind == 't';
+    }
+  }
+
+  return 0;
+}
+
+int
+b3_statusreader_begin_block(b3_statusreader_t *reader)
+{
+  b3_status_block_t *block_arr;
+  b3_status_block_t *block;
+  int cap;
+
+  if (reader->block_arr_len == reader->block_arr_cap) {
+    cap = reader->block_arr_cap ? reader->block_arr_cap * 2 : 8;
+    block_arr = realloc(reader->block_arr, sizeof(b3_status_block_t) * cap);
+    if (block_arr == NULL) {
+      return 1;
+    }
+    reader->block_arr = block_arr;
+    reader->block_arr_cap = cap;
+  }
+
+  block = &(reader->block_arr[reader->block_arr_len++]);
+  memset(block, 0, sizeof(b3_status_block_t));
+  block->color = B3_STATUS_COLOR_UNSET;
+  block->background = B3_STATUS_COLOR_UNSET;
+  block->border = B3_STATUS_COLOR_UNSET;
+  block->separator = 1;
+  block->separator_block_width = B3_STATUS_DEFAULT_SEPARATOR_BLOCK_WIDTH;
+
+  return 0;
+}
+
+int
+b3_statusreader_end_line(b3_statusreader_t *reader)
+{
+  if (reader->block_arr_len == 0) {
+    free(reader->block_arr);
+    reader->block_arr = NULL;
+  }
+
+  if (reader->handler) {
+    reader->handler(reader->data, reader->block_arr, reader->block_arr_len);
+  } else {
+    b3_status_block_arr_free(reader->block_arr, reader->block_arr_len);
+  }
+
+  reader->block_arr = NULL;
+  reader->block_arr_len = 0;
+  reader->block_arr_cap = 0;
+
+  return 0;
+}
+
+int
+b3_statusreader_append(b3_statusreader_t *reader, char c)
+{
+  char *string;
+  int cap;
+
+  if (reader->string_len >= B3_STATUSREADER_STRING_MAX) {
+    return 1;
+  }
+
+  /**
+   * Keeps space for the terminating byte
+   */
+  if (reader->string_len + 1 >= reader->string_cap) {
+    cap = reader->string_cap ? reader->string_cap * 2 : 64;
+    string = realloc(reader->string, sizeof(char) * cap);
+    if (string == NULL) {
+      return 1;
+    }
+    reader->string = string;
+    reader->string_cap = cap;
+  }
+
+  reader->string[reader->string_len++] = c;
+  reader->string[reader->string_len] = '\0';
+
+  return 0;
+}
+
+int
+b3_statusreader_append_code_point(b3_statusreader_t *reader, long code_point)
+{
+  if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+    b3_statusreader_flush_surrogate(reader);
+    reader->surrogate = code_point;
+    return 0;
+  }
+
+  if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+    if (reader->surrogate) {
+      code_point = 0x10000 + ((reader->surrogate - 0xD800) << 10) + (code_point - 0xDC00);
+      reader->surrogate = 0;
+    } else {
+      code_point = '?';
+    }
+  } else {
+    b3_statusreader_flush_surrogate(reader);
+  }
+
+  if (code_point < 0x80) {
+    b3_statusreader_append(reader, (char) code_point);
+  } else if (code_point < 0x800) {
+    b3_statusreader_append(reader, (char) (0xC0 | (code_point >> 6)));
+    b3_statusreader_append(reader, (char) (0x80 | (code_point & 0x3F)));
+  } else if (code_point < 0x10000) {
+    b3_statusreader_append(reader, (char) (0xE0 | (code_point >> 12)));
+    b3_statusreader_append(reader, (char) (0x80 | ((code_point >> 6) & 0x3F)));
+    b3_statusreader_append(reader, (char) (0x80 | (code_point & 0x3F)));
+  } else {
+    b3_statusreader_append(reader, (char) (0xF0 | (code_point >> 18)));
+    b3_statusreader_append(reader, (char) (0x80 | ((code_point >> 12) & 0x3F)));
+    b3_statusreader_append(reader, (char) (0x80 | ((code_point >> 6) & 0x3F)));
+    b3_statusreader_append(reader, (char) (0x80 | (code_point & 0x3F)));
+  }
+
+  return 0;
+}
+
+int
+b3_statusreader_flush_surrogate(b3_statusreader_t *reader)
+{
+  if (reader->surrogate) {
+    reader->surrogate = 0;
+    b3_statusreader_append(reader, '?');
+  }
+  return 0;
+}
+
+char
+b3_statusreader_scalar_kind(const char *scalar)
+{
+  char *end;
+
+  if (strcmp(scalar, "true") == 0) {
+    return 't';
+  } else if (strcmp(scalar, "false") == 0) {
+    return 'f';
+  } else if (strcmp(scalar, "null") == 0) {
+    return 'n';
+  } else if (scalar[0] == '-' || isdigit((unsigned char) scalar[0])) {
+    strtod(scalar, &end);
+    if (end != scalar && *end == '\0' && strchr(scalar, 'x') == NULL && strchr(scalar, 'X') == NULL) {
+      return '0';
+    }
+  }
+
+  return 0;
+}
+
+long
+b3_statusreader_parse_color(const char *color)
+{
+  char rgb[7];
+  int len;
+  int i;
+
+  len = color ? strlen(color) : 0;
+  if (len != 7 && len != 9) {
+    return B3_STATUS_COLOR_UNSET;
+  }
+
+  if (color[0] != '#') {
+    return B3_STATUS_COLOR_UNSET;
+  }
+
+  for (i = 1; i < len; i++) {
+    if (!isxdigit((unsigned char) color[i])) {
+      return B3_STATUS_COLOR_UNSET;
+    }
+  }
+
+  /**
+   * The alpha channel of #RRGGBBAA is ignored
+   */
+  memcpy(rgb, color + 1, 6);
+  rgb[6] = '\0';
+
+  return strtol(rgb, NULL, 16);
+}
+
+int
+b3_statusreader_set_string(b3_statusreader_t *reader, char **field)
+{
+  free(*field);
+  *field = strdup(reader->string ? reader->string : "");
+  return *field == NULL;
+}
+
+int
+b3_status_str_equals(const char *str, const char *other)
+{
+  if (str == NULL || other == NULL) {
+    return str == other;
+  }
+  return strcmp(str, other) == 0;
+}
+
+int
+b3_status_block_equals(const b3_status_block_t *block, const b3_status_block_t *other)
+{
+  return b3_status_str_equals(block->full_text, other->full_text)
+    && b3_status_str_equals(block->short_text, other->short_text)
+    && b3_status_str_equals(block->name, other->name)
+    && b3_status_str_equals(block->instance, other->instance)
+    && block->color == other->color
+    && block->background == other->background
+    && block->border == other->border
+    && block->min_width == other->min_width
+    && block->urgent == other->urgent
+    && block->separator == other->separator
+    && block->separator_block_width == other->separator_block_width;
+}
+
+int
+b3_status_block_arr_equals(const b3_status_block_t *block_arr, int block_arr_len,
+                           const b3_status_block_t *other_arr, int other_arr_len)
+{
+  int equals;
+  int i;
+
+  equals = block_arr_len == other_arr_len;
+  for (i = 0; equals && i < block_arr_len; i++) {
+    equals = b3_status_block_equals(&(block_arr[i]), &(other_arr[i]));
+  }
+
+  return equals;
+}
+
+b3_status_block_t *
+b3_status_block_arr_copy(const b3_status_block_t *block_arr, int block_arr_len)
+{
+  b3_status_block_t *copy_arr;
+  int i;
+
+  copy_arr = NULL;
+  if (block_arr_len > 0) {
+    copy_arr = malloc(sizeof(b3_status_block_t) * block_arr_len);
+  }
+
+  if (copy_arr) {
+    for (i = 0; i < block_arr_len; i++) {
+      copy_arr[i] = block_arr[i];
+      copy_arr[i].full_text = block_arr[i].full_text ? strdup(block_arr[i].full_text) : NULL;
+      copy_arr[i].short_text = block_arr[i].short_text ? strdup(block_arr[i].short_text) : NULL;
+      copy_arr[i].name = block_arr[i].name ? strdup(block_arr[i].name) : NULL;
+      copy_arr[i].instance = block_arr[i].instance ? strdup(block_arr[i].instance) : NULL;
+    }
+  }
+
+  return copy_arr;
+}
+
+int
+b3_status_block_arr_free(b3_status_block_t *block_arr, int block_arr_len)
+{
+  int i;
+
+  for (i = 0; i < block_arr_len; i++) {
+    free(block_arr[i].full_text);
+    free(block_arr[i].short_text);
+    free(block_arr[i].name);
+    free(block_arr[i].instance);
+  }
+  free(block_arr);
+
+  return 0;
+}
@@ -0,0 +1,251 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the status reader class definition
+ *
+ * The status reader parses the output of a status command speaking the i3bar
+ * protocol: a header object followed by an infinite JSON array, whose elements
+ * are arrays of blocks. Each element is one status line.
+ *
+ * The output is fed in chunks as it arrives from the pipe. The reader keeps
+ * only its state, the string or number being read and the blocks of the
+ * current status line. Keys it does not know are skipped, including nested
+ * values.
+ */
+
+#ifndef B3_STATUSREADER_H
+#define B3_STATUSREADER_H
+
+/**
+ * Longer keys are truncated, so they are unknown.
+ */
+#define B3_STATUSREADER_KEY_LEN 32
+
+/**
+ * Longer strings are truncated.
+ */
+#define B3_STATUSREADER_STRING_MAX 4096
+
+/**
+ * Longer numbers and literals are a syntax error.
+ */
+#define B3_STATUSREADER_SCALAR_LEN 32
+
+/**
+ * Color of a block which does not set it.
+ */
+#define B3_STATUS_COLOR_UNSET -1
+
+#define B3_STATUS_DEFAULT_SEPARATOR_BLOCK_WIDTH 9
+
+typedef struct b3_status_block_s
+{
+  char *full_text;
+  char *short_text;
+  char *name;
+  char *instance;
+
+  /**
+   * 0xRRGGBB or B3_STATUS_COLOR_UNSET
+   */
+  long color;
+  long background;
+  long border;
+
+  int min_width;
+  char urgent;
+  char separator;
+  int separator_block_width;
+} b3_status_block_t;
+
+typedef enum b3_statusreader_state_e
+{
+  /** Expects the header object or the infinite array */
+  B3_STATUSREADER_START = 0,
+  /** Expects the infinite array after the header */
+  B3_STATUSREADER_STREAM_BEGIN,
+  /** Expects a status line or the end of the infinite array */
+  B3_STATUSREADER_STREAM,
+  /** Expects a status line after a comma */
+  B3_STATUSREADER_STREAM_ELEMENT,
+  /** Expects a comma or the end of the infinite array */
+  B3_STATUSREADER_STREAM_NEXT,
+  /** Expects a block or the end of the status line */
+  B3_STATUSREADER_LINE,
+  /** Expects a block after a comma */
+  B3_STATUSREADER_LINE_ELEMENT,
+  /** Expects a comma or the end of the status line */
+  B3_STATUSREADER_LINE_NEXT,
+  /** Expects a key or the end of an object */
+  B3_STATUSREADER_OBJECT,
+  /** Expects a key after a comma */
+  B3_STATUSREADER_OBJECT_KEY,
+  B3_STATUSREADER_OBJECT_COLON,
+  B3_STATUSREADER_OBJECT_VALUE,
+  /** Expects a comma or the end of an object */
+  B3_STATUSREADER_OBJECT_NEXT,
+  /** Skips a nested value of an unknown key */
+  B3_STATUSREADER_SKIP,
+  B3_STATUSREADER_END,
+  B3_STATUSREADER_ERROR
+} b3_statusreader_state_t;
+
+typedef enum b3_statusreader_lex_e
+{
+  B3_STATUSREADER_LEX_NONE = 0,
+  B3_STATUSREADER_LEX_STRING,
+  B3_STATUSREADER_LEX_ESCAPE,
+  B3_STATUSREADER_LEX_UNICODE,
+  B3_STATUSREADER_LEX_SCALAR
+} b3_statusreader_lex_t;
+
+/**
+ * Receives the blocks of a complete status line.
+ *
+ * @param block_arr The handler takes the ownership. Free it by
+ * b3_status_block_arr_free(). NULL if the line is empty.
+ */
+typedef int (*b3_statusreader_handler_t)(void *data, b3_status_block_t *block_arr, int block_arr_len);
+
+typedef struct b3_statusreader_s
+{
+  b3_statusreader_handler_t handler;
+  void *data;
+
+  b3_statusreader_state_t state;
+
+  /**
+   * Non-0 while reading the header object instead of a block
+   */
+  char header;
+
+  /**
+   * Protocol version of the header. 0 if there was no header.
+   */
+  int version;
+
+  /**
+   * Depth of the nested value being skipped
+   */
+  int skip_depth;
+
+  char key[B3_STATUSREADER_KEY_LEN];
+
+  b3_statusreader_lex_t lex;
+
+  /**
+   * The string being read. It is reused for every string.
+   */
+  char *string;
+  int string_len;
+  int string_cap;
+
+  /**
+   * The code point of a \u escape and the number of its hex digits read
+   */
+  long unicode;
+  int unicode_len;
+
+  /**
+   * A high surrogate waiting for its low surrogate. 0 if there is none.
+   */
+  long surrogate;
+
+  /**
+   * The number or literal being read
+   */
+  char scalar[B3_STATUSREADER_SCALAR_LEN];
+  int scalar_len;
+
+  /**
+   * The blocks of the current status line
+   */
+  b3_status_block_t *block_arr;
+  int block_arr_len;
+  int block_arr_cap;
+} b3_statusreader_t;
+
+/**
+ * @brief Creates a new status reader
+ * @param handler Called for each complete status line. Can be NULL.
+ * @param data Passed to the handler
+ * @return A new status reader or NULL if allocation failed
+ */
+extern b3_statusreader_t *
+b3_statusreader_new(b3_statusreader_handler_t handler, void *data);
+
+/**
+ * @brief Frees a status reader including the incomplete status line.
+ */
+extern int
+b3_statusreader_free(b3_statusreader_t *reader);
+
+/**
+ * Reads the next chunk of the output. A chunk can end anywhere, even within a
+ * string or a number.
+ *
+ * @return Non-0 if the output is not valid. Every following chunk is rejected
+ * as well.
+ */
+extern int
+b3_statusreader_feed(b3_statusreader_t *reader, const char *buf, int len);
+
+/**
+ * @return The protocol version of the header. 0 if it was not read yet.
+ */
+extern int
+b3_statusreader_get_version(const b3_statusreader_t *reader);
+
+/**
+ * @return Non-0 if the infinite array was closed
+ */
+extern int
+b3_statusreader_is_end(const b3_statusreader_t *reader);
+
+/**
+ * @return Non-0 if both blocks look and act the same.
+ */
+extern int
+b3_status_block_equals(const b3_status_block_t *block, const b3_status_block_t *other);
+
+/**
+ * @return Non-0 if both status lines are equal.
+ */
+extern int
+b3_status_block_arr_equals(const b3_status_block_t *block_arr, int block_arr_len,
+                           const b3_status_block_t *other_arr, int other_arr_len);
+
+/**
+ * @return A deep copy of the blocks or NULL if block_arr_len is 0 or allocation
+ * failed.
+ */
+extern b3_status_block_t *
+b3_status_block_arr_copy(const b3_status_block_t *block_arr, int block_arr_len);
+
+extern int
+b3_status_block_arr_free(b3_status_block_t *block_arr, int block_arr_len);
+
+#endif // B3_STATUSREADER_H
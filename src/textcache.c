@@ -0,0 +1,353 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the text cache class implementation
+ */
+
+#include "textcache.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <w32bindkeys/logger.h>
+
+static wbk_logger_t logger = { "textcache" };
+
+static int
+b3_textcache_measure_impl(HDC hdc, b3_textcache_encoding_t encoding,
+                          const char *text, SIZE *size);
+
+/**
+ * Adds the extent of a text to the table of its font. The caller holds the
+ * mutex.
+ *
+ * @return Non-0 if the text could not be added
+ */
+static int
+b3_textcache_add(b3_textcache_t *textcache, const LOGFONT *logfont,
+                 b3_textcache_encoding_t encoding, const char *text, SIZE size);
+
+/**
+ * Returns the table of a font and makes it the most recently used one. If the
+ * font is new, the least recently used font is evicted if there are too many.
+ *
+ * @return The table of the font or NULL if allocation failed
+ */
+static b3_textcache_font_t *
+b3_textcache_get_font(b3_textcache_t *textcache, const LOGFONT *logfont,
+                      b3_textcache_encoding_t encoding);
+
+static b3_textcache_font_t *
+b3_textcache_font_new(const LOGFONT *logfont, b3_textcache_encoding_t encoding);
+
+static int
+b3_textcache_font_free(b3_textcache_font_t *font);
+
+/**
+ * Removes an entry from the least recently used list of its font.
+ */
+static int
+b3_textcache_font_unlink(b3_textcache_font_t *font, b3_textcache_entry_t *entry);
+
+/**
+ * Makes an entry the most recently used one of its font.
+ */
+static int
+b3_textcache_font_push(b3_textcache_font_t *font, b3_textcache_entry_t *entry);
+
+b3_textcache_t *
+b3_textcache_new(int capacity)
+{
+  b3_textcache_t *textcache;
+
+  textcache = malloc(sizeof(b3_textcache_t));
+  if (textcache) {
+    memset(textcache, 0, sizeof(b3_textcache_t));
+
+    textcache->b3_textcache_measure = b3_textcache_measure_impl;
+    textcache->capacity = capacity > 0 ? capacity : B3_TEXTCACHE_DEFAULT_CAPACITY;
+    textcache->mutex = CreateMutex(NULL, FALSE, NULL);
+  }
+
+  return textcache;
+}
+
+int
+b3_textcache_free(b3_textcache_t *textcache)
+{
+  int i;
+
+  wbk_logger_log(&logger, DEBUG, "Text extents: %ld hits, %ld misses\n",
+                 textcache->hit_count, textcache->miss_count);
+
+  for (i = 0; i < textcache->font_arr_len; i++) {
+    b3_textcache_font_free(textcache->font_arr[i]);
+    textcache->font_arr[i] = NULL;
+  }
+  textcache->font_arr_len = 0;
+
+  CloseHandle(textcache->mutex);
+
+  free(textcache);
+  return 0;
+}
+
+
+int
+b3_textcache_get_extent(b3_textcache_t *textcache, HDC hdc, const LOGFONT *logfont,
+                        b3_textcache_encoding_t encoding, const char *text, SIZE *size)
+{
+  b3_textcache_font_t *font;
+  b3_textcache_entry_t *entry;
+  int error;
+
+  error = 0;
+  entry = NULL;
+
+  WaitForSingleObject(textcache->mutex, INFINITE);
+
+  font = b3_textcache_get_font(textcache, logfont, encoding);
+  if (font && cc_hashtable_get(font->entry_ht, (void *) text, (void *) &entry) == CC_OK) {
+    b3_textcache_font_unlink(font, entry);
+    b3_textcache_font_push(font, entry);
+    *size = entry->size;
+    textcache->hit_count++;
+  } else {
+    entry = NULL;
+    textcache->miss_count++;
+  }
+
+  ReleaseMutex(textcache->mutex);
+
+  if (entry == NULL) {
+    /**
+     * Measure without holding the mutex, so bars being drawn at the same
+     * time do not wait for each other
+     */
+    error = textcache->b3_textcache_measure(hdc, encoding, text, size);
+  }
+
+  if (entry == NULL && !error) {
+    WaitForSingleObject(textcache->mutex, INFINITE);
+    b3_textcache_add(textcache, logfont, encoding, text, *size);
+    ReleaseMutex(textcache->mutex);
+  }
+
+  return error;
+}
+
+int
+b3_textcache_add(b3_textcache_t *textcache, const LOGFONT *logfont,
+                 b3_textcache_encoding_t encoding, const char *text, SIZE size)
+{
+  b3_textcache_font_t *font;
+  b3_textcache_entry_t *entry;
+
+  font = b3_textcache_get_font(textcache, logfont, encoding);
+  if (font == NULL) {
+    return 1;
+  }
+
+  /**
+   * Another thread may have measured the text in the meantime
+   */
+  if (cc_hashtable_get(font->entry_ht, (void *) text, (void *) &entry) == CC_OK) {
+    return 0;
+  }
+
+  /**
+   * Reuse the least recently used entry if the font is full
+   */
+  if (font->entry_count >= textcache->capacity) {
+    entry = font->tail;
+    b3_textcache_font_unlink(font, entry);
+    cc_hashtable_remove(font->entry_ht, entry->text, NULL);
+    free(entry->text);
+    font->entry_count--;
+  } else {
+    entry = malloc(sizeof(b3_textcache_entry_t));
+  }
+
+  if (entry == NULL) {
+    return 1;
+  }
+
+  entry->text = strdup(text);
+  entry->size = size;
+  if (entry->text == NULL
+      || cc_hashtable_add(font->entry_ht, entry->text, entry) != CC_OK) {
+    free(entry->text);
+    free(entry);
+    return 1;
+  }
+
+  b3_textcache_font_push(font, entry);
+  font->entry_count++;
+
+  return 0;
+}
+
+int
+b3_textcache_measure_impl(HDC hdc, b3_textcache_encoding_t encoding,
+                          const char *text, SIZE *size)
+{
+  wchar_t *wide;
+  int wide_len;
+  int error;
+
+  error = 0;
+
+  if (encoding == B3_TEXTCACHE_UTF8) {
+    wide = NULL;
+    wide_len = MultiByteToWideChar(CP_UTF8, 0, text, -1, NULL, 0);
+    if (wide_len > 0) {
+      wide = malloc(sizeof(wchar_t) * wide_len);
+    }
+
+    if (wide) {
+      MultiByteToWideChar(CP_UTF8, 0, text, -1, wide, wide_len);
+      /** Without the terminating byte */
+      error = !GetTextExtentPoint32W(hdc, wide, wide_len - 1, size);
+      free(wide);
+    } else {
+      error = 1;
+    }
+  } else {
+    error = !GetTextExtentPoint32A(hdc, text, strlen(text), size);
+  }
+
+  return error;
+}
+
+b3_textcache_font_t *
+b3_textcache_get_font(b3_textcache_t *textcache, const LOGFONT *logfont,
+                      b3_textcache_encoding_t encoding)
+{
+  b3_textcache_font_t *font;
+  int i;
+
+  font = NULL;
+  for (i = 0; font == NULL && i < textcache->font_arr_len; i++) {
+    if (textcache->font_arr[i]->encoding == encoding
+        && memcmp(&(textcache->font_arr[i]->logfont), logfont, sizeof(LOGFONT)) == 0) {
+      font = textcache->font_arr[i];
+      textcache->font_arr_len--;
+      memmove(&(textcache->font_arr[i]), &(textcache->font_arr[i + 1]),
+              sizeof(b3_textcache_font_t *) * (textcache->font_arr_len - i));
+    }
+  }
+
+  if (font == NULL) {
+    if (textcache->font_arr_len == B3_TEXTCACHE_MAX_FONTS) {
+      textcache->font_arr_len--;
+      b3_textcache_font_free(textcache->font_arr[textcache->font_arr_len]);
+    }
+    font = b3_textcache_font_new(logfont, encoding);
+  }
+
+  if (font) {
+    memmove(&(textcache->font_arr[1]), &(textcache->font_arr[0]),
+            sizeof(b3_textcache_font_t *) * textcache->font_arr_len);
+    textcache->font_arr[0] = font;
+    textcache->font_arr_len++;
+  }
+
+  return font;
+}
+
+b3_textcache_font_t *
+b3_textcache_font_new(const LOGFONT *logfont, b3_textcache_encoding_t encoding)
+{
+  b3_textcache_font_t *font;
+
+  font = malloc(sizeof(b3_textcache_font_t));
+  if (font) {
+    memset(font, 0, sizeof(b3_textcache_font_t));
+    font->logfont = *logfont;
+    font->encoding = encoding;
+    if (cc_hashtable_new(&(font->entry_ht)) != CC_OK) {
+      free(font);
+      font = NULL;
+    }
+  }
+
+  return font;
+}
+
+int
+b3_textcache_font_free(b3_textcache_font_t *font)
+{
+  b3_textcache_entry_t *entry;
+  b3_textcache_entry_t *next;
+
+  for (entry = font->head; entry; entry = next) {
+    next = entry->next;
+    free(entry->text);
+    free(entry);
+  }
+
+  cc_hashtable_destroy(font->entry_ht);
+  free(font);
+
+  return 0;
+}
+
+int
+b3_textcache_font_unlink(b3_textcache_font_t *font, b3_textcache_entry_t *entry)
+{
+  if (entry->prev) {
+    entry->prev->next = entry->next;
+  } else {
+    font->head = entry->next;
+  }
+
+  if (entry->next) {
+    entry->next->prev = entry->prev;
+  } else {
+    font->tail = entry->prev;
+  }
+
+  entry->prev = NULL;
+  entry->next = NULL;
+
+  return 0;
+}
+
+int
+b3_textcache_font_push(b3_textcache_font_t *font, b3_textcache_entry_t *entry)
+{
+  entry->prev = NULL;
+  entry->next = font->head;
+
+  if (font->head) {
+    font->head->prev = entry;
+  } else {
+    font->tail = entry;
+  }
+  font->head = entry;
+
+  return 0;
+}
@@ -0,0 +1,153 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the text cache class definition
+ *
+ * The text cache keeps the pixel extents of measured texts, so laying out
+ * labels which were already drawn does not call into GDI. Each font has its
+ * own table of texts. Both the texts of a font and the fonts are evicted least
+ * recently used first.
+ */
+
+#ifndef B3_TEXTCACHE_H
+#define B3_TEXTCACHE_H
+
+#include <windows.h>
+#include <collectc/cc_hashtable.h>
+
+/**
+ * Maximum number of texts kept per font
+ */
+#define B3_TEXTCACHE_DEFAULT_CAPACITY 512
+
+/**
+ * Maximum number of fonts kept
+ */
+#define B3_TEXTCACHE_MAX_FONTS 4
+
+typedef enum b3_textcache_encoding_e
+{
+  B3_TEXTCACHE_ANSI = 0,
+  B3_TEXTCACHE_UTF8
+} b3_textcache_encoding_t;
+
+typedef struct b3_textcache_entry_s
+{
+  /**
+   * Key of the entry in the table of its font
+   */
+  char *text;
+
+  SIZE size;
+
+  /**
+   * Neighbours in the least recently used list of the font
+   */
+  struct b3_textcache_entry_s *prev;
+  struct b3_textcache_entry_s *next;
+} b3_textcache_entry_t;
+
+typedef struct b3_textcache_font_s
+{
+  LOGFONT logfont;
+
+  b3_textcache_encoding_t encoding;
+
+  /**
+   * char * -> b3_textcache_entry_t *
+   */
+  CC_HashTable *entry_ht;
+
+  int entry_count;
+
+  /**
+   * Most recently used entry
+   */
+  b3_textcache_entry_t *head;
+
+  /**
+   * Least recently used entry, the next one to be evicted
+   */
+  b3_textcache_entry_t *tail;
+} b3_textcache_font_t;
+
+typedef struct b3_textcache_s
+{
+  /**
+   * Measures a text with the font selected into hdc. Replaceable for testing.
+   */
+  int (*b3_textcache_measure)(HDC hdc, b3_textcache_encoding_t encoding,
+                              const char *text, SIZE *size);
+
+  int capacity;
+
+  HANDLE mutex;
+
+  /**
+   * Sorted from the most to the least recently used
+   */
+  b3_textcache_font_t *font_arr[B3_TEXTCACHE_MAX_FONTS];
+  int font_arr_len;
+
+  /**
+   * Number of measurements, for the statistics
+   */
+  long miss_count;
+  long hit_count;
+} b3_textcache_t;
+
+/**
+ * @brief Creates a new text cache
+ * @param capacity Maximum number of texts kept per font
+ * @return A new text cache or NULL if allocation failed
+ */
+extern b3_textcache_t *
+b3_textcache_new(int capacity);
+
+/**
+ * @brief Frees a text cache
+ * @return Non-0 if the freeing failed
+ */
+extern int
+b3_textcache_free(b3_textcache_t *textcache);
+
+/**
+ * @brief Returns the extent of a text. It is only measured if it is not cached
+ * for the font yet. Can be called from any thread, measuring does not block
+ * the other threads.
+ * @param hdc The device context the font described by logfont is selected
+ * into. Only used to measure the text.
+ * @param logfont Identifies the font
+ * @param encoding Encoding of text
+ * @param size Set to the extent of text
+ * @return Non-0 if the text could not be measured
+ */
+extern int
+b3_textcache_get_extent(b3_textcache_t *textcache, HDC hdc, const LOGFONT *logfont,
+                        b3_textcache_encoding_t encoding, const char *text, SIZE *size);
+
+#endif // B3_TEXTCACHE_H
@@ -75,6 +75,10 @@ b3_win_new(HWND window_handler, char floating)
     win->floating = floating;
 
     GetWindowRect(window_handler, &(win->rect));
+
+    win->attrs_cached = 0;
+    win->class_name[0] = '\0';
+    win->title[0] = '\0';
   }
 
 	return win;
@@ -86,6 +90,11 @@ b3_win_copy(const b3_win_t *win)
 	b3_win_t * copy;
 
 	copy = b3_win_new(win->window_handler, win->floating);
+	if (copy && win->attrs_cached) {
+		copy->attrs_cached = 1;
+		memcpy(copy->class_name, win->class_name, B3_WIN_ATTR_LENGTH);
+		memcpy(copy->title, win->title, B3_WIN_ATTR_LENGTH);
+	}
 
 	return copy;
 }
@@ -115,11 +124,39 @@ b3_win_set_state(b3_win_t *win, b3_win_state_t state)
 	return 0;
 }
 
+int
+b3_win_cache_attrs(b3_win_t *win)
+{
+	int error;
+
+	error = 0;
+
+	if (!win->attrs_cached) {
+		if (GetClassName(win->window_handler, win->class_name, B3_WIN_ATTR_LENGTH) == 0) {
+			win->class_name[0] = '\0';
+			error = 1;
+		}
+
+		if (GetWindowText(win->window_handler, win->title, B3_WIN_ATTR_LENGTH) == 0) {
+			win->title[0] = '\0';
+		}
+
+		win->attrs_cached = 1;
+	}
+
+	return error;
+}
+
 const char *
 b3_win_get_title(b3_win_t *win)
 {
-	// TODO
-	return NULL;
+	return win->title;
+}
+
+const char *
+b3_win_get_class_name(b3_win_t *win)
+{
+	return win->class_name;
 }
 
 char
@@ -33,6 +33,8 @@
 
 #include <windows.h>
 
+#define B3_WIN_ATTR_LENGTH 256
+
 typedef enum b3_win_state_e
 {
 	NORMAL = 0,
@@ -50,6 +52,14 @@ struct b3_win_s
 	HWND window_handler;
 	char floating;
 	RECT rect;
+
+	/**
+	 * Window attributes read by b3_win_cache_attrs(). Conditions evaluate
+	 * against these instead of querying the window again.
+	 */
+	char attrs_cached;
+	char class_name[B3_WIN_ATTR_LENGTH];
+	char title[B3_WIN_ATTR_LENGTH];
 };
 
 /**
@@ -71,9 +81,26 @@ b3_win_copy(const b3_win_t *win);
 extern int
 b3_win_free(b3_win_t *win);
 
+/**
+ * @brief Reads the class name and the title of the window once and keeps
+ * them for later use.
+ * @return Non-0 if the window is not available anymore
+ */
+extern int
+b3_win_cache_attrs(b3_win_t *win);
+
+/**
+ * @return The title cached by b3_win_cache_attrs(). Do not free it!
+ */
 extern const char *
 b3_win_get_title(b3_win_t *win);
 
+/**
+ * @return The class name cached by b3_win_cache_attrs(). Do not free it!
+ */
+extern const char *
+b3_win_get_class_name(b3_win_t *win);
+
 extern b3_win_state_t
 b3_win_get_state(b3_win_t *win);
 
@@ -49,6 +49,12 @@ typedef struct b3_win_watcher_win_closed_comm_s
 	HWND closed_window_handler;
 } b3_win_watcher_win_closed_comm_t;
 
+typedef struct b3_win_watcher_win_flashed_comm_s
+{
+	b3_win_watcher_t *win_watcher;
+	HWND flashed_window_handler;
+} b3_win_watcher_win_flashed_comm_t;
+
 static wbk_logger_t logger =  { "win_watcher" };
 
 static int
@@ -72,6 +78,12 @@ b3_win_watcher_win_opened_threaded(LPVOID param);
 static DWORD WINAPI
 b3_win_watcher_win_closed_threaded(LPVOID param);
 
+/**
+ * Marks the workspace of a flashing window as urgent.
+ */
+static DWORD WINAPI
+b3_win_watcher_win_flashed_threaded(LPVOID param);
+
 static int
 b3_win_watcher_managable_window_handler_impl(b3_win_watcher_t *win_watcher, HWND window_handler);
 
@@ -249,6 +261,7 @@ b3_win_watcher_wnd_proc(HWND window_handler, UINT msg, WPARAM wParam, LPARAM lPa
 	b3_win_watcher_win_focused_comm_t focused_comm;
 	b3_win_watcher_win_opened_comm_t opened_comm;
 	b3_win_watcher_win_closed_comm_t closed_comm;
+	b3_win_watcher_win_flashed_comm_t flashed_comm;
 
     win_watcher = (b3_win_watcher_t *) GetWindowLongPtr(window_handler, GWLP_USERDATA);
 
@@ -305,6 +318,26 @@ b3_win_watcher_wnd_proc(HWND window_handler, UINT msg, WPARAM wParam, LPARAM lPa
 						b3_win_watcher_win_focused_threaded((LPVOID) &focused_comm);
 					}
 					break;
+
+				case HSHELL_REDRAW:
+					/**
+					 * HSHELL_FLASH is HSHELL_REDRAW with the high bit set
+					 */
+					if (wParam == HSHELL_FLASH) {
+						flashed_comm.win_watcher = win_watcher;
+						flashed_comm.flashed_window_handler = (HWND) lParam;
+						if (b3_win_watcher_is_threaded(win_watcher)) {
+							CreateThread(NULL,
+										 0,
+										 b3_win_watcher_win_flashed_threaded,
+										 (LPVOID) &flashed_comm,
+										 0,
+										 NULL);
+						} else {
+							b3_win_watcher_win_flashed_threaded((LPVOID) &flashed_comm);
+						}
+					}
+					break;
 			}
 		} else {
 			return DefWindowProc(window_handler, msg, wParam, lParam);
@@ -372,6 +405,23 @@ b3_win_watcher_win_closed_threaded(LPVOID param)
 	return 0;
 }
 
+DWORD WINAPI
+b3_win_watcher_win_flashed_threaded(LPVOID param)
+{
+	b3_win_watcher_win_flashed_comm_t *comm;
+	b3_win_t *win;
+
+	comm = (b3_win_watcher_win_flashed_comm_t *) param;
+	if (b3_win_watcher_managable_window_handler(comm->win_watcher, comm->flashed_window_handler)) {
+		win = b3_win_factory_win_create(comm->win_watcher->win_factory, comm->flashed_window_handler);
+		if (b3_director_set_urgent_win(comm->win_watcher->director, win)) {
+			wbk_logger_log(&logger, DEBUG, "Flashing window is not managed\n");
+		}
+	}
+
+	return 0;
+}
+
 BOOL CALLBACK
 b3_win_watcher_enum_windows(HWND window_handler, LPARAM param)
 {
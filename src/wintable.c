@@ -0,0 +1,242 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the window table class implementation
+ */
+
+#include "wintable.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * Grows the arrays by one block and pads it with empty rectangles.
+ *
+ * @return Non-0 if allocation failed
+ */
+static int
+b3_wintable_grow(b3_wintable_t *wintable);
+
+/**
+ * Resets the padding from index to the capacity to empty rectangles, which
+ * contain no point.
+ */
+static void
+b3_wintable_pad(b3_wintable_t *wintable, int index);
+
+b3_wintable_t *
+b3_wintable_new(void)
+{
+  b3_wintable_t *wintable;
+
+  wintable = malloc(sizeof(b3_wintable_t));
+  if (wintable) {
+    memset(wintable, 0, sizeof(b3_wintable_t));
+  }
+
+  return wintable;
+}
+
+int
+b3_wintable_free(b3_wintable_t *wintable)
+{
+  free(wintable->left_arr);
+  free(wintable->top_arr);
+  free(wintable->right_arr);
+  free(wintable->bottom_arr);
+  free(wintable->win_arr);
+
+  free(wintable);
+  return 0;
+}
+
+int
+b3_wintable_clear(b3_wintable_t *wintable)
+{
+  b3_wintable_pad(wintable, 0);
+  wintable->len = 0;
+  return 0;
+}
+
+int
+b3_wintable_add(b3_wintable_t *wintable, b3_win_t *win)
+{
+  RECT rect;
+
+  if (wintable->len == wintable->cap && b3_wintable_grow(wintable)) {
+    return 1;
+  }
+
+  rect = b3_win_get_rect(win);
+  wintable->left_arr[wintable->len] = rect.left;
+  wintable->top_arr[wintable->len] = rect.top;
+  wintable->right_arr[wintable->len] = rect.right;
+  wintable->bottom_arr[wintable->len] = rect.bottom;
+  wintable->win_arr[wintable->len] = win;
+  wintable->len++;
+
+  return 0;
+}
+
+int
+b3_wintable_find(const b3_wintable_t *wintable, const POINT *position)
+{
+  int i;
+#if defined(__AVX2__)
+  __m256i x;
+  __m256i y;
+  __m256i outside;
+  __m256i inside;
+  int mask;
+
+  /**
+   * A point is inside if left <= x < right and top <= y < bottom, like
+   * PtInRect()
+   */
+  x = _mm256_set1_epi32(position->x);
+  y = _mm256_set1_epi32(position->y);
+  for (i = 0; i < wintable->len; i += 8) {
+    outside = _mm256_or_si256(_mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i *) (wintable->left_arr + i)), x),
+                              _mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i *) (wintable->top_arr + i)), y));
+    inside = _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i *) (wintable->right_arr + i)), x),
+                              _mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i *) (wintable->bottom_arr + i)), y));
+    mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_andnot_si256(outside, inside)));
+    if (mask) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+#elif defined(__SSE2__)
+  __m128i x;
+  __m128i y;
+  __m128i outside;
+  __m128i inside;
+  int mask;
+
+  /**
+   * A point is inside if left <= x < right and top <= y < bottom, like
+   * PtInRect()
+   */
+  x = _mm_set1_epi32(position->x);
+  y = _mm_set1_epi32(position->y);
+  for (i = 0; i < wintable->len; i += 4) {
+    outside = _mm_or_si128(_mm_cmpgt_epi32(_mm_loadu_si128((const __m128i *) (wintable->left_arr + i)), x),
+                           _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i *) (wintable->top_arr + i)), y));
+    inside = _mm_and_si128(_mm_cmpgt_epi32(_mm_loadu_si128((const __m128i *) (wintable->right_arr + i)), x),
+                           _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i *) (wintable->bottom_arr + i)), y));
+    mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_andnot_si128(outside, inside)));
+    if (mask) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+#else
+  for (i = 0; i < wintable->len; i++) {
+    if (wintable->left_arr[i] <= position->x && position->x < wintable->right_arr[i]
+        && wintable->top_arr[i] <= position->y && position->y < wintable->bottom_arr[i]) {
+      return i;
+    }
+  }
+#endif
+
+  return -1;
+}
+
+b3_win_t *
+b3_wintable_get_win_at_pos(const b3_wintable_t *wintable, const POINT *position)
+{
+  int index;
+
+  index = b3_wintable_find(wintable, position);
+  if (index < 0) {
+    return NULL;
+  }
+
+  return wintable->win_arr[index];
+}
+
+int
+b3_wintable_grow(b3_wintable_t *wintable)
+{
+  int cap;
+  int *left_arr;
+  int *top_arr;
+  int *right_arr;
+  int *bottom_arr;
+  b3_win_t **win_arr;
+
+  cap = wintable->cap + B3_WINTABLE_BLOCK_LEN;
+
+  left_arr = realloc(wintable->left_arr, sizeof(int) * cap);
+  if (left_arr) {
+    wintable->left_arr = left_arr;
+  }
+  top_arr = realloc(wintable->top_arr, sizeof(int) * cap);
+  if (top_arr) {
+    wintable->top_arr = top_arr;
+  }
+  right_arr = realloc(wintable->right_arr, sizeof(int) * cap);
+  if (right_arr) {
+    wintable->right_arr = right_arr;
+  }
+  bottom_arr = realloc(wintable->bottom_arr, sizeof(int) * cap);
+  if (bottom_arr) {
+    wintable->bottom_arr = bottom_arr;
+  }
+  win_arr = realloc(wintable->win_arr, sizeof(b3_win_t *) * cap);
+  if (win_arr) {
+    wintable->win_arr = win_arr;
+  }
+
+  if (left_arr == NULL || top_arr == NULL || right_arr == NULL
+      || bottom_arr == NULL || win_arr == NULL) {
+    return 1;
+  }
+
+  wintable->cap = cap;
+  b3_wintable_pad(wintable, wintable->len);
+
+  return 0;
+}
+
+void
+b3_wintable_pad(b3_wintable_t *wintable, int index)
+{
+  int count;
+
+  count = wintable->cap - index;
+  if (count > 0) {
+    memset(wintable->left_arr + index, 0, sizeof(int) * count);
+    memset(wintable->top_arr + index, 0, sizeof(int) * count);
+    memset(wintable->right_arr + index, 0, sizeof(int) * count);
+    memset(wintable->bottom_arr + index, 0, sizeof(int) * count);
+  }
+}
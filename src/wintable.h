@@ -0,0 +1,115 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the window table class definition
+ *
+ * The window table keeps the rectangles of the visible windows as a structure
+ * of arrays, one array per edge. A point is tested against several windows at
+ * once with SSE2 or AVX2, whichever the build targets, otherwise one window
+ * after the other. The windows are stored from the top to the bottom of the
+ * z-order, the first window containing a point is the one under it.
+ */
+
+#ifndef B3_WINTABLE_H
+#define B3_WINTABLE_H
+
+#include <windows.h>
+
+#include "win.h"
+
+/**
+ * The arrays are padded with empty rectangles to a multiple of this, so they
+ * can always be read in full vectors.
+ */
+#define B3_WINTABLE_BLOCK_LEN 8
+
+typedef struct b3_wintable_s
+{
+  /**
+   * The edges of the windows' rectangles, as in RECT
+   */
+  int *left_arr;
+  int *top_arr;
+  int *right_arr;
+  int *bottom_arr;
+
+  /**
+   * The windows are not owned by the table
+   */
+  b3_win_t **win_arr;
+
+  int len;
+
+  /**
+   * Always a multiple of B3_WINTABLE_BLOCK_LEN
+   */
+  int cap;
+} b3_wintable_t;
+
+/**
+ * @brief Creates a new, empty window table
+ * @return A new window table or NULL if allocation failed
+ */
+extern b3_wintable_t *
+b3_wintable_new(void);
+
+/**
+ * @brief Frees a window table. The windows are not freed.
+ * @return Non-0 if the freeing failed
+ */
+extern int
+b3_wintable_free(b3_wintable_t *wintable);
+
+/**
+ * @brief Removes all windows from the table.
+ */
+extern int
+b3_wintable_clear(b3_wintable_t *wintable);
+
+/**
+ * @brief Adds a window below all windows already added. Its current rectangle
+ * is copied.
+ * @param win It will not be freed by the table.
+ * @return Non-0 if allocation failed
+ */
+extern int
+b3_wintable_add(b3_wintable_t *wintable, b3_win_t *win);
+
+/**
+ * @return The index of the topmost window containing position or -1 if there
+ * is none.
+ */
+extern int
+b3_wintable_find(const b3_wintable_t *wintable, const POINT *position);
+
+/**
+ * @return The topmost window containing position or NULL if there is none.
+ */
+extern b3_win_t *
+b3_wintable_get_win_at_pos(const b3_wintable_t *wintable, const POINT *position);
+
+#endif // B3_WINTABLE_H
@@ -147,6 +147,23 @@ b3_ws_arrange_wins_visitor(b3_winman_t *winman, void *data);
 static b3_win_t *
 b3_ws_get_win_at_pos_impl(b3_ws_t *ws, POINT *position);
 
+static int
+b3_ws_set_urgent_impl(b3_ws_t *ws, char urgent);
+
+static char
+b3_ws_is_urgent_impl(b3_ws_t *ws);
+
+static int
+b3_ws_fill_wintable_impl(b3_ws_t *ws, b3_wintable_t *wintable);
+
+/**
+ * Visitor used in b3_ws_fill_wintable_impl() to add the window of each leaf.
+ *
+ * @param data The window table
+ */
+static void
+b3_ws_fill_wintable_visitor(b3_winman_t *winman, void *data);
+
 b3_ws_t *
 b3_ws_new(const char *name)
 {
@@ -172,6 +189,9 @@ b3_ws_new(const char *name)
 		ws->b3_ws_get_win_rel_to_focused_win = b3_ws_get_win_rel_to_focused_win_impl;
 		ws->b3_ws_arrange_wins = b3_ws_arrange_wins_impl;
 		ws->b3_ws_get_win_at_pos = b3_ws_get_win_at_pos_impl;
+		ws->b3_ws_set_urgent = b3_ws_set_urgent_impl;
+		ws->b3_ws_is_urgent = b3_ws_is_urgent_impl;
+		ws->b3_ws_fill_wintable = b3_ws_fill_wintable_impl;
 
 		ws->winman = b3_winman_new(HORIZONTAL);
 		ws->mode = DEFAULT;
@@ -180,6 +200,7 @@ b3_ws_new(const char *name)
 		ws->focused_win_tree = NULL;
 		cc_array_new(&(ws->previously_focused_win_arr));
 		cc_array_new(&(ws->floating_win_arr));
+		ws->urgent = 0;
 	}
 
 	return ws;
@@ -283,6 +304,24 @@ b3_ws_get_win_at_pos(b3_ws_t *ws, POINT *position)
 	return ws->b3_ws_get_win_at_pos(ws, position);
 }
 
+int
+b3_ws_set_urgent(b3_ws_t *ws, char urgent)
+{
+	return ws->b3_ws_set_urgent(ws, urgent);
+}
+
+int
+b3_ws_fill_wintable(b3_ws_t *ws, b3_wintable_t *wintable)
+{
+	return ws->b3_ws_fill_wintable(ws, wintable);
+}
+
+char
+b3_ws_is_urgent(b3_ws_t *ws)
+{
+	return ws->b3_ws_is_urgent(ws);
+}
+
 int
 b3_ws_free_impl(b3_ws_t *ws)
 {
@@ -1212,3 +1251,34 @@ b3_ws_get_win_at_pos_impl(b3_ws_t *ws, POINT *position)
 {
 	return b3_winman_get_win_at_pos(ws->winman, position);
 }
+
+int
+b3_ws_set_urgent_impl(b3_ws_t *ws, char urgent)
+{
+	ws->urgent = urgent;
+	return 0;
+}
+
+char
+b3_ws_is_urgent_impl(b3_ws_t *ws)
+{
+	return ws->urgent;
+}
+
+int
+b3_ws_fill_wintable_impl(b3_ws_t *ws, b3_wintable_t *wintable)
+{
+	b3_winman_traverse(ws->winman, b3_ws_fill_wintable_visitor, wintable);
+	return 0;
+}
+
+void
+b3_ws_fill_wintable_visitor(b3_winman_t *winman, void *data)
+{
+	b3_win_t *win;
+
+	win = b3_winman_get_win(winman);
+	if (win) {
+		b3_wintable_add((b3_wintable_t *) data, win);
+	}
+}
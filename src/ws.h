@@ -38,6 +38,7 @@
 #include "counter.h"
 #include "winman.h"
 #include "win.h"
+#include "wintable.h"
 
 typedef enum b3_ws_move_direction_s
 {
@@ -68,6 +69,9 @@ struct b3_ws_s {
 												   char rolling);
 	int (*b3_ws_arrange_wins)(b3_ws_t *ws, RECT monitor_area);
 	b3_win_t *(*b3_ws_get_win_at_pos)(b3_ws_t *ws, POINT *position);
+	int (*b3_ws_set_urgent)(b3_ws_t *ws, char urgent);
+	char (*b3_ws_is_urgent)(b3_ws_t *ws);
+	int (*b3_ws_fill_wintable)(b3_ws_t *ws, b3_wintable_t *wintable);
 
 	b3_winman_t *winman;
 
@@ -105,6 +109,12 @@ struct b3_ws_s {
 	 * CC_Array containing the floating windows.
 	 */
 	CC_Array *floating_win_arr;
+
+	/**
+	 * Non-0 if a window of the workspace demands attention and the workspace
+	 * was not focused since then.
+	 */
+	char urgent;
 };
 
 /**
@@ -250,4 +260,23 @@ b3_ws_arrange_wins(b3_ws_t *ws, RECT monitor_area);
 extern b3_win_t *
 b3_ws_get_win_at_pos(b3_ws_t *ws, POINT *position);
 
+/**
+ * Marks the workspace as demanding attention (or not).
+ */
+extern int
+b3_ws_set_urgent(b3_ws_t *ws, char urgent);
+
+/**
+ * @return Non-0 if a window of the workspace demands attention.
+ */
+extern char
+b3_ws_is_urgent(b3_ws_t *ws);
+
+/**
+ * Adds the tiled windows of the workspace to a window table, in the order
+ * b3_ws_get_win_at_pos() searches them.
+ */
+extern int
+b3_ws_fill_wintable(b3_ws_t *ws, b3_wintable_t *wintable);
+
 #endif // B3_WS_H
@@ -346,7 +346,7 @@ b3_wsman_get_ws_arr(b3_wsman_t *wsman)
 }
 
 int
-b3_wsman_iterate_ws_arr(b3_wsman_t *wsman, void (*visitor)(b3_ws_t *ws))
+b3_wsman_iterate_ws_arr(b3_wsman_t *wsman, void (*visitor)(b3_ws_t *ws, void *data), void *data)
 {
   CC_ArrayIter iter;
 	b3_ws_t *ws;
@@ -355,7 +355,7 @@ b3_wsman_iterate_ws_arr(b3_wsman_t *wsman, void (*visitor)(b3_ws_t *ws))
 
 	cc_array_iter_init(&iter, b3_wsman_get_ws_arr(wsman));
 	while (cc_array_iter_next(&iter, (void*) &ws) != CC_ITER_END) {
-    visitor(ws);
+    visitor(ws, data);
   }
 
 	ReleaseMutex(wsman->global_mutex);
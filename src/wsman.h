@@ -134,9 +134,10 @@ b3_wsman_remove_empty_ws(b3_wsman_t *wsman);
  * same time as this method is thread safe.
  *
  * @param visitor A function that will visit each workspace.
+ * @param data Passed to each call of visitor
  */
 extern int
-b3_wsman_iterate_ws_arr(b3_wsman_t *wsman, void (*visitor)(b3_ws_t *ws));
+b3_wsman_iterate_ws_arr(b3_wsman_t *wsman, void (*visitor)(b3_ws_t *ws, void *data), void *data);
 
 /**
  * @return Returns the window at position. If no window can be found at the
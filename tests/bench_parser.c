@@ -0,0 +1,217 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the parser benchmark
+ *
+ * Usage: bench_parser [binding_len [rule_len [iteration_len]]]
+ *
+ * Parses a generated configuration and reports the parse time, the peak memory
+ * and the number of allocations made by b3 during parsing. The allocations are
+ * counted by wrapping malloc(), calloc(), realloc() and strdup() at link time,
+ * so allocations inside of other DLLs are not counted.
+ */
+
+#include <windows.h>
+#include <psapi.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <collectc/cc_array.h>
+#include <w32bindkeys/kbman.h>
+
+#include "config_gen.h"
+
+#include "../src/parser.h"
+#include "../src/director.h"
+#include "../src/rule.h"
+#include "../src/monitor_factory.h"
+#include "../src/wsman_factory.h"
+#include "../src/ws_factory.h"
+#include "../src/kc_director_factory.h"
+#include "../src/condition_factory.h"
+#include "../src/action_factory.h"
+
+#define B3_BENCH_PARSER_ITERATION_LEN 10
+
+static volatile LONG g_alloc_len = 0;
+
+extern void *
+__real_malloc(size_t size);
+
+extern void *
+__real_calloc(size_t nmemb, size_t size);
+
+extern void *
+__real_realloc(void *ptr, size_t size);
+
+extern char *
+__real_strdup(const char *s);
+
+void *
+__wrap_malloc(size_t size)
+{
+	InterlockedIncrement(&g_alloc_len);
+	return __real_malloc(size);
+}
+
+void *
+__wrap_calloc(size_t nmemb, size_t size)
+{
+	InterlockedIncrement(&g_alloc_len);
+	return __real_calloc(nmemb, size);
+}
+
+void *
+__wrap_realloc(void *ptr, size_t size)
+{
+	InterlockedIncrement(&g_alloc_len);
+	return __real_realloc(ptr, size);
+}
+
+char *
+__wrap_strdup(const char *s)
+{
+	InterlockedIncrement(&g_alloc_len);
+	return __real_strdup(s);
+}
+
+int
+main(int argc, char **argv)
+{
+	int error;
+	int binding_len;
+	int rule_len;
+	int iteration_len;
+	char *config;
+	b3_ws_factory_t *ws_factory;
+	b3_wsman_factory_t *wsman_factory;
+	b3_monitor_factory_t *monitor_factory;
+	b3_kc_director_factory_t *kc_director_factory;
+	b3_condition_factory_t *condition_factory;
+	b3_action_factory_t *action_factory;
+	b3_parser_t *parser;
+	b3_director_t *director;
+	wbk_kbman_t *kbman;
+	CC_Array *rule_arr;
+	b3_rule_t *rule;
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER start;
+	LARGE_INTEGER end;
+	double elapsed;
+	double elapsed_min;
+	double elapsed_sum;
+	LONG alloc_len;
+	PROCESS_MEMORY_COUNTERS memory_counters;
+	SIZE_T working_set_before;
+	int i;
+
+	error = 0;
+	binding_len = argc > 1 ? atoi(argv[1]) : B3_CONFIG_GEN_BINDING_LEN;
+	rule_len = argc > 2 ? atoi(argv[2]) : B3_CONFIG_GEN_RULE_LEN;
+	iteration_len = argc > 3 ? atoi(argv[3]) : B3_BENCH_PARSER_ITERATION_LEN;
+	if (binding_len < 0 || rule_len < 0 || iteration_len <= 0) {
+		fprintf(stderr, "Usage: %s [binding_len [rule_len [iteration_len]]]\n", argv[0]);
+		return 1;
+	}
+
+	config = b3_config_gen(binding_len, rule_len);
+
+	ws_factory = b3_ws_factory_new();
+	wsman_factory = b3_wsman_factory_new(ws_factory);
+	monitor_factory = b3_monitor_factory_new(wsman_factory);
+	kc_director_factory = b3_kc_director_factory_new();
+	condition_factory = b3_condition_factory_new();
+	action_factory = b3_action_factory_new();
+	parser = b3_parser_new(kc_director_factory, condition_factory, action_factory);
+	director = b3_director_new(monitor_factory);
+
+	QueryPerformanceFrequency(&frequency);
+	GetProcessMemoryInfo(GetCurrentProcess(), &memory_counters, sizeof(memory_counters));
+	working_set_before = memory_counters.WorkingSetSize;
+
+	printf("Configuration: %d key bindings, %d rules, %lu bytes\n",
+		   binding_len, rule_len, (unsigned long) strlen(config));
+
+	elapsed_min = 0;
+	elapsed_sum = 0;
+	alloc_len = 0;
+	for (i = 0; !error && i < iteration_len; i++) {
+		cc_array_new(&rule_arr);
+
+		InterlockedExchange(&g_alloc_len, 0);
+		QueryPerformanceCounter(&start);
+		kbman = b3_parser_parse_str_staged(parser, director, config, rule_arr);
+		QueryPerformanceCounter(&end);
+		alloc_len = InterlockedExchange(&g_alloc_len, 0);
+
+		if (kbman == NULL) {
+			fprintf(stderr, "Could not parse the generated configuration\n");
+			error = 1;
+		}
+
+		if (!error) {
+			elapsed = (double) (end.QuadPart - start.QuadPart) * 1000.0 / frequency.QuadPart;
+			elapsed_sum += elapsed;
+			if (i == 0 || elapsed < elapsed_min) {
+				elapsed_min = elapsed;
+			}
+
+			wbk_kbman_free(kbman);
+		}
+
+		while (cc_array_remove_last(rule_arr, (void*) &rule) == CC_OK) {
+			b3_rule_free(rule);
+		}
+		cc_array_destroy(rule_arr);
+	}
+
+	if (!error) {
+		GetProcessMemoryInfo(GetCurrentProcess(), &memory_counters, sizeof(memory_counters));
+
+		printf("Parse time: %.3f ms min, %.3f ms mean over %d iterations\n",
+			   elapsed_min, elapsed_sum / iteration_len, iteration_len);
+		printf("Allocations per parse: %ld\n", (long) alloc_len);
+		printf("Peak working set: %lu KiB (%lu KiB before parsing)\n",
+			   (unsigned long) (memory_counters.PeakWorkingSetSize / 1024),
+			   (unsigned long) (working_set_before / 1024));
+		printf("Peak pagefile usage: %lu KiB\n",
+			   (unsigned long) (memory_counters.PeakPagefileUsage / 1024));
+	}
+
+	b3_director_free(director);
+	b3_parser_free(parser);
+	b3_action_factory_free(action_factory);
+	b3_condition_factory_free(condition_factory);
+	b3_kc_director_factory_free(kc_director_factory);
+	b3_monitor_factory_free(monitor_factory);
+	b3_wsman_factory_free(wsman_factory);
+	b3_ws_factory_free(ws_factory);
+
+	free(config);
+
+	return error;
+}
@@ -0,0 +1,235 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the synthetic configuration generator implementation
+ */
+
+#include "config_gen.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+typedef struct b3_config_gen_buffer_s
+{
+	char *str;
+	size_t len;
+	size_t capacity;
+} b3_config_gen_buffer_t;
+
+static const char *g_modifier_arr[] = {
+	"Mod4", "Mod1", "Shift", "Ctrl", "Space", "Return",
+	"F1", "F2", "F3", "F4", "F5", "F6", "F7", "F8", "F9", "F10", "F11", "F12"
+};
+
+static const char g_key_arr[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+
+static const char *g_direction_arr[] = { "up", "down", "left", "right" };
+
+static int
+b3_config_gen_append(b3_config_gen_buffer_t *buffer, const char *format, ...);
+
+static int
+b3_config_gen_binding(b3_config_gen_buffer_t *buffer, int index);
+
+static int
+b3_config_gen_rule(b3_config_gen_buffer_t *buffer, int index);
+
+char *
+b3_config_gen(int binding_len, int rule_len)
+{
+	b3_config_gen_buffer_t buffer;
+	int i;
+
+	buffer.len = 0;
+	buffer.capacity = 64 * (binding_len + rule_len) + 1;
+	buffer.str = malloc(sizeof(char) * buffer.capacity);
+	buffer.str[0] = '\0';
+
+	b3_config_gen_append(&buffer, "# Generated configuration with %d key bindings and %d rules\n",
+						 binding_len, rule_len);
+
+	for (i = 0; i < binding_len; i++) {
+		if (i % 100 == 0) {
+			b3_config_gen_append(&buffer, "\n# Key bindings from %d on\n", i);
+		}
+
+		b3_config_gen_binding(&buffer, i);
+	}
+
+	for (i = 0; i < rule_len; i++) {
+		if (i % 100 == 0) {
+			b3_config_gen_append(&buffer, "\n# Rules from %d on\n", i);
+		}
+
+		b3_config_gen_rule(&buffer, i);
+	}
+
+	return buffer.str;
+}
+
+int
+b3_config_gen_append(b3_config_gen_buffer_t *buffer, const char *format, ...)
+{
+	va_list args;
+	int len;
+
+	va_start(args, format);
+	len = vsnprintf(NULL, 0, format, args);
+	va_end(args);
+
+	if (buffer->len + len + 1 > buffer->capacity) {
+		buffer->capacity = 2 * (buffer->len + len + 1);
+		buffer->str = realloc(buffer->str, sizeof(char) * buffer->capacity);
+	}
+
+	va_start(args, format);
+	vsnprintf(buffer->str + buffer->len, len + 1, format, args);
+	va_end(args);
+
+	buffer->len += len;
+
+	return 0;
+}
+
+int
+b3_config_gen_binding(b3_config_gen_buffer_t *buffer, int index)
+{
+	int modifier_mask;
+	const char *direction;
+	int i;
+
+	/**
+	 * The key and the set of modifiers make each binding distinct
+	 */
+	b3_config_gen_append(buffer, "bindsym ");
+
+	modifier_mask = index / (sizeof(g_key_arr) - 1);
+	for (i = 0; modifier_mask; i++, modifier_mask >>= 1) {
+		if (modifier_mask & 1) {
+			b3_config_gen_append(buffer, "%s+", g_modifier_arr[i]);
+		}
+	}
+
+	b3_config_gen_append(buffer, "%c ", g_key_arr[index % (sizeof(g_key_arr) - 1)]);
+
+	direction = g_direction_arr[index % 4];
+	switch (index % 13) {
+	case 0:
+		b3_config_gen_append(buffer, "focus %s\n", direction);
+		break;
+
+	case 1:
+		b3_config_gen_append(buffer, "focus output %s\n", direction);
+		break;
+
+	case 2:
+		b3_config_gen_append(buffer, "move %s\n", direction);
+		break;
+
+	case 3:
+		b3_config_gen_append(buffer, "move container to output %s\n", direction);
+		break;
+
+	case 4:
+		b3_config_gen_append(buffer, "move container to workspace ws%d\n", index % 50);
+		break;
+
+	case 5:
+		b3_config_gen_append(buffer, "move workspace to output %s\n", direction);
+		break;
+
+	case 6:
+		b3_config_gen_append(buffer, "workspace ws%d\n", index % 50);
+		break;
+
+	case 7:
+		b3_config_gen_append(buffer, "kill\n");
+		break;
+
+	case 8:
+		b3_config_gen_append(buffer, "floating toggle\n");
+		break;
+
+	case 9:
+		b3_config_gen_append(buffer, "fullscreen toggle\n");
+		break;
+
+	case 10:
+		b3_config_gen_append(buffer, "split %c\n", index % 2 ? 'h' : 'v');
+		break;
+
+	case 11:
+		b3_config_gen_append(buffer, "exec cmd.exe /c \"echo binding %d, %s\"\n", index, direction);
+		break;
+
+	default:
+		b3_config_gen_append(buffer, "exec --no-startup-id notepad.exe C:\\config\\%d.txt\n", index);
+		break;
+	}
+
+	return 0;
+}
+
+int
+b3_config_gen_rule(b3_config_gen_buffer_t *buffer, int index)
+{
+	b3_config_gen_append(buffer, "for_window [");
+
+	switch (index % 3) {
+	case 0:
+		b3_config_gen_append(buffer, "title=\".*Window %d.*\"", index);
+		break;
+
+	case 1:
+		b3_config_gen_append(buffer, "class=\"App%dClass\"", index);
+		break;
+
+	default:
+		b3_config_gen_append(buffer, "class=\"App%dClass\" title=\"^Dialog [0-9]+$\"", index);
+		break;
+	}
+
+	b3_config_gen_append(buffer, "] ");
+
+	switch (index % 3) {
+	case 0:
+		b3_config_gen_append(buffer, "floating enable\n");
+		break;
+
+	case 1:
+		b3_config_gen_append(buffer, "move container to workspace ws%d\n", index % 50);
+		break;
+
+	default:
+		b3_config_gen_append(buffer, "floating enable, move container to workspace ws%d\n", index % 50);
+		break;
+	}
+
+	return 0;
+}
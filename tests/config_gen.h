@@ -0,0 +1,57 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the definition of the synthetic configuration generator
+ *
+ * The generated configurations use every command of the grammar. They are
+ * used to benchmark the parser and to seed the fuzzer.
+ */
+
+#ifndef B3_CONFIG_GEN_H
+#define B3_CONFIG_GEN_H
+
+/**
+ * Number of key bindings of a large configuration
+ */
+#define B3_CONFIG_GEN_BINDING_LEN 10000
+
+/**
+ * Number of for_window rules of a large configuration
+ */
+#define B3_CONFIG_GEN_RULE_LEN 5000
+
+/**
+ * @brief Generates a configuration. The same arguments always generate the
+ * same configuration. All key bindings are distinct.
+ * @param binding_len Number of key bindings. At most 36 * 2^18.
+ * @param rule_len Number of for_window rules.
+ * @return The configuration. Free it by yourself!
+ */
+extern char *
+b3_config_gen(int binding_len, int rule_len);
+
+#endif // B3_CONFIG_GEN_H
@@ -0,0 +1,159 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the parser fuzzing harness
+ *
+ * The harness is built on Linux by the Makefile next to it, against the Win32
+ * and w32bindkeys shim in shim/. Defining B3_FUZZ_LIBFUZZER builds
+ * LLVMFuzzerTestOneInput() only, so that the harness can be linked with
+ * -fsanitize=fuzzer. Otherwise a main() is built, which runs every file passed
+ * on the command line through the harness. The configurations in tests/ are
+ * the seed corpus.
+ *
+ * The parser runs without a director, so the key bindings and the rules are
+ * built but never executed.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <collectc/cc_array.h>
+#include <w32bindkeys/kbman.h>
+#include <w32bindkeys/logger.h>
+
+#include "parser.h"
+#include "rule.h"
+#include "kc_director_factory.h"
+#include "condition_factory.h"
+#include "action_factory.h"
+
+static b3_parser_t *g_parser = NULL;
+
+static int
+b3_fuzz_parser_setup(void);
+
+extern int
+LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+int
+LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	char *config;
+	wbk_kbman_t *kbman;
+	CC_Array *rule_arr;
+	b3_rule_t *rule;
+
+	if (g_parser == NULL) {
+		b3_fuzz_parser_setup();
+	}
+
+	/**
+	 * The parser expects a terminated string
+	 */
+	config = malloc(sizeof(char) * (size + 1));
+	memcpy(config, data, size);
+	config[size] = '\0';
+
+	cc_array_new(&rule_arr);
+
+	kbman = b3_parser_parse_str_staged(g_parser, NULL, config, rule_arr);
+	if (kbman) {
+		wbk_kbman_free(kbman);
+	}
+
+	while (cc_array_remove_last(rule_arr, (void*) &rule) == CC_OK) {
+		b3_rule_free(rule);
+	}
+	cc_array_destroy(rule_arr);
+
+	free(config);
+
+	return 0;
+}
+
+int
+b3_fuzz_parser_setup(void)
+{
+	/**
+	 * Most inputs are no valid configuration, the syntax errors would drown
+	 * the findings of the sanitizers.
+	 */
+	wbk_logger_set_level(SEVERE + 1);
+
+	/**
+	 * The parser lives as long as the fuzzer
+	 */
+	g_parser = b3_parser_new(b3_kc_director_factory_new(),
+							 b3_condition_factory_new(),
+							 b3_action_factory_new());
+
+	return 0;
+}
+
+#ifndef B3_FUZZ_LIBFUZZER
+int
+main(int argc, char **argv)
+{
+	int error;
+	FILE *file;
+	uint8_t *data;
+	long size;
+	int i;
+
+	error = 0;
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s FILE...\n", argv[0]);
+		error = 1;
+	}
+
+	for (i = 1; !error && i < argc; i++) {
+		file = fopen(argv[i], "rb");
+		if (file == NULL) {
+			fprintf(stderr, "Could not open %s\n", argv[i]);
+			error = 1;
+		}
+
+		if (!error) {
+			fseek(file, 0, SEEK_END);
+			size = ftell(file);
+			fseek(file, 0, SEEK_SET);
+
+			data = malloc(size > 0 ? size : 1);
+			size = fread(data, 1, size, file);
+			fclose(file);
+
+			printf("Running %s (%ld bytes)\n", argv[i], size);
+			LLVMFuzzerTestOneInput(data, size);
+
+			free(data);
+		}
+	}
+
+	return error;
+}
+#endif
@@ -0,0 +1,257 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the window manager functions of the fuzzing shim
+ *
+ * The fuzzer parses with no director, so none of the functions are called.
+ * They are referenced by key commands and rules, which the fuzzer never
+ * executes, and abort to tell if this ever changes.
+ */
+
+#include <stdlib.h>
+
+#include "director.h"
+#include "launchman.h"
+#include "monitor.h"
+#include "win.h"
+#include "ws.h"
+
+int
+b3_director_active_win_toggle_floating(b3_director_t *director)
+{
+	abort();
+}
+
+int
+b3_director_add_rule(b3_director_t *director, b3_rule_t *rule)
+{
+	abort();
+}
+
+int
+b3_director_begin_transaction(b3_director_t *director)
+{
+	abort();
+}
+
+int
+b3_director_close_active_win(b3_director_t *director)
+{
+	abort();
+}
+
+int
+b3_director_commit_transaction(b3_director_t *director)
+{
+	abort();
+}
+
+b3_win_t *
+b3_director_copy_focused_win(b3_director_t *director)
+{
+	abort();
+}
+
+int
+b3_director_dump_rule_profile(b3_director_t *director)
+{
+	abort();
+}
+
+b3_monitor_t *
+b3_director_get_focused_monitor(b3_director_t *director)
+{
+	abort();
+}
+
+b3_launchman_t *
+b3_director_get_launchman(b3_director_t *director)
+{
+	abort();
+}
+
+CC_Array *
+b3_director_get_monitor_arr(b3_director_t *director)
+{
+	abort();
+}
+
+int
+b3_director_move_active_win(b3_director_t *director, b3_ws_move_direction_t direction)
+{
+	abort();
+}
+
+int
+b3_director_move_active_win_to_ws(b3_director_t *director, const char *ws_id)
+{
+	abort();
+}
+
+int
+b3_director_move_focused_win_to_monitor_by_dir(b3_director_t *director, b3_ws_move_direction_t direction)
+{
+	abort();
+}
+
+int
+b3_director_move_focused_ws_to_monitor_by_dir(b3_director_t *director, b3_ws_move_direction_t direction)
+{
+	abort();
+}
+
+int
+b3_director_move_win_to_ws(b3_director_t *director, b3_win_t *win, const char *ws_id)
+{
+	abort();
+}
+
+int
+b3_director_reload(b3_director_t *director)
+{
+	abort();
+}
+
+int
+b3_director_set_active_win_by_direction(b3_director_t *director, b3_ws_move_direction_t direction)
+{
+	abort();
+}
+
+int
+b3_director_set_focused_monitor_by_direction(b3_director_t *director, b3_ws_move_direction_t direction)
+{
+	abort();
+}
+
+int
+b3_director_set_focused_monitor_by_name(b3_director_t *director, const char *monitor_name)
+{
+	abort();
+}
+
+int
+b3_director_split(b3_director_t *director, b3_winman_mode_t mode)
+{
+	abort();
+}
+
+int
+b3_director_switch_mode(b3_director_t *director, const char *mode_name)
+{
+	abort();
+}
+
+int
+b3_director_switch_to_ws(b3_director_t *director, const char *ws_id)
+{
+	abort();
+}
+
+int
+b3_director_toggle_active_win_fullscreen(b3_director_t *director)
+{
+	abort();
+}
+
+int
+b3_launch_free(b3_launch_t *launch)
+{
+	abort();
+}
+
+b3_launch_t *
+b3_launch_new(const char *ws_name, const char *monitor_name, DWORD timeout)
+{
+	abort();
+}
+
+int
+b3_launchman_launch(b3_launchman_t *launchman, char *cmd, b3_launch_t *launch)
+{
+	abort();
+}
+
+b3_ws_t *
+b3_monitor_find_win(b3_monitor_t *monitor, const b3_win_t *win)
+{
+	abort();
+}
+
+b3_ws_t *
+b3_monitor_get_focused_ws(b3_monitor_t *monitor)
+{
+	abort();
+}
+
+RECT
+b3_monitor_get_monitor_area(b3_monitor_t *monitor)
+{
+	abort();
+}
+
+const char *
+b3_monitor_get_monitor_name(b3_monitor_t *monitor)
+{
+	abort();
+}
+
+int
+b3_win_cache_attrs(b3_win_t *win)
+{
+	abort();
+}
+
+int
+b3_win_free(b3_win_t *win)
+{
+	abort();
+}
+
+const char *
+b3_win_get_class_name(b3_win_t *win)
+{
+	abort();
+}
+
+const char *
+b3_win_get_title(b3_win_t *win)
+{
+	abort();
+}
+
+const char *
+b3_ws_get_name(b3_ws_t *ws)
+{
+	abort();
+}
+
+int
+b3_ws_toggle_floating_win(b3_ws_t *ws, b3_win_t *win)
+{
+	abort();
+}
@@ -0,0 +1,357 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the w32bindkeys functions of the fuzzing shim
+ *
+ * The headers are the ones of w32bindkeys shipped in src/w32bindkeys. Only
+ * the functions, which the parser and its factories call, are implemented.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <w32bindkeys/b.h>
+#include <w32bindkeys/be.h>
+#include <w32bindkeys/kbman.h>
+#include <w32bindkeys/kc.h>
+#include <w32bindkeys/logger.h>
+#include <w32bindkeys/util.h>
+
+static wbk_loglevel_t g_loglevel = DEBUG;
+
+static wbk_kc_t *
+wbk_kc_clone_impl(const wbk_kc_t *other);
+
+static int
+wbk_kc_free_impl(wbk_kc_t *kc);
+
+static const wbk_b_t *
+wbk_kc_get_binding_impl(const wbk_kc_t *kc);
+
+static int
+wbk_kc_exec_impl(const wbk_kc_t *kc);
+
+wbk_be_t *
+wbk_be_new(wbk_mk_t modifier, char key)
+{
+	wbk_be_t *be;
+
+	be = malloc(sizeof(wbk_be_t));
+	if (be) {
+		be->modifier = modifier;
+		be->key = key;
+	}
+
+	return be;
+}
+
+int
+wbk_be_free(wbk_be_t *be)
+{
+	free(be);
+
+	return 0;
+}
+
+wbk_b_t *
+wbk_b_new()
+{
+	wbk_b_t *b;
+
+	b = malloc(sizeof(wbk_b_t));
+	if (b) {
+		memset(b, 0, sizeof(wbk_b_t));
+	}
+
+	return b;
+}
+
+wbk_b_t *
+wbk_b_clone(const wbk_b_t *other)
+{
+	wbk_b_t *b;
+
+	b = malloc(sizeof(wbk_b_t));
+	if (b) {
+		memcpy(b, other, sizeof(wbk_b_t));
+	}
+
+	return b;
+}
+
+int
+wbk_b_free(wbk_b_t *b)
+{
+	free(b);
+
+	return 0;
+}
+
+int
+wbk_b_add(wbk_b_t *b, const wbk_be_t *be)
+{
+	int error;
+
+	error = 0;
+
+	if (be->modifier != NOT_A_MODIFIER) {
+		if (be->modifier >= WBK_B_MODIFER_MAP_LEN || b->modifier_map[be->modifier]) {
+			error = 1;
+		} else {
+			b->modifier_map[be->modifier] = be->modifier;
+		}
+	} else {
+		if (b->key_map[(unsigned char) be->key]) {
+			error = 1;
+		} else {
+			b->key_map[(unsigned char) be->key] = 1;
+		}
+	}
+
+	return error;
+}
+
+int
+wbk_b_compare(const wbk_b_t *b, const wbk_b_t *other)
+{
+	return memcmp(b, other, sizeof(wbk_b_t));
+}
+
+char *
+wbk_b_to_str(const wbk_b_t *b)
+{
+	char *str;
+	int length;
+	int i;
+
+	/**
+	 * Every element takes at most four characters and a plus
+	 */
+	str = malloc(sizeof(char) * (WBK_B_MODIFER_MAP_LEN + WBK_B_KEY_MAP_LEN) * 5 + 1);
+	if (str) {
+		length = 0;
+		for (i = 0; i < WBK_B_MODIFER_MAP_LEN; i++) {
+			if (b->modifier_map[i]) {
+				length += sprintf(str + length, "%s%d", length ? "+" : "", i);
+			}
+		}
+		for (i = 0; i < WBK_B_KEY_MAP_LEN; i++) {
+			if (b->key_map[i]) {
+				length += sprintf(str + length, "%s%c", length ? "+" : "", i);
+			}
+		}
+		str[length] = '\0';
+	}
+
+	return str;
+}
+
+wbk_kc_t *
+wbk_kc_new(wbk_b_t *comb)
+{
+	wbk_kc_t *kc;
+
+	kc = malloc(sizeof(wbk_kc_t));
+	if (kc) {
+		kc->kc_clone = wbk_kc_clone_impl;
+		kc->kc_free = wbk_kc_free_impl;
+		kc->kc_get_binding = wbk_kc_get_binding_impl;
+		kc->kc_exec = wbk_kc_exec_impl;
+
+		kc->binding = comb;
+	}
+
+	return kc;
+}
+
+wbk_kc_t *
+wbk_kc_clone(const wbk_kc_t *other)
+{
+	return other->kc_clone(other);
+}
+
+int
+wbk_kc_free(wbk_kc_t *kc)
+{
+	return kc->kc_free(kc);
+}
+
+const wbk_b_t *
+wbk_kc_get_binding(const wbk_kc_t *kc)
+{
+	return kc->kc_get_binding(kc);
+}
+
+int
+wbk_kc_exec(const wbk_kc_t *kc)
+{
+	return kc->kc_exec(kc);
+}
+
+wbk_kbman_t *
+wbk_kbman_new()
+{
+	wbk_kbman_t *kbman;
+
+	kbman = malloc(sizeof(wbk_kbman_t));
+	if (kbman) {
+		memset(kbman, 0, sizeof(wbk_kbman_t));
+		kbman->kbman_free = wbk_kbman_free;
+		kbman->kbman_add = wbk_kbman_add;
+	}
+
+	return kbman;
+}
+
+wbk_kbman_t *
+wbk_kbman_free(wbk_kbman_t *kbman)
+{
+	int i;
+
+	for (i = 0; i < kbman->kc_arr_len; i++) {
+		wbk_kc_free(kbman->kc_arr[i]);
+	}
+	free(kbman->kc_arr);
+	free(kbman);
+
+	return NULL;
+}
+
+int
+wbk_kbman_add(wbk_kbman_t *kbman, wbk_kc_t *kc)
+{
+	wbk_kc_t **kc_arr;
+	int error;
+
+	error = 0;
+
+	kc_arr = realloc(kbman->kc_arr, sizeof(wbk_kc_t *) * (kbman->kc_arr_len + 1));
+	if (kc_arr == NULL) {
+		error = 1;
+	}
+
+	if (!error) {
+		kbman->kc_arr = kc_arr;
+		kbman->kc_arr[kbman->kc_arr_len] = kc;
+		kbman->kc_arr_len++;
+	}
+
+	return error;
+}
+
+int
+wbk_logger_set_level(wbk_loglevel_t level)
+{
+	g_loglevel = level;
+
+	return 0;
+}
+
+int
+wbk_logger_log(wbk_logger_t *logger, wbk_loglevel_t level, const char *fmt, ...)
+{
+	char msg[1024];
+	va_list args;
+
+	/**
+	 * The message is formatted in any case, so its arguments are checked by the
+	 * sanitizers even if the fuzzer keeps quiet.
+	 */
+	va_start(args, fmt);
+	vsnprintf(msg, sizeof(msg), fmt, args);
+	va_end(args);
+
+	if (level >= g_loglevel) {
+		fprintf(stderr, "%s: %s", logger->name, msg);
+	}
+
+	return 0;
+}
+
+char *
+wbk_path_from_home(const char *relative_path)
+{
+	const char *home;
+	char *path;
+
+	path = NULL;
+
+	home = getenv("HOME");
+	if (home) {
+		path = malloc(sizeof(char) * (strlen(home) + strlen(relative_path) + 2));
+	}
+
+	if (path) {
+		sprintf(path, "%s/%s", home, relative_path);
+	}
+
+	return path;
+}
+
+wbk_kc_t *
+wbk_kc_clone_impl(const wbk_kc_t *other)
+{
+	wbk_b_t *comb;
+	wbk_kc_t *kc;
+
+	kc = NULL;
+
+	comb = wbk_b_clone(other->binding);
+	if (comb) {
+		kc = wbk_kc_new(comb);
+		if (kc == NULL) {
+			wbk_b_free(comb);
+		}
+	}
+
+	return kc;
+}
+
+int
+wbk_kc_free_impl(wbk_kc_t *kc)
+{
+	wbk_b_free(kc->binding);
+	free(kc);
+
+	return 0;
+}
+
+const wbk_b_t *
+wbk_kc_get_binding_impl(const wbk_kc_t *kc)
+{
+	return kc->binding;
+}
+
+int
+wbk_kc_exec_impl(const wbk_kc_t *kc)
+{
+	/**
+	 * The fuzzer parses key bindings, it never executes them
+	 */
+	abort();
+}
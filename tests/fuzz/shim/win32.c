@@ -0,0 +1,448 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the Win32 functions of the fuzzing shim
+ *
+ * Mutexes are recursive and owned by the locking thread, like the ones of
+ * Win32. Unlocking a mutex of another thread fails instead of corrupting it.
+ */
+
+#define _GNU_SOURCE
+
+#include <glob.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "windows.h"
+
+typedef enum b3_shim_handle_kind_e
+{
+	B3_SHIM_THREAD = 0,
+	B3_SHIM_MUTEX,
+	B3_SHIM_SEMAPHORE,
+	B3_SHIM_FIND
+} b3_shim_handle_kind_t;
+
+typedef struct b3_shim_handle_s
+{
+	b3_shim_handle_kind_t kind;
+
+	pthread_t thread;
+	LPTHREAD_START_ROUTINE start;
+	LPVOID param;
+
+	pthread_mutex_t mutex;
+
+	pthread_cond_t cond;
+	LONG count;
+	LONG maximum_count;
+
+	glob_t glob;
+	size_t glob_index;
+} b3_shim_handle_t;
+
+static void *
+b3_shim_thread_start(void *param);
+
+static b3_shim_handle_t *
+b3_shim_handle_new(b3_shim_handle_kind_t kind);
+
+/**
+ * Fills the find data with the glob entry at the index of the handle.
+ *
+ * @return 0 if there was an entry left. Non-0 otherwise.
+ */
+static int
+b3_shim_find_fill(b3_shim_handle_t *handle, WIN32_FIND_DATA *find_data);
+
+HANDLE
+CreateThread(void *attributes, size_t stack_size, LPTHREAD_START_ROUTINE start,
+             LPVOID param, DWORD flags, LPDWORD thread_id)
+{
+	b3_shim_handle_t *handle;
+
+	handle = b3_shim_handle_new(B3_SHIM_THREAD);
+	if (handle) {
+		handle->start = start;
+		handle->param = param;
+		if (pthread_create(&handle->thread, NULL, b3_shim_thread_start, handle)) {
+			free(handle);
+			handle = NULL;
+		}
+	}
+
+	return handle;
+}
+
+HANDLE
+CreateMutex(void *attributes, BOOL initial_owner, LPCSTR name)
+{
+	b3_shim_handle_t *handle;
+	pthread_mutexattr_t mutex_attr;
+
+	handle = b3_shim_handle_new(B3_SHIM_MUTEX);
+	if (handle) {
+		pthread_mutexattr_init(&mutex_attr);
+		pthread_mutexattr_settype(&mutex_attr, PTHREAD_MUTEX_RECURSIVE);
+		pthread_mutex_init(&handle->mutex, &mutex_attr);
+		pthread_mutexattr_destroy(&mutex_attr);
+
+		if (initial_owner) {
+			pthread_mutex_lock(&handle->mutex);
+		}
+	}
+
+	return handle;
+}
+
+BOOL
+ReleaseMutex(HANDLE mutex)
+{
+	b3_shim_handle_t *handle;
+
+	handle = (b3_shim_handle_t *) mutex;
+
+	return pthread_mutex_unlock(&handle->mutex) == 0;
+}
+
+HANDLE
+CreateSemaphore(void *attributes, LONG initial_count, LONG maximum_count, LPCSTR name)
+{
+	b3_shim_handle_t *handle;
+
+	handle = b3_shim_handle_new(B3_SHIM_SEMAPHORE);
+	if (handle) {
+		pthread_mutex_init(&handle->mutex, NULL);
+		pthread_cond_init(&handle->cond, NULL);
+		handle->count = initial_count;
+		handle->maximum_count = maximum_count;
+	}
+
+	return handle;
+}
+
+BOOL
+ReleaseSemaphore(HANDLE semaphore, LONG release_count, LONG *previous_count)
+{
+	b3_shim_handle_t *handle;
+	BOOL success;
+
+	handle = (b3_shim_handle_t *) semaphore;
+	success = TRUE;
+
+	pthread_mutex_lock(&handle->mutex);
+	if (previous_count) {
+		*previous_count = handle->count;
+	}
+	if (release_count <= 0 || release_count > handle->maximum_count - handle->count) {
+		success = FALSE;
+	} else {
+		handle->count += release_count;
+		pthread_cond_broadcast(&handle->cond);
+	}
+	pthread_mutex_unlock(&handle->mutex);
+
+	return success;
+}
+
+DWORD
+WaitForSingleObject(HANDLE object, DWORD milliseconds)
+{
+	b3_shim_handle_t *handle;
+	DWORD result;
+
+	handle = (b3_shim_handle_t *) object;
+	result = WAIT_OBJECT_0;
+
+	if (milliseconds != INFINITE) {
+		/**
+		 * The parser waits for its objects only
+		 */
+		abort();
+	}
+
+	switch (handle->kind) {
+	case B3_SHIM_THREAD:
+		if (pthread_join(handle->thread, NULL)) {
+			result = WAIT_FAILED;
+		}
+		break;
+
+	case B3_SHIM_MUTEX:
+		if (pthread_mutex_lock(&handle->mutex)) {
+			result = WAIT_FAILED;
+		}
+		break;
+
+	case B3_SHIM_SEMAPHORE:
+		pthread_mutex_lock(&handle->mutex);
+		while (handle->count == 0) {
+			pthread_cond_wait(&handle->cond, &handle->mutex);
+		}
+		handle->count--;
+		pthread_mutex_unlock(&handle->mutex);
+		break;
+
+	default:
+		result = WAIT_FAILED;
+	}
+
+	return result;
+}
+
+DWORD
+WaitForMultipleObjects(DWORD count, const HANDLE *handle_arr, BOOL wait_all, DWORD milliseconds)
+{
+	DWORD result;
+	DWORD i;
+
+	result = WAIT_OBJECT_0;
+
+	if (!wait_all) {
+		abort();
+	}
+
+	for (i = 0; result != WAIT_FAILED && i < count; i++) {
+		result = WaitForSingleObject(handle_arr[i], milliseconds);
+	}
+
+	return result;
+}
+
+BOOL
+CloseHandle(HANDLE object)
+{
+	b3_shim_handle_t *handle;
+
+	handle = (b3_shim_handle_t *) object;
+
+	switch (handle->kind) {
+	case B3_SHIM_MUTEX:
+		pthread_mutex_destroy(&handle->mutex);
+		break;
+
+	case B3_SHIM_SEMAPHORE:
+		pthread_cond_destroy(&handle->cond);
+		pthread_mutex_destroy(&handle->mutex);
+		break;
+
+	default:
+		break;
+	}
+
+	free(handle);
+
+	return TRUE;
+}
+
+void
+GetSystemInfo(SYSTEM_INFO *system_info)
+{
+	long processors;
+
+	memset(system_info, 0, sizeof(SYSTEM_INFO));
+
+	processors = sysconf(_SC_NPROCESSORS_ONLN);
+	system_info->dwNumberOfProcessors = processors > 0 ? processors : 1;
+	system_info->dwPageSize = sysconf(_SC_PAGESIZE);
+}
+
+BOOL
+QueryPerformanceCounter(LARGE_INTEGER *count)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	count->QuadPart = (LONGLONG) now.tv_sec * 1000000000LL + now.tv_nsec;
+
+	return TRUE;
+}
+
+BOOL
+QueryPerformanceFrequency(LARGE_INTEGER *frequency)
+{
+	frequency->QuadPart = 1000000000LL;
+
+	return TRUE;
+}
+
+HANDLE
+FindFirstFile(LPCSTR pattern, WIN32_FIND_DATA *find_data)
+{
+	b3_shim_handle_t *handle;
+
+	handle = b3_shim_handle_new(B3_SHIM_FIND);
+	if (handle) {
+		if (glob(pattern, 0, NULL, &handle->glob)) {
+			free(handle);
+			handle = NULL;
+		} else if (b3_shim_find_fill(handle, find_data)) {
+			globfree(&handle->glob);
+			free(handle);
+			handle = NULL;
+		}
+	}
+
+	return handle ? handle : INVALID_HANDLE_VALUE;
+}
+
+BOOL
+FindNextFile(HANDLE object, WIN32_FIND_DATA *find_data)
+{
+	return b3_shim_find_fill((b3_shim_handle_t *) object, find_data) == 0;
+}
+
+BOOL
+FindClose(HANDLE object)
+{
+	b3_shim_handle_t *handle;
+
+	handle = (b3_shim_handle_t *) object;
+
+	globfree(&handle->glob);
+	free(handle);
+
+	return TRUE;
+}
+
+DWORD
+GetFullPathName(LPCSTR filename, DWORD buffer_len, LPSTR buffer, LPSTR *file_part)
+{
+	char full_path[PATH_MAX];
+	char cwd[PATH_MAX];
+	DWORD length;
+
+	length = 0;
+
+	/**
+	 * Like Win32, a path which does not exist is resolved as well.
+	 */
+	if (realpath(filename, full_path) == NULL) {
+		if (filename[0] == '/') {
+			length = snprintf(full_path, PATH_MAX, "%s", filename);
+		} else if (getcwd(cwd, PATH_MAX)) {
+			length = snprintf(full_path, PATH_MAX, "%s/%s", cwd, filename);
+		}
+	} else {
+		length = strlen(full_path);
+	}
+
+	if (length > 0 && length < PATH_MAX) {
+		if (buffer_len > length) {
+			memcpy(buffer, full_path, length + 1);
+		} else {
+			length++;
+		}
+	} else {
+		length = 0;
+	}
+
+	if (file_part) {
+		*file_part = NULL;
+	}
+
+	return length;
+}
+
+int
+lstrcmpi(LPCSTR string, LPCSTR other)
+{
+	return strcasecmp(string, other);
+}
+
+BOOL
+SetCursorPos(int x, int y)
+{
+	/**
+	 * The fuzzer parses key bindings, it never executes them
+	 */
+	abort();
+}
+
+void *
+b3_shim_thread_start(void *param)
+{
+	b3_shim_handle_t *handle;
+
+	handle = (b3_shim_handle_t *) param;
+	handle->start(handle->param);
+
+	return NULL;
+}
+
+b3_shim_handle_t *
+b3_shim_handle_new(b3_shim_handle_kind_t kind)
+{
+	b3_shim_handle_t *handle;
+
+	handle = malloc(sizeof(b3_shim_handle_t));
+	if (handle) {
+		memset(handle, 0, sizeof(b3_shim_handle_t));
+		handle->kind = kind;
+	}
+
+	return handle;
+}
+
+int
+b3_shim_find_fill(b3_shim_handle_t *handle, WIN32_FIND_DATA *find_data)
+{
+	const char *path;
+	const char *name;
+	struct stat path_stat;
+	int error;
+
+	error = 0;
+
+	if (handle->glob_index >= handle->glob.gl_pathc) {
+		error = 1;
+	}
+
+	if (!error) {
+		path = handle->glob.gl_pathv[handle->glob_index];
+		handle->glob_index++;
+
+		memset(find_data, 0, sizeof(WIN32_FIND_DATA));
+
+		name = strrchr(path, '/');
+		name = name ? name + 1 : path;
+		snprintf(find_data->cFileName, MAX_PATH, "%s", name);
+
+		if (stat(path, &path_stat) == 0 && S_ISDIR(path_stat.st_mode)) {
+			find_data->dwFileAttributes = FILE_ATTRIBUTE_DIRECTORY;
+		}
+	}
+
+	return error;
+}
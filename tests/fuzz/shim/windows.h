@@ -0,0 +1,294 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the subset of the Win32 API the parser needs to be
+ * built on Linux
+ *
+ * The header only declares what the parser, the factories and the headers
+ * they include use. Threads, mutexes and semaphores are implemented with
+ * POSIX threads in win32.c, see there. Functions which the parser never calls
+ * are declared for the headers only.
+ */
+
+#ifndef B3_FUZZ_WINDOWS_H
+#define B3_FUZZ_WINDOWS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <wchar.h>
+
+#define WINAPI
+#define CALLBACK
+
+#define TRUE 1
+#define FALSE 0
+
+#define INFINITE 0xFFFFFFFF
+#define WAIT_OBJECT_0 0
+#define WAIT_FAILED 0xFFFFFFFF
+
+#define MAX_PATH 260
+
+#define FILE_ATTRIBUTE_DIRECTORY 0x10
+
+typedef int BOOL;
+typedef unsigned char BYTE;
+typedef unsigned short WORD;
+typedef unsigned int UINT;
+typedef unsigned long DWORD;
+typedef long LONG;
+typedef long long LONGLONG;
+typedef unsigned long long ULONGLONG;
+typedef intptr_t LONG_PTR;
+typedef uintptr_t ULONG_PTR;
+typedef uintptr_t UINT_PTR;
+typedef uintptr_t DWORD_PTR;
+typedef DWORD COLORREF;
+typedef DWORD *LPDWORD;
+
+typedef void *PVOID;
+typedef void *LPVOID;
+typedef char *LPSTR;
+typedef const char *LPCSTR;
+typedef wchar_t *LPWSTR;
+typedef const wchar_t *LPCWSTR;
+
+typedef LONG_PTR LPARAM;
+typedef UINT_PTR WPARAM;
+typedef LONG_PTR LRESULT;
+
+typedef void *HANDLE;
+typedef struct HWND__ *HWND;
+typedef void *HINSTANCE;
+typedef void *HMODULE;
+typedef void *HMONITOR;
+typedef void *HDC;
+typedef void *HGDIOBJ;
+typedef void *HBITMAP;
+typedef void *HBRUSH;
+typedef void *HFONT;
+typedef void *HPEN;
+typedef void *HHOOK;
+
+#define INVALID_HANDLE_VALUE ((HANDLE) (LONG_PTR) -1)
+
+typedef union _LARGE_INTEGER
+{
+	struct
+	{
+		DWORD LowPart;
+		LONG HighPart;
+	};
+	LONGLONG QuadPart;
+} LARGE_INTEGER;
+
+typedef struct tagRECT
+{
+	LONG left;
+	LONG top;
+	LONG right;
+	LONG bottom;
+} RECT, *LPRECT;
+
+typedef struct tagPOINT
+{
+	LONG x;
+	LONG y;
+} POINT, *LPPOINT;
+
+typedef struct tagSIZE
+{
+	LONG cx;
+	LONG cy;
+} SIZE;
+
+typedef struct tagLOGFONT
+{
+	LONG lfHeight;
+	LONG lfWidth;
+	LONG lfWeight;
+	BYTE lfCharSet;
+	char lfFaceName[32];
+} LOGFONT;
+
+typedef struct _SYSTEM_INFO
+{
+	DWORD dwPageSize;
+	DWORD dwNumberOfProcessors;
+} SYSTEM_INFO;
+
+typedef struct _WIN32_FIND_DATA
+{
+	DWORD dwFileAttributes;
+	char cFileName[MAX_PATH];
+} WIN32_FIND_DATA;
+
+typedef struct _OVERLAPPED
+{
+	ULONG_PTR Internal;
+} OVERLAPPED, *LPOVERLAPPED;
+
+typedef DWORD (WINAPI *LPTHREAD_START_ROUTINE)(LPVOID param);
+
+/**
+ * Threads and synchronization
+ */
+
+extern HANDLE
+CreateThread(void *attributes, size_t stack_size, LPTHREAD_START_ROUTINE start,
+             LPVOID param, DWORD flags, LPDWORD thread_id);
+
+extern HANDLE
+CreateMutex(void *attributes, BOOL initial_owner, LPCSTR name);
+
+extern BOOL
+ReleaseMutex(HANDLE mutex);
+
+extern HANDLE
+CreateSemaphore(void *attributes, LONG initial_count, LONG maximum_count, LPCSTR name);
+
+extern BOOL
+ReleaseSemaphore(HANDLE semaphore, LONG release_count, LONG *previous_count);
+
+extern DWORD
+WaitForSingleObject(HANDLE handle, DWORD milliseconds);
+
+extern DWORD
+WaitForMultipleObjects(DWORD count, const HANDLE *handle_arr, BOOL wait_all, DWORD milliseconds);
+
+extern BOOL
+CloseHandle(HANDLE handle);
+
+extern void
+GetSystemInfo(SYSTEM_INFO *system_info);
+
+static inline LONG
+InterlockedIncrement(volatile LONG *value)
+{
+	return __atomic_add_fetch(value, 1, __ATOMIC_SEQ_CST);
+}
+
+static inline LONG
+InterlockedDecrement(volatile LONG *value)
+{
+	return __atomic_sub_fetch(value, 1, __ATOMIC_SEQ_CST);
+}
+
+static inline LONG
+InterlockedExchange(volatile LONG *target, LONG value)
+{
+	return __atomic_exchange_n(target, value, __ATOMIC_SEQ_CST);
+}
+
+static inline LONG
+InterlockedExchangeAdd(volatile LONG *target, LONG value)
+{
+	return __atomic_fetch_add(target, value, __ATOMIC_SEQ_CST);
+}
+
+static inline LONG
+InterlockedCompareExchange(volatile LONG *target, LONG value, LONG comparand)
+{
+	__atomic_compare_exchange_n(target, &comparand, value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	return comparand;
+}
+
+static inline LONGLONG
+InterlockedExchangeAdd64(volatile LONGLONG *target, LONGLONG value)
+{
+	return __atomic_fetch_add(target, value, __ATOMIC_SEQ_CST);
+}
+
+static inline LONGLONG
+InterlockedIncrement64(volatile LONGLONG *value)
+{
+	return __atomic_add_fetch(value, 1, __ATOMIC_SEQ_CST);
+}
+
+static inline LONGLONG
+InterlockedCompareExchange64(volatile LONGLONG *target, LONGLONG value, LONGLONG comparand)
+{
+	__atomic_compare_exchange_n(target, &comparand, value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	return comparand;
+}
+
+static inline LONGLONG
+InterlockedExchange64(volatile LONGLONG *target, LONGLONG value)
+{
+	return __atomic_exchange_n(target, value, __ATOMIC_SEQ_CST);
+}
+
+static inline PVOID
+InterlockedExchangePointer(PVOID volatile *target, PVOID value)
+{
+	return __atomic_exchange_n(target, value, __ATOMIC_SEQ_CST);
+}
+
+static inline PVOID
+InterlockedCompareExchangePointer(PVOID volatile *target, PVOID value, PVOID comparand)
+{
+	__atomic_compare_exchange_n(target, &comparand, value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+	return comparand;
+}
+
+/**
+ * Time
+ */
+
+extern BOOL
+QueryPerformanceCounter(LARGE_INTEGER *count);
+
+extern BOOL
+QueryPerformanceFrequency(LARGE_INTEGER *frequency);
+
+/**
+ * Files
+ */
+
+extern HANDLE
+FindFirstFile(LPCSTR pattern, WIN32_FIND_DATA *find_data);
+
+extern BOOL
+FindNextFile(HANDLE handle, WIN32_FIND_DATA *find_data);
+
+extern BOOL
+FindClose(HANDLE handle);
+
+extern DWORD
+GetFullPathName(LPCSTR filename, DWORD buffer_len, LPSTR buffer, LPSTR *file_part);
+
+extern int
+lstrcmpi(LPCSTR string, LPCSTR other);
+
+/**
+ * Windows. The parser does not call them.
+ */
+
+extern BOOL
+SetCursorPos(int x, int y);
+
+#endif // B3_FUZZ_WINDOWS_H
@@ -0,0 +1,250 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the tests for the key binding table class
+ */
+
+#include "../src/kbtable.h"
+
+#include "test.h"
+
+#include <stdlib.h>
+#include <w32bindkeys/be.h>
+
+#define B3_TEST_KBTABLE_MODIFIER_LEN 5
+
+static const wbk_mk_t g_modifier_arr[B3_TEST_KBTABLE_MODIFIER_LEN] = { WIN, ALT, SHIFT, CTRL, SPACE };
+
+static wbk_kbman_t *g_kbman;
+
+static void
+setup(void)
+{
+	g_kbman = wbk_kbman_new();
+}
+
+static void
+teardown(void)
+{
+	if (g_kbman) {
+		wbk_kbman_free(g_kbman);
+		g_kbman = NULL;
+	}
+}
+
+/**
+ * @param modifier_mask Bit i selects g_modifier_arr[i].
+ * @param key The key or 0 if the binding has none.
+ * @param reversed Adds the elements in reverse order.
+ */
+static wbk_b_t *
+create_b(int modifier_mask, char key, int reversed)
+{
+	wbk_b_t *b;
+	wbk_be_t *be;
+	int i;
+	int j;
+
+	b = wbk_b_new();
+
+	if (key && reversed) {
+		be = wbk_be_new(NOT_A_MODIFIER, key);
+		wbk_b_add(b, be);
+		wbk_be_free(be);
+	}
+
+	for (i = 0; i < B3_TEST_KBTABLE_MODIFIER_LEN; i++) {
+		j = reversed ? B3_TEST_KBTABLE_MODIFIER_LEN - 1 - i : i;
+		if (modifier_mask & (1 << j)) {
+			be = wbk_be_new(g_modifier_arr[j], 0);
+			wbk_b_add(b, be);
+			wbk_be_free(be);
+		}
+	}
+
+	if (key && !reversed) {
+		be = wbk_be_new(NOT_A_MODIFIER, key);
+		wbk_b_add(b, be);
+		wbk_be_free(be);
+	}
+
+	return b;
+}
+
+static wbk_kc_t *
+add_kc(int modifier_mask, char key)
+{
+	wbk_kc_t *kc;
+
+	kc = wbk_kc_new(create_b(modifier_mask, key, 0));
+	wbk_kbman_add(g_kbman, kc);
+
+	return kc;
+}
+
+static int
+check_find(b3_kbtable_t *kbtable, int modifier_mask, char key, wbk_kc_t *exp, char *msg)
+{
+	int error;
+	wbk_b_t *b;
+
+	b = create_b(modifier_mask, key, 1);
+	error = b3_test_check_void(b3_kbtable_find(kbtable, b), exp, msg);
+	wbk_b_free(b);
+
+	return error;
+}
+
+static int
+test_kbtable_find(void)
+{
+	int error;
+	b3_kbtable_t *kbtable;
+	wbk_kc_t *win_a;
+	wbk_kc_t *win_shift_a;
+	wbk_kc_t *alt_a;
+	wbk_kc_t *win;
+
+	error = 0;
+
+	win_a = add_kc(1, 'a');
+	win_shift_a = add_kc(1 | 4, 'a');
+	alt_a = add_kc(2, 'a');
+	win = add_kc(1, 0);
+
+	kbtable = b3_kbtable_new(g_kbman);
+	g_kbman = NULL;
+
+	if (!error) {
+		error = b3_test_check_int(kbtable->key_len, 4, "all combinations are stored");
+	}
+
+	if (!error) {
+		error = check_find(kbtable, 1, 'a', win_a, "a combination is found");
+	}
+
+	if (!error) {
+		error = check_find(kbtable, 1 | 4, 'a', win_shift_a, "the order of the elements does not matter");
+	}
+
+	if (!error) {
+		error = check_find(kbtable, 2, 'a', alt_a, "modifiers are told apart");
+	}
+
+	if (!error) {
+		error = check_find(kbtable, 1, 0, win, "a combination without a key is found");
+	}
+
+	if (!error) {
+		error = check_find(kbtable, 8, 'a', NULL, "an unbound combination is not found");
+	}
+
+	if (!error) {
+		error = check_find(kbtable, 1, 'b', NULL, "keys are told apart");
+	}
+
+	b3_kbtable_free(kbtable);
+
+	return error;
+}
+
+static int
+test_kbtable_first_wins(void)
+{
+	int error;
+	b3_kbtable_t *kbtable;
+	wbk_kc_t *first;
+
+	error = 0;
+
+	first = add_kc(1, 'a');
+	add_kc(1, 'a');
+
+	kbtable = b3_kbtable_new(g_kbman);
+	g_kbman = NULL;
+
+	if (!error) {
+		error = b3_test_check_int(kbtable->key_len, 1, "a combination is stored once");
+	}
+
+	if (!error) {
+		error = check_find(kbtable, 1, 'a', first, "the first key command takes effect");
+	}
+
+	b3_kbtable_free(kbtable);
+
+	return error;
+}
+
+static int
+test_kbtable_many(void)
+{
+	int error;
+	const char key_arr[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+	wbk_kc_t **kc_arr;
+	b3_kbtable_t *kbtable;
+	int kc_arr_len;
+	int modifier_mask;
+	int i;
+
+	error = 0;
+	kc_arr_len = (sizeof(key_arr) - 1) << B3_TEST_KBTABLE_MODIFIER_LEN;
+	kc_arr = malloc(sizeof(wbk_kc_t *) * kc_arr_len);
+
+	for (i = 0; i < kc_arr_len; i++) {
+		kc_arr[i] = add_kc(i & ((1 << B3_TEST_KBTABLE_MODIFIER_LEN) - 1),
+						   key_arr[i >> B3_TEST_KBTABLE_MODIFIER_LEN]);
+	}
+
+	kbtable = b3_kbtable_new(g_kbman);
+	g_kbman = NULL;
+
+	if (!error) {
+		error = b3_test_check_int(kbtable->key_len, kc_arr_len, "all combinations are stored");
+	}
+
+	for (i = 0; !error && i < kc_arr_len; i++) {
+		modifier_mask = i & ((1 << B3_TEST_KBTABLE_MODIFIER_LEN) - 1);
+		error = check_find(kbtable, modifier_mask, key_arr[i >> B3_TEST_KBTABLE_MODIFIER_LEN],
+						   kc_arr[i], "every combination is found");
+	}
+
+	b3_kbtable_free(kbtable);
+	free(kc_arr);
+
+	return error;
+}
+
+int
+main(void)
+{
+	b3_test(setup, teardown, test_kbtable_find, "test_kbtable_find");
+	b3_test(setup, teardown, test_kbtable_first_wins, "test_kbtable_first_wins");
+	b3_test(setup, teardown, test_kbtable_many, "test_kbtable_many");
+
+	return 0;
+}
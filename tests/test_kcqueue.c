@@ -0,0 +1,224 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the tests for the key command queue class
+ */
+
+#include "../src/kcqueue.h"
+
+#include "test.h"
+
+#include <string.h>
+
+#define B3_TEST_KCQUEUE_KC_LEN (B3_KCQUEUE_LEN + 2)
+
+/**
+ * Maximum time to wait for the worker in milliseconds
+ */
+#define B3_TEST_KCQUEUE_TIMEOUT 5000
+
+typedef struct b3_test_kc_s
+{
+	wbk_kc_t kc;
+	int id;
+} b3_test_kc_t;
+
+static b3_test_kc_t g_kc_arr[B3_TEST_KCQUEUE_KC_LEN];
+
+static int g_exec_arr[B3_TEST_KCQUEUE_KC_LEN];
+
+static volatile LONG g_exec_len;
+
+/**
+ * As long as it is set, the key command with id 0 blocks the worker.
+ */
+static volatile LONG g_blocked;
+
+static volatile LONG g_users;
+
+static b3_kcqueue_t *g_kcqueue;
+
+static int
+exec(const wbk_kc_t *kc)
+{
+	const b3_test_kc_t *test_kc;
+
+	test_kc = (const b3_test_kc_t *) kc;
+
+	while (test_kc->id == 0 && InterlockedCompareExchange(&g_blocked, 0, 0)) {
+		Sleep(1);
+	}
+
+	g_exec_arr[InterlockedIncrement(&g_exec_len) - 1] = test_kc->id;
+
+	return 0;
+}
+
+static void
+setup(void)
+{
+	int i;
+
+	memset(g_kc_arr, 0, sizeof(g_kc_arr));
+	for (i = 0; i < B3_TEST_KCQUEUE_KC_LEN; i++) {
+		g_kc_arr[i].kc.kc_exec = exec;
+		g_kc_arr[i].id = i;
+	}
+
+	memset(g_exec_arr, 0, sizeof(g_exec_arr));
+	g_exec_len = 0;
+	g_blocked = 0;
+	g_users = 0;
+
+	g_kcqueue = b3_kcqueue_new();
+}
+
+static void
+teardown(void)
+{
+	if (g_kcqueue) {
+		b3_kcqueue_free(g_kcqueue);
+		g_kcqueue = NULL;
+	}
+}
+
+/**
+ * @return Non-0 if the worker did not execute all pushed key commands in time.
+ */
+static int
+wait_for_users(void)
+{
+	int waited;
+
+	waited = 0;
+	while (InterlockedCompareExchange(&g_users, 0, 0) > 0 && waited < B3_TEST_KCQUEUE_TIMEOUT) {
+		Sleep(1);
+		waited++;
+	}
+
+	return b3_test_check_int(InterlockedCompareExchange(&g_users, 0, 0), 0,
+							 "the worker releases every key command");
+}
+
+static int
+push(int id)
+{
+	int error;
+
+	InterlockedIncrement(&g_users);
+	error = b3_kcqueue_push(g_kcqueue, &(g_kc_arr[id].kc), &g_users);
+	if (error) {
+		InterlockedDecrement(&g_users);
+	}
+
+	return error;
+}
+
+static int
+test_kcqueue_order(void)
+{
+	int error;
+	int i;
+
+	error = 0;
+
+	for (i = 0; !error && i < B3_KCQUEUE_LEN; i++) {
+		error = b3_test_check_int(push(i), 0, "a key command is pushed");
+	}
+
+	if (!error) {
+		error = wait_for_users();
+	}
+
+	if (!error) {
+		error = b3_test_check_int(g_exec_len, B3_KCQUEUE_LEN, "every key command is executed");
+	}
+
+	for (i = 0; !error && i < B3_KCQUEUE_LEN; i++) {
+		error = b3_test_check_int(g_exec_arr[i], i, "key commands are executed in order");
+	}
+
+	return error;
+}
+
+static int
+test_kcqueue_full(void)
+{
+	int error;
+	int waited;
+	int i;
+
+	error = 0;
+	g_blocked = 1;
+
+	if (!error) {
+		error = b3_test_check_int(push(0), 0, "the blocking key command is pushed");
+	}
+
+	/**
+	 * Waits until the worker popped the blocking key command
+	 */
+	waited = 0;
+	while (InterlockedCompareExchange(&(g_kcqueue->head), 0, 0) == 0 && waited < B3_TEST_KCQUEUE_TIMEOUT) {
+		Sleep(1);
+		waited++;
+	}
+
+	for (i = 1; !error && i <= B3_KCQUEUE_LEN; i++) {
+		error = b3_test_check_int(push(i), 0, "the queue takes its capacity");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(push(B3_KCQUEUE_LEN + 1) != 0, 1, "a full queue refuses a key command");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(g_kcqueue->dropped_len, 1, "the refused key command is counted");
+	}
+
+	InterlockedExchange(&g_blocked, 0);
+
+	if (!error) {
+		error = wait_for_users();
+	}
+
+	if (!error) {
+		error = b3_test_check_int(g_exec_len, B3_KCQUEUE_LEN + 1, "the refused key command is not executed");
+	}
+
+	return error;
+}
+
+int
+main(void)
+{
+	b3_test(setup, teardown, test_kcqueue_order, "test_kcqueue_order");
+	b3_test(setup, teardown, test_kcqueue_full, "test_kcqueue_full");
+
+	return 0;
+}
@@ -0,0 +1,331 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the tests for the launch manager class
+ */
+
+#include "../src/launchman.h"
+
+#include "test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define B3_TEST_LAUNCHMAN_LAUNCH_LEN 1000
+
+/**
+ * Maximum time to wait for the worker in milliseconds
+ */
+#define B3_TEST_LAUNCHMAN_TIMEOUT 5000
+
+static b3_launchman_t *g_launchman;
+
+static void
+setup(void)
+{
+	g_launchman = b3_launchman_new();
+}
+
+static void
+teardown(void)
+{
+	if (g_launchman) {
+		b3_launchman_free(g_launchman);
+		g_launchman = NULL;
+	}
+}
+
+/**
+ * @return The id of the new launch.
+ */
+static ULONG_PTR
+add(DWORD process_id, const char *ws_name, DWORD timeout)
+{
+	return b3_launchman_add(g_launchman, process_id, NULL,
+							b3_launch_new(ws_name, "monitor", timeout));
+}
+
+/**
+ * @param ws_name The expected workspace or NULL if the process has no launch.
+ */
+static int
+check_claim(DWORD process_id, const char *ws_name, char *msg)
+{
+	b3_launch_t *launch;
+	int error;
+
+	launch = b3_launchman_claim(g_launchman, process_id);
+	if (ws_name == NULL || launch == NULL) {
+		error = b3_test_check_void(launch ? (void *) b3_launch_get_ws_name(launch) : NULL,
+								   (void *) ws_name, msg);
+	} else {
+		error = b3_test_check_int(strcmp(b3_launch_get_ws_name(launch), ws_name), 0, msg);
+	}
+
+	if (launch) {
+		b3_launch_free(launch);
+	}
+
+	return error;
+}
+
+static int
+test_launchman_claim(void)
+{
+	int error;
+
+	error = 0;
+
+	if (!error) {
+		error = b3_test_check_int(add(100, "2", B3_LAUNCH_TIMEOUT) != 0, 1,
+								  "a launch is added");
+	}
+
+	if (!error) {
+		error = check_claim(104, NULL, "an unknown process has no launch");
+	}
+
+	if (!error) {
+		error = check_claim(100, "2", "the launched process has the workspace of the launch");
+	}
+
+	if (!error) {
+		error = check_claim(100, NULL, "a launch is claimed once");
+	}
+
+	return error;
+}
+
+static int
+test_launchman_children(void)
+{
+	ULONG_PTR id;
+	int error;
+
+	error = 0;
+	id = add(100, "3", B3_LAUNCH_TIMEOUT);
+
+	if (!error) {
+		error = b3_test_check_int(b3_launchman_add_process(g_launchman, id, 104), 0,
+								  "a child is added to a pending launch");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_launchman_add_process(g_launchman, id, 108), 0,
+								  "another child is added to a pending launch");
+	}
+
+	if (!error) {
+		b3_launchman_remove_process(g_launchman, 104);
+		error = check_claim(104, NULL, "an exited child has no launch");
+	}
+
+	if (!error) {
+		error = check_claim(108, "3", "a child has the workspace of the launch");
+	}
+
+	if (!error) {
+		error = check_claim(100, NULL, "claiming a child resolves the whole launch");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_launchman_add_process(g_launchman, id, 112) != 0, 1,
+								  "a child is not added to a resolved launch");
+	}
+
+	return error;
+}
+
+static int
+test_launchman_many(void)
+{
+	char ws_name[16];
+	int error;
+	int i;
+
+	error = 0;
+
+	for (i = 0; !error && i < B3_TEST_LAUNCHMAN_LAUNCH_LEN; i++) {
+		sprintf(ws_name, "%d", i);
+		error = b3_test_check_int(add(4 * i + 4, ws_name, B3_LAUNCH_TIMEOUT) != 0, 1,
+								  "a launch is added");
+	}
+
+	/**
+	 * Removing every other process moves the remaining entries of the table
+	 */
+	for (i = 1; !error && i < B3_TEST_LAUNCHMAN_LAUNCH_LEN; i += 2) {
+		b3_launchman_remove_process(g_launchman, 4 * i + 4);
+	}
+
+	for (i = 0; !error && i < B3_TEST_LAUNCHMAN_LAUNCH_LEN; i++) {
+		sprintf(ws_name, "%d", i);
+		error = check_claim(4 * i + 4, i % 2 ? NULL : ws_name,
+							"every remaining process is found after removals");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(g_launchman->process_id_len, 0, "no process is left");
+	}
+
+	return error;
+}
+
+static int
+test_launchman_job_msg(void)
+{
+	ULONG_PTR id;
+	b3_launch_t *claimed;
+	int waited;
+	int error;
+
+	error = 0;
+	id = add(100, "4", B3_LAUNCH_TIMEOUT);
+
+	/**
+	 * Windows reports processes joining the job of a launch to the worker
+	 */
+	PostQueuedCompletionStatus(g_launchman->port, JOB_OBJECT_MSG_NEW_PROCESS, id, (LPOVERLAPPED) 104);
+
+	claimed = NULL;
+	waited = 0;
+	while (claimed == NULL && waited < B3_TEST_LAUNCHMAN_TIMEOUT) {
+		claimed = b3_launchman_claim(g_launchman, 104);
+		if (claimed == NULL) {
+			Sleep(1);
+			waited++;
+		}
+	}
+
+	if (!error) {
+		error = b3_test_check_int(claimed != NULL, 1, "the worker adds a new process of a job");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(strcmp(b3_launch_get_ws_name(claimed), "4"), 0,
+								  "the new process has the workspace of the launch");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(strcmp(b3_launch_get_monitor_name(claimed), "monitor"), 0,
+								  "the new process has the monitor of the launch");
+	}
+
+	if (claimed) {
+		b3_launch_free(claimed);
+	}
+
+	return error;
+}
+
+static int
+test_launchman_expire(void)
+{
+	ULONGLONG now;
+	int error;
+
+	error = 0;
+	now = GetTickCount64();
+
+	/**
+	 * The deadlines lie in the future, so the worker does not interfere
+	 */
+	add(100, "5", 4 * B3_LAUNCHMAN_TICK);
+	add(104, "6", 10 * B3_LAUNCHMAN_TICK);
+
+	/**
+	 * Outlasts a whole round of the timer wheel
+	 */
+	add(108, "7", 3 * B3_LAUNCHMAN_WHEEL_LEN * B3_LAUNCHMAN_TICK / 2);
+
+	if (!error) {
+		error = b3_test_check_int(b3_launchman_expire(g_launchman, now + 5 * B3_LAUNCHMAN_TICK), 1,
+								  "a launch expires at its deadline");
+	}
+
+	if (!error) {
+		error = check_claim(100, NULL, "an expired launch is not found");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_launchman_expire(g_launchman, now + 11 * B3_LAUNCHMAN_TICK), 1,
+								  "a later launch expires later");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_launchman_expire(g_launchman,
+													  now + B3_LAUNCHMAN_WHEEL_LEN * B3_LAUNCHMAN_TICK + 12 * B3_LAUNCHMAN_TICK), 0,
+								  "a launch of a later round of the wheel does not expire early");
+	}
+
+	if (!error) {
+		error = check_claim(108, "7", "a launch is found until its deadline");
+	}
+
+	return error;
+}
+
+static int
+test_launchman_expire_worker(void)
+{
+	int waited;
+	int error;
+
+	error = 0;
+
+	add(100, "8", 1);
+
+	/**
+	 * The worker wakes up for the deadline on its own
+	 */
+	waited = 0;
+	while (cc_array_size(g_launchman->launch_arr) > 0 && waited < B3_TEST_LAUNCHMAN_TIMEOUT) {
+		Sleep(1);
+		waited++;
+	}
+
+	if (!error) {
+		error = b3_test_check_int(cc_array_size(g_launchman->launch_arr), 0, "the worker expires a launch");
+	}
+
+	return error;
+}
+
+int
+main(void)
+{
+	b3_test(setup, teardown, test_launchman_claim, "test_launchman_claim");
+	b3_test(setup, teardown, test_launchman_children, "test_launchman_children");
+	b3_test(setup, teardown, test_launchman_many, "test_launchman_many");
+	b3_test(setup, teardown, test_launchman_job_msg, "test_launchman_job_msg");
+	b3_test(setup, teardown, test_launchman_expire, "test_launchman_expire");
+	b3_test(setup, teardown, test_launchman_expire_worker, "test_launchman_expire_worker");
+
+	return 0;
+}
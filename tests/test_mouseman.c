@@ -0,0 +1,226 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the tests for the mouse manager and its mouse commands
+ */
+
+#include "../src/mouseman.h"
+#include "../src/mousedaemon.h"
+#include "../src/mc_focus.h"
+#include "../src/director.h"
+#include "../src/win.h"
+
+#include "test.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static b3_mouseman_t *g_mouseman;
+
+/**
+ * Only provides the window at a position
+ */
+static b3_director_t g_director;
+
+static b3_win_t *g_win_a;
+
+static b3_win_t *g_win_b;
+
+static int g_exec_count;
+
+static POINT g_exec_position;
+
+static int g_focus_count;
+
+static b3_win_t *g_focus_win;
+
+static int
+exec(b3_mc_t *mc, POINT *position)
+{
+	g_exec_count++;
+	g_exec_position = *position;
+	return 0;
+}
+
+/**
+ * Window a is left of x = 100, window b right of x = 200
+ */
+static b3_win_t *
+get_win_at_pos(b3_director_t *director, POINT *position)
+{
+	if (position->x < 100) {
+		return g_win_a;
+	} else if (position->x > 200) {
+		return g_win_b;
+	}
+	return NULL;
+}
+
+static int
+focus_win(b3_director_t *director, b3_win_t *win)
+{
+	g_focus_count++;
+	g_focus_win = win;
+	return 0;
+}
+
+static void
+setup(void)
+{
+	g_mouseman = b3_mouseman_new();
+
+	memset(&g_director, 0, sizeof(b3_director_t));
+	g_director.global_mutex = CreateMutex(NULL, FALSE, NULL);
+	g_director.b3_director_get_win_at_pos = get_win_at_pos;
+
+	g_win_a = b3_win_new((HWND) 1, 0);
+	g_win_b = b3_win_new((HWND) 2, 0);
+
+	g_exec_count = 0;
+	g_focus_count = 0;
+	g_focus_win = NULL;
+}
+
+static void
+teardown(void)
+{
+	b3_mouseman_free(g_mouseman);
+	g_mouseman = NULL;
+
+	b3_win_free(g_win_a);
+	b3_win_free(g_win_b);
+
+	CloseHandle(g_director.global_mutex);
+}
+
+/**
+ * Moves the cursor to x
+ */
+static int
+move(LONG x)
+{
+	POINT position;
+
+	position.x = x;
+	position.y = 10;
+	return b3_mouseman_exec(g_mouseman, &position);
+}
+
+static int
+test_mouseman_exec(void)
+{
+	int error;
+	b3_mc_t *mc;
+	int i;
+
+	for (i = 0; i < 2; i++) {
+		mc = b3_mc_new();
+		mc->b3_mc_exec = exec;
+		b3_mouseman_add(g_mouseman, mc);
+	}
+
+	error = move(42);
+
+	if (!error) {
+		error = b3_test_check_int(g_exec_count, 2, "every mouse command is executed");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(g_exec_position.x, 42, "the position is passed");
+	}
+
+	return error;
+}
+
+static int
+test_mc_focus(void)
+{
+	int error;
+	b3_mc_t *mc;
+
+	mc = b3_mc_focus_new(&g_director);
+	((b3_mc_focus_t *) mc)->b3_mc_focus_win = focus_win;
+	b3_mouseman_add(g_mouseman, mc);
+
+	move(10);
+	error = b3_test_check_int(g_focus_count, 1, "entering a window focuses it");
+
+	if (!error) {
+		error = b3_test_check_void(g_focus_win, g_win_a, "the window under the cursor is focused");
+	}
+
+	if (!error) {
+		move(20);
+		error = b3_test_check_int(g_focus_count, 1, "the focus does not change without another target");
+	}
+
+	if (!error) {
+		move(150);
+		move(30);
+		error = b3_test_check_int(g_focus_count, 2, "returning from outside of the windows focuses again");
+	}
+
+	if (!error) {
+		move(250);
+		error = b3_test_check_int(g_focus_count, 3, "entering another window focuses it");
+	}
+
+	if (!error) {
+		error = b3_test_check_void(g_focus_win, g_win_b, "the other window is focused");
+	}
+
+	return error;
+}
+
+static int
+test_mousedaemon_interval(void)
+{
+	int error;
+
+	error = b3_test_check_int(b3_mousedaemon_get_interval(60), 16, "60 Hz");
+
+	if (!error) {
+		error = b3_test_check_int(b3_mousedaemon_get_interval(144), 6, "144 Hz");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_mousedaemon_get_interval(1), 1000 / B3_MOUSEDAEMON_DEFAULT_REFRESH_RATE,
+		                          "an unknown refresh rate falls back to the default");
+	}
+
+	return error;
+}
+
+int
+main(void)
+{
+	b3_test(setup, teardown, test_mouseman_exec, "test_mouseman_exec");
+	b3_test(setup, teardown, test_mc_focus, "test_mc_focus");
+	b3_test(setup, teardown, test_mousedaemon_interval, "test_mousedaemon_interval");
+
+	return 0;
+}
@@ -33,6 +33,7 @@
 #include <w32bindkeys/datafinder.h>
 
 #include "test.h"
+#include "config_gen.h"
 
 #include "../src/win_factory.h"
 #include "../src/ws_factory.h"
@@ -41,6 +42,30 @@
 #include "../src/kc_director_factory.h"
 #include "../src/condition_factory.h"
 #include "../src/action_factory.h"
+#include "../src/config_cache.h"
+#include "../src/kc_director.h"
+#include "../src/kc_exec.h"
+#include "../src/rule.h"
+#include "../src/keyword.h"
+#include "../src/config_check.h"
+#include "../src/mode.h"
+
+#define B3_TEST_PARSER_THREAD_LEN 8
+#define B3_TEST_PARSER_PARSE_LEN 25
+
+typedef struct b3_test_parser_job_s
+{
+	char config[4096];
+
+	/**
+	 * Name of the workspace every binding of the configuration switches to
+	 */
+	char ws_name[16];
+
+	int binding_len;
+
+	int error;
+} b3_test_parser_job_t;
 
 static wbk_datafinder_t *g_datafinder;
 
@@ -243,6 +268,651 @@ test_parse_file(void)
 	return 0;
 }
 
+static int
+test_config_cache(void)
+{
+	int error;
+	char config[] = "bindsym Mod4+Shift+q kill\n"
+		"bindsym Mod4+1 workspace 1\n"
+		"bindsym Mod4+Return exec cmd.exe\n"
+		"for_window [title=\".*Microsoft Teams.*\"] floating enable\n"
+		"for_window [class=\"CabinetWClass\"] floating enable, move container to workspace 2";
+	unsigned long long key;
+	wbk_kbman_t *kbman;
+	wbk_kbman_t *cached_kbman;
+	CC_Array *rule_arr;
+	CC_Array *cached_rule_arr;
+	b3_rule_t *rule;
+	b3_rule_t *cached_rule;
+	char *buffer;
+	size_t buffer_len;
+	int i;
+
+	error = 0;
+	buffer = NULL;
+	cached_kbman = NULL;
+	cc_array_new(&rule_arr);
+	cc_array_new(&cached_rule_arr);
+
+	key = b3_config_cache_key(config, strlen(config));
+	kbman = b3_parser_parse_str_staged(g_parser, g_director, config, rule_arr);
+	if (kbman == NULL) {
+		error = 1;
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_config_cache_write(key, kbman, rule_arr, &buffer, &buffer_len),
+								  0, "configuration can be cached");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_config_cache_read(buffer, buffer_len, key + 1, g_director,
+													   &cached_kbman, cached_rule_arr) != 0,
+								  1, "cache of another configuration is rejected");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_config_cache_read(buffer, buffer_len - 1, key, g_director,
+													   &cached_kbman, cached_rule_arr) != 0,
+								  1, "truncated cache is rejected");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_config_cache_read(buffer, buffer_len, key, g_director,
+													   &cached_kbman, cached_rule_arr),
+								  0, "cache can be read");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(cached_kbman->kc_arr_len, kbman->kc_arr_len, "all key bindings are restored");
+	}
+
+	for (i = 0; !error && i < kbman->kc_arr_len; i++) {
+		error = !(b3_kc_director_equals(kbman->kc_arr[i], cached_kbman->kc_arr[i])
+				  || b3_kc_exec_equals(kbman->kc_arr[i], cached_kbman->kc_arr[i]));
+	}
+
+	if (!error) {
+		error = b3_test_check_int(cc_array_size(cached_rule_arr), cc_array_size(rule_arr), "all rules are restored");
+	}
+
+	for (i = 0; !error && i < cc_array_size(rule_arr); i++) {
+		cc_array_get_at(rule_arr, i, (void*) &rule);
+		cc_array_get_at(cached_rule_arr, i, (void*) &cached_rule);
+		error = !b3_rule_equals(rule, cached_rule);
+	}
+
+	while (cc_array_remove_last(rule_arr, (void*) &rule) == CC_OK) {
+		b3_rule_free(rule);
+	}
+	cc_array_destroy(rule_arr);
+
+	while (cc_array_remove_last(cached_rule_arr, (void*) &rule) == CC_OK) {
+		b3_rule_free(rule);
+	}
+	cc_array_destroy(cached_rule_arr);
+
+	if (cached_kbman) {
+		wbk_kbman_free(cached_kbman);
+	}
+
+	if (kbman) {
+		wbk_kbman_free(kbman);
+	}
+
+	free(buffer);
+
+	return error;
+}
+
+static DWORD WINAPI
+parse_job(LPVOID param)
+{
+	b3_test_parser_job_t *job;
+	wbk_kbman_t *kbman;
+	CC_Array *rule_arr;
+	b3_rule_t *rule;
+	b3_kc_director_t *kc_director;
+	int i;
+	int j;
+
+	job = (b3_test_parser_job_t *) param;
+
+	for (i = 0; !job->error && i < B3_TEST_PARSER_PARSE_LEN; i++) {
+		cc_array_new(&rule_arr);
+
+		kbman = b3_parser_parse_str_staged(g_parser, g_director, job->config, rule_arr);
+		if (kbman == NULL
+			|| kbman->kc_arr_len != job->binding_len
+			|| cc_array_size(rule_arr) != job->binding_len) {
+			job->error = 1;
+		}
+
+		for (j = 0; !job->error && j < kbman->kc_arr_len; j++) {
+			kc_director = (b3_kc_director_t *) kbman->kc_arr[j];
+			if (strcmp((char *) kc_director->data, job->ws_name)) {
+				job->error = 2;
+			}
+		}
+
+		while (cc_array_remove_last(rule_arr, (void*) &rule) == CC_OK) {
+			b3_rule_free(rule);
+		}
+		cc_array_destroy(rule_arr);
+
+		if (kbman) {
+			wbk_kbman_free(kbman);
+		}
+	}
+
+	return 0;
+}
+
+static int
+test_parse_str_threaded(void)
+{
+	int error;
+	b3_test_parser_job_t *job_arr;
+	HANDLE thread_arr[B3_TEST_PARSER_THREAD_LEN];
+	char line[256];
+	int i;
+	int j;
+
+	error = 0;
+	job_arr = malloc(sizeof(b3_test_parser_job_t) * B3_TEST_PARSER_THREAD_LEN);
+
+	/** Every thread parses a configuration of its own */
+	for (i = 0; i < B3_TEST_PARSER_THREAD_LEN; i++) {
+		sprintf(job_arr[i].ws_name, "ws%d", i);
+		job_arr[i].binding_len = i + 1;
+		job_arr[i].error = 0;
+		job_arr[i].config[0] = '\0';
+
+		for (j = 0; j < job_arr[i].binding_len; j++) {
+			sprintf(line, "bindsym Mod4+%c workspace %s\n"
+					"for_window [class=\"app%d\"] floating enable\n",
+					'a' + j, job_arr[i].ws_name, j);
+			strcat(job_arr[i].config, line);
+		}
+	}
+
+	for (i = 0; i < B3_TEST_PARSER_THREAD_LEN; i++) {
+		thread_arr[i] = CreateThread(NULL, 0, parse_job, &(job_arr[i]), 0, NULL);
+	}
+
+	WaitForMultipleObjects(B3_TEST_PARSER_THREAD_LEN, thread_arr, TRUE, INFINITE);
+
+	for (i = 0; i < B3_TEST_PARSER_THREAD_LEN; i++) {
+		CloseHandle(thread_arr[i]);
+
+		if (!error) {
+			error = b3_test_check_int(job_arr[i].error, 0, "concurrent parse is correct");
+		}
+	}
+
+	free(job_arr);
+
+	return error;
+}
+
+static int
+test_parse_include(void)
+{
+	int error;
+	char config[] = "bindsym Mod4+a workspace main1\n"
+		"include include.d/*.config\n"
+		"for_window [class=\"main\"] floating enable\n"
+		"bindsym Mod4+z workspace main2\n";
+	char expected_rules[] = "for_window [class=\"first\"] floating enable\n"
+		"for_window [class=\"main\"] floating enable\n";
+	const char *ws_name_arr[] = { "main1", "first", "second", "nested", "main2" };
+	wbk_kbman_t *kbman;
+	wbk_kbman_t *expected_kbman;
+	CC_Array *rule_arr;
+	CC_Array *expected_rule_arr;
+	b3_rule_t *rule;
+	b3_rule_t *expected_rule;
+	b3_kc_director_t *kc_director;
+	int fragment_len;
+	int i;
+
+	error = 0;
+	cc_array_new(&rule_arr);
+	cc_array_new(&expected_rule_arr);
+
+	kbman = b3_parser_parse_str_in_dir(g_parser, g_director, config, TESTDATADIR, NULL, rule_arr, NULL,
+	                                   &fragment_len);
+	expected_kbman = b3_parser_parse_str_staged(g_parser, g_director, expected_rules, expected_rule_arr);
+	if (kbman == NULL || expected_kbman == NULL) {
+		error = 1;
+	}
+
+	if (!error) {
+		error = b3_test_check_int(fragment_len, 3, "nested fragments are included");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(kbman->kc_arr_len, 5, "key bindings of all fragments are merged");
+	}
+
+	for (i = 0; !error && i < kbman->kc_arr_len; i++) {
+		kc_director = (b3_kc_director_t *) kbman->kc_arr[i];
+		error = b3_test_check_int(strcmp((char *) kc_director->data, ws_name_arr[i]), 0,
+								  "key bindings are merged in include order");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(cc_array_size(rule_arr), cc_array_size(expected_rule_arr),
+								  "rules of all fragments are merged");
+	}
+
+	for (i = 0; !error && i < cc_array_size(rule_arr); i++) {
+		cc_array_get_at(rule_arr, i, (void*) &rule);
+		cc_array_get_at(expected_rule_arr, i, (void*) &expected_rule);
+		error = b3_test_check_int(b3_rule_equals(rule, expected_rule) != 0, 1,
+								  "rules are merged in include order");
+	}
+
+	while (cc_array_remove_last(rule_arr, (void*) &rule) == CC_OK) {
+		b3_rule_free(rule);
+	}
+	cc_array_destroy(rule_arr);
+
+	while (cc_array_remove_last(expected_rule_arr, (void*) &rule) == CC_OK) {
+		b3_rule_free(rule);
+	}
+	cc_array_destroy(expected_rule_arr);
+
+	if (kbman) {
+		wbk_kbman_free(kbman);
+	}
+
+	if (expected_kbman) {
+		wbk_kbman_free(expected_kbman);
+	}
+
+	return error;
+}
+
+static int
+test_parse_include_broken(void)
+{
+	int error;
+	char config[] = "bindsym Mod4+a workspace main\n"
+		"include broken.config\n"
+		"for_window [class=\"main\"] floating enable\n";
+	wbk_kbman_t *kbman;
+	CC_Array *rule_arr;
+
+	cc_array_new(&rule_arr);
+
+	kbman = b3_parser_parse_str_in_dir(g_parser, g_director, config, TESTDATADIR, NULL, rule_arr, NULL, NULL);
+
+	error = b3_test_check_int(kbman == NULL, 1, "broken fragment fails the configuration");
+	if (!error) {
+		error = b3_test_check_int(cc_array_size(rule_arr), 0, "no rules of a broken configuration are added");
+	}
+
+	cc_array_destroy(rule_arr);
+
+	if (kbman) {
+		wbk_kbman_free(kbman);
+	}
+
+	return error;
+}
+
+static int
+test_parse_include_cycle(void)
+{
+	int error;
+	char config[] = "bindsym Mod4+a workspace cycle\n"
+		"include cycle.d/*.config\n";
+	char glob_config[] = "bindsym Mod4+a workspace main\n"
+		"include glob.d/*.config\n";
+	wbk_kbman_t *kbman;
+	CC_Array *rule_arr;
+
+	error = 0;
+	cc_array_new(&rule_arr);
+
+	kbman = b3_parser_parse_str_in_dir(g_parser, g_director, config, TESTDATADIR,
+	                                   TESTDATADIR "/cycle.config", rule_arr, NULL, NULL);
+	error = b3_test_check_int(kbman == NULL, 1, "fragment including the configuration fails it");
+	if (kbman) {
+		wbk_kbman_free(kbman);
+	}
+
+	if (!error) {
+		kbman = b3_parser_parse_str_in_dir(g_parser, g_director, glob_config, TESTDATADIR,
+		                                   NULL, rule_arr, NULL, NULL);
+		error = b3_test_check_int(kbman == NULL, 1, "fragment matching its own pattern fails the configuration");
+		if (kbman) {
+			wbk_kbman_free(kbman);
+		}
+	}
+
+	if (!error) {
+		error = b3_test_check_int(cc_array_size(rule_arr), 0, "no rules of a cyclic configuration are added");
+	}
+
+	cc_array_destroy(rule_arr);
+
+	return error;
+}
+
+static int
+test_keyword(void)
+{
+	int error;
+	const b3_keyword_t *keyword_arr;
+	const b3_keyword_t *keyword;
+	int keyword_len;
+	int i;
+
+	error = 0;
+	keyword_arr = b3_keyword_get_all(&keyword_len);
+
+	for (i = 0; !error && i < keyword_len; i++) {
+		keyword = b3_keyword_find(keyword_arr[i].name, keyword_arr[i].len);
+		error = b3_test_check_int(keyword == &(keyword_arr[i]), 1, "every keyword is found");
+	}
+
+	if (!error) {
+		keyword = b3_keyword_find("MOD4+a", 4);
+		error = b3_test_check_int(keyword && keyword->modifier == WIN, 1,
+								  "modifiers are found case insensitive in a slice");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_keyword_find("Bindsym", 7) == NULL, 1,
+								  "keywords are case sensitive");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_keyword_find("toggles", 7) == NULL
+								  && b3_keyword_find("to", 1) == NULL
+								  && b3_keyword_find("f13", 3) == NULL, 1,
+								  "other words are not found");
+	}
+
+	return error;
+}
+
+static int
+test_parse_str_text(void)
+{
+	int error;
+	char config[] = "bindsym Mod4+Return exec cmd.exe /c \"echo a,b=c\" toggle\n"
+		"bindsym Mod4+e exec --no-startup-id notepad.exe\n";
+	wbk_kbman_t *kbman;
+	CC_Array *rule_arr;
+
+	error = 0;
+	cc_array_new(&rule_arr);
+
+	kbman = b3_parser_parse_str_staged(g_parser, g_director, config, rule_arr);
+	if (kbman == NULL) {
+		error = 1;
+	}
+
+	if (!error) {
+		error = b3_test_check_int(kbman->kc_arr_len, 2, "all key bindings are parsed");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(strcmp(b3_kc_exec_get_cmd((b3_kc_exec_t *) kbman->kc_arr[0]),
+										 "cmd.exe /c \"echo a,b=c\" toggle"), 0,
+								  "text is taken from the input as it is");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(strcmp(b3_kc_exec_get_cmd((b3_kc_exec_t *) kbman->kc_arr[1]),
+										 "notepad.exe"), 0,
+								  "text ends with the statement");
+	}
+
+	cc_array_destroy(rule_arr);
+
+	if (kbman) {
+		wbk_kbman_free(kbman);
+	}
+
+	return error;
+}
+
+static int
+test_parse_str_other_char(void)
+{
+	int error;
+	char config[] = "bindsym Mod4+Return exec notepad.exe C:\\Users\\Zo\xc3\xab\\user@example.txt\n";
+	wbk_kbman_t *kbman;
+	CC_Array *rule_arr;
+
+	error = 0;
+	cc_array_new(&rule_arr);
+
+	kbman = b3_parser_parse_str_staged(g_parser, g_director, config, rule_arr);
+	if (kbman == NULL) {
+		error = 1;
+	}
+
+	if (!error) {
+		error = b3_test_check_int(strcmp(b3_kc_exec_get_cmd((b3_kc_exec_t *) kbman->kc_arr[0]),
+										 "notepad.exe C:\\Users\\Zo\xc3\xab\\user@example.txt"), 0,
+								  "characters unknown to the lexer are part of the text");
+	}
+
+	cc_array_destroy(rule_arr);
+
+	if (kbman) {
+		wbk_kbman_free(kbman);
+	}
+
+	return error;
+}
+
+static int
+test_parse_generated(void)
+{
+	int error;
+	char *config;
+	wbk_kbman_t *kbman;
+	CC_Array *rule_arr;
+	b3_rule_t *rule;
+
+	error = 0;
+	cc_array_new(&rule_arr);
+
+	config = b3_config_gen(1000, 500);
+	kbman = b3_parser_parse_str_staged(g_parser, g_director, config, rule_arr);
+	if (kbman == NULL) {
+		error = 1;
+	}
+
+	if (!error) {
+		error = b3_test_check_int(kbman->kc_arr_len, 1000, "all generated key bindings are parsed");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(cc_array_size(rule_arr), 500, "all generated rules are parsed");
+	}
+
+	while (cc_array_remove_last(rule_arr, (void*) &rule) == CC_OK) {
+		b3_rule_free(rule);
+	}
+	cc_array_destroy(rule_arr);
+
+	if (kbman) {
+		wbk_kbman_free(kbman);
+	}
+
+	free(config);
+
+	return error;
+}
+
+static int
+test_parse_mode(void)
+{
+	int error;
+	char config[] = "bindsym Mod4+r mode \"resize\"\n"
+		"mode \"resize\" {\n"
+		"\tbindsym h exec notepad.exe\n"
+		"\t# Leave the mode\n"
+		"\tbindsym Return mode \"default\"\n"
+		"}\n"
+		"bindsym Mod4+e exec notepad.exe {x}\n"
+		"mode \"resize\" {\n"
+		"\tbindsym l exec calc.exe\n"
+		"}\n";
+	wbk_kbman_t *kbman;
+	CC_Array *rule_arr;
+	CC_Array *mode_arr;
+	b3_mode_t *mode;
+	b3_kc_director_t *kc_director;
+
+	error = 0;
+	cc_array_new(&rule_arr);
+	cc_array_new(&mode_arr);
+
+	kbman = b3_parser_parse_str_in_dir(g_parser, g_director, config, NULL, NULL, rule_arr, mode_arr, NULL);
+	if (kbman == NULL) {
+		error = 1;
+	}
+
+	if (!error) {
+		error = b3_test_check_int(kbman->kc_arr_len, 2, "bindings of mode blocks are kept apart");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(cc_array_size(mode_arr), 1, "blocks of the same mode are merged");
+	}
+
+	if (!error) {
+		cc_array_get_at(mode_arr, 0, (void *) &mode);
+		error = b3_test_check_int(strcmp(b3_mode_get_name(mode), "resize"), 0, "the mode is named");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_mode_get_kbman(mode)->kc_arr_len, 3, "all bindings of the mode are parsed");
+	}
+
+	if (!error) {
+		kc_director = (b3_kc_director_t *) kbman->kc_arr[0];
+		error = b3_test_check_int(kc_director->kind == SWITCH_MODE
+								  && strcmp(kc_director->data, "resize") == 0, 1,
+								  "the mode command names the mode without quotes");
+	}
+
+	if (!error) {
+		kc_director = (b3_kc_director_t *) b3_mode_get_kbman(mode)->kc_arr[1];
+		error = b3_test_check_int(kc_director->kind == SWITCH_MODE
+								  && strcmp(kc_director->data, B3_MODE_DEFAULT) == 0, 1,
+								  "a mode can switch back to the default mode");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(strcmp(b3_kc_exec_get_cmd((b3_kc_exec_t *) kbman->kc_arr[1]),
+										 "notepad.exe {x}"), 0,
+								  "braces within a line are text");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_parser_parse_str_in_dir(g_parser, g_director, "mode \"resize\" {\n",
+															 NULL, NULL, rule_arr, mode_arr, NULL) == NULL, 1,
+								  "an unterminated mode block is an error");
+	}
+
+	cc_array_destroy(rule_arr);
+
+	while (cc_array_remove_last(mode_arr, (void*) &mode) == CC_OK) {
+		b3_mode_free(mode);
+	}
+	cc_array_destroy(mode_arr);
+
+	if (kbman) {
+		wbk_kbman_free(kbman);
+	}
+
+	return error;
+}
+
+static int
+test_config_check(void)
+{
+	int error;
+	char *filename;
+	b3_config_check_t check;
+
+	error = 0;
+
+	filename = wbk_datafinder_gen_path(g_datafinder, "valid.config");
+	error = b3_test_check_int(b3_config_check(g_parser, filename, 1, &check), 0, "a valid configuration passes");
+	free(filename);
+
+	if (!error) {
+		error = b3_test_check_int(check.binding_len, 5, "key bindings are counted");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(check.rule_len, 2, "rules are counted");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(check.duplicate_len + check.shadowed_len, 0,
+								  "a valid configuration binds no combination twice");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(check.phase_profile_arr[B3_CONFIG_CHECK_PHASE_BINDINGS].evaluations, 1,
+								  "all phases are run");
+	}
+
+	if (!error) {
+		filename = wbk_datafinder_gen_path(g_datafinder, "full.config");
+		error = b3_test_check_int(b3_config_check(g_parser, filename, 0, &check), 0,
+								  "the default configuration passes");
+		free(filename);
+	}
+
+	if (!error) {
+		filename = wbk_datafinder_gen_path(g_datafinder, "shadowed.config");
+		error = b3_test_check_int(b3_config_check(g_parser, filename, 0, &check), 0,
+								  "a shadowed key binding is only a warning");
+		free(filename);
+	}
+
+	if (!error) {
+		filename = wbk_datafinder_gen_path(g_datafinder, "shadowed.config");
+		error = b3_test_check_int(b3_config_check(g_parser, filename, 1, &check) != 0, 1,
+								  "a shadowed key binding fails a strict check");
+		free(filename);
+	}
+
+	if (!error) {
+		error = b3_test_check_int(check.duplicate_len, 1, "repeated key bindings are found");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(check.shadowed_len, 1, "shadowed key bindings are found");
+	}
+
+	if (!error) {
+		filename = wbk_datafinder_gen_path(g_datafinder, "bad_pattern.config");
+		error = b3_test_check_int(b3_config_check(g_parser, filename, 0, &check) != 0, 1,
+								  "an invalid pattern is an error");
+		free(filename);
+	}
+
+	if (!error) {
+		error = b3_test_check_int(check.phase_profile_arr[B3_CONFIG_CHECK_PHASE_PATTERNS].evaluations, 0,
+								  "checking stops after the failed phase");
+	}
+
+	return error;
+}
+
 int
 main(void)
 {
@@ -254,6 +924,17 @@ main(void)
 	b3_test(setup, teardown, test_parse_file_none, "test_parse_file_none");
 	b3_test(setup, teardown, test_parse_file_rules, "test_parse_file_rules");
 	b3_test(setup, teardown, test_parse_file, "test_parse_file");
+	b3_test(setup, teardown, test_config_cache, "test_config_cache");
+	b3_test(setup, teardown, test_parse_str_threaded, "test_parse_str_threaded");
+	b3_test(setup, teardown, test_parse_include, "test_parse_include");
+	b3_test(setup, teardown, test_parse_include_broken, "test_parse_include_broken");
+	b3_test(setup, teardown, test_parse_include_cycle, "test_parse_include_cycle");
+	b3_test(setup, teardown, test_keyword, "test_keyword");
+	b3_test(setup, teardown, test_parse_str_text, "test_parse_str_text");
+	b3_test(setup, teardown, test_parse_str_other_char, "test_parse_str_other_char");
+	b3_test(setup, teardown, test_parse_generated, "test_parse_generated");
+	b3_test(setup, teardown, test_parse_mode, "test_parse_mode");
+	b3_test(setup, teardown, test_config_check, "test_config_check");
 
 	return 0;
 }
@@ -0,0 +1,366 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-18
+ * @brief File contains the tests for the rule set class
+ */
+
+#include "../src/rule_set.h"
+
+#include "test.h"
+
+#include <string.h>
+
+#include "../src/condition_factory.h"
+#include "../src/action_factory.h"
+
+static b3_condition_factory_t *g_condition_factory;
+static b3_action_factory_t *g_action_factory;
+
+static void
+setup(void)
+{
+	g_condition_factory = b3_condition_factory_new();
+	g_action_factory = b3_action_factory_new();
+}
+
+static void
+teardown(void)
+{
+	b3_action_factory_free(g_action_factory);
+	b3_condition_factory_free(g_condition_factory);
+}
+
+static b3_rule_t *
+create_rule(b3_condition_t *condition)
+{
+	b3_condition_and_t *condition_and;
+
+	condition_and = b3_condition_factory_create_and(g_condition_factory);
+	b3_condition_and_add(condition_and, condition);
+
+	return b3_rule_new((b3_condition_t *) condition_and,
+					   (b3_action_t *) b3_action_factory_create_fa(g_action_factory));
+}
+
+static b3_win_t *
+create_win(const char *class_name, const char *title)
+{
+	b3_win_t *win;
+
+	win = b3_win_new((HWND) 1, 0);
+	strcpy(win->class_name, class_name);
+	strcpy(win->title, title);
+	win->attrs_cached = 1;
+
+	return win;
+}
+
+static int
+check_kind(const char *pattern, b3_pattern_kind_t kind_exp, const char *literal_exp)
+{
+	int error;
+	b3_class_condition_t *cc;
+	const char *literal;
+
+	cc = b3_condition_factory_create_cc(g_condition_factory, pattern);
+
+	error = b3_test_check_int(b3_pattern_condition_get_kind((b3_pattern_condition_t *) cc),
+							  kind_exp, (char *) pattern);
+
+	if (!error) {
+		literal = b3_pattern_condition_get_literal((b3_pattern_condition_t *) cc);
+		if (literal_exp == NULL) {
+			error = b3_test_check_void((void *) literal, NULL, (char *) pattern);
+		} else {
+			error = (literal == NULL || strcmp(literal, literal_exp));
+		}
+	}
+
+	b3_condition_free((b3_condition_t *) cc);
+
+	return error;
+}
+
+static int
+test_pattern_kind(void)
+{
+	int error;
+
+	error = check_kind("^Firefox$", B3_PATTERN_KIND_EXACT, "Firefox");
+
+	if (!error) {
+		error = check_kind("^Mozilla", B3_PATTERN_KIND_PREFIX, "Mozilla");
+	}
+
+	if (!error) {
+		error = check_kind("Firefox", B3_PATTERN_KIND_SUBSTRING, "Firefox");
+	}
+
+	if (!error) {
+		error = check_kind("^b3\\.exe$", B3_PATTERN_KIND_EXACT, "b3.exe");
+	}
+
+	if (!error) {
+		error = check_kind("Fire.*fox", B3_PATTERN_KIND_REGEX, NULL);
+	}
+
+	if (!error) {
+		error = check_kind("fox$", B3_PATTERN_KIND_REGEX, NULL);
+	}
+
+	if (!error) {
+		error = check_kind("^\\d+$", B3_PATTERN_KIND_REGEX, NULL);
+	}
+
+	return error;
+}
+
+static int
+test_pattern_match(void)
+{
+	int error;
+	b3_class_condition_t *cc;
+
+	cc = b3_condition_factory_create_cc(g_condition_factory, "^Mozilla");
+
+	error = b3_test_check_int(b3_pattern_condition_match((b3_pattern_condition_t *) cc, "Mozilla Firefox"),
+							  1, "prefix should match");
+
+	if (!error) {
+		error = b3_test_check_int(b3_pattern_condition_match((b3_pattern_condition_t *) cc, "Firefox - Mozilla"),
+								  0, "prefix should not match");
+	}
+
+	b3_condition_free((b3_condition_t *) cc);
+
+	return error;
+}
+
+static int
+test_match(void)
+{
+	int error;
+	CC_Array *rule_arr;
+	CC_Array *matched_rule_arr;
+	b3_rule_t *rule_exact;
+	b3_rule_t *rule_regex;
+	b3_rule_t *rule_prefix;
+	b3_rule_t *rule_other;
+	b3_rule_set_t *rule_set;
+	b3_win_t *win;
+	void *rule;
+
+	rule_exact = create_rule((b3_condition_t *) b3_condition_factory_create_cc(g_condition_factory, "^Firefox$"));
+	rule_regex = create_rule((b3_condition_t *) b3_condition_factory_create_cc(g_condition_factory, "Fire.*"));
+	rule_prefix = create_rule((b3_condition_t *) b3_condition_factory_create_tc(g_condition_factory, "^Mozilla"));
+	rule_other = create_rule((b3_condition_t *) b3_condition_factory_create_cc(g_condition_factory, "^Chrome$"));
+
+	cc_array_new(&rule_arr);
+	cc_array_add(rule_arr, rule_exact);
+	cc_array_add(rule_arr, rule_regex);
+	cc_array_add(rule_arr, rule_prefix);
+	cc_array_add(rule_arr, rule_other);
+
+	rule_set = b3_rule_set_new(rule_arr);
+	win = create_win("Firefox", "Mozilla Firefox");
+	cc_array_new(&matched_rule_arr);
+
+	error = b3_test_check_int(cc_array_size(rule_set->residual_arr), 1, "only the regex is residual");
+
+	if (!error) {
+		error = b3_test_check_int(b3_rule_set_match(rule_set, NULL, win, matched_rule_arr),
+								  3, "three rules match");
+	}
+
+	if (!error) {
+		cc_array_get_at(matched_rule_arr, 0, &rule);
+		error = b3_test_check_void(rule, rule_exact, "exact rule first");
+	}
+
+	if (!error) {
+		cc_array_get_at(matched_rule_arr, 1, &rule);
+		error = b3_test_check_void(rule, rule_regex, "regex rule second");
+	}
+
+	if (!error) {
+		cc_array_get_at(matched_rule_arr, 2, &rule);
+		error = b3_test_check_void(rule, rule_prefix, "prefix rule third");
+	}
+
+	cc_array_destroy(matched_rule_arr);
+	b3_win_free(win);
+	b3_rule_set_release(rule_set);
+	b3_rule_free(rule_exact);
+	b3_rule_free(rule_regex);
+	b3_rule_free(rule_prefix);
+	b3_rule_free(rule_other);
+	cc_array_destroy(rule_arr);
+
+	return error;
+}
+
+static int
+test_profile(void)
+{
+	int error;
+	CC_Array *rule_arr;
+	CC_Array *matched_rule_arr;
+	b3_rule_t *rule_exact;
+	b3_rule_t *rule_other;
+	b3_rule_set_t *rule_set;
+	b3_win_t *win;
+	b3_profile_t profile;
+
+	rule_exact = create_rule((b3_condition_t *) b3_condition_factory_create_cc(g_condition_factory, "^Firefox$"));
+	rule_other = create_rule((b3_condition_t *) b3_condition_factory_create_cc(g_condition_factory, "^Chrome$"));
+
+	cc_array_new(&rule_arr);
+	cc_array_add(rule_arr, rule_exact);
+	cc_array_add(rule_arr, rule_other);
+
+	rule_set = b3_rule_set_new(rule_arr);
+	win = create_win("Firefox", "Mozilla Firefox");
+	cc_array_new(&matched_rule_arr);
+
+	b3_rule_set_match(rule_set, NULL, win, matched_rule_arr);
+	b3_rule_set_match(rule_set, NULL, win, matched_rule_arr);
+
+	b3_profile_copy(b3_rule_get_profile(rule_exact), &profile);
+	error = b3_test_check_int(profile.evaluations, 2, "exact rule evaluated twice");
+
+	if (!error) {
+		error = b3_test_check_int(profile.matches, 2, "exact rule matched twice");
+	}
+
+	if (!error) {
+		error = (profile.max_ns > profile.total_ns);
+	}
+
+	if (!error) {
+		b3_profile_copy(b3_condition_get_profile(b3_rule_get_condition(rule_exact)), &profile);
+		error = b3_test_check_int(profile.evaluations, 2, "condition evaluated twice");
+	}
+
+	if (!error) {
+		b3_profile_copy(b3_rule_get_profile(rule_other), &profile);
+		error = b3_test_check_int(profile.evaluations, 0, "other rule is never a candidate");
+	}
+
+	if (!error) {
+		error = b3_rule_set_dump_profile(rule_set);
+	}
+
+	cc_array_destroy(matched_rule_arr);
+	b3_win_free(win);
+	b3_rule_set_release(rule_set);
+	b3_rule_free(rule_exact);
+	b3_rule_free(rule_other);
+	cc_array_destroy(rule_arr);
+
+	return error;
+}
+
+static int
+test_prepare(void)
+{
+	int error;
+	b3_action_list_t *action_list;
+	b3_rule_t *rule;
+	b3_win_t *win;
+	b3_action_placement_t placement;
+
+	action_list = b3_action_factory_create_list(g_action_factory);
+	b3_action_cc_list_add(action_list, (b3_action_t *) b3_action_factory_create_mwtw(g_action_factory, strdup("2")));
+	b3_action_cc_list_add(action_list, (b3_action_t *) b3_action_factory_create_fa(g_action_factory));
+
+	rule = b3_rule_new((b3_condition_t *) b3_condition_factory_create_cc(g_condition_factory, "^Firefox$"),
+					   (b3_action_t *) action_list);
+	win = create_win("Firefox", "Mozilla Firefox");
+
+	placement.ws_id = NULL;
+	placement.floating = 0;
+
+	error = b3_test_check_int(b3_rule_prepare(rule, NULL, win, &placement), 0, "rule can be prepared");
+
+	if (!error) {
+		error = b3_test_check_int(placement.floating, 1, "window will be floating");
+	}
+
+	if (!error) {
+		error = (placement.ws_id == NULL || strcmp(placement.ws_id, "2"));
+	}
+
+	b3_win_free(win);
+	b3_rule_free(rule);
+
+	return error;
+}
+
+static int
+test_equals(void)
+{
+	int error;
+	b3_rule_t *rule;
+	b3_rule_t *same_rule;
+	b3_rule_t *title_rule;
+	b3_rule_t *other_rule;
+
+	rule = create_rule((b3_condition_t *) b3_condition_factory_create_cc(g_condition_factory, "^Firefox$"));
+	same_rule = create_rule((b3_condition_t *) b3_condition_factory_create_cc(g_condition_factory, "^Firefox$"));
+	title_rule = create_rule((b3_condition_t *) b3_condition_factory_create_tc(g_condition_factory, "^Firefox$"));
+	other_rule = create_rule((b3_condition_t *) b3_condition_factory_create_cc(g_condition_factory, "^Chrome$"));
+
+	error = b3_test_check_int(b3_rule_equals(rule, same_rule) != 0, 1, "same rules are equal");
+
+	if (!error) {
+		error = b3_test_check_int(b3_rule_equals(rule, title_rule), 0, "class and title rules differ");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_rule_equals(rule, other_rule), 0, "patterns differ");
+	}
+
+	b3_rule_free(other_rule);
+	b3_rule_free(title_rule);
+	b3_rule_free(same_rule);
+	b3_rule_free(rule);
+
+	return error;
+}
+
+int
+main(void)
+{
+	b3_test(setup, teardown, test_pattern_kind, "test_pattern_kind");
+	b3_test(setup, teardown, test_pattern_match, "test_pattern_match");
+	b3_test(setup, teardown, test_match, "test_match");
+	b3_test(setup, teardown, test_profile, "test_profile");
+	b3_test(setup, teardown, test_prepare, "test_prepare");
+	b3_test(setup, teardown, test_equals, "test_equals");
+
+	return 0;
+}
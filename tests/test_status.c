@@ -0,0 +1,134 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the tests for the status class
+ */
+
+#include "../src/status.h"
+
+#include "test.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static b3_status_t *g_status;
+
+static void
+setup(void)
+{
+	g_status = b3_status_new("status", B3_STATUS_DEFAULT_INTERVAL, NULL, NULL);
+}
+
+static void
+teardown(void)
+{
+	if (g_status) {
+		b3_status_free(g_status);
+		g_status = NULL;
+	}
+}
+
+/**
+ * Feeds a status line through the reader of the status
+ */
+static int
+feed(const char *line)
+{
+	return b3_statusreader_feed(g_status->reader, line, strlen(line));
+}
+
+static int
+test_status_diff(void)
+{
+	int error;
+	LONG serial;
+	b3_status_block_t *block_arr;
+	int block_arr_len;
+
+	error = feed("[[{\"full_text\":\"a\"}]\n");
+
+	if (!error) {
+		error = b3_test_check_int(b3_status_get_serial(g_status), 1, "the first line changes the blocks");
+	}
+
+	if (!error) {
+		error = feed(",[{\"full_text\":\"a\"}]\n");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_status_get_serial(g_status), 1, "an equal line is dropped");
+	}
+
+	if (!error) {
+		error = feed(",[{\"full_text\":\"a\",\"urgent\":true}]\n");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_status_get_serial(g_status), 2, "a changed attribute changes the blocks");
+	}
+
+	if (!error) {
+		serial = b3_status_copy_blocks(g_status, &block_arr, &block_arr_len);
+		error = b3_test_check_int(serial, 2, "the copy has the current serial");
+		if (!error) {
+			error = b3_test_check_int(block_arr_len == 1 && block_arr[0].urgent, 1, "the current blocks are copied");
+		}
+		b3_status_block_arr_free(block_arr, block_arr_len);
+	}
+
+	if (!error) {
+		error = b3_test_check_int(g_status->changed, 1, "the change is pending");
+	}
+
+	return error;
+}
+
+static int
+test_status_delay(void)
+{
+	int error;
+
+	error = b3_test_check_int(b3_status_get_delay(0, 5000, 250), 0, "the first update is not delayed");
+
+	if (!error) {
+		error = b3_test_check_int(b3_status_get_delay(5000, 5100, 250), 150, "an update waits for the interval");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_status_get_delay(5000, 5250, 250), 0, "an update after the interval is not delayed");
+	}
+
+	return error;
+}
+
+int
+main(void)
+{
+	b3_test(setup, teardown, test_status_diff, "test_status_diff");
+	b3_test(setup, teardown, test_status_delay, "test_status_delay");
+
+	return 0;
+}
@@ -0,0 +1,324 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the tests for the status reader class
+ */
+
+#include "../src/statusreader.h"
+
+#include "test.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define B3_TEST_STATUSREADER_LINE_LEN 8
+
+static const char *g_stream =
+	"{\"version\":1,\"click_events\":true,\"stop_signal\":10}\n"
+	"[\n"
+	"[{\"full_text\":\"E: up\",\"name\":\"ethernet\",\"instance\":\"eth0\",\"color\":\"#00FF00\"},"
+	"{\"full_text\":\"Disk 12 GiB\",\"urgent\":true,\"separator\":false,\"separator_block_width\":15,"
+	"\"markup\":{\"nested\":[1,{\"a\":\"]\"}]},\"min_width\":120}]\n"
+	",[{\"full_text\":\"12:00\",\"background\":\"#11223344\",\"color\":\"green\"}]\n";
+
+typedef struct b3_test_line_s
+{
+	b3_status_block_t *block_arr;
+	int block_arr_len;
+} b3_test_line_t;
+
+static b3_test_line_t g_line_arr[B3_TEST_STATUSREADER_LINE_LEN];
+
+static int g_line_arr_len;
+
+static b3_statusreader_t *g_reader;
+
+static int
+handler(void *data, b3_status_block_t *block_arr, int block_arr_len)
+{
+	if (g_line_arr_len < B3_TEST_STATUSREADER_LINE_LEN) {
+		g_line_arr[g_line_arr_len].block_arr = block_arr;
+		g_line_arr[g_line_arr_len].block_arr_len = block_arr_len;
+		g_line_arr_len++;
+	} else {
+		b3_status_block_arr_free(block_arr, block_arr_len);
+	}
+
+	return 0;
+}
+
+static void
+setup(void)
+{
+	memset(g_line_arr, 0, sizeof(g_line_arr));
+	g_line_arr_len = 0;
+
+	g_reader = b3_statusreader_new(handler, NULL);
+}
+
+static void
+teardown(void)
+{
+	int i;
+
+	for (i = 0; i < g_line_arr_len; i++) {
+		b3_status_block_arr_free(g_line_arr[i].block_arr, g_line_arr[i].block_arr_len);
+	}
+	g_line_arr_len = 0;
+
+	if (g_reader) {
+		b3_statusreader_free(g_reader);
+		g_reader = NULL;
+	}
+}
+
+static int
+check_str(const char *act, const char *exp, char *msg)
+{
+	if (act == NULL || strcmp(act, exp)) {
+		return b3_test_check_void((void *) act, (void *) exp, msg);
+	}
+	return 0;
+}
+
+/**
+ * Checks the lines read from g_stream
+ */
+static int
+check_stream_lines(void)
+{
+	int error;
+	b3_status_block_t *block;
+
+	error = b3_test_check_int(g_line_arr_len, 2, "both status lines are read");
+
+	if (!error) {
+		error = b3_test_check_int(b3_statusreader_get_version(g_reader), 1, "the header is read");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(g_line_arr[0].block_arr_len, 2, "the first line has two blocks");
+	}
+
+	if (!error) {
+		block = &(g_line_arr[0].block_arr[0]);
+		error = check_str(block->full_text, "E: up", "full_text is read");
+		if (!error) {
+			error = check_str(block->name, "ethernet", "name is read");
+		}
+		if (!error) {
+			error = check_str(block->instance, "eth0", "instance is read");
+		}
+		if (!error) {
+			error = b3_test_check_int(block->color, 0x00FF00, "color is read");
+		}
+		if (!error) {
+			error = b3_test_check_int(block->separator, 1, "separator defaults to true");
+		}
+		if (!error) {
+			error = b3_test_check_int(block->separator_block_width,
+									  B3_STATUS_DEFAULT_SEPARATOR_BLOCK_WIDTH,
+									  "separator_block_width has its default");
+		}
+	}
+
+	if (!error) {
+		block = &(g_line_arr[0].block_arr[1]);
+		error = check_str(block->full_text, "Disk 12 GiB", "full_text is read");
+		if (!error) {
+			error = b3_test_check_int(block->urgent, 1, "urgent is read");
+		}
+		if (!error) {
+			error = b3_test_check_int(block->separator, 0, "separator is read");
+		}
+		if (!error) {
+			error = b3_test_check_int(block->separator_block_width, 15, "separator_block_width is read");
+		}
+		if (!error) {
+			error = b3_test_check_int(block->min_width, 120, "the key after a skipped value is read");
+		}
+		if (!error) {
+			error = b3_test_check_int(block->color, B3_STATUS_COLOR_UNSET, "color is unset");
+		}
+	}
+
+	if (!error) {
+		error = b3_test_check_int(g_line_arr[1].block_arr_len, 1, "the second line has one block");
+	}
+
+	if (!error) {
+		block = &(g_line_arr[1].block_arr[0]);
+		error = check_str(block->full_text, "12:00", "full_text is read");
+		if (!error) {
+			error = b3_test_check_int(block->background, 0x112233, "the alpha channel is ignored");
+		}
+		if (!error) {
+			error = b3_test_check_int(block->color, B3_STATUS_COLOR_UNSET, "named colors are not supported");
+		}
+	}
+
+	return error;
+}
+
+static int
+test_statusreader_stream(void)
+{
+	int error;
+
+	error = b3_statusreader_feed(g_reader, g_stream, strlen(g_stream));
+	error = b3_test_check_int(error, 0, "the stream is valid");
+
+	if (!error) {
+		error = check_stream_lines();
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_statusreader_is_end(g_reader), 0, "the infinite array is still open");
+	}
+
+	return error;
+}
+
+static int
+test_statusreader_chunks(void)
+{
+	int error;
+	int len;
+	int i;
+
+	error = 0;
+
+	/**
+	 * Every byte is a chunk of its own, so each token is split
+	 */
+	len = strlen(g_stream);
+	for (i = 0; !error && i < len; i++) {
+		error = b3_statusreader_feed(g_reader, g_stream + i, 1);
+	}
+	error = b3_test_check_int(error, 0, "the stream is valid");
+
+	if (!error) {
+		error = check_stream_lines();
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_status_block_arr_equals(g_line_arr[0].block_arr, g_line_arr[0].block_arr_len,
+															 g_line_arr[1].block_arr, g_line_arr[1].block_arr_len),
+								  0, "different lines are not equal");
+	}
+
+	return error;
+}
+
+static int
+test_statusreader_no_header(void)
+{
+	int error;
+	const char *stream;
+	b3_status_block_t *copy_arr;
+
+	stream = "[[{\"full_text\":\"a\\\"b\\\\c\\u00e4\\ud83d\\ude00\\ud83d\"}],[],[{\"full_text\":\"\"}]]";
+
+	error = b3_statusreader_feed(g_reader, stream, strlen(stream));
+	error = b3_test_check_int(error, 0, "the stream is valid");
+
+	if (!error) {
+		error = b3_test_check_int(b3_statusreader_get_version(g_reader), 0, "there is no header");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(g_line_arr_len, 3, "all status lines are read");
+	}
+
+	if (!error) {
+		error = check_str(g_line_arr[0].block_arr[0].full_text,
+						  "a\"b\\c\xC3\xA4\xF0\x9F\x98\x80?",
+						  "escapes are decoded as UTF-8");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(g_line_arr[1].block_arr_len, 0, "an empty line has no blocks");
+	}
+
+	if (!error) {
+		error = check_str(g_line_arr[2].block_arr[0].full_text, "", "an empty string is read");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(b3_statusreader_is_end(g_reader), 1, "the array was closed");
+	}
+
+	if (!error) {
+		copy_arr = b3_status_block_arr_copy(g_line_arr[0].block_arr, g_line_arr[0].block_arr_len);
+		error = b3_test_check_int(b3_status_block_arr_equals(copy_arr, 1, g_line_arr[0].block_arr, 1),
+								  1, "a copy is equal");
+		b3_status_block_arr_free(copy_arr, 1);
+	}
+
+	return error;
+}
+
+static int
+test_statusreader_error(void)
+{
+	int error;
+	const char *stream;
+
+	stream = "{\"version\":1}[[{\"full_text\" \"a\"}]";
+
+	error = b3_test_check_int(b3_statusreader_feed(g_reader, stream, strlen(stream)) != 0, 1,
+							  "a missing colon is rejected");
+
+	if (!error) {
+		error = b3_test_check_int(b3_statusreader_feed(g_reader, "]", 1) != 0, 1,
+								  "the reader stays in the error state");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(g_line_arr_len, 0, "no line is passed");
+	}
+
+	if (!error) {
+		teardown();
+		setup();
+		stream = "[[{\"urgent\":truth}]]";
+		error = b3_test_check_int(b3_statusreader_feed(g_reader, stream, strlen(stream)) != 0, 1,
+								  "an invalid literal is rejected");
+	}
+
+	return error;
+}
+
+int
+main(void)
+{
+	b3_test(setup, teardown, test_statusreader_stream, "test_statusreader_stream");
+	b3_test(setup, teardown, test_statusreader_chunks, "test_statusreader_chunks");
+	b3_test(setup, teardown, test_statusreader_no_header, "test_statusreader_no_header");
+	b3_test(setup, teardown, test_statusreader_error, "test_statusreader_error");
+
+	return 0;
+}
@@ -0,0 +1,165 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the tests for the text cache class
+ */
+
+#include "../src/textcache.h"
+
+#include "test.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static b3_textcache_t *g_textcache;
+
+static int g_measure_count;
+
+static LOGFONT g_logfont;
+
+/**
+ * Every character is 7 pixels wide
+ */
+static int
+measure(HDC hdc, b3_textcache_encoding_t encoding, const char *text, SIZE *size)
+{
+	g_measure_count++;
+	size->cx = 7 * strlen(text);
+	size->cy = 12;
+	return 0;
+}
+
+static void
+setup(void)
+{
+	g_textcache = b3_textcache_new(2);
+	g_textcache->b3_textcache_measure = measure;
+	g_measure_count = 0;
+	memset(&g_logfont, 0, sizeof(LOGFONT));
+}
+
+static void
+teardown(void)
+{
+	if (g_textcache) {
+		b3_textcache_free(g_textcache);
+		g_textcache = NULL;
+	}
+}
+
+static int
+get_width(const LOGFONT *logfont, const char *text)
+{
+	SIZE size;
+
+	size.cx = -1;
+	b3_textcache_get_extent(g_textcache, NULL, logfont, B3_TEXTCACHE_ANSI, text, &size);
+	return size.cx;
+}
+
+static int
+test_textcache_hit(void)
+{
+	int error;
+
+	error = b3_test_check_int(get_width(&g_logfont, "1"), 7, "the text is measured");
+
+	if (!error) {
+		error = b3_test_check_int(get_width(&g_logfont, "1"), 7, "the cached extent is returned");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(g_measure_count, 1, "a cached text is not measured again");
+	}
+
+	return error;
+}
+
+static int
+test_textcache_lru(void)
+{
+	int error;
+
+	get_width(&g_logfont, "1");
+	get_width(&g_logfont, "22");
+	get_width(&g_logfont, "1");
+	get_width(&g_logfont, "333");
+
+	error = b3_test_check_int(g_measure_count, 3, "each text is measured once");
+
+	if (!error) {
+		get_width(&g_logfont, "1");
+		error = b3_test_check_int(g_measure_count, 3, "the recently used text is kept");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(get_width(&g_logfont, "22"), 14, "the evicted text is measured again");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(g_measure_count, 4, "the least recently used text was evicted");
+	}
+
+	return error;
+}
+
+static int
+test_textcache_font(void)
+{
+	int error;
+	LOGFONT other;
+	int i;
+
+	other = g_logfont;
+	other.lfHeight = 20;
+
+	get_width(&g_logfont, "1");
+	get_width(&other, "1");
+
+	error = b3_test_check_int(g_measure_count, 2, "each font has its own extents");
+
+	if (!error) {
+		for (i = 0; i < B3_TEXTCACHE_MAX_FONTS; i++) {
+			other.lfHeight = 30 + i;
+			get_width(&other, "1");
+		}
+		get_width(&g_logfont, "1");
+		error = b3_test_check_int(g_measure_count, 3 + B3_TEXTCACHE_MAX_FONTS, "the least recently used font was evicted");
+	}
+
+	return error;
+}
+
+int
+main(void)
+{
+	b3_test(setup, teardown, test_textcache_hit, "test_textcache_hit");
+	b3_test(setup, teardown, test_textcache_lru, "test_textcache_lru");
+	b3_test(setup, teardown, test_textcache_font, "test_textcache_font");
+
+	return 0;
+}
@@ -0,0 +1,166 @@
+/******************************************************************************
+  This file is part of b3.
+
+  Copyright 2020-2021 Richard Paul Baeck <richard.baeck@mailbox.org>
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+*******************************************************************************/
+
+/**
+ * @author Richard Bäck <richard.baeck@mailbox.org>
+ * @date 2026-10-19
+ * @brief File contains the tests for the window table class
+ */
+
+#include "../src/wintable.h"
+
+#include "test.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define WIN_ARR_LEN 20
+
+static b3_wintable_t *g_wintable;
+
+static b3_win_t *g_win_arr[WIN_ARR_LEN];
+
+static void
+setup(void)
+{
+	RECT rect;
+	int i;
+
+	g_wintable = b3_wintable_new();
+
+	/**
+	 * A row of windows, each 10 pixels wide
+	 */
+	for (i = 0; i < WIN_ARR_LEN; i++) {
+		g_win_arr[i] = b3_win_new((HWND) (LONG_PTR) (i + 1), 0);
+		rect.left = 10 * i;
+		rect.top = 0;
+		rect.right = 10 * (i + 1);
+		rect.bottom = 100;
+		b3_win_set_rect(g_win_arr[i], rect);
+	}
+}
+
+static void
+teardown(void)
+{
+	int i;
+
+	b3_wintable_free(g_wintable);
+	g_wintable = NULL;
+
+	for (i = 0; i < WIN_ARR_LEN; i++) {
+		b3_win_free(g_win_arr[i]);
+		g_win_arr[i] = NULL;
+	}
+}
+
+static int
+find(LONG x, LONG y)
+{
+	POINT position;
+
+	position.x = x;
+	position.y = y;
+	return b3_wintable_find(g_wintable, &position);
+}
+
+static int
+test_wintable_find(void)
+{
+	int error;
+	int i;
+
+	error = b3_test_check_int(find(5, 5), -1, "an empty table contains no window");
+
+	for (i = 0; !error && i < WIN_ARR_LEN; i++) {
+		error = b3_wintable_add(g_wintable, g_win_arr[i]);
+	}
+
+	for (i = 0; !error && i < WIN_ARR_LEN; i++) {
+		error = b3_test_check_int(find(10 * i + 5, 50), i, "the window under the point is found");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(find(10, 0), 1, "the left and top edges belong to the window");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(find(5, 100), -1, "the bottom edge does not belong to the window");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(find(10 * WIN_ARR_LEN, 50), -1, "the right edge does not belong to the window");
+	}
+
+	if (!error) {
+		error = b3_test_check_int(find(-5, -5), -1, "the padding contains no point");
+	}
+
+	if (!error) {
+		b3_wintable_clear(g_wintable);
+		error = b3_test_check_int(find(5, 5), -1, "a cleared table contains no window");
+	}
+
+	return error;
+}
+
+static int
+test_wintable_z_order(void)
+{
+	int error;
+	RECT rect;
+	POINT position;
+
+	rect.left = 0;
+	rect.top = 0;
+	rect.right = 1000;
+	rect.bottom = 1000;
+	b3_win_set_rect(g_win_arr[0], rect);
+
+	b3_wintable_add(g_wintable, g_win_arr[5]);
+	b3_wintable_add(g_wintable, g_win_arr[0]);
+
+	position.x = 55;
+	position.y = 5;
+	error = b3_test_check_void(b3_wintable_get_win_at_pos(g_wintable, &position), g_win_arr[5],
+	                           "the upper window is found");
+
+	if (!error) {
+		position.x = 500;
+		error = b3_test_check_void(b3_wintable_get_win_at_pos(g_wintable, &position), g_win_arr[0],
+		                           "the lower window is found outside of the upper one");
+	}
+
+	return error;
+}
+
+int
+main(void)
+{
+	b3_test(setup, teardown, test_wintable_find, "test_wintable_find");
+	b3_test(setup, teardown, test_wintable_z_order, "test_wintable_z_order");
+
+	return 0;
+}
@@ -167,6 +167,35 @@ test_set_name(void)
 	return error;
 }
 
+static int
+test_urgent(void)
+{
+	int error;
+	b3_ws_t *ws;
+
+	ws = b3_ws_new("test");
+
+	error = 0;
+
+	if (!error) {
+		error = b3_ws_is_urgent(ws);
+	}
+
+	if (!error) {
+		b3_ws_set_urgent(ws, 1);
+		error = !b3_ws_is_urgent(ws);
+	}
+
+	if (!error) {
+		b3_ws_set_urgent(ws, 0);
+		error = b3_ws_is_urgent(ws);
+	}
+
+	b3_ws_free(ws);
+
+	return error;
+}
+
 static int
 test_simple_tree(void)
 {
@@ -1460,6 +1489,7 @@ int
 main(void)
 {
 	b3_test(setup, teardown, test_set_name, "test_set_name");
+	b3_test(setup, teardown, test_urgent, "test_urgent");
 	b3_test(setup, teardown, test_simple_tree, "test_simple_tree");
 	b3_test(setup, teardown, test_set_focused_win, "test_set_focused_win");
 	b3_test(setup, teardown, test_vsplit, "test_vsplit");